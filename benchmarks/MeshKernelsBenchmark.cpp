@@ -0,0 +1,244 @@
+/**
+ * MeshKernels 微基准
+ *
+ * 用法: MeshKernelsBenchmark [--iterations N] [--grid N]
+ * 生成 N×N 四边形网格（默认 1024，约 100 万顶点 / 200 万三角形，高度与 UV 带扰动），
+ * 对包围盒、包围球半径、顶点法线、切线分别计时 MeshKernels 与原标量实现（各运行 N 次取最小值），
+ * 并比较两者的结果：串行路径应逐位一致，并行路径只允许舍入误差，超出容差时返回非零。
+ */
+#include "MeshKernels.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace {
+
+constexpr float TOLERANCE = 1e-5f;
+
+// 原 Mesh::calculateBounds / getBoundingSphereRadius / calculateNormals / calculateTangents 的标量实现
+namespace reference {
+
+void computeBounds(const std::vector<Vertex>& vertices, glm::vec3& minBounds, glm::vec3& maxBounds) {
+    if (vertices.empty()) {
+        minBounds = maxBounds = glm::vec3(0.0f);
+        return;
+    }
+    minBounds = maxBounds = vertices[0].pos;
+    for (const auto& vertex : vertices) {
+        minBounds = glm::min(minBounds, vertex.pos);
+        maxBounds = glm::max(maxBounds, vertex.pos);
+    }
+}
+
+float computeMaxDistance(const std::vector<Vertex>& vertices, const glm::vec3& center) {
+    float maxDist = 0.0f;
+    for (const auto& vertex : vertices) {
+        maxDist = std::max(maxDist, glm::length(vertex.pos - center));
+    }
+    return maxDist;
+}
+
+void computeNormals(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    for (auto& vertex : vertices) {
+        vertex.normal = glm::vec3(0.0f);
+    }
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        uint32_t i0 = indices[i];
+        uint32_t i1 = indices[i + 1];
+        uint32_t i2 = indices[i + 2];
+        glm::vec3 faceNormal = glm::cross(vertices[i1].pos - vertices[i0].pos, vertices[i2].pos - vertices[i0].pos);
+        vertices[i0].normal += faceNormal;
+        vertices[i1].normal += faceNormal;
+        vertices[i2].normal += faceNormal;
+    }
+    for (auto& vertex : vertices) {
+        if (glm::length(vertex.normal) > 0.0001f) {
+            vertex.normal = glm::normalize(vertex.normal);
+        } else {
+            vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+    }
+}
+
+void computeTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    for (auto& vertex : vertices) {
+        vertex.tangent = glm::vec3(0.0f);
+    }
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        Vertex& v0 = vertices[indices[i]];
+        Vertex& v1 = vertices[indices[i + 1]];
+        Vertex& v2 = vertices[indices[i + 2]];
+
+        glm::vec3 edge1 = v1.pos - v0.pos;
+        glm::vec3 edge2 = v2.pos - v0.pos;
+        glm::vec2 deltaUV1 = v1.texCoord - v0.texCoord;
+        glm::vec2 deltaUV2 = v2.texCoord - v0.texCoord;
+
+        float f = deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y;
+        if (std::abs(f) > 0.0001f) {
+            f = 1.0f / f;
+            glm::vec3 tangent;
+            tangent.x = f * (deltaUV2.y * edge1.x - deltaUV1.y * edge2.x);
+            tangent.y = f * (deltaUV2.y * edge1.y - deltaUV1.y * edge2.y);
+            tangent.z = f * (deltaUV2.y * edge1.z - deltaUV1.y * edge2.z);
+            v0.tangent += tangent;
+            v1.tangent += tangent;
+            v2.tangent += tangent;
+        }
+    }
+    for (auto& vertex : vertices) {
+        if (glm::length(vertex.tangent) > 0.0001f) {
+            vertex.tangent = glm::normalize(vertex.tangent - vertex.normal * glm::dot(vertex.normal, vertex.tangent));
+        } else if (std::abs(vertex.normal.x) < 0.9f) {
+            vertex.tangent = glm::normalize(glm::cross(vertex.normal, glm::vec3(1.0f, 0.0f, 0.0f)));
+        } else {
+            vertex.tangent = glm::normalize(glm::cross(vertex.normal, glm::vec3(0.0f, 1.0f, 0.0f)));
+        }
+    }
+}
+
+} // namespace reference
+
+void generateGrid(int size, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    const uint32_t rowLength = static_cast<uint32_t>(size) + 1;
+    vertices.resize(static_cast<size_t>(rowLength) * rowLength);
+    for (uint32_t z = 0; z < rowLength; ++z) {
+        for (uint32_t x = 0; x < rowLength; ++x) {
+            float fx = static_cast<float>(x) / size;
+            float fz = static_cast<float>(z) / size;
+            Vertex& v = vertices[z * rowLength + x];
+            v = Vertex{};
+            v.pos = glm::vec3(fx * 10.0f - 5.0f, 0.3f * std::sin(fx * 37.0f) * std::cos(fz * 23.0f), fz * 10.0f - 5.0f);
+            v.texCoord = glm::vec2(fx + 0.01f * std::sin(fz * 91.0f), fz);
+        }
+    }
+    indices.clear();
+    indices.reserve(static_cast<size_t>(size) * size * 6);
+    for (uint32_t z = 0; z < static_cast<uint32_t>(size); ++z) {
+        for (uint32_t x = 0; x < static_cast<uint32_t>(size); ++x) {
+            uint32_t a = z * rowLength + x;
+            uint32_t b = a + 1;
+            uint32_t c = a + rowLength + 1;
+            uint32_t d = a + rowLength;
+            indices.insert(indices.end(), {a, b, c, a, c, d});
+        }
+    }
+}
+
+template <typename Fn>
+double measureBest(int iterations, Fn&& fn) {
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+struct Difference {
+    size_t differing = 0;   // 与参考结果不逐位相同的分量数
+    float maxError = 0.0f;
+};
+
+void accumulate(Difference& diff, float a, float b) {
+    if (std::memcmp(&a, &b, sizeof(float)) != 0) {
+        ++diff.differing;
+        diff.maxError = std::max(diff.maxError, std::abs(a - b));
+    }
+}
+
+Difference compareVec3(const std::vector<Vertex>& a, const std::vector<Vertex>& b, glm::vec3 Vertex::*member) {
+    Difference diff;
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (int c = 0; c < 3; ++c) {
+            accumulate(diff, (a[i].*member)[c], (b[i].*member)[c]);
+        }
+    }
+    return diff;
+}
+
+bool report(const char* name, double referenceMs, double kernelMs, const Difference& diff) {
+    bool ok = diff.maxError <= TOLERANCE;
+    std::cout << "  " << std::left << std::setw(9) << name << std::right
+              << std::setw(9) << referenceMs << " ms -> " << std::setw(8) << kernelMs << " ms  ("
+              << referenceMs / kernelMs << "x)  ";
+    if (diff.differing == 0) {
+        std::cout << "bit-identical";
+    } else {
+        std::cout << diff.differing << " components differ, max " << std::scientific << diff.maxError
+                  << std::fixed << (ok ? "" : "  EXCEEDS TOLERANCE");
+    }
+    std::cout << std::endl;
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = 5;
+    int gridSize = 1024;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--grid") == 0 && i + 1 < argc) {
+            gridSize = std::max(1, std::atoi(argv[++i]));
+        }
+    }
+
+    std::vector<Vertex> input;
+    std::vector<uint32_t> indices;
+    generateGrid(gridSize, input, indices);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Instruction set: " << MeshKernels::getInstructionSet()
+              << ", threads: " << ThreadPool::getShared().getThreadCount() + 1
+              << ", iterations: " << iterations << "\n"
+              << "Grid " << gridSize << "x" << gridSize << ": " << input.size() << " vertices, "
+              << indices.size() / 3 << " triangles" << std::endl;
+
+    bool ok = true;
+
+    // 包围盒与包围球半径（只读）
+    glm::vec3 refMin, refMax, minBounds, maxBounds;
+    double refMs = measureBest(iterations, [&]() { reference::computeBounds(input, refMin, refMax); });
+    double kernelMs = measureBest(iterations, [&]() { MeshKernels::computeBounds(input, minBounds, maxBounds); });
+    Difference boundsDiff;
+    for (int c = 0; c < 3; ++c) {
+        accumulate(boundsDiff, refMin[c], minBounds[c]);
+        accumulate(boundsDiff, refMax[c], maxBounds[c]);
+    }
+    ok &= report("bounds", refMs, kernelMs, boundsDiff);
+
+    glm::vec3 center = (refMin + refMax) * 0.5f;
+    float refRadius = 0.0f, radius = 0.0f;
+    refMs = measureBest(iterations, [&]() { refRadius = reference::computeMaxDistance(input, center); });
+    kernelMs = measureBest(iterations, [&]() { radius = MeshKernels::computeMaxDistance(input, center); });
+    Difference radiusDiff;
+    accumulate(radiusDiff, refRadius, radius);
+    ok &= report("radius", refMs, kernelMs, radiusDiff);
+
+    // 法线与切线（原地写入，每次调用都会先清零累加结果）
+    std::vector<Vertex> expected = input;
+    std::vector<Vertex> actual = input;
+    refMs = measureBest(iterations, [&]() { reference::computeNormals(expected, indices); });
+    kernelMs = measureBest(iterations, [&]() { MeshKernels::computeNormals(actual, indices); });
+    ok &= report("normals", refMs, kernelMs, compareVec3(expected, actual, &Vertex::normal));
+
+    // 切线以同一组法线为输入，避免法线误差传递到切线比较中
+    actual = expected;
+    refMs = measureBest(iterations, [&]() { reference::computeTangents(expected, indices); });
+    kernelMs = measureBest(iterations, [&]() { MeshKernels::computeTangents(actual, indices); });
+    ok &= report("tangents", refMs, kernelMs, compareVec3(expected, actual, &Vertex::tangent));
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+/**
+ * MeshOptimizer 微基准
+ *
+ * 用法: MeshOptimizerBenchmark [--iterations N] [--grid N] [file.obj ...]
+ * 依次处理球体（Mesh::createSphere(64)，与 MeshManager 的内置 "sphere" 相同）、N×N 四边形网格
+ * （默认 256，按行生成索引）以及命令行传入的 OBJ 文件，输出原始顺序、Tipsify、过度绘制排序和
+ * 完整 MeshOptimizer::optimize 之后的 ACMR/ATVR（FIFO 缓存模拟，大小 DEFAULT_CACHE_SIZE），
+ * 以及各阶段耗时（各运行 N 次取最小值）。优化只允许重排：三角形（含绕序）的多重集合发生变化时返回非零。
+ */
+#include "Mesh.h"
+#include "MeshOptimizer.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+
+void generateGrid(int size, Mesh& mesh) {
+    const uint32_t rowLength = static_cast<uint32_t>(size) + 1;
+    std::vector<Vertex> vertices(static_cast<size_t>(rowLength) * rowLength);
+    for (uint32_t z = 0; z < rowLength; ++z) {
+        for (uint32_t x = 0; x < rowLength; ++x) {
+            float fx = static_cast<float>(x) / size;
+            float fz = static_cast<float>(z) / size;
+            Vertex& v = vertices[z * rowLength + x];
+            v = Vertex{};
+            v.pos = glm::vec3(fx * 10.0f - 5.0f, 0.0f, fz * 10.0f - 5.0f);
+            v.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+            v.texCoord = glm::vec2(fx, fz);
+            v.tangent = glm::vec3(1.0f, 0.0f, 0.0f);
+        }
+    }
+    std::vector<uint32_t> indices;
+    indices.reserve(static_cast<size_t>(size) * size * 6);
+    for (uint32_t z = 0; z < static_cast<uint32_t>(size); ++z) {
+        for (uint32_t x = 0; x < static_cast<uint32_t>(size); ++x) {
+            uint32_t a = z * rowLength + x;
+            uint32_t b = a + 1;
+            uint32_t c = a + rowLength + 1;
+            uint32_t d = a + rowLength;
+            indices.insert(indices.end(), {a, c, b, a, d, c});
+        }
+    }
+    mesh.setVertices(vertices);
+    mesh.setIndices(indices);
+}
+
+template <typename Fn>
+double measureBest(int iterations, Fn&& fn) {
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+// 三角形按顶点内容比较（optimizeVertexFetch 会重排顶点），旋转到最小顶点在前以保留绕序
+using Triangle = std::array<Vertex, 3>;
+
+bool vertexLess(const Vertex& a, const Vertex& b) {
+    return std::memcmp(&a, &b, sizeof(Vertex)) < 0;
+}
+
+std::vector<Triangle> collectTriangles(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    std::vector<Triangle> triangles(indices.size() / 3);
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        Triangle tri = {vertices[indices[t * 3]], vertices[indices[t * 3 + 1]], vertices[indices[t * 3 + 2]]};
+        size_t first = 0;
+        for (size_t k = 1; k < 3; ++k) {
+            if (vertexLess(tri[k], tri[first])) {
+                first = k;
+            }
+        }
+        std::rotate(tri.begin(), tri.begin() + first, tri.end());
+        triangles[t] = tri;
+    }
+    std::sort(triangles.begin(), triangles.end(), [](const Triangle& a, const Triangle& b) {
+        return std::memcmp(a.data(), b.data(), sizeof(Triangle)) < 0;
+    });
+    return triangles;
+}
+
+bool sameTriangles(const std::vector<Triangle>& a, const std::vector<Triangle>& b) {
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(Triangle)) == 0);
+}
+
+void reportStage(const char* name, const VertexCacheStats& stats) {
+    std::cout << "  " << std::left << std::setw(10) << name << std::right
+              << "ACMR " << std::setw(5) << stats.acmr << "  ATVR " << std::setw(5) << stats.atvr;
+}
+
+bool runCase(const std::string& name, const Mesh& source, int iterations) {
+    const std::vector<Vertex>& vertices = source.getVertices();
+    const std::vector<uint32_t>& indices = source.getIndices();
+    std::cout << name << ": " << vertices.size() << " vertices, " << indices.size() / 3 << " triangles" << std::endl;
+
+    reportStage("input", MeshOptimizer::analyzeVertexCache(indices, vertices.size()));
+    std::cout << std::endl;
+
+    std::vector<uint32_t> cacheOrdered;
+    double tipsifyMs = measureBest(iterations, [&]() {
+        cacheOrdered = MeshOptimizer::optimizeVertexCache(indices, vertices.size());
+    });
+    reportStage("tipsify", MeshOptimizer::analyzeVertexCache(cacheOrdered, vertices.size()));
+    std::cout << std::setw(9) << tipsifyMs << " ms" << std::endl;
+
+    std::vector<uint32_t> overdrawOrdered;
+    size_t clusterCount = 0;
+    double overdrawMs = measureBest(iterations, [&]() {
+        overdrawOrdered = MeshOptimizer::optimizeOverdraw(cacheOrdered, vertices, MeshOptimizer::DEFAULT_CACHE_SIZE,
+                                                          &clusterCount);
+    });
+    reportStage("overdraw", MeshOptimizer::analyzeVertexCache(overdrawOrdered, vertices.size()));
+    std::cout << std::setw(9) << overdrawMs << " ms  (" << clusterCount << " clusters)" << std::endl;
+
+    // optimize 原地改写网格，每次迭代从源网格的副本开始，只统计 optimize 自身的耗时
+    Mesh optimized;
+    MeshOptimizeStats stats;
+    double optimizeMs = std::numeric_limits<double>::max();
+    for (int i = 0; i < iterations; ++i) {
+        optimized = source;
+        stats = MeshOptimizer::optimize(optimized);
+        optimizeMs = std::min(optimizeMs, stats.milliseconds);
+    }
+    reportStage("optimize", stats.after);
+    std::cout << std::setw(9) << optimizeMs << " ms  (" << stats.clusterCount << " clusters, "
+              << optimized.getVertices().size() << " vertices)" << std::endl;
+
+    bool ok = sameTriangles(collectTriangles(vertices, indices),
+                            collectTriangles(optimized.getVertices(), optimized.getIndices()));
+    std::cout << "  " << (ok ? "triangles preserved" : "TRIANGLES CHANGED") << std::endl;
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = 5;
+    int gridSize = 256;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--grid") == 0 && i + 1 < argc) {
+            gridSize = std::max(1, std::atoi(argv[++i]));
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Threads: " << ThreadPool::getShared().getThreadCount() + 1
+              << ", iterations: " << iterations
+              << ", cache size: " << MeshOptimizer::DEFAULT_CACHE_SIZE << std::endl;
+
+    bool ok = true;
+
+    Mesh sphere;
+    sphere.createSphere(64);
+    ok &= runCase("Sphere (64 segments)", sphere, iterations);
+
+    Mesh grid;
+    generateGrid(gridSize, grid);
+    ok &= runCase("Grid " + std::to_string(gridSize) + "x" + std::to_string(gridSize), grid, iterations);
+
+    for (const auto& file : files) {
+        Mesh mesh;
+        if (!mesh.loadFromOBJ(file)) {
+            std::cerr << "Failed to load " << file << std::endl;
+            ok = false;
+            continue;
+        }
+        ok &= runCase(file, mesh, iterations);
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+/**
+ * ObjParser 解析吞吐量基准
+ *
+ * 用法: ObjParserBenchmark [--iterations N] [--grid N] [file.obj ...]
+ * 不指定文件时生成 N×N 四边形网格（含 v/vt/vn，默认 512）。
+ * 文件先整体读入内存，只计时解析本身：ObjParser::parse 与 tinyobj::LoadObj（istream）
+ * 各运行 N 次取最小值，并逐项比较两者的顶点属性和三角形索引，不一致时返回非零。
+ */
+#define TINYOBJLOADER_IMPLEMENTATION
+#include "ObjParser.h"
+#include "ThreadPool.h"
+#include "tiny_obj_loader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Input {
+    std::string name;
+    std::string text;
+};
+
+std::string generateGrid(int size) {
+    std::ostringstream out;
+    out << std::setprecision(7);
+    const int rowLength = size + 1;
+    for (int z = 0; z <= size; ++z) {
+        for (int x = 0; x <= size; ++x) {
+            float fx = static_cast<float>(x) / size;
+            float fz = static_cast<float>(z) / size;
+            out << "v " << fx * 10.0f - 5.0f << ' ' << 0.25f * (fx * fx - fz) << ' ' << fz * 10.0f - 5.0f << '\n';
+            out << "vt " << fx << ' ' << fz << '\n';
+            out << "vn 0 1 0\n";
+        }
+    }
+    for (int z = 0; z < size; ++z) {
+        for (int x = 0; x < size; ++x) {
+            int a = z * rowLength + x + 1;
+            int b = a + 1;
+            int c = a + rowLength + 1;
+            int d = a + rowLength;
+            out << "f " << a << '/' << a << '/' << a << ' ' << b << '/' << b << '/' << b << ' '
+                << c << '/' << c << '/' << c << ' ' << d << '/' << d << '/' << d << '\n';
+        }
+    }
+    return out.str();
+}
+
+bool readFile(const std::string& path, std::string& text) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << stream.rdbuf();
+    text = buffer.str();
+    return true;
+}
+
+template <typename Fn>
+double measureBest(int iterations, Fn&& fn) {
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+// 两条路径都做扇形三角化，按形状顺序拼接后的三角形应与 ObjParser 的 corners 一一对应
+bool matches(const ObjData& obj, const tinyobj::attrib_t& attrib, const std::vector<tinyobj::shape_t>& shapes) {
+    if (obj.positions != attrib.vertices || obj.normals != attrib.normals || obj.texCoords != attrib.texcoords) {
+        return false;
+    }
+    size_t corner = 0;
+    for (const auto& shape : shapes) {
+        for (const auto& index : shape.mesh.indices) {
+            if (corner >= obj.corners.size()) {
+                return false;
+            }
+            const ObjCorner& c = obj.corners[corner++];
+            if (c.position != index.vertex_index || c.texCoord != index.texcoord_index || c.normal != index.normal_index) {
+                return false;
+            }
+        }
+    }
+    return corner == obj.corners.size();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = 5;
+    int gridSize = 512;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--grid") == 0 && i + 1 < argc) {
+            gridSize = std::max(1, std::atoi(argv[++i]));
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+
+    std::vector<Input> inputs;
+    if (files.empty()) {
+        inputs.push_back({"grid " + std::to_string(gridSize) + "x" + std::to_string(gridSize), generateGrid(gridSize)});
+    }
+    for (const auto& path : files) {
+        Input input{path, {}};
+        if (!readFile(path, input.text)) {
+            std::cerr << "Cannot read " << path << std::endl;
+            return 1;
+        }
+        inputs.push_back(std::move(input));
+    }
+
+    std::cout << "Threads: " << ThreadPool::getShared().getThreadCount() + 1
+              << ", iterations: " << iterations << std::endl;
+
+    bool allMatch = true;
+    for (const auto& input : inputs) {
+        ObjData obj;
+        std::string error;
+        double nativeMs = measureBest(iterations, [&]() {
+            if (!ObjParser::parse(input.text.data(), input.text.size(), obj, error)) {
+                std::cerr << "ObjParser failed on " << input.name << ": " << error << std::endl;
+                std::exit(1);
+            }
+        });
+
+        tinyobj::attrib_t attrib;
+        std::vector<tinyobj::shape_t> shapes;
+        std::vector<tinyobj::material_t> materials;
+        double tinyobjMs = measureBest(iterations, [&]() {
+            std::istringstream stream(input.text);
+            std::string warn, err;
+            attrib = {};
+            shapes.clear();
+            materials.clear();
+            tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, &stream, nullptr);
+        });
+
+        bool same = matches(obj, attrib, shapes);
+        allMatch = allMatch && same;
+
+        double megabytes = static_cast<double>(input.text.size()) / (1024.0 * 1024.0);
+        std::cout << std::fixed << std::setprecision(2)
+                  << input.name << " (" << megabytes << " MB, " << obj.getTriangleCount() << " triangles)\n"
+                  << "  ObjParser: " << nativeMs << " ms (" << megabytes * 1000.0 / nativeMs << " MB/s)\n"
+                  << "  tinyobj:   " << tinyobjMs << " ms (" << megabytes * 1000.0 / tinyobjMs << " MB/s)\n"
+                  << "  speedup:   " << tinyobjMs / nativeMs << "x, output " << (same ? "identical" : "MISMATCH")
+                  << std::endl;
+    }
+    return allMatch ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+# ============================================================
+# 校验仓库中预编译的 SPIR-V 与 GLSL 源文件一致
+#
+# 用法: cmake -DSHADER_DIR=<shaders 目录> -P CheckShaderBinaries.cmake
+#
+# shaders/spirv_sources.sha256 由 compile_shaders.sh 在 glslc 编译（并通过 spirv-val 校验）后生成，
+# 每行为 "<源文件 SHA-256> <二进制> <源文件>"。以下情况视为漂移，脚本以错误退出：
+#   - 清单中的源文件内容已变化（二进制需要重新编译）
+#   - 清单中的二进制不存在
+#   - 目录中的 .spv 不在清单中（不是由 compile_shaders.sh 生成的）
+# ============================================================
+if(NOT SHADER_DIR)
+    message(FATAL_ERROR "SHADER_DIR is not set")
+endif()
+
+set(MANIFEST "${SHADER_DIR}/spirv_sources.sha256")
+if(NOT EXISTS "${MANIFEST}")
+    message(FATAL_ERROR "Missing ${MANIFEST}; run compile_shaders.sh to regenerate the SPIR-V binaries")
+endif()
+
+file(STRINGS "${MANIFEST}" MANIFEST_LINES ENCODING UTF-8)
+set(LISTED_BINARIES)
+set(ERRORS)
+
+foreach(LINE ${MANIFEST_LINES})
+    if(LINE MATCHES "^#" OR LINE STREQUAL "")
+        continue()
+    endif()
+
+    string(REGEX MATCH "^([0-9a-f]+) +([^ ]+) +([^ ]+)$" MATCHED "${LINE}")
+    if(NOT MATCHED)
+        list(APPEND ERRORS "malformed manifest line: ${LINE}")
+        continue()
+    endif()
+    set(RECORDED_HASH ${CMAKE_MATCH_1})
+    set(BINARY ${CMAKE_MATCH_2})
+    set(SOURCE ${CMAKE_MATCH_3})
+    list(APPEND LISTED_BINARIES ${BINARY})
+
+    if(NOT EXISTS "${SHADER_DIR}/${BINARY}")
+        list(APPEND ERRORS "${BINARY} is listed but missing")
+    endif()
+    if(NOT EXISTS "${SHADER_DIR}/${SOURCE}")
+        list(APPEND ERRORS "${BINARY}: source ${SOURCE} not found")
+        continue()
+    endif()
+
+    file(SHA256 "${SHADER_DIR}/${SOURCE}" SOURCE_HASH)
+    if(NOT SOURCE_HASH STREQUAL RECORDED_HASH)
+        list(APPEND ERRORS "${BINARY} is stale: ${SOURCE} changed since it was compiled")
+    endif()
+endforeach()
+
+file(GLOB CHECKED_IN_BINARIES RELATIVE "${SHADER_DIR}" "${SHADER_DIR}/*.spv")
+foreach(BINARY ${CHECKED_IN_BINARIES})
+    list(FIND LISTED_BINARIES ${BINARY} INDEX)
+    if(INDEX EQUAL -1)
+        list(APPEND ERRORS "${BINARY} is not in spirv_sources.sha256 (not produced by compile_shaders.sh)")
+    endif()
+endforeach()
+
+if(ERRORS)
+    string(REPLACE ";" "\n  " ERROR_TEXT "${ERRORS}")
+    message(FATAL_ERROR "Checked-in SPIR-V does not match its sources:\n  ${ERROR_TEXT}\n"
+                        "Run compile_shaders.sh (requires glslc) and commit the results.")
+endif()
+
+list(LENGTH LISTED_BINARIES BINARY_COUNT)
+message(STATUS "Checked-in SPIR-V up to date (${BINARY_COUNT} binaries)")
@@ -2,6 +2,11 @@
 
 # 着色器编译脚本
 # 确保已安装Vulkan SDK并设置了环境变量
+# 输出文件名与 CMakeLists.txt 一致：simple.vert -> simple_vert.spv，-DBINDLESS 变体为 pbr_bindless_frag.spv
+# 找到 spirv-val 时逐个校验输出；全部成功后写入 shaders/spirv_sources.sha256（源文件哈希清单），
+# 由 CMake 的 CheckShaderBinaries 目标检查提交的 .spv 是否与源文件一致
+
+cd "$(dirname "$0")" || exit 1
 
 echo "编译着色器..."
 
@@ -11,24 +16,85 @@ if ! command -v glslc &> /dev/null; then
     exit 1
 fi
 
-# 编译顶点着色器
-echo "编译 pbr.vert..."
-glslc shaders/pbr.vert -o shaders/pbr.vert.spv
-if [ $? -eq 0 ]; then
-    echo "✓ pbr.vert 编译成功"
+if command -v spirv-val &> /dev/null; then
+    SPIRV_VAL=spirv-val
 else
-    echo "✗ pbr.vert 编译失败"
-    exit 1
+    echo "警告: 找不到spirv-val，跳过SPIR-V校验。"
 fi
 
-# 编译片段着色器
-echo "编译 pbr.frag..."
-glslc shaders/pbr.frag -o shaders/pbr.frag.spv
-if [ $? -eq 0 ]; then
-    echo "✓ pbr.frag 编译成功"
+if command -v sha256sum &> /dev/null; then
+    SHA256="sha256sum"
 else
-    echo "✗ pbr.frag 编译失败"
-    exit 1
+    SHA256="shasum -a 256"
 fi
 
-echo "所有着色器编译完成！"
\ No newline at end of file
+MANIFEST_ENTRIES=()
+
+# 与 CMakeLists.txt 的 SHADER_SOURCES 保持一致
+SHADER_SOURCES=(
+    simple.vert
+    simple.frag
+    mesh.vert
+    mesh.frag
+    pbr.vert
+    pbr.frag
+    simple_mesh.vert
+    simple_mesh.frag
+    gbuffer.vert
+    gbuffer.frag
+    ssr.vert
+    ssr.frag
+    water.vert
+    water.frag
+    deferred_lighting.vert
+    deferred_lighting.frag
+    cull.comp
+)
+
+# 与 CMakeLists.txt 的 BINDLESS_SHADER_SOURCES 保持一致
+BINDLESS_SHADER_SOURCES=(
+    pbr.frag
+    gbuffer.frag
+)
+
+# compile <源文件> <输出文件> [glslc 额外参数...]
+compile() {
+    local source="shaders/$1"
+    local output="shaders/$2"
+    shift 2
+
+    if [ ! -f "$source" ]; then
+        echo "✗ 找不到 $source"
+        exit 1
+    fi
+
+    echo "编译 $source -> $output"
+    if ! glslc "$@" "$source" -o "$output"; then
+        echo "✗ $source 编译失败"
+        exit 1
+    fi
+    if [ -n "$SPIRV_VAL" ] && ! "$SPIRV_VAL" --target-env vulkan1.0 "$output"; then
+        echo "✗ $output 校验失败"
+        exit 1
+    fi
+    echo "✓ $output 编译成功"
+
+    local hash
+    hash=$($SHA256 "$source" | cut -d' ' -f1)
+    MANIFEST_ENTRIES+=("$hash $(basename "$output") $(basename "$source")")
+}
+
+for shader in "${SHADER_SOURCES[@]}"; do
+    compile "$shader" "${shader//./_}.spv"
+done
+
+for shader in "${BINDLESS_SHADER_SOURCES[@]}"; do
+    compile "$shader" "${shader//./_bindless_}.spv" -DBINDLESS
+done
+
+{
+    echo "# <源文件 SHA-256> <二进制> <源文件>，由 compile_shaders.sh 生成，请勿手工修改"
+    printf '%s\n' "${MANIFEST_ENTRIES[@]}"
+} > shaders/spirv_sources.sha256
+
+echo "所有着色器编译完成！"
@@ -1,5 +1,9 @@
 #version 450
 
+#ifdef BINDLESS
+#extension GL_EXT_nonuniform_qualifier : require
+#endif
+
 // G-Buffer 片段着色器
 // 输出到多个渲染目标 (MRT):
 // - Location 0: Position (RGB16F) - 世界空间位置
@@ -16,10 +20,34 @@ layout(location = 0) out vec4 outPosition;
 layout(location = 1) out vec4 outNormal;
 layout(location = 2) out vec4 outAlbedo;
 
+#ifdef BINDLESS
+// Bindless：纹理在同一数组中，材质参数在存储缓冲区中（Set 1），材质索引来自 push constant
+layout(push_constant) uniform PushConstants {
+    uint materialIndex;  // 按材质推送一次，同一材质的实例共用
+} push;
+
+struct MaterialData {
+    uint albedoTexture;
+    uint normalTexture;
+    uint metallicTexture;
+    uint padding;
+};
+
+layout(set = 1, binding = 0) uniform sampler2D textures[];
+layout(std430, set = 1, binding = 1) readonly buffer MaterialBuffer {
+    MaterialData materials[];
+};
+
+#define MATERIAL materials[push.materialIndex]
+#define albedoMap textures[nonuniformEXT(MATERIAL.albedoTexture)]
+#define normalMap textures[nonuniformEXT(MATERIAL.normalTexture)]
+#define specularMap textures[nonuniformEXT(MATERIAL.metallicTexture)]
+#else
 // 纹理采样器 (Set 1)
 layout(set = 1, binding = 0) uniform sampler2D albedoMap;
 layout(set = 1, binding = 1) uniform sampler2D normalMap;
 layout(set = 1, binding = 2) uniform sampler2D specularMap;  // R: 金属度, G: 粗糙度
+#endif
 
 void main() {
     // ========================================
@@ -31,12 +59,14 @@ void main() {
     // 输出 1: 世界空间法线
     // ========================================
     // 从法线贴图获取切线空间法线
-    vec3 normalMapValue = texture(normalMap, fragTexCoord).rgb;
+    // 只使用 RG 通道（BC5 压缩的法线贴图没有 B 通道），Z 由单位长度重建
+    vec2 normalMapValue = texture(normalMap, fragTexCoord).rg;
     
     vec3 normal;
     if (length(normalMapValue) > 0.01) {
         // 将法线从 [0, 1] 转换到 [-1, 1]
-        vec3 tangentNormal = normalMapValue * 2.0 - 1.0;
+        vec2 tangentXY = normalMapValue * 2.0 - 1.0;
+        vec3 tangentNormal = vec3(tangentXY, sqrt(max(1.0 - dot(tangentXY, tangentXY), 0.0)));
         // 转换到世界空间
         normal = normalize(fragTBN * tangentNormal);
     } else {
@@ -52,7 +82,7 @@ void main() {
     // ========================================
     vec3 albedo = texture(albedoMap, fragTexCoord).rgb;
     
-    // 从 specular 贴图获取金属度（假设存储在 R 通道）
+    // 从 specular 贴图获取金属度：单通道遮罩的视图复制到 R，glTF 打包贴图烘焙时已从 B 重排到 R
     float metallic = texture(specularMap, fragTexCoord).r;
     
     outAlbedo = vec4(albedo, metallic);
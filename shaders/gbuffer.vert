@@ -3,17 +3,35 @@
 // G-Buffer 顶点着色器
 // 输出世界空间的位置、法线等信息供片段着色器使用
 
-// Push Constants - 每个物体独立的变换数据
-layout(push_constant) uniform PushConstants {
+// 逐实例数据（Set 0, binding 1）：同一网格 + 材质的实体合并为一次实例化绘制，
+// gl_InstanceIndex 已包含 firstInstance，即本次绘制在实例数组中的起点
+struct InstanceData {
     mat4 model;
-    mat4 normalMatrix;
-} push;
+    mat4 normalMatrix;  // 只使用左上 3x3
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer InstanceBuffer {
+    InstanceData instances[];
+};
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inTexCoord;
 layout(location = 3) in vec3 inTangent;
 
+// 紧凑顶点格式（CompactVertex）：位置反量化已并入实例的 model，
+// 法线/切线为八面体编码，只使用 .xy
+layout(constant_id = 0) const bool COMPACT_VERTEX = false;
+
+vec3 octDecode(vec2 e) {
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (v.z < 0.0) {
+        vec2 signs = vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+        v.xy = (1.0 - abs(v.yx)) * signs;
+    }
+    return normalize(v);
+}
+
 layout(location = 0) out vec3 fragWorldPos;
 layout(location = 1) out vec3 fragNormal;
 layout(location = 2) out vec2 fragTexCoord;
@@ -29,19 +47,24 @@ layout(binding = 0) uniform UniformBufferObject {
 } ubo;
 
 void main() {
-    // 计算世界空间位置（使用 Push Constants 的 model）
-    vec4 worldPos = push.model * vec4(inPosition, 1.0);
+    vec3 normal = COMPACT_VERTEX ? octDecode(inNormal.xy) : inNormal;
+    vec3 tangent = COMPACT_VERTEX ? octDecode(inTangent.xy) : inTangent;
+    
+    InstanceData instance = instances[gl_InstanceIndex];
+    
+    // 计算世界空间位置（使用实例数据的 model）
+    vec4 worldPos = instance.model * vec4(inPosition, 1.0);
     fragWorldPos = worldPos.xyz;
     
-    // 计算世界空间法线（使用 Push Constants 的 normalMatrix）
-    mat3 normalMat = mat3(push.normalMatrix);
-    fragNormal = normalize(normalMat * inNormal);
+    // 计算世界空间法线（使用实例数据的 normalMatrix）
+    mat3 normalMat = mat3(instance.normalMatrix);
+    fragNormal = normalize(normalMat * normal);
     
     // 传递纹理坐标
     fragTexCoord = inTexCoord;
     
     // 计算 TBN 矩阵（用于法线贴图）
-    vec3 T = normalize(normalMat * inTangent);
+    vec3 T = normalize(normalMat * tangent);
     vec3 N = fragNormal;
     // 使用 Gram-Schmidt 正交化
     T = normalize(T - dot(T, N) * N);
@@ -1,5 +1,9 @@
 #version 450
 
+#ifdef BINDLESS
+#extension GL_EXT_nonuniform_qualifier : require
+#endif
+
 layout(location = 0) in vec3 fragWorldPos;
 layout(location = 1) in vec3 fragNormal;
 layout(location = 2) in vec2 fragTexCoord;
@@ -10,10 +14,34 @@ layout(location = 6) in vec3 fragLightPos;
 
 layout(location = 0) out vec4 outColor;
 
+#ifdef BINDLESS
+// Bindless：纹理在同一数组中，材质参数在存储缓冲区中（Set 1），材质索引来自 push constant
+layout(push_constant) uniform PushConstants {
+    uint materialIndex;  // 按材质推送一次，同一材质的实例共用
+} push;
+
+struct MaterialData {
+    uint albedoTexture;
+    uint normalTexture;
+    uint metallicTexture;
+    uint padding;
+};
+
+layout(set = 1, binding = 0) uniform sampler2D textures[];
+layout(std430, set = 1, binding = 1) readonly buffer MaterialBuffer {
+    MaterialData materials[];
+};
+
+#define MATERIAL materials[push.materialIndex]
+#define albedoMap textures[nonuniformEXT(MATERIAL.albedoTexture)]
+#define normalMap textures[nonuniformEXT(MATERIAL.normalTexture)]
+#define specularMap textures[nonuniformEXT(MATERIAL.metallicTexture)]
+#else
 // 纹理采样器 (Set 1)
 layout(set = 1, binding = 0) uniform sampler2D albedoMap;
 layout(set = 1, binding = 1) uniform sampler2D normalMap;
 layout(set = 1, binding = 2) uniform sampler2D specularMap;  // 用作金属度/粗糙度控制
+#endif
 
 const float PI = 3.14159265359;
 
@@ -25,7 +53,9 @@ const float DEFAULT_AO = 1.0;         // 无遮蔽
 // 从法线贴图获取法线（切线空间到世界空间）
 vec3 getNormalFromMap() {
     // 采样法线贴图
-    vec3 tangentNormal = texture(normalMap, fragTexCoord).xyz * 2.0 - 1.0;
+    // 只使用 RG 通道（BC5 压缩的法线贴图没有 B 通道），Z 由单位长度重建
+    vec2 tangentXY = texture(normalMap, fragTexCoord).rg * 2.0 - 1.0;
+    vec3 tangentNormal = vec3(tangentXY, sqrt(max(1.0 - dot(tangentXY, tangentXY), 0.0)));
     
     // 构建 TBN 矩阵
     vec3 N = normalize(fragNormal);
@@ -78,16 +108,24 @@ void main() {
     vec3 albedo = pow(texture(albedoMap, fragTexCoord).rgb, vec3(2.2));  // sRGB 到线性空间
     
     // 从高光贴图获取金属度和粗糙度
-    // Spec Mask: 白色 = 高光/金属, 黑色 = 非高光/粗糙
-    vec3 specMask = texture(specularMap, fragTexCoord).rgb;
-    float specValue = (specMask.r + specMask.g + specMask.b) / 3.0;
-    
-    // 使用高光贴图控制粗糙度（反转：高光 = 低粗糙度）
-    float roughness = 1.0 - specValue * 0.8;  // 保留一些基础粗糙度
-    roughness = clamp(roughness, 0.05, 1.0);
-    
-    // 金属度：根据高光强度
-    float metallic = specValue * 0.3;  // 地球主要是非金属
+    vec4 specSample = texture(specularMap, fragTexCoord);
+    float roughness;
+    float metallic;
+    if (specSample.a < 0.5) {
+        // glTF 金属度/粗糙度贴图（烘焙时重排为 R: 金属度, G: 粗糙度, A: 0）
+        metallic = specSample.r;
+        roughness = clamp(specSample.g, 0.05, 1.0);
+    } else {
+        // Spec Mask: 白色 = 高光/金属, 黑色 = 非高光/粗糙
+        float specValue = (specSample.r + specSample.g + specSample.b) / 3.0;
+        
+        // 使用高光贴图控制粗糙度（反转：高光 = 低粗糙度）
+        roughness = 1.0 - specValue * 0.8;  // 保留一些基础粗糙度
+        roughness = clamp(roughness, 0.05, 1.0);
+        
+        // 金属度：根据高光强度
+        metallic = specValue * 0.3;  // 地球主要是非金属
+    }
     
     float ao = DEFAULT_AO;
     
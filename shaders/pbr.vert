@@ -1,10 +1,15 @@
 #version 450
 
-// Push Constants - 每个物体独立的变换数据
-layout(push_constant) uniform PushConstants {
+// 逐实例数据（Set 0, binding 1）：同一网格 + 材质的实体合并为一次实例化绘制，
+// gl_InstanceIndex 已包含 firstInstance，即本次绘制在实例数组中的起点
+struct InstanceData {
     mat4 model;
-    mat4 normalMatrix;
-} push;
+    mat4 normalMatrix;  // 只使用左上 3x3
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer InstanceBuffer {
+    InstanceData instances[];
+};
 
 // UBO - 全局共享的数据（相机、光照）
 layout(binding = 0) uniform UniformBufferObject {
@@ -20,6 +25,19 @@ layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inTexCoord;
 layout(location = 3) in vec3 inTangent;
 
+// 紧凑顶点格式（CompactVertex）：位置反量化已并入实例的 model，
+// 法线/切线为八面体编码，只使用 .xy
+layout(constant_id = 0) const bool COMPACT_VERTEX = false;
+
+vec3 octDecode(vec2 e) {
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (v.z < 0.0) {
+        vec2 signs = vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+        v.xy = (1.0 - abs(v.yx)) * signs;
+    }
+    return normalize(v);
+}
+
 layout(location = 0) out vec3 fragWorldPos;
 layout(location = 1) out vec3 fragNormal;
 layout(location = 2) out vec2 fragTexCoord;
@@ -29,15 +47,20 @@ layout(location = 5) out vec3 fragViewPos;
 layout(location = 6) out vec3 fragLightPos;
 
 void main() {
-    // Transform position to world space (使用 Push Constants 的 model)
-    vec4 worldPos = push.model * vec4(inPosition, 1.0);
+    vec3 normal = COMPACT_VERTEX ? octDecode(inNormal.xy) : inNormal;
+    vec3 tangent = COMPACT_VERTEX ? octDecode(inTangent.xy) : inTangent;
+    
+    InstanceData instance = instances[gl_InstanceIndex];
+    
+    // Transform position to world space (使用实例数据的 model)
+    vec4 worldPos = instance.model * vec4(inPosition, 1.0);
     fragWorldPos = worldPos.xyz;
     
-    // Transform normal to world space (使用 Push Constants 的 normalMatrix)
-    fragNormal = normalize(mat3(push.normalMatrix) * inNormal);
+    // Transform normal to world space (使用实例数据的 normalMatrix)
+    fragNormal = normalize(mat3(instance.normalMatrix) * normal);
     
     // Transform tangent to world space
-    fragTangent = normalize(mat3(push.normalMatrix) * inTangent);
+    fragTangent = normalize(mat3(instance.normalMatrix) * tangent);
     
     // Calculate bitangent
     fragBitangent = cross(fragNormal, fragTangent);
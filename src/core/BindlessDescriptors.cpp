@@ -0,0 +1,282 @@
+#include "BindlessDescriptors.h"
+#include "VulkanDevice.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+uint32_t queryTextureCapacity(const VulkanDevice& device) {
+    const VkPhysicalDeviceLimits& limits = device.getProperties().limits;
+    return std::min({ BindlessDescriptors::MAX_TEXTURES,
+                      limits.maxPerStageDescriptorSamplers,
+                      limits.maxPerStageDescriptorSampledImages,
+                      limits.maxDescriptorSetSamplers,
+                      limits.maxDescriptorSetSampledImages });
+}
+
+} // namespace
+
+BindlessDescriptors::BindlessDescriptors(std::shared_ptr<VulkanDevice> device, uint32_t maxFramesInFlight)
+    : device(device)
+    , maxFramesInFlight(maxFramesInFlight)
+    , textureCapacity(queryTextureCapacity(*device)) {
+
+    createSetLayout();
+    createDescriptorSets();
+
+    std::cout << "BindlessDescriptors created: " << textureCapacity << " texture slots, "
+              << maxFramesInFlight << " frames" << std::endl;
+}
+
+BindlessDescriptors::~BindlessDescriptors() {
+    VkDevice dev = device->getDevice();
+
+    for (FrameData& frame : frames) {
+        destroyMaterialBuffer(frame);
+    }
+    frames.clear();
+
+    if (descriptorPool != VK_NULL_HANDLE) {
+        vkDestroyDescriptorPool(dev, descriptorPool, nullptr);
+        descriptorPool = VK_NULL_HANDLE;
+    }
+    if (setLayout != VK_NULL_HANDLE) {
+        vkDestroyDescriptorSetLayout(dev, setLayout, nullptr);
+        setLayout = VK_NULL_HANDLE;
+    }
+}
+
+bool BindlessDescriptors::isSupported(const VulkanDevice& device) {
+    return device.supportsDescriptorIndexing() && queryTextureCapacity(device) >= MIN_TEXTURES;
+}
+
+void BindlessDescriptors::createSetLayout() {
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+
+    // Binding 0: 纹理数组
+    bindings[0].binding = 0;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[0].descriptorCount = textureCapacity;
+    bindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    // Binding 1: 材质参数
+    bindings[1].binding = 1;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[1].descriptorCount = 1;
+    bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    // 纹理数组只写入已分配的槽位
+    std::array<VkDescriptorBindingFlagsEXT, 2> bindingFlags = { VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT, 0 };
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT flagsInfo{};
+    flagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    flagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+    flagsInfo.pBindingFlags = bindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext = &flagsInfo;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+
+    if (vkCreateDescriptorSetLayout(device->getDevice(), &layoutInfo, nullptr, &setLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create bindless descriptor set layout!");
+    }
+}
+
+void BindlessDescriptors::createDescriptorSets() {
+    VkDevice dev = device->getDevice();
+
+    std::array<VkDescriptorPoolSize, 2> poolSizes{};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSizes[0].descriptorCount = textureCapacity * maxFramesInFlight;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSizes[1].descriptorCount = maxFramesInFlight;
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+    poolInfo.maxSets = maxFramesInFlight;
+
+    if (vkCreateDescriptorPool(dev, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create bindless descriptor pool!");
+    }
+
+    std::vector<VkDescriptorSetLayout> layouts(maxFramesInFlight, setLayout);
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool;
+    allocInfo.descriptorSetCount = maxFramesInFlight;
+    allocInfo.pSetLayouts = layouts.data();
+
+    descriptorSets.resize(maxFramesInFlight);
+    if (vkAllocateDescriptorSets(dev, &allocInfo, descriptorSets.data()) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate bindless descriptor sets!");
+    }
+
+    frames.resize(maxFramesInFlight);
+    for (uint32_t i = 0; i < maxFramesInFlight; ++i) {
+        createMaterialBuffer(frames[i], materialCapacity);
+        writeMaterialDescriptor(i);
+    }
+}
+
+void BindlessDescriptors::createMaterialBuffer(FrameData& frame, uint32_t capacity) {
+    VkDeviceSize size = static_cast<VkDeviceSize>(capacity) * sizeof(BindlessMaterialData);
+    device->createBuffer(size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         frame.materialBuffer, frame.materialAllocation, VulkanMemoryCategory::Uniform);
+    frame.materialMapped = frame.materialAllocation.mapped;
+    frame.materialCapacity = capacity;
+    frame.materialVersion = 0;
+}
+
+void BindlessDescriptors::destroyMaterialBuffer(FrameData& frame) {
+    device->destroyBuffer(frame.materialBuffer, frame.materialAllocation);
+    frame.materialMapped = nullptr;
+    frame.materialCapacity = 0;
+}
+
+void BindlessDescriptors::writeMaterialDescriptor(uint32_t frameIndex) {
+    VkDescriptorBufferInfo bufferInfo{};
+    bufferInfo.buffer = frames[frameIndex].materialBuffer;
+    bufferInfo.offset = 0;
+    bufferInfo.range = VK_WHOLE_SIZE;
+
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = descriptorSets[frameIndex];
+    write.dstBinding = 1;
+    write.dstArrayElement = 0;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.descriptorCount = 1;
+    write.pBufferInfo = &bufferInfo;
+
+    vkUpdateDescriptorSets(device->getDevice(), 1, &write, 0, nullptr);
+}
+
+uint32_t BindlessDescriptors::addTexture(VkImageView view, VkSampler sampler) {
+    uint32_t index;
+    if (!freeTextureSlots.empty()) {
+        index = freeTextureSlots.back();
+        freeTextureSlots.pop_back();
+    } else if (textures.size() < textureCapacity) {
+        index = static_cast<uint32_t>(textures.size());
+        textures.emplace_back();
+    } else {
+        std::cerr << "BindlessDescriptors: texture array full (" << textureCapacity << " slots)" << std::endl;
+        return INVALID_INDEX;
+    }
+
+    textures[index] = { view, sampler };
+    ++textureCount;
+    markTextureDirty(index);
+    return index;
+}
+
+void BindlessDescriptors::updateTexture(uint32_t index, VkImageView view, VkSampler sampler) {
+    if (index >= textures.size() || textures[index].view == VK_NULL_HANDLE) return;
+    textures[index] = { view, sampler };
+    markTextureDirty(index);
+}
+
+void BindlessDescriptors::removeTexture(uint32_t index) {
+    if (index >= textures.size() || textures[index].view == VK_NULL_HANDLE) return;
+
+    // 描述符保持原值（部分绑定，不会再被访问），槽位等所有帧执行完毕后再复用
+    textures[index] = {};
+    --textureCount;
+    releasedTextureSlots.push_back({ index, (1u << maxFramesInFlight) - 1 });
+}
+
+uint32_t BindlessDescriptors::addMaterial(const BindlessMaterialData& data) {
+    if (materials.size() == materialCapacity) {
+        materialCapacity *= 2;
+    }
+    materials.push_back(data);
+    ++materialVersion;
+    return static_cast<uint32_t>(materials.size() - 1);
+}
+
+void BindlessDescriptors::updateMaterial(uint32_t index, const BindlessMaterialData& data) {
+    if (index >= materials.size()) return;
+    materials[index] = data;
+    ++materialVersion;
+}
+
+void BindlessDescriptors::markTextureDirty(uint32_t index) {
+    for (FrameData& frame : frames) {
+        frame.dirtyTextures.push_back(index);
+    }
+}
+
+void BindlessDescriptors::beginFrame(uint32_t frameIndex) {
+    FrameData& frame = frames[frameIndex];
+
+    // 材质参数：容量不足时重建该帧的缓冲区，有修改时整体拷贝（材质很少变化，数据量为 16 字节/材质）
+    if (frame.materialCapacity < materials.size()) {
+        destroyMaterialBuffer(frame);
+        createMaterialBuffer(frame, materialCapacity);
+        writeMaterialDescriptor(frameIndex);
+    }
+    if (frame.materialVersion != materialVersion) {
+        if (!materials.empty()) {
+            memcpy(frame.materialMapped, materials.data(), materials.size() * sizeof(BindlessMaterialData));
+        }
+        frame.materialVersion = materialVersion;
+    }
+
+    // 纹理槽位：一次 vkUpdateDescriptorSets 写入所有修改
+    if (!frame.dirtyTextures.empty()) {
+        std::sort(frame.dirtyTextures.begin(), frame.dirtyTextures.end());
+        frame.dirtyTextures.erase(std::unique(frame.dirtyTextures.begin(), frame.dirtyTextures.end()),
+                                  frame.dirtyTextures.end());
+
+        std::vector<VkDescriptorImageInfo> imageInfos;
+        std::vector<VkWriteDescriptorSet> writes;
+        imageInfos.reserve(frame.dirtyTextures.size());
+        writes.reserve(frame.dirtyTextures.size());
+
+        for (uint32_t index : frame.dirtyTextures) {
+            const TextureSlot& slot = textures[index];
+            if (slot.view == VK_NULL_HANDLE) continue;  // 写入前已被移除
+
+            VkDescriptorImageInfo imageInfo{};
+            imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            imageInfo.imageView = slot.view;
+            imageInfo.sampler = slot.sampler;
+            imageInfos.push_back(imageInfo);
+
+            VkWriteDescriptorSet write{};
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = descriptorSets[frameIndex];
+            write.dstBinding = 0;
+            write.dstArrayElement = index;
+            write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            write.descriptorCount = 1;
+            write.pImageInfo = &imageInfos.back();
+            writes.push_back(write);
+        }
+
+        if (!writes.empty()) {
+            vkUpdateDescriptorSets(device->getDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        }
+        frame.dirtyTextures.clear();
+    }
+
+    // 该帧之前的提交已执行完毕，不再引用释放的槽位
+    const uint32_t frameBit = 1u << frameIndex;
+    for (auto it = releasedTextureSlots.begin(); it != releasedTextureSlots.end();) {
+        it->pendingFrames &= ~frameBit;
+        if (it->pendingFrames == 0) {
+            freeTextureSlots.push_back(it->index);
+            it = releasedTextureSlots.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
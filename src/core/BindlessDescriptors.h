@@ -0,0 +1,119 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "VulkanAllocator.h"
+
+class VulkanDevice;
+
+/**
+ * bindless 材质参数（与着色器中的 MaterialData 一致，std430）
+ * 纹理字段为 BindlessDescriptors 纹理数组中的槽位
+ */
+struct BindlessMaterialData {
+    uint32_t albedoTexture = 0;
+    uint32_t normalTexture = 0;
+    uint32_t metallicTexture = 0;
+    uint32_t padding = 0;
+
+    bool operator==(const BindlessMaterialData& other) const {
+        return albedoTexture == other.albedoTexture && normalTexture == other.normalTexture &&
+               metallicTexture == other.metallicTexture;
+    }
+    bool operator!=(const BindlessMaterialData& other) const { return !(*this == other); }
+};
+
+/**
+ * BindlessDescriptors - 所有材质共用的描述符集（需要 VK_EXT_descriptor_indexing）
+ *
+ * 布局（作为各 Pass 的 Set 1）：
+ * - Binding 0: sampler2D 数组，容量取设备限制与 MAX_TEXTURES 的较小值，未写入的槽位不可访问（部分绑定）
+ * - Binding 1: 材质参数存储缓冲区（BindlessMaterialData 数组），着色器按材质索引读取
+ *
+ * 每帧一个描述符集和一个材质缓冲区。修改先记录在 CPU 端，beginFrame(frameIndex) 在该帧的栅栏
+ * 等待之后、录制之前写入该帧的集合，因此不需要 UPDATE_AFTER_BIND；释放的纹理槽位在所有帧都
+ * 执行过 beginFrame 后才重新分配。材质缓冲区容量不足时在 beginFrame 中按帧重建（加倍）。
+ */
+class BindlessDescriptors {
+public:
+    static constexpr uint32_t MAX_TEXTURES = 4096;
+    static constexpr uint32_t MIN_TEXTURES = 256;          // 设备限制低于此值时不启用
+    static constexpr uint32_t INITIAL_MATERIALS = 256;
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    BindlessDescriptors(std::shared_ptr<VulkanDevice> device, uint32_t maxFramesInFlight);
+    ~BindlessDescriptors();
+
+    BindlessDescriptors(const BindlessDescriptors&) = delete;
+    BindlessDescriptors& operator=(const BindlessDescriptors&) = delete;
+
+    // 设备是否支持（descriptor indexing 且纹理数组容量不低于 MIN_TEXTURES）
+    static bool isSupported(const VulkanDevice& device);
+
+    VkDescriptorSetLayout getSetLayout() const { return setLayout; }
+    VkDescriptorSet getDescriptorSet(uint32_t frameIndex) const { return descriptorSets[frameIndex]; }
+    uint32_t getTextureCapacity() const { return textureCapacity; }
+    uint32_t getTextureCount() const { return textureCount; }
+    uint32_t getMaterialCount() const { return static_cast<uint32_t>(materials.size()); }
+
+    // 分配纹理槽位，数组已满时返回 INVALID_INDEX
+    uint32_t addTexture(VkImageView view, VkSampler sampler);
+    // 纹理资源被替换后（流式加载）重写槽位
+    void updateTexture(uint32_t index, VkImageView view, VkSampler sampler);
+    void removeTexture(uint32_t index);
+
+    uint32_t addMaterial(const BindlessMaterialData& data);
+    void updateMaterial(uint32_t index, const BindlessMaterialData& data);
+    const BindlessMaterialData& getMaterial(uint32_t index) const { return materials[index]; }
+
+    // 把待写入的修改应用到该帧的描述符集和材质缓冲区（该帧的上一次提交必须已执行完毕）
+    // 同一帧内多次调用只有第一次有实际写入
+    void beginFrame(uint32_t frameIndex);
+
+private:
+    struct TextureSlot {
+        VkImageView view = VK_NULL_HANDLE;
+        VkSampler sampler = VK_NULL_HANDLE;
+    };
+
+    struct ReleasedSlot {
+        uint32_t index;
+        uint32_t pendingFrames;  // 尚未执行 beginFrame 的帧（位掩码）
+    };
+
+    struct FrameData {
+        VkBuffer materialBuffer = VK_NULL_HANDLE;
+        VulkanAllocation materialAllocation;
+        void* materialMapped = nullptr;
+        uint32_t materialCapacity = 0;
+        uint64_t materialVersion = 0;       // 已写入缓冲区的材质版本
+        std::vector<uint32_t> dirtyTextures;
+    };
+
+    void createSetLayout();
+    void createDescriptorSets();
+    void createMaterialBuffer(FrameData& frame, uint32_t capacity);
+    void destroyMaterialBuffer(FrameData& frame);
+    void writeMaterialDescriptor(uint32_t frameIndex);
+    void markTextureDirty(uint32_t index);
+
+    std::shared_ptr<VulkanDevice> device;
+    uint32_t maxFramesInFlight;
+    uint32_t textureCapacity = 0;
+
+    VkDescriptorSetLayout setLayout = VK_NULL_HANDLE;
+    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> descriptorSets;
+    std::vector<FrameData> frames;
+
+    std::vector<TextureSlot> textures;
+    std::vector<uint32_t> freeTextureSlots;
+    std::vector<ReleasedSlot> releasedTextureSlots;
+    uint32_t textureCount = 0;
+
+    std::vector<BindlessMaterialData> materials;
+    uint32_t materialCapacity = INITIAL_MATERIALS;
+    uint64_t materialVersion = 0;
+};
@@ -0,0 +1,122 @@
+#include "FrameAllocator.h"
+#include "VulkanDevice.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+FrameAllocator::FrameAllocator(VulkanDevice& device, uint32_t frameCount, VkDeviceSize frameSize)
+    : device(device)
+    , frameCount(frameCount) {
+
+    const VkPhysicalDeviceLimits& limits = device.getProperties().limits;
+    uniformAlignment = std::max<VkDeviceSize>(limits.minUniformBufferOffsetAlignment, 1);
+    storageAlignment = std::max<VkDeviceSize>(limits.minStorageBufferOffsetAlignment, 1);
+
+    // 段大小对齐到两种偏移对齐的较大者，保证每段起点对两种用途都合法
+    segmentAlignment = std::max(uniformAlignment, storageAlignment);
+    this->frameSize = (frameSize + segmentAlignment - 1) / segmentAlignment * segmentAlignment;
+
+    // 实例数据等以整段为存储缓冲区的可见范围；动态偏移为 32 位
+    const VkDeviceSize offsetLimit = std::numeric_limits<uint32_t>::max() / frameCount;
+    maxFrameSize = std::min<VkDeviceSize>(limits.maxStorageBufferRange, offsetLimit) / segmentAlignment * segmentAlignment;
+    maxFrameSize = std::max(maxFrameSize, this->frameSize);
+
+    createBuffer();
+
+    std::cout << "FrameAllocator created: " << frameCount << " x " << (this->frameSize >> 10)
+              << " KB per-frame segments" << std::endl;
+}
+
+FrameAllocator::~FrameAllocator() {
+    device.destroyBuffer(buffer, allocation);
+}
+
+void FrameAllocator::createBuffer() {
+    device.createBuffer(frameSize * frameCount,
+                        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                        buffer, allocation, VulkanMemoryCategory::Uniform);
+}
+
+void FrameAllocator::grow(VkDeviceSize requiredSize) {
+    VkDeviceSize newSize = std::max(requiredSize, frameSize * 2);
+    newSize = (newSize + segmentAlignment - 1) / segmentAlignment * segmentAlignment;
+    newSize = std::min(newSize, maxFrameSize);
+    if (newSize <= frameSize) {
+        std::cerr << "FrameAllocator: per-frame segment already at its limit (" << (frameSize >> 10)
+                  << " KB), " << (requiredSize >> 10) << " KB requested" << std::endl;
+        return;
+    }
+
+    // 其他飞行帧和各 Pass 的描述符集仍引用旧缓冲区：等待设备空闲后重建，使用者按版本重新写入描述符
+    vkDeviceWaitIdle(device.getDevice());
+    device.destroyBuffer(buffer, allocation);
+    frameSize = newSize;
+    createBuffer();
+    ++version;
+
+    std::cout << "FrameAllocator grown: " << frameCount << " x " << (frameSize >> 10)
+              << " KB per-frame segments" << std::endl;
+}
+
+void FrameAllocator::beginFrame(uint32_t frameIndex) {
+    if (requiredBytes > frameSize) {
+        grow(requiredBytes);
+    }
+    requiredBytes = 0;
+
+    currentFrame = frameIndex % frameCount;
+    head = 0;
+    allocationCount = 0;
+}
+
+void FrameAllocator::reserve(VkDeviceSize bytes) {
+    if (bytes > frameSize && head == 0) {
+        grow(bytes);
+    }
+}
+
+FrameAllocation FrameAllocator::allocateUniform(VkDeviceSize size) {
+    return allocate(size, uniformAlignment);
+}
+
+FrameAllocation FrameAllocator::allocateStorage(VkDeviceSize size) {
+    return allocate(size, storageAlignment);
+}
+
+FrameAllocation FrameAllocator::allocate(VkDeviceSize size, VkDeviceSize alignment) {
+    alignment = std::max<VkDeviceSize>(alignment, 1);
+    const VkDeviceSize begin = (head + alignment - 1) / alignment * alignment;
+    if (begin + size > frameSize) {
+        // 记录本帧所需的段大小，下一帧开始时扩容；调用方跳过本次写入或回退到其他路径
+        if (requiredBytes == 0) {
+            std::cerr << "FrameAllocator: per-frame segment exhausted (" << (frameSize >> 10)
+                      << " KB), growing at the next frame" << std::endl;
+        }
+        requiredBytes = std::max(requiredBytes, begin + size);
+        return FrameAllocation{};
+    }
+    head = begin + size;
+    ++allocationCount;
+    peakBytes = std::max(peakBytes, head);
+
+    const VkDeviceSize offset = getFrameOffset(currentFrame) + begin;
+
+    FrameAllocation result;
+    result.buffer = buffer;
+    result.offset = static_cast<uint32_t>(offset);
+    result.size = size;
+    result.mapped = allocation.mapped + offset;
+    return result;
+}
+
+FrameAllocatorStats FrameAllocator::getStats() const {
+    FrameAllocatorStats stats;
+    stats.frameSize = frameSize;
+    stats.usedBytes = head;
+    stats.peakBytes = peakBytes;
+    stats.allocationCount = allocationCount;
+    stats.version = version;
+    return stats;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <cstring>
+#include "VulkanAllocator.h"
+
+class VulkanDevice;
+
+/**
+ * 帧内分配结果：offset 既是缓冲区内偏移，也是绑定动态描述符时传入的动态偏移
+ */
+struct FrameAllocation {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    uint32_t offset = 0;
+    VkDeviceSize size = 0;
+    uint8_t* mapped = nullptr;   // 已加上 offset
+
+    bool isValid() const { return mapped != nullptr; }
+};
+
+/**
+ * 帧分配统计
+ */
+struct FrameAllocatorStats {
+    VkDeviceSize frameSize = 0;
+    VkDeviceSize usedBytes = 0;      // 当前帧已分配的字节（含对齐填充）
+    VkDeviceSize peakBytes = 0;      // 单帧最大用量
+    uint32_t allocationCount = 0;    // 当前帧的分配次数
+    uint32_t version = 0;            // 缓冲区重建（扩容）次数
+};
+
+/**
+ * FrameAllocator - 每帧常量数据的线性分配器（VulkanDevice 持有，每个设备一个）
+ *
+ * 一个持久映射的缓冲区（HOST_VISIBLE | HOST_COHERENT，UNIFORM | STORAGE | INDIRECT 用途）按飞行帧数分段，
+ * 每帧在自己的段内顺序分配，帧开始时（该帧的栅栏已等待）整段重置，分配只是一次指针递增。
+ * 各 Pass 的描述符使用 UNIFORM_BUFFER_DYNAMIC / STORAGE_BUFFER_DYNAMIC 指向整个缓冲区，
+ * 描述符集只需写入一次，绘制时以分配的 offset 作为动态偏移，不再为每帧、每个 Pass 单独创建缓冲区。
+ * GPU 剔除的对象、实例与间接绘制命令同样从这里分配，由计算着色器在本帧内读写。
+ *
+ * 段空间不足时 allocate 返回无效分配（不抛出异常）并记录所需大小，调用方跳过或回退；下一帧 beginFrame
+ * 等待设备空闲后按两倍（至少为所需大小）重建缓冲区并递增 getVersion()。各 Pass 的描述符集只写入一次，
+ * 每帧更新数据时比较版本，缓冲区重建后重新写入。已知用量的调用方可在帧开始时用 reserve 提前扩容。
+ * 只在主线程使用。
+ */
+class FrameAllocator {
+public:
+    static constexpr uint32_t FRAMES_IN_FLIGHT = 2;
+    static constexpr VkDeviceSize DEFAULT_FRAME_SIZE = 8ull * 1024 * 1024;
+
+    FrameAllocator(VulkanDevice& device, uint32_t frameCount = FRAMES_IN_FLIGHT,
+                   VkDeviceSize frameSize = DEFAULT_FRAME_SIZE);
+    ~FrameAllocator();
+
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+    // 帧开始时调用（该帧上一次提交的栅栏已等待），重置该帧的段；上一帧有分配因空间不足失败时先扩容
+    void beginFrame(uint32_t frameIndex);
+
+    // 保证每帧段至少 bytes 字节，不足时扩容（重建缓冲区）。只能在 beginFrame 之后、本帧第一次分配之前调用
+    void reserve(VkDeviceSize bytes);
+
+    // 按 minUniformBufferOffsetAlignment / minStorageBufferOffsetAlignment 对齐；空间不足时返回无效分配
+    FrameAllocation allocateUniform(VkDeviceSize size);
+    FrameAllocation allocateStorage(VkDeviceSize size);
+    FrameAllocation allocate(VkDeviceSize size, VkDeviceSize alignment);
+
+    // 写入一个结构体，返回动态偏移（空间不足时不写入，返回本帧段起点）
+    template<typename T>
+    uint32_t pushUniform(const T& data) {
+        FrameAllocation allocation = allocateUniform(sizeof(T));
+        if (!allocation.isValid()) {
+            return static_cast<uint32_t>(getFrameOffset(currentFrame));
+        }
+        std::memcpy(allocation.mapped, &data, sizeof(T));
+        return allocation.offset;
+    }
+
+    // 动态描述符的写入信息：整个缓冲区，range 为单次绑定可见的字节数
+    VkDescriptorBufferInfo getDescriptorInfo(VkDeviceSize range) const {
+        return VkDescriptorBufferInfo{ buffer, 0, range };
+    }
+
+    VkBuffer getBuffer() const { return buffer; }
+    uint32_t getFrameCount() const { return frameCount; }
+    uint32_t getCurrentFrame() const { return currentFrame; }
+    VkDeviceSize getFrameSize() const { return frameSize; }
+    VkDeviceSize getFrameOffset(uint32_t frameIndex) const { return frameIndex * frameSize; }
+    // 缓冲区重建时递增，持有指向缓冲区的描述符集的使用者据此重新写入
+    uint32_t getVersion() const { return version; }
+    FrameAllocatorStats getStats() const;
+
+private:
+    void createBuffer();
+    void grow(VkDeviceSize requiredSize);
+
+    VulkanDevice& device;
+    uint32_t frameCount;
+    VkDeviceSize frameSize;
+    VkDeviceSize maxFrameSize = 0;       // 受 maxStorageBufferRange 与 32 位动态偏移限制
+    VkDeviceSize uniformAlignment = 1;
+    VkDeviceSize storageAlignment = 1;
+    VkDeviceSize segmentAlignment = 1;
+
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VulkanAllocation allocation;
+
+    uint32_t currentFrame = 0;
+    VkDeviceSize head = 0;               // 当前帧段内的下一次分配位置
+    uint32_t allocationCount = 0;
+    VkDeviceSize peakBytes = 0;
+    VkDeviceSize requiredBytes = 0;      // 本帧分配失败时所需的段大小（0 表示没有失败）
+    uint32_t version = 0;
+};
@@ -0,0 +1,177 @@
+#include "MipmapGenerator.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MIPMAP_GENERATOR_SSE 1
+#endif
+
+namespace {
+
+constexpr size_t ROW_GRAIN = 16;
+
+// sRGB 8 位 -> 16 位线性
+const std::array<uint16_t, 256>& getDecodeTable() {
+    static const std::array<uint16_t, 256> table = [] {
+        std::array<uint16_t, 256> result{};
+        for (int i = 0; i < 256; ++i) {
+            double s = i / 255.0;
+            double linear = s <= 0.04045 ? s / 12.92 : std::pow((s + 0.055) / 1.055, 2.4);
+            result[i] = static_cast<uint16_t>(std::lround(linear * 65535.0));
+        }
+        return result;
+    }();
+    return table;
+}
+
+// 16 位线性 -> sRGB 8 位（64 KB，暗部步长约 0.05 LSB，误差可忽略）
+const std::array<uint8_t, 65536>& getEncodeTable() {
+    static const std::array<uint8_t, 65536> table = [] {
+        std::array<uint8_t, 65536> result{};
+        for (int i = 0; i < 65536; ++i) {
+            double linear = i / 65535.0;
+            double s = linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+            result[i] = static_cast<uint8_t>(std::lround(std::min(std::max(s, 0.0), 1.0) * 255.0));
+        }
+        return result;
+    }();
+    return table;
+}
+
+// 一行输出：row0/row1 为参与平均的两行源像素
+void downsampleRowUnorm(const uint8_t* row0, const uint8_t* row1, uint32_t srcWidth, uint8_t* dst, uint32_t dstWidth) {
+    uint32_t x = 0;
+
+#if defined(MIPMAP_GENERATOR_SSE)
+    // 源像素完整配对的部分：每次 8 个源像素 -> 4 个输出像素
+    const uint32_t pairedWidth = srcWidth / 2;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rounding = _mm_set1_epi16(2);
+    for (; x + 4 <= pairedWidth; x += 4) {
+        const uint8_t* a = row0 + x * 8;
+        const uint8_t* b = row1 + x * 8;
+        __m128 a0 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)));
+        __m128 a1 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + 16)));
+        __m128 b0 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+        __m128 b1 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + 16)));
+
+        // 按 32 位像素拆成偶数列和奇数列
+        __m128i evenA = _mm_castps_si128(_mm_shuffle_ps(a0, a1, _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128i oddA = _mm_castps_si128(_mm_shuffle_ps(a0, a1, _MM_SHUFFLE(3, 1, 3, 1)));
+        __m128i evenB = _mm_castps_si128(_mm_shuffle_ps(b0, b1, _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128i oddB = _mm_castps_si128(_mm_shuffle_ps(b0, b1, _MM_SHUFFLE(3, 1, 3, 1)));
+
+        __m128i sumLo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(evenA, zero), _mm_unpacklo_epi8(oddA, zero)),
+                                      _mm_add_epi16(_mm_unpacklo_epi8(evenB, zero), _mm_unpacklo_epi8(oddB, zero)));
+        __m128i sumHi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(evenA, zero), _mm_unpackhi_epi8(oddA, zero)),
+                                      _mm_add_epi16(_mm_unpackhi_epi8(evenB, zero), _mm_unpackhi_epi8(oddB, zero)));
+        sumLo = _mm_srli_epi16(_mm_add_epi16(sumLo, rounding), 2);
+        sumHi = _mm_srli_epi16(_mm_add_epi16(sumHi, rounding), 2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_packus_epi16(sumLo, sumHi));
+    }
+#endif
+
+    for (; x < dstWidth; ++x) {
+        const uint32_t x0 = std::min(2 * x, srcWidth - 1) * 4;
+        const uint32_t x1 = std::min(2 * x + 1, srcWidth - 1) * 4;
+        for (int c = 0; c < 4; ++c) {
+            uint32_t sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+            dst[x * 4 + c] = static_cast<uint8_t>((sum + 2) >> 2);
+        }
+    }
+}
+
+void downsampleRowSrgb(const uint8_t* row0, const uint8_t* row1, uint32_t srcWidth, uint8_t* dst, uint32_t dstWidth) {
+    const auto& decode = getDecodeTable();
+    const auto& encode = getEncodeTable();
+
+    for (uint32_t x = 0; x < dstWidth; ++x) {
+        const uint32_t x0 = std::min(2 * x, srcWidth - 1) * 4;
+        const uint32_t x1 = std::min(2 * x + 1, srcWidth - 1) * 4;
+        for (int c = 0; c < 3; ++c) {
+            uint32_t sum = decode[row0[x0 + c]] + decode[row0[x1 + c]] + decode[row1[x0 + c]] + decode[row1[x1 + c]];
+            dst[x * 4 + c] = encode[(sum + 2) >> 2];
+        }
+        uint32_t alpha = row0[x0 + 3] + row0[x1 + 3] + row1[x0 + 3] + row1[x1 + 3];
+        dst[x * 4 + 3] = static_cast<uint8_t>((alpha + 2) >> 2);
+    }
+}
+
+} // namespace
+
+uint32_t MipmapGenerator::getMipLevelCount(uint32_t width, uint32_t height) {
+    uint32_t size = std::max(width, height);
+    uint32_t levels = 1;
+    while (size > 1) {
+        size >>= 1;
+        ++levels;
+    }
+    return levels;
+}
+
+void MipmapGenerator::downsample(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, uint8_t* dst, bool srgb) {
+    const uint32_t dstWidth = std::max(1u, srcWidth / 2);
+    const uint32_t dstHeight = std::max(1u, srcHeight / 2);
+    const size_t srcStride = static_cast<size_t>(srcWidth) * 4;
+    const size_t dstStride = static_cast<size_t>(dstWidth) * 4;
+
+    auto processRows = [=](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y) {
+            const uint8_t* row0 = src + std::min<size_t>(2 * y, srcHeight - 1) * srcStride;
+            const uint8_t* row1 = src + std::min<size_t>(2 * y + 1, srcHeight - 1) * srcStride;
+            uint8_t* out = dst + y * dstStride;
+            if (srgb) {
+                downsampleRowSrgb(row0, row1, srcWidth, out, dstWidth);
+            } else {
+                downsampleRowUnorm(row0, row1, srcWidth, out, dstWidth);
+            }
+        }
+    };
+
+    ThreadPool& pool = ThreadPool::getShared();
+    if (static_cast<size_t>(dstWidth) * dstHeight >= PARALLEL_MIN_PIXELS && pool.getThreadCount() >= 2) {
+        pool.parallelFor(dstHeight, ROW_GRAIN, processRows);
+    } else {
+        processRows(0, dstHeight);
+    }
+}
+
+std::vector<MipLevel> MipmapGenerator::generate(const uint8_t* rgba, uint32_t width, uint32_t height, bool srgb,
+                                                std::vector<uint8_t>& out) {
+    const uint32_t levelCount = getMipLevelCount(width, height);
+    std::vector<MipLevel> levels(levelCount);
+
+    size_t total = 0;
+    uint32_t levelWidth = width;
+    uint32_t levelHeight = height;
+    for (uint32_t i = 0; i < levelCount; ++i) {
+        levels[i].width = levelWidth;
+        levels[i].height = levelHeight;
+        levels[i].offset = total;
+        levels[i].size = static_cast<size_t>(levelWidth) * levelHeight * 4;
+        total += levels[i].size;
+        levelWidth = std::max(1u, levelWidth / 2);
+        levelHeight = std::max(1u, levelHeight / 2);
+    }
+
+    out.resize(total);
+    std::memcpy(out.data(), rgba, levels[0].size);
+    for (uint32_t i = 1; i < levelCount; ++i) {
+        const MipLevel& source = levels[i - 1];
+        downsample(out.data() + source.offset, source.width, source.height, out.data() + levels[i].offset, srgb);
+    }
+    return levels;
+}
+
+const char* MipmapGenerator::getInstructionSet() {
+#if defined(MIPMAP_GENERATOR_SSE)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
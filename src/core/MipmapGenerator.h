@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Mip 级别在打包数据中的位置
+ */
+struct MipLevel {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    size_t offset = 0;
+    size_t size = 0;
+};
+
+/**
+ * CPU 端 RGBA8 mip 链生成（GPU 不支持对该格式线性 blit 时的回退路径）
+ *
+ * 每级由上一级 2x2 盒式滤波得到，奇数尺寸时最后一行/列与前一行/列配对。
+ * - UNORM：整数平均（四舍五入），x86 上 SSE2 每次处理 4 个输出像素
+ * - sRGB：RGB 经查表解码到 16 位线性值后平均，再查表编码回 sRGB；
+ *   alpha 始终线性平均
+ * 输出像素数超过 PARALLEL_MIN_PIXELS 且共享线程池至少有两个工作线程时按行并行
+ */
+class MipmapGenerator {
+public:
+    static constexpr size_t PARALLEL_MIN_PIXELS = 1 << 16;
+
+    /**
+     * @brief 完整 mip 链的级数：floor(log2(max(width, height))) + 1
+     */
+    static uint32_t getMipLevelCount(uint32_t width, uint32_t height);
+
+    /**
+     * @brief 生成完整 mip 链，所有级别（含 LOD0 拷贝）依次紧密排列在 out 中
+     * @return 各级别的尺寸和偏移
+     */
+    static std::vector<MipLevel> generate(const uint8_t* rgba, uint32_t width, uint32_t height, bool srgb,
+                                          std::vector<uint8_t>& out);
+
+    /**
+     * @brief 下采样一级：dst 尺寸为 max(1, src / 2)
+     */
+    static void downsample(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, uint8_t* dst, bool srgb);
+
+    /**
+     * @brief 当前编译使用的指令集（"SSE2" / "Scalar"）
+     */
+    static const char* getInstructionSet();
+};
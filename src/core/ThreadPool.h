@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * 通用工作线程池
+ * - submit(): 提交异步任务，返回 std::future
+ * - parallelFor(): 将 [0, count) 切分为块并行执行，调用线程也参与计算，
+ *   因此在工作线程内部嵌套调用也不会死锁
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // 进程级共享线程池（线程数 = 硬件线程数 - 1，至少 1）
+    static ThreadPool& getShared();
+
+    size_t getThreadCount() const { return workers.size(); }
+
+    template<typename F>
+    auto submit(F&& task) -> std::future<decltype(task())> {
+        using Result = decltype(task());
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return future;
+    }
+
+    /**
+     * 并行执行 fn(begin, end)，每块至少 grainSize 个元素
+     */
+    void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& fn);
+
+private:
+    void enqueue(std::function<void()> task);
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex queueMutex;
+    std::condition_variable condition;
+    bool stopping = false;
+};
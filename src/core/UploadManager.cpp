@@ -0,0 +1,287 @@
+#include "UploadManager.h"
+#include "VulkanDevice.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+UploadManager::UploadManager(VulkanDevice& device, VkDeviceSize ringSize)
+    : device(device)
+    , ringSize(ringSize) {
+
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = device.getGraphicsQueueFamily();
+    if (vkCreateCommandPool(device.getDevice(), &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create upload command pool!");
+    }
+
+    device.createBuffer(ringSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                        ringBuffer, ringAllocation, VulkanMemoryCategory::Staging);
+    ringMapped = ringAllocation.mapped;
+
+    std::cout << "UploadManager created: " << (ringSize >> 20) << " MB staging ring" << std::endl;
+}
+
+UploadManager::~UploadManager() {
+    VkDevice dev = device.getDevice();
+
+    // 提交并等待所有批次，之后所有命令缓冲区都在空闲列表中
+    waitIdle();
+
+    for (VkFence fence : freeFences) {
+        vkDestroyFence(dev, fence, nullptr);
+    }
+    freeFences.clear();
+    freeCommandBuffers.clear();
+    vkDestroyCommandPool(dev, commandPool, nullptr);
+
+    device.destroyBuffer(ringBuffer, ringAllocation);
+}
+
+UploadManager::StagingAllocation UploadManager::allocateStaging(VkDeviceSize size, VkDeviceSize alignment) {
+    StagingAllocation allocation;
+    if (size > ringSize) {
+        allocation = allocateDedicated(size);
+    } else {
+        VkDeviceSize offset = 0;
+        bool allocated = tryAllocateRing(size, alignment, offset);
+        while (!allocated) {
+            // 当前批次占用的空间只能在提交后回收
+            if (recording && current.ringBytes > 0) {
+                flush();
+            }
+            if (inFlight.empty()) {
+                break;
+            }
+            ++stats.stalls;
+            retireOldest();
+            allocated = tryAllocateRing(size, alignment, offset);
+        }
+        if (allocated) {
+            allocation.buffer = ringBuffer;
+            allocation.offset = offset;
+            allocation.mapped = ringMapped + offset;
+        } else {
+            allocation = allocateDedicated(size);
+        }
+    }
+
+    stats.uploadedBytes += size;
+    beginBatch();
+    return allocation;
+}
+
+VkCommandBuffer UploadManager::getCommandBuffer() {
+    beginBatch();
+    return current.commandBuffer;
+}
+
+void UploadManager::uploadBuffer(VkBuffer dstBuffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset) {
+    if (size == 0) {
+        return;
+    }
+
+    StagingAllocation staging = allocateStaging(size);
+    memcpy(staging.mapped, data, static_cast<size_t>(size));
+
+    VkBufferCopy region{};
+    region.srcOffset = staging.offset;
+    region.dstOffset = dstOffset;
+    region.size = size;
+    vkCmdCopyBuffer(getCommandBuffer(), staging.buffer, dstBuffer, 1, &region);
+}
+
+uint64_t UploadManager::flush() {
+    retireCompleted();
+    if (!recording) {
+        return nextTicket - 1;
+    }
+
+    // 拷贝结果对之后在同一队列上提交的所有命令可见
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+    vkCmdPipelineBarrier(current.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         0, 1, &barrier, 0, nullptr, 0, nullptr);
+    vkEndCommandBuffer(current.commandBuffer);
+    recording = false;
+
+    if (!freeFences.empty()) {
+        current.fence = freeFences.back();
+        freeFences.pop_back();
+    } else {
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        if (vkCreateFence(device.getDevice(), &fenceInfo, nullptr, &current.fence) != VK_SUCCESS) {
+            releaseBatch(current);
+            current = Batch{};
+            throw std::runtime_error("Failed to create upload fence!");
+        }
+    }
+    current.ticket = nextTicket++;
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &current.commandBuffer;
+
+    if (vkQueueSubmit(device.getGraphicsQueue(), 1, &submitInfo, current.fence) != VK_SUCCESS) {
+        // 命令未执行：回收资源并视为已完成，调用方的资源内容未定义
+        releaseBatch(current);
+        current = Batch{};
+        throw std::runtime_error("Failed to submit uploads!");
+    }
+
+    const uint64_t ticket = current.ticket;
+    ++stats.submittedBatches;
+    inFlight.push_back(std::move(current));
+    current = Batch{};
+    return ticket;
+}
+
+bool UploadManager::isComplete(uint64_t ticket) {
+    if (ticket > completedTicket) {
+        retireCompleted();
+    }
+    return ticket <= completedTicket;
+}
+
+void UploadManager::wait(uint64_t ticket) {
+    while (ticket > completedTicket && !inFlight.empty()) {
+        retireOldest();
+    }
+}
+
+void UploadManager::waitIdle() {
+    wait(flush());
+}
+
+UploadStats UploadManager::getStats() const {
+    UploadStats result = stats;
+    result.ringSize = ringSize;
+    result.ringUsed = ringUsed;
+    return result;
+}
+
+void UploadManager::beginBatch() {
+    if (recording) {
+        return;
+    }
+
+    if (current.commandBuffer == VK_NULL_HANDLE) {
+        if (!freeCommandBuffers.empty()) {
+            current.commandBuffer = freeCommandBuffers.back();
+            freeCommandBuffers.pop_back();
+        } else {
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandPool = commandPool;
+            allocInfo.commandBufferCount = 1;
+            if (vkAllocateCommandBuffers(device.getDevice(), &allocInfo, &current.commandBuffer) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to allocate upload command buffer!");
+            }
+        }
+    }
+
+    // 命令池带 RESET_COMMAND_BUFFER，begin 时隐式重置
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(current.commandBuffer, &beginInfo);
+    recording = true;
+}
+
+bool UploadManager::tryAllocateRing(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset) {
+    if (ringUsed == 0) {
+        ringHead = 0;
+        ringTail = 0;
+    }
+
+    alignment = std::max<VkDeviceSize>(alignment, 1);
+    offset = (ringHead + alignment - 1) / alignment * alignment;
+
+    // 空闲区间：head >= tail 时为 [head, size) 和 [0, tail)，否则为 [head, tail)（head == tail 且非空时已满）
+    VkDeviceSize consumed = 0;
+    if (ringHead > ringTail || (ringHead == ringTail && ringUsed == 0)) {
+        if (offset + size <= ringSize) {
+            consumed = offset + size - ringHead;
+        } else if (size <= ringTail) {
+            // 回绕：跳过的尾部随本批次一起回收
+            consumed = ringSize - ringHead + size;
+            offset = 0;
+        } else {
+            return false;
+        }
+    } else {
+        if (offset + size > ringTail) {
+            return false;
+        }
+        consumed = offset + size - ringHead;
+    }
+
+    ringHead = offset + size;
+    ringUsed += consumed;
+    current.ringBytes += consumed;
+    current.ringEnd = ringHead;
+    return true;
+}
+
+UploadManager::StagingAllocation UploadManager::allocateDedicated(VkDeviceSize size) {
+    DedicatedStaging dedicated;
+    device.createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                        dedicated.buffer, dedicated.allocation, VulkanMemoryCategory::Staging);
+    current.dedicated.push_back(dedicated);
+    stats.dedicatedBytes += size;
+
+    StagingAllocation allocation;
+    allocation.buffer = dedicated.buffer;
+    allocation.offset = 0;
+    allocation.mapped = dedicated.allocation.mapped;
+    return allocation;
+}
+
+void UploadManager::retireCompleted() {
+    while (!inFlight.empty() && vkGetFenceStatus(device.getDevice(), inFlight.front().fence) == VK_SUCCESS) {
+        releaseBatch(inFlight.front());
+        inFlight.pop_front();
+    }
+}
+
+void UploadManager::retireOldest() {
+    Batch& batch = inFlight.front();
+    vkWaitForFences(device.getDevice(), 1, &batch.fence, VK_TRUE, UINT64_MAX);
+    releaseBatch(batch);
+    inFlight.pop_front();
+}
+
+void UploadManager::releaseBatch(Batch& batch) {
+    VkDevice dev = device.getDevice();
+
+    // 临时暂存缓冲区
+    for (DedicatedStaging& dedicated : batch.dedicated) {
+        device.destroyBuffer(dedicated.buffer, dedicated.allocation);
+    }
+    batch.dedicated.clear();
+
+    if (batch.ringBytes > 0) {
+        ringTail = batch.ringEnd;
+        ringUsed -= batch.ringBytes;
+        batch.ringBytes = 0;
+    }
+    if (batch.commandBuffer != VK_NULL_HANDLE) {
+        freeCommandBuffers.push_back(batch.commandBuffer);
+        batch.commandBuffer = VK_NULL_HANDLE;
+    }
+    if (batch.fence != VK_NULL_HANDLE) {
+        vkResetFences(dev, 1, &batch.fence);
+        freeFences.push_back(batch.fence);
+        batch.fence = VK_NULL_HANDLE;
+    }
+    completedTicket = std::max(completedTicket, batch.ticket);
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "VulkanAllocator.h"
+
+class VulkanDevice;
+
+/**
+ * 上传统计
+ */
+struct UploadStats {
+    uint64_t submittedBatches = 0;
+    uint64_t uploadedBytes = 0;
+    uint64_t dedicatedBytes = 0;     // 超过暂存环容量、使用临时暂存缓冲区的字节数
+    uint64_t stalls = 0;             // 暂存环已满、阻塞等待较早批次的次数
+    VkDeviceSize ringSize = 0;
+    VkDeviceSize ringUsed = 0;       // 已提交和正在录制的批次占用的暂存环字节数
+};
+
+/**
+ * UploadManager - 统一的 CPU -> GPU 上传（VulkanDevice 持有，每个设备一个）
+ *
+ * 持久映射的暂存环（HOST_VISIBLE | HOST_COHERENT）+ 传输命令缓冲区池：
+ * - allocateStaging 在环中顺序分配，数据立即写入暂存区，调用方的 CPU 数据随后即可释放
+ * - 缓冲区和图像的拷贝命令都记录到当前批次的命令缓冲区，flush() 提交（不阻塞），返回批次号
+ * - 每个批次一个栅栏；栅栏发出信号后回收该批次占用的环空间和命令缓冲区
+ * - 环空间不足时先提交当前批次再等待最早的批次；超过环容量的单次分配使用临时缓冲区，随批次释放
+ *
+ * 批次结尾记录一个 TRANSFER -> ALL_COMMANDS 的内存屏障，渲染帧在同一队列上、flush() 之后提交即可
+ * 直接使用上传的缓冲区；图像上传自行完成到 SHADER_READ_ONLY_OPTIMAL 的布局转换。
+ * 渲染器每帧提交前调用一次 flush()。只在主线程使用。
+ */
+class UploadManager {
+public:
+    static constexpr VkDeviceSize DEFAULT_RING_SIZE = 64ull * 1024 * 1024;
+
+    struct StagingAllocation {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        uint8_t* mapped = nullptr;   // 已加上 offset
+    };
+
+    UploadManager(VulkanDevice& device, VkDeviceSize ringSize = DEFAULT_RING_SIZE);
+    ~UploadManager();
+
+    UploadManager(const UploadManager&) = delete;
+    UploadManager& operator=(const UploadManager&) = delete;
+
+    // 分配暂存空间（可能提交当前批次并等待较早的批次，因此要在 getCommandBuffer 之前调用）
+    StagingAllocation allocateStaging(VkDeviceSize size, VkDeviceSize alignment = 16);
+
+    // 当前批次的命令缓冲区（处于录制状态）
+    VkCommandBuffer getCommandBuffer();
+
+    // 复制 data 到暂存区并记录到 dstBuffer 的拷贝（dstBuffer 需有 TRANSFER_DST 用途）
+    void uploadBuffer(VkBuffer dstBuffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset = 0);
+
+    // 提交当前批次（没有记录命令时不提交），返回包含之前所有记录的批次号
+    uint64_t flush();
+
+    // 批次 ticket 及之前的批次是否已执行完毕
+    bool isComplete(uint64_t ticket);
+    void wait(uint64_t ticket);
+    void waitIdle();
+
+    UploadStats getStats() const;
+
+private:
+    struct DedicatedStaging {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VulkanAllocation allocation;
+    };
+
+    struct Batch {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+        uint64_t ticket = 0;
+        VkDeviceSize ringEnd = 0;         // 批次最后一次分配之后的环位置
+        VkDeviceSize ringBytes = 0;       // 占用的环字节数（含回绕时跳过的尾部）
+        std::vector<DedicatedStaging> dedicated;
+    };
+
+    void beginBatch();
+    bool tryAllocateRing(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset);
+    StagingAllocation allocateDedicated(VkDeviceSize size);
+    void retireCompleted();
+    void retireOldest();
+    void releaseBatch(Batch& batch);
+
+    VulkanDevice& device;
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+
+    VkBuffer ringBuffer = VK_NULL_HANDLE;
+    VulkanAllocation ringAllocation;
+    uint8_t* ringMapped = nullptr;
+    VkDeviceSize ringSize = 0;
+    VkDeviceSize ringHead = 0;            // 下一次分配的起点
+    VkDeviceSize ringTail = 0;            // 最早未回收批次的起点
+    VkDeviceSize ringUsed = 0;
+
+    Batch current;
+    bool recording = false;
+    std::deque<Batch> inFlight;
+    std::vector<VkCommandBuffer> freeCommandBuffers;
+    std::vector<VkFence> freeFences;
+
+    uint64_t nextTicket = 1;
+    uint64_t completedTicket = 0;
+    UploadStats stats;
+};
@@ -0,0 +1,727 @@
+#include "VulkanAllocator.h"
+#include "VulkanDevice.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+constexpr uint32_t NIL = UINT32_MAX;
+
+uint32_t floorLog2(uint64_t value) {
+    uint32_t result = 0;
+    while (value >>= 1) {
+        ++result;
+    }
+    return result;
+}
+
+uint32_t lowestBit(uint64_t value) {
+    uint32_t result = 0;
+    while (!(value & 1)) {
+        value >>= 1;
+        ++result;
+    }
+    return result;
+}
+
+VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+/**
+ * 一个 VkDeviceMemory 块内的 TLSF 分配
+ * 节点按物理顺序双向链接；空闲节点按大小挂在 (fl, sl) 链表上：fl 为 log2(size)，
+ * sl 把 [2^fl, 2^(fl+1)) 再分为 SL_COUNT 段；小于 SMALL_SIZE 的按 8 字节分段放在 fl = 0
+ */
+class VulkanAllocator::Block {
+public:
+    Block(VkDeviceMemory memory, VkDeviceSize size, uint8_t* mapped)
+        : memory(memory), size(size), mapped(mapped) {
+        for (auto& row : heads) {
+            std::fill(std::begin(row), std::end(row), NIL);
+        }
+        Node node;
+        node.size = size;
+        nodes.push_back(node);
+        insertFree(0);
+    }
+
+    bool allocate(VkDeviceSize allocSize, VkDeviceSize alignment, void* userData, VulkanMemoryCategory category,
+                  VkDeviceSize& offset, uint32_t& nodeIndex) {
+        const uint32_t n = findFree(allocSize + alignment - 1);
+        if (n == NIL) {
+            return false;
+        }
+        removeFree(n);
+
+        // 对齐产生的前部空隙成为新的空闲节点（前一个物理节点必然已分配，无需合并）
+        const VkDeviceSize aligned = alignUp(nodes[n].offset, alignment);
+        const VkDeviceSize padding = aligned - nodes[n].offset;
+        if (padding > 0) {
+            const uint32_t front = createNode();
+            nodes[front].offset = nodes[n].offset;
+            nodes[front].size = padding;
+            nodes[front].prevPhys = nodes[n].prevPhys;
+            nodes[front].nextPhys = n;
+            if (nodes[n].prevPhys != NIL) {
+                nodes[nodes[n].prevPhys].nextPhys = front;
+            }
+            nodes[n].prevPhys = front;
+            nodes[n].offset = aligned;
+            nodes[n].size -= padding;
+            insertFree(front);
+        }
+
+        // 剩余部分拆分为后部空闲节点
+        if (nodes[n].size > allocSize) {
+            const uint32_t back = createNode();
+            nodes[back].offset = nodes[n].offset + allocSize;
+            nodes[back].size = nodes[n].size - allocSize;
+            nodes[back].prevPhys = n;
+            nodes[back].nextPhys = nodes[n].nextPhys;
+            if (nodes[n].nextPhys != NIL) {
+                nodes[nodes[n].nextPhys].prevPhys = back;
+            }
+            nodes[n].nextPhys = back;
+            nodes[n].size = allocSize;
+            insertFree(back);
+        }
+
+        nodes[n].free = false;
+        nodes[n].alignment = alignment;
+        nodes[n].userData = userData;
+        nodes[n].category = category;
+        usedBytes += allocSize;
+        ++allocationCount;
+
+        offset = nodes[n].offset;
+        nodeIndex = n;
+        return true;
+    }
+
+    void free(uint32_t n) {
+        usedBytes -= nodes[n].size;
+        --allocationCount;
+        nodes[n].free = true;
+        nodes[n].userData = nullptr;
+
+        // 与前后空闲节点合并
+        const uint32_t prev = nodes[n].prevPhys;
+        if (prev != NIL && nodes[prev].free) {
+            removeFree(prev);
+            nodes[prev].size += nodes[n].size;
+            unlinkPhys(n);
+            releaseNode(n);
+            n = prev;
+        }
+        const uint32_t next = nodes[n].nextPhys;
+        if (next != NIL && nodes[next].free) {
+            removeFree(next);
+            nodes[n].size += nodes[next].size;
+            unlinkPhys(next);
+            releaseNode(next);
+        }
+        insertFree(n);
+    }
+
+    bool isEmpty() const { return allocationCount == 0; }
+
+    void collectFreeRanges(VkDeviceSize& largest, uint32_t& count) const {
+        for (const Node& node : nodes) {
+            if (node.active && node.free) {
+                largest = std::max(largest, node.size);
+                ++count;
+            }
+        }
+    }
+
+    // 可移动（userData 非空）的已分配节点
+    template<typename Func>
+    void forEachMovable(Func&& func) const {
+        for (uint32_t i = 0; i < nodes.size(); ++i) {
+            const Node& node = nodes[i];
+            if (node.active && !node.free && node.userData) {
+                func(i, node.offset, node.size, node.alignment, node.category, node.userData);
+            }
+        }
+    }
+
+    VkDeviceMemory memory;
+    VkDeviceSize size;
+    uint8_t* mapped;
+    VkDeviceSize usedBytes = 0;
+    uint32_t allocationCount = 0;
+
+private:
+    static constexpr uint32_t SL_BITS = 5;
+    static constexpr uint32_t SL_COUNT = 1u << SL_BITS;
+    static constexpr uint32_t SMALL_LOG = 8;
+    static constexpr VkDeviceSize SMALL_SIZE = VkDeviceSize(1) << SMALL_LOG;
+    static constexpr uint32_t FL_COUNT = 48;
+
+    struct Node {
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+        VkDeviceSize alignment = 1;
+        uint32_t prevPhys = NIL;
+        uint32_t nextPhys = NIL;
+        uint32_t prevFree = NIL;
+        uint32_t nextFree = NIL;
+        void* userData = nullptr;
+        VulkanMemoryCategory category = VulkanMemoryCategory::Other;
+        bool free = true;
+        bool active = true;
+    };
+
+    static void mapping(VkDeviceSize value, uint32_t& fl, uint32_t& sl) {
+        if (value < SMALL_SIZE) {
+            fl = 0;
+            sl = static_cast<uint32_t>(value / (SMALL_SIZE / SL_COUNT));
+        } else {
+            const uint32_t log = floorLog2(value);
+            fl = log - SMALL_LOG + 1;
+            sl = static_cast<uint32_t>((value >> (log - SL_BITS)) - SL_COUNT);
+        }
+    }
+
+    // 查找不小于 required 的空闲节点：向上取整到下一个分段，保证链表中任意节点都足够大
+    uint32_t findFree(VkDeviceSize required) const {
+        VkDeviceSize search = required;
+        if (required >= SMALL_SIZE) {
+            search += (VkDeviceSize(1) << (floorLog2(required) - SL_BITS)) - 1;
+        } else {
+            search += SMALL_SIZE / SL_COUNT - 1;
+        }
+
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        mapping(search, fl, sl);
+        if (fl >= FL_COUNT) {
+            return NIL;
+        }
+
+        uint32_t slMap = slBitmap[fl] & (~0u << sl);
+        if (slMap == 0) {
+            const uint64_t flMap = fl + 1 < 64 ? flBitmap & (~0ull << (fl + 1)) : 0;
+            if (flMap == 0) {
+                return NIL;
+            }
+            fl = lowestBit(flMap);
+            slMap = slBitmap[fl];
+        }
+        return heads[fl][lowestBit(slMap)];
+    }
+
+    void insertFree(uint32_t n) {
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        mapping(nodes[n].size, fl, sl);
+        nodes[n].prevFree = NIL;
+        nodes[n].nextFree = heads[fl][sl];
+        if (heads[fl][sl] != NIL) {
+            nodes[heads[fl][sl]].prevFree = n;
+        }
+        heads[fl][sl] = n;
+        slBitmap[fl] |= 1u << sl;
+        flBitmap |= 1ull << fl;
+    }
+
+    void removeFree(uint32_t n) {
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        mapping(nodes[n].size, fl, sl);
+        if (nodes[n].prevFree != NIL) {
+            nodes[nodes[n].prevFree].nextFree = nodes[n].nextFree;
+        } else {
+            heads[fl][sl] = nodes[n].nextFree;
+        }
+        if (nodes[n].nextFree != NIL) {
+            nodes[nodes[n].nextFree].prevFree = nodes[n].prevFree;
+        }
+        if (heads[fl][sl] == NIL) {
+            slBitmap[fl] &= ~(1u << sl);
+            if (slBitmap[fl] == 0) {
+                flBitmap &= ~(1ull << fl);
+            }
+        }
+    }
+
+    void unlinkPhys(uint32_t n) {
+        if (nodes[n].prevPhys != NIL) {
+            nodes[nodes[n].prevPhys].nextPhys = nodes[n].nextPhys;
+        }
+        if (nodes[n].nextPhys != NIL) {
+            nodes[nodes[n].nextPhys].prevPhys = nodes[n].prevPhys;
+        }
+    }
+
+    uint32_t createNode() {
+        if (!unusedNodes.empty()) {
+            const uint32_t n = unusedNodes.back();
+            unusedNodes.pop_back();
+            nodes[n] = Node{};
+            return n;
+        }
+        nodes.emplace_back();
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+
+    void releaseNode(uint32_t n) {
+        nodes[n].active = false;
+        unusedNodes.push_back(n);
+    }
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> unusedNodes;
+    uint64_t flBitmap = 0;
+    uint32_t slBitmap[FL_COUNT] = {};
+    uint32_t heads[FL_COUNT][SL_COUNT];
+};
+
+VulkanAllocator::VulkanAllocator(VulkanDevice& device, VkDeviceSize preferredBlockSize)
+    : device(device)
+    , preferredBlockSize(preferredBlockSize) {
+    vkGetPhysicalDeviceMemoryProperties(device.getPhysicalDevice(), &memoryProperties);
+    bufferImageGranularity = std::max<VkDeviceSize>(device.getProperties().limits.bufferImageGranularity, 1);
+    nonCoherentAtomSize = std::max<VkDeviceSize>(device.getProperties().limits.nonCoherentAtomSize, 1);
+    pools.resize(memoryProperties.memoryTypeCount * 2);
+
+    heapStats.resize(memoryProperties.memoryHeapCount);
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i) {
+        heapStats[i].heapSize = memoryProperties.memoryHeaps[i].size;
+        heapStats[i].deviceLocal = (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+    }
+
+    std::cout << "VulkanAllocator created: " << (preferredBlockSize >> 20) << " MB blocks, "
+              << "bufferImageGranularity " << bufferImageGranularity << std::endl;
+}
+
+VulkanAllocator::~VulkanAllocator() {
+    VkDevice dev = device.getDevice();
+    for (Pool& pool : pools) {
+        for (auto& block : pool.blocks) {
+            if (block) {
+                vkFreeMemory(dev, block->memory, nullptr);
+            }
+        }
+        pool.blocks.clear();
+    }
+    for (const Dedicated& entry : dedicated) {
+        if (entry.memory != VK_NULL_HANDLE) {
+            vkFreeMemory(dev, entry.memory, nullptr);
+        }
+    }
+    dedicated.clear();
+}
+
+VulkanAllocation VulkanAllocator::allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties,
+                                           VulkanResourceKind kind, VulkanMemoryCategory category, void* userData) {
+    const uint32_t memoryType = findMemoryType(requirements.memoryTypeBits, properties);
+    const VkMemoryPropertyFlags typeFlags = memoryProperties.memoryTypes[memoryType].propertyFlags;
+
+    // 粒度为 1 时线性资源和最优平铺图像可以相邻，共用一个池
+    if (bufferImageGranularity <= 1) {
+        kind = VulkanResourceKind::Linear;
+    }
+    Pool& pool = getPool(memoryType, kind);
+    const uint32_t poolIndex = memoryType * 2 + static_cast<uint32_t>(kind);
+
+    if (requirements.size > pool.blockSize / 2) {
+        VulkanAllocation allocation = allocateDedicated(memoryType, requirements.size);
+        allocation.category = category;
+        trackAllocation(allocation, 1);
+        return allocation;
+    }
+
+    // 非一致的主机可见内存按 nonCoherentAtomSize 对齐，flush / invalidate 范围不会越界到相邻分配
+    VkDeviceSize alignment = std::max<VkDeviceSize>(requirements.alignment, 1);
+    if ((typeFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) && !(typeFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+        alignment = std::max(alignment, nonCoherentAtomSize);
+    }
+
+    VulkanAllocation allocation;
+    allocation.category = category;
+    if (allocateFromPool(poolIndex, requirements.size, alignment, userData, NIL, allocation)) {
+        trackAllocation(allocation, 1);
+        return allocation;
+    }
+
+    // 新建块：申请失败时逐级减半，直到不足以容纳本次分配
+    VkDeviceSize blockSize = pool.blockSize;
+    uint8_t* mapped = nullptr;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    while (memory == VK_NULL_HANDLE && blockSize >= requirements.size + alignment) {
+        memory = allocateDeviceMemory(memoryType, blockSize, &mapped);
+        if (memory == VK_NULL_HANDLE) {
+            blockSize /= 2;
+        }
+    }
+    if (memory == VK_NULL_HANDLE) {
+        throw std::runtime_error("Failed to allocate device memory block!");
+    }
+
+    auto slot = std::find(pool.blocks.begin(), pool.blocks.end(), nullptr);
+    if (slot == pool.blocks.end()) {
+        pool.blocks.push_back(nullptr);
+        slot = pool.blocks.end() - 1;
+    }
+    *slot = std::make_unique<Block>(memory, blockSize, mapped);
+
+    const uint32_t blockIndex = static_cast<uint32_t>(slot - pool.blocks.begin());
+    if (!allocateFromPool(poolIndex, requirements.size, alignment, userData, NIL, allocation) ||
+        allocation.block != blockIndex) {
+        // 新块足以容纳本次分配，不会走到这里
+        throw std::logic_error("VulkanAllocator: allocation from a new block failed");
+    }
+    trackAllocation(allocation, 1);
+    return allocation;
+}
+
+void VulkanAllocator::free(VulkanAllocation& allocation) {
+    if (!allocation.isValid()) {
+        return;
+    }
+    trackAllocation(allocation, -1);
+
+    if (allocation.pool == DEDICATED) {
+        const Dedicated& entry = dedicated[allocation.block];
+        vkFreeMemory(device.getDevice(), entry.memory, nullptr);
+        trackDeviceMemory(entry.memoryType, entry.size, -1);
+        dedicated[allocation.block] = Dedicated{};
+        freeDedicatedSlots.push_back(allocation.block);
+        --deviceAllocationCount;
+    } else {
+        Pool& pool = pools[allocation.pool];
+        Block& block = *pool.blocks[allocation.block];
+        block.free(allocation.node);
+        if (block.isEmpty()) {
+            releaseEmptyBlock(pool, allocation.block);
+        }
+    }
+    allocation = VulkanAllocation{};
+}
+
+VulkanAllocation VulkanAllocator::allocateBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties,
+                                                 VulkanMemoryCategory category, void* userData) {
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device.getDevice(), buffer, &requirements);
+
+    VulkanAllocation allocation = allocate(requirements, properties, VulkanResourceKind::Linear, category, userData);
+    if (vkBindBufferMemory(device.getDevice(), buffer, allocation.memory, allocation.offset) != VK_SUCCESS) {
+        free(allocation);
+        throw std::runtime_error("Failed to bind buffer memory!");
+    }
+    return allocation;
+}
+
+VulkanAllocation VulkanAllocator::allocateImage(VkImage image, VkMemoryPropertyFlags properties,
+                                                VulkanMemoryCategory category, VulkanResourceKind kind, void* userData) {
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(device.getDevice(), image, &requirements);
+
+    VulkanAllocation allocation = allocate(requirements, properties, kind, category, userData);
+    if (vkBindImageMemory(device.getDevice(), image, allocation.memory, allocation.offset) != VK_SUCCESS) {
+        free(allocation);
+        throw std::runtime_error("Failed to bind image memory!");
+    }
+    return allocation;
+}
+
+std::vector<VulkanDefragMove> VulkanAllocator::beginDefragmentation(VkDeviceSize maxBytes) {
+    std::vector<VulkanDefragMove> moves;
+    VkDeviceSize movedBytes = 0;
+
+    for (uint32_t poolIndex = 0; poolIndex < pools.size() && movedBytes < maxBytes; ++poolIndex) {
+        Pool& pool = pools[poolIndex];
+
+        // 源块：使用率最低且不足一半的块（池中至少还有一个块可以接收）
+        uint32_t source = NIL;
+        uint32_t liveBlocks = 0;
+        for (uint32_t i = 0; i < pool.blocks.size(); ++i) {
+            if (!pool.blocks[i]) continue;
+            ++liveBlocks;
+            if (source == NIL || pool.blocks[i]->usedBytes < pool.blocks[source]->usedBytes) {
+                source = i;
+            }
+        }
+        if (liveBlocks < 2 || pool.blocks[source]->usedBytes > pool.blocks[source]->size / 2) {
+            continue;
+        }
+
+        const Block& block = *pool.blocks[source];
+        block.forEachMovable([&](uint32_t node, VkDeviceSize offset, VkDeviceSize size, VkDeviceSize alignment,
+                                 VulkanMemoryCategory category, void* userData) {
+            if (movedBytes >= maxBytes) return;
+
+            VulkanDefragMove move;
+            move.destination.category = category;
+            if (!allocateFromPool(poolIndex, size, alignment, userData, source, move.destination)) return;
+            trackAllocation(move.destination, 1);
+
+            move.source.memory = block.memory;
+            move.source.offset = offset;
+            move.source.size = size;
+            move.source.mapped = block.mapped ? block.mapped + offset : nullptr;
+            move.source.pool = poolIndex;
+            move.source.block = source;
+            move.source.node = node;
+            move.source.category = category;
+            move.userData = userData;
+            moves.push_back(move);
+            movedBytes += size;
+        });
+    }
+    return moves;
+}
+
+void VulkanAllocator::endDefragmentation(std::vector<VulkanDefragMove>& moves) {
+    for (VulkanDefragMove& move : moves) {
+        free(move.source);
+    }
+    moves.clear();
+}
+
+VulkanAllocatorStats VulkanAllocator::getStats() const {
+    VulkanAllocatorStats stats;
+    for (const Pool& pool : pools) {
+        for (const auto& block : pool.blocks) {
+            if (!block) continue;
+            ++stats.blockCount;
+            stats.allocationCount += block->allocationCount;
+            stats.reservedBytes += block->size;
+            stats.usedBytes += block->usedBytes;
+            block->collectFreeRanges(stats.largestFreeRange, stats.freeRangeCount);
+        }
+    }
+    for (const Dedicated& entry : dedicated) {
+        if (entry.memory == VK_NULL_HANDLE) continue;
+        ++stats.dedicatedCount;
+        ++stats.allocationCount;
+        stats.reservedBytes += entry.size;
+        stats.usedBytes += entry.size;
+    }
+    stats.deviceAllocationCount = deviceAllocationCount;
+    return stats;
+}
+
+uint32_t VulkanAllocator::findMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const {
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+        if ((typeBits & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+    throw std::runtime_error("Failed to find suitable memory type!");
+}
+
+VulkanAllocator::Pool& VulkanAllocator::getPool(uint32_t memoryType, VulkanResourceKind kind) {
+    Pool& pool = pools[memoryType * 2 + static_cast<uint32_t>(kind)];
+    if (pool.blockSize == 0) {
+        // 小堆（如 256 MiB 的 BAR 堆）按堆大小的 1/8 分块
+        const VkMemoryType& type = memoryProperties.memoryTypes[memoryType];
+        const VkDeviceSize heapSize = memoryProperties.memoryHeaps[type.heapIndex].size;
+        pool.memoryType = memoryType;
+        pool.kind = kind;
+        pool.blockSize = std::min(preferredBlockSize, std::max<VkDeviceSize>(heapSize / 8, 1ull << 20));
+        pool.hostVisible = (type.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+    }
+    return pool;
+}
+
+bool VulkanAllocator::allocateFromPool(uint32_t poolIndex, VkDeviceSize size, VkDeviceSize alignment, void* userData,
+                                       uint32_t excludeBlock, VulkanAllocation& allocation) {
+    Pool& pool = pools[poolIndex];
+    for (uint32_t i = 0; i < pool.blocks.size(); ++i) {
+        Block* block = pool.blocks[i].get();
+        if (!block || i == excludeBlock) continue;
+
+        VkDeviceSize offset = 0;
+        uint32_t node = 0;
+        if (block->allocate(size, alignment, userData, allocation.category, offset, node)) {
+            allocation.memory = block->memory;
+            allocation.offset = offset;
+            allocation.size = size;
+            allocation.mapped = block->mapped ? block->mapped + offset : nullptr;
+            allocation.pool = poolIndex;
+            allocation.block = i;
+            allocation.node = node;
+            return true;
+        }
+    }
+    return false;
+}
+
+VkDeviceMemory VulkanAllocator::allocateDeviceMemory(uint32_t memoryType, VkDeviceSize size, uint8_t** mapped) {
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = size;
+    allocInfo.memoryTypeIndex = memoryType;
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    if (vkAllocateMemory(device.getDevice(), &allocInfo, nullptr, &memory) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    *mapped = nullptr;
+    if (memoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        void* data = nullptr;
+        if (vkMapMemory(device.getDevice(), memory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS) {
+            vkFreeMemory(device.getDevice(), memory, nullptr);
+            return VK_NULL_HANDLE;
+        }
+        *mapped = static_cast<uint8_t*>(data);
+    }
+    ++deviceAllocationCount;
+    trackDeviceMemory(memoryType, size, 1);
+    return memory;
+}
+
+VulkanAllocation VulkanAllocator::allocateDedicated(uint32_t memoryType, VkDeviceSize size) {
+    VulkanAllocation allocation;
+    allocation.memory = allocateDeviceMemory(memoryType, size, &allocation.mapped);
+    if (allocation.memory == VK_NULL_HANDLE) {
+        throw std::runtime_error("Failed to allocate device memory!");
+    }
+    allocation.size = size;
+    allocation.pool = DEDICATED;
+
+    if (!freeDedicatedSlots.empty()) {
+        allocation.block = freeDedicatedSlots.back();
+        freeDedicatedSlots.pop_back();
+    } else {
+        allocation.block = static_cast<uint32_t>(dedicated.size());
+        dedicated.emplace_back();
+    }
+    dedicated[allocation.block] = { allocation.memory, size, memoryType };
+    return allocation;
+}
+
+void VulkanAllocator::releaseEmptyBlock(Pool& pool, uint32_t blockIndex) {
+    // 每个池保留最后一个空块，避免分配 / 释放交替时反复申请
+    const auto others = std::count_if(pool.blocks.begin(), pool.blocks.end(),
+                                      [](const std::unique_ptr<Block>& block) { return block != nullptr; });
+    if (others <= 1) {
+        return;
+    }
+    vkFreeMemory(device.getDevice(), pool.blocks[blockIndex]->memory, nullptr);
+    trackDeviceMemory(pool.memoryType, pool.blocks[blockIndex]->size, -1);
+    pool.blocks[blockIndex].reset();
+    --deviceAllocationCount;
+}
+
+uint32_t VulkanAllocator::getMemoryType(const VulkanAllocation& allocation) const {
+    return allocation.pool == DEDICATED ? dedicated[allocation.block].memoryType : pools[allocation.pool].memoryType;
+}
+
+void VulkanAllocator::trackAllocation(const VulkanAllocation& allocation, int64_t sign) {
+    VulkanCategoryStats& category = categoryStats[static_cast<size_t>(allocation.category)];
+    VulkanHeapStats& heap = heapStats[memoryProperties.memoryTypes[getMemoryType(allocation)].heapIndex];
+    if (sign > 0) {
+        category.bytes += allocation.size;
+        category.peakBytes = std::max(category.peakBytes, category.bytes);
+        ++category.allocationCount;
+        heap.usedBytes += allocation.size;
+    } else {
+        category.bytes -= allocation.size;
+        --category.allocationCount;
+        heap.usedBytes -= allocation.size;
+    }
+}
+
+void VulkanAllocator::trackDeviceMemory(uint32_t memoryType, VkDeviceSize size, int64_t sign) {
+    VulkanHeapStats& heap = heapStats[memoryProperties.memoryTypes[memoryType].heapIndex];
+    if (sign > 0) {
+        heap.reservedBytes += size;
+        heap.peakReservedBytes = std::max(heap.peakReservedBytes, heap.reservedBytes);
+        ++heap.deviceAllocationCount;
+    } else {
+        heap.reservedBytes -= size;
+        --heap.deviceAllocationCount;
+    }
+}
+
+VulkanMemoryReport VulkanAllocator::getMemoryReport() const {
+    VulkanMemoryReport report;
+    report.allocator = getStats();
+    std::copy(std::begin(categoryStats), std::end(categoryStats), std::begin(report.categories));
+    report.heaps = heapStats;
+    report.maxAllocationCount = device.getProperties().limits.maxMemoryAllocationCount;
+
+    // VK_EXT_memory_budget：驱动报告的每堆预算与本进程实际占用
+    if (device.supportsMemoryBudget()) {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{};
+        budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+        VkPhysicalDeviceMemoryProperties2 properties2{};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        properties2.pNext = &budget;
+        vkGetPhysicalDeviceMemoryProperties2(device.getPhysicalDevice(), &properties2);
+
+        for (uint32_t i = 0; i < report.heaps.size(); ++i) {
+            report.heaps[i].budgetBytes = budget.heapBudget[i];
+            report.heaps[i].usageBytes = budget.heapUsage[i];
+        }
+        report.hasBudget = true;
+    }
+    return report;
+}
+
+const char* getMemoryCategoryName(VulkanMemoryCategory category) {
+    switch (category) {
+        case VulkanMemoryCategory::Other:        return "other";
+        case VulkanMemoryCategory::Staging:      return "staging";
+        case VulkanMemoryCategory::Uniform:      return "uniform";
+        case VulkanMemoryCategory::Mesh:         return "mesh";
+        case VulkanMemoryCategory::Texture:      return "texture";
+        case VulkanMemoryCategory::GBuffer:      return "gbuffer";
+        case VulkanMemoryCategory::SSR:          return "ssr";
+        case VulkanMemoryCategory::RenderTarget: return "render_target";
+        default:                                 return "unknown";
+    }
+}
+
+void VulkanMemoryReport::writeJson(std::ostream& out) const {
+    out << "{\n";
+    out << "  \"allocator\": {"
+        << "\"blocks\": " << allocator.blockCount
+        << ", \"dedicated\": " << allocator.dedicatedCount
+        << ", \"allocations\": " << allocator.allocationCount
+        << ", \"deviceAllocations\": " << allocator.deviceAllocationCount
+        << ", \"maxDeviceAllocations\": " << maxAllocationCount
+        << ", \"reservedBytes\": " << allocator.reservedBytes
+        << ", \"usedBytes\": " << allocator.usedBytes
+        << ", \"largestFreeRange\": " << allocator.largestFreeRange
+        << ", \"freeRanges\": " << allocator.freeRangeCount << "},\n";
+
+    out << "  \"categories\": {\n";
+    const size_t categoryCount = static_cast<size_t>(VulkanMemoryCategory::Count);
+    for (size_t i = 0; i < categoryCount; ++i) {
+        const VulkanCategoryStats& category = categories[i];
+        out << "    \"" << getMemoryCategoryName(static_cast<VulkanMemoryCategory>(i)) << "\": {"
+            << "\"bytes\": " << category.bytes
+            << ", \"peakBytes\": " << category.peakBytes
+            << ", \"allocations\": " << category.allocationCount << "}"
+            << (i + 1 < categoryCount ? ",\n" : "\n");
+    }
+    out << "  },\n";
+
+    out << "  \"hasBudget\": " << (hasBudget ? "true" : "false") << ",\n";
+    out << "  \"heaps\": [\n";
+    for (size_t i = 0; i < heaps.size(); ++i) {
+        const VulkanHeapStats& heap = heaps[i];
+        out << "    {\"index\": " << i
+            << ", \"deviceLocal\": " << (heap.deviceLocal ? "true" : "false")
+            << ", \"size\": " << heap.heapSize
+            << ", \"reservedBytes\": " << heap.reservedBytes
+            << ", \"usedBytes\": " << heap.usedBytes
+            << ", \"peakReservedBytes\": " << heap.peakReservedBytes
+            << ", \"deviceAllocations\": " << heap.deviceAllocationCount
+            << ", \"budgetBytes\": " << heap.budgetBytes
+            << ", \"usageBytes\": " << heap.usageBytes << "}"
+            << (i + 1 < heaps.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+class VulkanDevice;
+
+/**
+ * 资源类型：线性资源（缓冲区、线性图像）与最优平铺图像放在不同的内存块中，
+ * 同一块内不会出现两者相邻，无需按 bufferImageGranularity 对齐
+ */
+enum class VulkanResourceKind : uint32_t {
+    Linear = 0,
+    Optimal = 1,
+};
+
+/**
+ * 内存用途分类（统计用，不影响分配策略）
+ */
+enum class VulkanMemoryCategory : uint8_t {
+    Other = 0,
+    Staging,          // 上传暂存
+    Uniform,          // UBO / 材质参数等每帧常量
+    Mesh,             // 顶点 / 索引缓冲区
+    Texture,          // 材质纹理
+    GBuffer,          // G-Buffer 附件
+    SSR,              // SSR 输出
+    RenderTarget,     // 深度缓冲、场景颜色等其他渲染目标
+    Count
+};
+
+const char* getMemoryCategoryName(VulkanMemoryCategory category);
+
+/**
+ * 一次子分配（由 VulkanAllocator 返回，按值持有，释放时交还）
+ */
+struct VulkanAllocation {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+    uint8_t* mapped = nullptr;          // 主机可见内存的映射地址（已加 offset），否则为 nullptr
+
+    // 内部：所属内存池 / 块 / 节点，pool == DEDICATED 表示独立的 vkAllocateMemory
+    uint32_t pool = 0;
+    uint32_t block = 0;
+    uint32_t node = 0;
+    VulkanMemoryCategory category = VulkanMemoryCategory::Other;
+
+    bool isValid() const { return memory != VK_NULL_HANDLE; }
+};
+
+/**
+ * 分配器统计
+ */
+struct VulkanAllocatorStats {
+    uint32_t blockCount = 0;
+    uint32_t dedicatedCount = 0;
+    uint32_t allocationCount = 0;       // 子分配与独立分配之和
+    uint32_t deviceAllocationCount = 0; // vkAllocateMemory 对象数（上限 maxMemoryAllocationCount）
+    VkDeviceSize reservedBytes = 0;     // 向驱动申请的总量
+    VkDeviceSize usedBytes = 0;         // 已分配出去的字节（含对齐填充）
+    VkDeviceSize largestFreeRange = 0;
+    uint32_t freeRangeCount = 0;        // 空闲区间数，越多碎片越严重
+};
+
+/**
+ * 按用途分类的内存统计（字节为分配大小，不含块内空闲部分）
+ */
+struct VulkanCategoryStats {
+    VkDeviceSize bytes = 0;
+    VkDeviceSize peakBytes = 0;
+    uint32_t allocationCount = 0;
+};
+
+/**
+ * 按内存堆的统计；budgetBytes / usageBytes 来自 VK_EXT_memory_budget（不支持时为 0），
+ * usageBytes 包含本进程其他途径（驱动内部、交换链等）的占用
+ */
+struct VulkanHeapStats {
+    VkDeviceSize heapSize = 0;
+    bool deviceLocal = false;
+    VkDeviceSize reservedBytes = 0;     // 本分配器向驱动申请的块与独立分配
+    VkDeviceSize usedBytes = 0;
+    VkDeviceSize peakReservedBytes = 0;
+    uint32_t deviceAllocationCount = 0;
+    VkDeviceSize budgetBytes = 0;
+    VkDeviceSize usageBytes = 0;
+};
+
+/**
+ * 内存报告：分配器统计 + 按用途 + 按堆
+ */
+struct VulkanMemoryReport {
+    VulkanAllocatorStats allocator;
+    VulkanCategoryStats categories[static_cast<size_t>(VulkanMemoryCategory::Count)];
+    std::vector<VulkanHeapStats> heaps;
+    bool hasBudget = false;             // 是否来自 VK_EXT_memory_budget
+    uint32_t maxAllocationCount = 0;    // maxMemoryAllocationCount
+
+    const VulkanCategoryStats& get(VulkanMemoryCategory category) const {
+        return categories[static_cast<size_t>(category)];
+    }
+
+    // 以 JSON 输出，供容量规划脚本读取
+    void writeJson(std::ostream& out) const;
+};
+
+/**
+ * 碎片整理中的一次移动：调用方在 destination 上创建新资源、拷贝内容并切换引用，
+ * GPU 不再使用旧资源后调用 endDefragmentation 释放 source
+ */
+struct VulkanDefragMove {
+    VulkanAllocation source;
+    VulkanAllocation destination;
+    void* userData = nullptr;
+};
+
+/**
+ * VulkanAllocator - 设备内存子分配器（VulkanDevice 持有）
+ *
+ * 每个内存类型 × 资源类型一个内存池，池由若干大块（默认 128 MiB，小堆取堆大小的 1/8）组成，
+ * 块内用 TLSF（两级分离空闲链表）管理：分配和释放为 O(1)，相邻空闲区间在释放时合并。
+ * 超过块大小一半的资源使用独立的 vkAllocateMemory。主机可见的块创建时整体映射一次，
+ * 分配直接返回映射地址（同一 VkDeviceMemory 不能重复映射，调用方不再调用 vkMapMemory）。
+ * 空块只保留每个池的最后一块，其余立即释放。
+ *
+ * 碎片整理钩子：分配时传入非空 userData 表示资源可移动；beginDefragmentation 从使用率最低的块
+ * 中挑选可移动的分配，在同池其他块中预留目标位置并返回移动列表，由资源持有者执行拷贝。
+ * 统计：每次分配记录用途分类，按分类和内存堆累计当前值与峰值；
+ * 设备启用 VK_EXT_memory_budget 时 getMemoryReport 同时查询各堆的预算与实际占用。
+ * 只在主线程使用。
+ */
+class VulkanAllocator {
+public:
+    static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = 128ull * 1024 * 1024;
+    static constexpr uint32_t DEDICATED = UINT32_MAX;
+
+    explicit VulkanAllocator(VulkanDevice& device, VkDeviceSize preferredBlockSize = DEFAULT_BLOCK_SIZE);
+    ~VulkanAllocator();
+
+    VulkanAllocator(const VulkanAllocator&) = delete;
+    VulkanAllocator& operator=(const VulkanAllocator&) = delete;
+
+    // 按需求分配内存，失败时抛出异常
+    VulkanAllocation allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties,
+                              VulkanResourceKind kind, VulkanMemoryCategory category = VulkanMemoryCategory::Other,
+                              void* userData = nullptr);
+    void free(VulkanAllocation& allocation);
+
+    // 分配并绑定到缓冲区 / 图像
+    VulkanAllocation allocateBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties,
+                                    VulkanMemoryCategory category = VulkanMemoryCategory::Other,
+                                    void* userData = nullptr);
+    VulkanAllocation allocateImage(VkImage image, VkMemoryPropertyFlags properties,
+                                   VulkanMemoryCategory category = VulkanMemoryCategory::Other,
+                                   VulkanResourceKind kind = VulkanResourceKind::Optimal, void* userData = nullptr);
+
+    // 碎片整理：最多移动 maxBytes 字节；返回的目标位置已预留
+    std::vector<VulkanDefragMove> beginDefragmentation(VkDeviceSize maxBytes);
+    // 释放已完成移动的源位置（未执行的移动应由调用方直接 free(destination)）
+    void endDefragmentation(std::vector<VulkanDefragMove>& moves);
+
+    VulkanAllocatorStats getStats() const;
+    // 包含分类 / 堆统计；启用 VK_EXT_memory_budget 时查询驱动报告的预算（有一定开销，不必每帧调用）
+    VulkanMemoryReport getMemoryReport() const;
+
+private:
+    // 块内 TLSF 管理
+    class Block;
+
+    struct Pool {
+        uint32_t memoryType = 0;
+        VulkanResourceKind kind = VulkanResourceKind::Linear;
+        VkDeviceSize blockSize = 0;
+        bool hostVisible = false;
+        std::vector<std::unique_ptr<Block>> blocks;   // 释放的块留空位，保证块索引不变
+    };
+
+    struct Dedicated {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize size = 0;
+        uint32_t memoryType = 0;
+    };
+
+    uint32_t findMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
+    Pool& getPool(uint32_t memoryType, VulkanResourceKind kind);
+    bool allocateFromPool(uint32_t poolIndex, VkDeviceSize size, VkDeviceSize alignment, void* userData,
+                          uint32_t excludeBlock, VulkanAllocation& allocation);
+    VkDeviceMemory allocateDeviceMemory(uint32_t memoryType, VkDeviceSize size, uint8_t** mapped);
+    VulkanAllocation allocateDedicated(uint32_t memoryType, VkDeviceSize size);
+    void releaseEmptyBlock(Pool& pool, uint32_t blockIndex);
+    uint32_t getMemoryType(const VulkanAllocation& allocation) const;
+    void trackAllocation(const VulkanAllocation& allocation, int64_t sign);
+    void trackDeviceMemory(uint32_t memoryType, VkDeviceSize size, int64_t sign);
+
+    VulkanDevice& device;
+    VkPhysicalDeviceMemoryProperties memoryProperties{};
+    VkDeviceSize preferredBlockSize;
+    VkDeviceSize bufferImageGranularity = 1;
+    VkDeviceSize nonCoherentAtomSize = 1;
+
+    std::vector<Pool> pools;                          // 索引 = memoryType * 2 + kind
+    std::vector<Dedicated> dedicated;                 // 释放的留空位
+    std::vector<uint32_t> freeDedicatedSlots;
+    uint32_t deviceAllocationCount = 0;
+
+    // 统计
+    VulkanCategoryStats categoryStats[static_cast<size_t>(VulkanMemoryCategory::Count)];
+    std::vector<VulkanHeapStats> heapStats;
+};
@@ -2,6 +2,7 @@
 
 #include <vulkan/vulkan.h>
 #include <memory>
+#include "VulkanAllocator.h"
 
 class VulkanDevice;
 
@@ -10,22 +11,24 @@ public:
     VulkanBuffer(std::shared_ptr<VulkanDevice> device, 
                 VkDeviceSize size, 
                 VkBufferUsageFlags usage, 
-                VkMemoryPropertyFlags properties);
+                VkMemoryPropertyFlags properties,
+                VulkanMemoryCategory category = VulkanMemoryCategory::Other);
     ~VulkanBuffer();
 
+    // 主机可见内存由分配器持久映射：map 直接返回映射地址，unmap 无操作
     void map(void** data, VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
     void unmap();
-    void copyFrom(const void* src, VkDeviceSize size);
+    void copyFrom(const void* src, VkDeviceSize size, VkDeviceSize offset = 0);
 
     VkBuffer getBuffer() const { return buffer; }
-    VkDeviceMemory getMemory() const { return memory; }
+    VkDeviceMemory getMemory() const { return allocation.memory; }
+    const VulkanAllocation& getAllocation() const { return allocation; }
     VkDeviceSize getSize() const { return size; }
 
 private:
     std::shared_ptr<VulkanDevice> device;
     
     VkBuffer buffer = VK_NULL_HANDLE;
-    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VulkanAllocation allocation;
     VkDeviceSize size = 0;
-    void* mapped = nullptr;
 };
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "VulkanDevice.h"
+#include "UploadManager.h"
+#include "FrameAllocator.h"
 #include "Utils.h"
 #include <iostream>
 #include <stdexcept>
@@ -40,9 +42,15 @@ VulkanDevice::VulkanDevice(GLFWwindow* window) : window(window) {
     pickPhysicalDevice();
     createLogicalDevice();
     createCommandPool();
+    allocator = std::make_unique<VulkanAllocator>(*this);
+    uploadManager = std::make_unique<UploadManager>(*this);
+    frameAllocator = std::make_unique<FrameAllocator>(*this);
 }
 
 VulkanDevice::~VulkanDevice() {
+    frameAllocator.reset();
+    uploadManager.reset();
+    allocator.reset();
     vkDestroyCommandPool(device_, commandPool, nullptr);
     
     vkDestroyDevice(device_, nullptr);
@@ -150,7 +158,7 @@ VkFormat VulkanDevice::findDepthFormat() {
 
 void VulkanDevice::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, 
                                VkMemoryPropertyFlags properties, VkBuffer& buffer, 
-                               VkDeviceMemory& bufferMemory) {
+                               VulkanAllocation& bufferAllocation, VulkanMemoryCategory category) {
     VkBufferCreateInfo bufferInfo{};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     bufferInfo.size = size;
@@ -161,35 +169,35 @@ void VulkanDevice::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage,
         throw std::runtime_error("failed to create buffer!");
     }
 
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(device_, buffer, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-
-    if (vkAllocateMemory(device_, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate buffer memory!");
+    try {
+        bufferAllocation = allocator->allocateBuffer(buffer, properties, category);
+    } catch (...) {
+        vkDestroyBuffer(device_, buffer, nullptr);
+        buffer = VK_NULL_HANDLE;
+        throw;
     }
+}
 
-    vkBindBufferMemory(device_, buffer, bufferMemory, 0);
+void VulkanDevice::destroyBuffer(VkBuffer& buffer, VulkanAllocation& bufferAllocation) {
+    if (buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(device_, buffer, nullptr);
+        buffer = VK_NULL_HANDLE;
+    }
+    allocator->free(bufferAllocation);
 }
 
 void VulkanDevice::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) {
-    VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-
     VkBufferCopy copyRegion{};
     copyRegion.size = size;
-    vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+    vkCmdCopyBuffer(uploadManager->getCommandBuffer(), srcBuffer, dstBuffer, 1, &copyRegion);
 
-    endSingleTimeCommands(commandBuffer);
+    uploadManager->wait(uploadManager->flush());
 }
 
 void VulkanDevice::createImage(uint32_t width, uint32_t height, VkFormat format, 
                               VkImageTiling tiling, VkImageUsageFlags usage, 
                               VkMemoryPropertyFlags properties, VkImage& image, 
-                              VkDeviceMemory& imageMemory) {
+                              VulkanAllocation& imageAllocation, VulkanMemoryCategory category) {
     VkImageCreateInfo imageInfo{};
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     imageInfo.imageType = VK_IMAGE_TYPE_2D;
@@ -209,19 +217,23 @@ void VulkanDevice::createImage(uint32_t width, uint32_t height, VkFormat format,
         throw std::runtime_error("failed to create image!");
     }
 
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(device_, image, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-
-    if (vkAllocateMemory(device_, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate image memory!");
+    const VulkanResourceKind kind = tiling == VK_IMAGE_TILING_LINEAR ? VulkanResourceKind::Linear
+                                                                      : VulkanResourceKind::Optimal;
+    try {
+        imageAllocation = allocator->allocateImage(image, properties, category, kind);
+    } catch (...) {
+        vkDestroyImage(device_, image, nullptr);
+        image = VK_NULL_HANDLE;
+        throw;
     }
+}
 
-    vkBindImageMemory(device_, image, imageMemory, 0);
+void VulkanDevice::destroyImage(VkImage& image, VulkanAllocation& imageAllocation) {
+    if (image != VK_NULL_HANDLE) {
+        vkDestroyImage(device_, image, nullptr);
+        image = VK_NULL_HANDLE;
+    }
+    allocator->free(imageAllocation);
 }
 
 VkCommandBuffer VulkanDevice::beginSingleTimeCommands() {
@@ -251,9 +263,16 @@ void VulkanDevice::endSingleTimeCommands(VkCommandBuffer commandBuffer) {
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffer;
 
-    vkQueueSubmit(graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(graphicsQueue_);
+    // 只等待本次提交，不等待队列上的其他工作（渲染帧、进行中的上传）
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    VkFence fence;
+    vkCreateFence(device_, &fenceInfo, nullptr, &fence);
 
+    vkQueueSubmit(graphicsQueue_, 1, &submitInfo, fence);
+    vkWaitForFences(device_, 1, &fence, VK_TRUE, UINT64_MAX);
+
+    vkDestroyFence(device_, fence, nullptr);
     vkFreeCommandBuffers(device_, commandPool, 1, &commandBuffer);
 }
 
@@ -300,7 +319,8 @@ void VulkanDevice::createInstance() {
     appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
     appInfo.pEngineName = "PBR Engine";
     appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-    appInfo.apiVersion = VK_API_VERSION_1_0;
+    // 1.1：vkGetPhysicalDeviceFeatures2 用于查询可选的扩展特性
+    appInfo.apiVersion = VK_API_VERSION_1_1;
 
     VkInstanceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -406,16 +426,74 @@ void VulkanDevice::createLogicalDevice() {
         queueCreateInfos.push_back(queueCreateInfo);
     }
 
+    VkPhysicalDeviceFeatures supportedFeatures{};
+    vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
     VkPhysicalDeviceFeatures deviceFeatures{};
     deviceFeatures.samplerAnisotropy = VK_TRUE;
+    // BC 压缩纹理为可选特性，不支持时纹理回退到未压缩的 RGBA8
+    deviceFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+    textureCompressionBC_ = supportedFeatures.textureCompressionBC == VK_TRUE;
+    // GPU 驱动渲染（计算着色器剔除 + 间接绘制）使用的特性，均为可选
+    deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+    deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+    multiDrawIndirect_ = supportedFeatures.multiDrawIndirect == VK_TRUE;
+    drawIndirectFirstInstance_ = supportedFeatures.drawIndirectFirstInstance == VK_TRUE;
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+    graphicsCompute_ = (queueFamilies[indices.graphicsFamily.value()].queueFlags & VK_QUEUE_COMPUTE_BIT) != 0;
+
+    std::vector<const char*> enabledExtensions(deviceExtensions.begin(), deviceExtensions.end());
+
+    // Descriptor indexing 为可选特性，不支持时材质回退到每材质独立的描述符集
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures{};
+    indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+    if (properties.apiVersion >= VK_API_VERSION_1_1 &&
+        hasDeviceExtension(physicalDevice, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)) {
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &indexingFeatures;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+
+        descriptorIndexing_ = indexingFeatures.shaderSampledImageArrayNonUniformIndexing &&
+                              indexingFeatures.runtimeDescriptorArray &&
+                              indexingFeatures.descriptorBindingPartiallyBound;
+    }
+    if (descriptorIndexing_) {
+        // 只启用用到的特性
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT supported = indexingFeatures;
+        indexingFeatures = VkPhysicalDeviceDescriptorIndexingFeaturesEXT{};
+        indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        indexingFeatures.shaderSampledImageArrayNonUniformIndexing = supported.shaderSampledImageArrayNonUniformIndexing;
+        indexingFeatures.runtimeDescriptorArray = supported.runtimeDescriptorArray;
+        indexingFeatures.descriptorBindingPartiallyBound = supported.descriptorBindingPartiallyBound;
+        enabledExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+    }
+
+    // 内存预算查询为可选扩展，不支持时内存报告只包含分配器自身的统计
+    if (properties.apiVersion >= VK_API_VERSION_1_1 &&
+        hasDeviceExtension(physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) {
+        memoryBudget_ = true;
+        enabledExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+
+    // 绘制数量来自缓冲区为可选扩展，不支持时间接绘制按最大数量提交（实例数为 0 的命令不产生图元）
+    const bool drawIndirectCount = hasDeviceExtension(physicalDevice, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    if (drawIndirectCount) {
+        enabledExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    }
 
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
     createInfo.pEnabledFeatures = &deviceFeatures;
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(enabledExtensions.size());
+    createInfo.ppEnabledExtensionNames = enabledExtensions.data();
+    createInfo.pNext = descriptorIndexing_ ? &indexingFeatures : nullptr;
 
     if (enableValidationLayers) {
         createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
@@ -428,6 +506,17 @@ void VulkanDevice::createLogicalDevice() {
         throw std::runtime_error("failed to create logical device!");
     }
 
+    std::cout << "Descriptor indexing: " << (descriptorIndexing_ ? "enabled" : "not supported") << std::endl;
+    std::cout << "Memory budget: " << (memoryBudget_ ? "enabled" : "not supported") << std::endl;
+
+    if (drawIndirectCount) {
+        cmdDrawIndexedIndirectCount_ = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+            vkGetDeviceProcAddr(device_, "vkCmdDrawIndexedIndirectCountKHR"));
+    }
+    std::cout << "Indirect draw: multi-draw " << (multiDrawIndirect_ ? "yes" : "no")
+              << ", first instance " << (drawIndirectFirstInstance_ ? "yes" : "no")
+              << ", draw count " << (cmdDrawIndexedIndirectCount_ ? "yes" : "no") << std::endl;
+
     vkGetDeviceQueue(device_, indices.graphicsFamily.value(), 0, &graphicsQueue_);
     vkGetDeviceQueue(device_, indices.presentFamily.value(), 0, &presentQueue_);
     
@@ -524,3 +613,18 @@ bool VulkanDevice::checkDeviceExtensionSupport(VkPhysicalDevice device) {
 
     return requiredExtensions.empty();
 }
+
+bool VulkanDevice::hasDeviceExtension(VkPhysicalDevice device, const char* extensionName) {
+    uint32_t extensionCount;
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+
+    std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
+
+    for (const auto& extension : availableExtensions) {
+        if (strcmp(extension.extensionName, extensionName) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -3,11 +3,17 @@
 #include <GLFW/glfw3.h>
 #include <vulkan/vulkan.h>
 
+#include <memory>
 #include <vector>
 #include <optional>
 #include <set>
 #include <string>
 
+#include "VulkanAllocator.h"
+
+class UploadManager;
+class FrameAllocator;
+
 struct QueueFamilyIndices {
     std::optional<uint32_t> graphicsFamily;
     std::optional<uint32_t> presentFamily;
@@ -38,6 +44,26 @@ public:
     VkCommandPool getCommandPool() const { return commandPool; }
     uint32_t getGraphicsQueueFamily() const { return graphicsQueueFamily_; }
     uint32_t getGraphicsQueueFamilyIndex() const { return graphicsQueueFamily_; }  // 别名
+    bool supportsTextureCompressionBC() const { return textureCompressionBC_; }
+    // VK_EXT_descriptor_indexing（bindless 纹理数组：非一致索引、运行时数组、部分绑定）
+    bool supportsDescriptorIndexing() const { return descriptorIndexing_; }
+    // VK_EXT_memory_budget（各内存堆的预算与实际占用，见 VulkanAllocator::getMemoryReport）
+    bool supportsMemoryBudget() const { return memoryBudget_; }
+    // 间接绘制：multiDrawIndirect（一次调用多条命令）、drawIndirectFirstInstance（命令中 firstInstance 非 0）、
+    // VK_KHR_draw_indirect_count（绘制数量来自缓冲区），以及图形队列是否支持计算着色器
+    bool supportsMultiDrawIndirect() const { return multiDrawIndirect_; }
+    bool supportsDrawIndirectFirstInstance() const { return drawIndirectFirstInstance_; }
+    bool supportsDrawIndirectCount() const { return cmdDrawIndexedIndirectCount_ != nullptr; }
+    bool supportsComputeOnGraphicsQueue() const { return graphicsCompute_; }
+    // 不支持 VK_KHR_draw_indirect_count 时为 nullptr
+    PFN_vkCmdDrawIndexedIndirectCountKHR getCmdDrawIndexedIndirectCount() const { return cmdDrawIndexedIndirectCount_; }
+    const VkPhysicalDeviceProperties& getProperties() const { return properties; }
+    // 统一的暂存上传（暂存环 + 批量提交），缓冲区和纹理上传都经由它
+    UploadManager& getUploadManager() { return *uploadManager; }
+    // 每帧常量的线性分配器（持久映射，动态偏移），飞行帧数以它为准
+    FrameAllocator& getFrameAllocator() { return *frameAllocator; }
+    // 设备内存子分配器，core/ 与 passes/ 中的缓冲区和图像内存都从这里分配
+    VulkanAllocator& getAllocator() { return *allocator; }
 
     // Helper functions
     QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device);
@@ -47,16 +73,23 @@ public:
                                 VkImageTiling tiling, VkFormatFeatureFlags features);
     VkFormat findDepthFormat();
     
+    // 内存由 VulkanAllocator 子分配；主机可见内存已持久映射（allocation.mapped）
     void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, 
                      VkMemoryPropertyFlags properties, VkBuffer& buffer, 
-                     VkDeviceMemory& bufferMemory);
+                     VulkanAllocation& bufferAllocation,
+                     VulkanMemoryCategory category = VulkanMemoryCategory::Other);
+    void destroyBuffer(VkBuffer& buffer, VulkanAllocation& bufferAllocation);
+    // 记录到 UploadManager 的当前批次并等待该批次完成（srcBuffer 由调用方持有）
     void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
     
     void createImage(uint32_t width, uint32_t height, VkFormat format, 
                     VkImageTiling tiling, VkImageUsageFlags usage, 
                     VkMemoryPropertyFlags properties, VkImage& image, 
-                    VkDeviceMemory& imageMemory);
+                    VulkanAllocation& imageAllocation,
+                    VulkanMemoryCategory category = VulkanMemoryCategory::Other);
+    void destroyImage(VkImage& image, VulkanAllocation& imageAllocation);
     
+    // 一次性命令：提交后只等待本次提交的栅栏
     VkCommandBuffer beginSingleTimeCommands();
     void endSingleTimeCommands(VkCommandBuffer commandBuffer);
 
@@ -73,6 +106,7 @@ private:
     std::vector<const char*> getRequiredExtensions();
     bool isDeviceSuitable(VkPhysicalDevice device);
     bool checkDeviceExtensionSupport(VkPhysicalDevice device);
+    bool hasDeviceExtension(VkPhysicalDevice device, const char* extensionName);
 
     GLFWwindow* window;
     
@@ -88,6 +122,16 @@ private:
     VkQueue presentQueue_;
     VkCommandPool commandPool;
     uint32_t graphicsQueueFamily_ = 0;
+    bool textureCompressionBC_ = false;
+    bool descriptorIndexing_ = false;
+    bool memoryBudget_ = false;
+    bool multiDrawIndirect_ = false;
+    bool drawIndirectFirstInstance_ = false;
+    bool graphicsCompute_ = false;
+    PFN_vkCmdDrawIndexedIndirectCountKHR cmdDrawIndexedIndirectCount_ = nullptr;
+    std::unique_ptr<VulkanAllocator> allocator;
+    std::unique_ptr<UploadManager> uploadManager;
+    std::unique_ptr<FrameAllocator> frameAllocator;
 
     const std::vector<const char*> validationLayers = {
         "VK_LAYER_KHRONOS_validation"
@@ -289,7 +289,7 @@ void VulkanSwapChain::createRenderPass() {
  * 
  * 创建内容：
  * - VkImage: 存储深度数据的图像
- * - VkDeviceMemory: 图像使用的 GPU 内存
+ * - VulkanAllocation: 图像使用的 GPU 内存（从设备的子分配器中分配）
  * - VkImageView: 访问深度图像的视图
  */
 void VulkanSwapChain::createDepthResources() {
@@ -302,7 +302,8 @@ void VulkanSwapChain::createDepthResources() {
     // - DEVICE_LOCAL_BIT: 存储在 GPU 专用内存中
     device->createImage(swapChainExtent.width, swapChainExtent.height, depthFormat,
                        VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
-                       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, depthImage, depthImageMemory);
+                       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, depthImage, depthImageAllocation,
+                       VulkanMemoryCategory::RenderTarget);
 
     // 创建深度图像视图
     VkImageViewCreateInfo viewInfo{};
@@ -377,8 +378,7 @@ void VulkanSwapChain::createFramebuffers() {
 void VulkanSwapChain::cleanup() {
     // 销毁深度资源
     vkDestroyImageView(device->getDevice(), depthImageView, nullptr);
-    vkDestroyImage(device->getDevice(), depthImage, nullptr);
-    vkFreeMemory(device->getDevice(), depthImageMemory, nullptr);
+    device->destroyImage(depthImage, depthImageAllocation);
 
     // 销毁所有帧缓冲
     for (auto framebuffer : swapChainFramebuffers) {
@@ -51,7 +51,7 @@ private:
     
     // Depth resources
     VkImage depthImage = VK_NULL_HANDLE;
-    VkDeviceMemory depthImageMemory = VK_NULL_HANDLE;
+    VulkanAllocation depthImageAllocation;
     VkImageView depthImageView = VK_NULL_HANDLE;
     
     int width, height;
@@ -1,8 +1,10 @@
 #include "VulkanTexture.h"
 #include "VulkanDevice.h"
+#include "UploadManager.h"
 #include <stdexcept>
 #include <iostream>
 #include <cstring>
+#include <utility>
 
 // 使用 stb_image 加载图像
 #define STB_IMAGE_IMPLEMENTATION
@@ -16,7 +18,7 @@ VulkanTexture::VulkanTexture(std::shared_ptr<VulkanDevice> device)
 
 VulkanTexture::VulkanTexture(std::shared_ptr<VulkanDevice> device, const std::string& filepath)
     : device(device) {
-    createTextureImage(filepath);
+    createTextureImage(filepath, VK_FORMAT_R8G8B8A8_SRGB);
     createTextureImageView();
     createTextureSampler();
 }
@@ -28,26 +30,75 @@ VulkanTexture::~VulkanTexture() {
     if (imageView != VK_NULL_HANDLE) {
         vkDestroyImageView(device->getDevice(), imageView, nullptr);
     }
-    if (image != VK_NULL_HANDLE) {
-        vkDestroyImage(device->getDevice(), image, nullptr);
+    device->destroyImage(image, imageAllocation);
+}
+
+bool VulkanTexture::loadFromFile(const std::string& filepath, VkFormat format) {
+    try {
+        createTextureImage(filepath, format);
+        createTextureImageView(format);
+        createTextureSampler();
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to load texture: " << e.what() << std::endl;
+        return false;
     }
-    if (imageMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(device->getDevice(), imageMemory, nullptr);
+}
+
+bool VulkanTexture::loadFromMipChain(const uint8_t* data, const std::vector<MipLevel>& levels, VkFormat format) {
+    TextureUploadBatch batch(device);
+    if (!loadFromMipChain(batch, data, levels, format)) {
+        return false;
     }
+    batch.submit();
+    batch.wait();
+    return true;
 }
 
-bool VulkanTexture::loadFromFile(const std::string& filepath) {
+bool VulkanTexture::loadFromMipChain(TextureUploadBatch& batch, const uint8_t* data, const std::vector<MipLevel>& levels,
+                                     VkFormat format, bool gpuBlit) {
+    if (levels.empty()) {
+        return false;
+    }
+    
     try {
-        createTextureImage(filepath);
-        createTextureImageView();
+        width = levels[0].width;
+        height = levels[0].height;
+        mipLevels = gpuBlit ? MipmapGenerator::getMipLevelCount(width, height) : static_cast<uint32_t>(levels.size());
+        this->format = format;
+        if (gpuBlit && mipLevels > 1) {
+            mipSource = "GPU blit";
+        } else if (levels.size() > 1) {
+            mipSource = (format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_BC7_SRGB_BLOCK) ? "cooked" : "CPU";
+        } else {
+            mipSource = "none";
+        }
+        
+        batch.record(*this, data, levels, gpuBlit && mipLevels > 1);
+        createTextureImageView(format);
         createTextureSampler();
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "Failed to load texture: " << e.what() << std::endl;
+        std::cerr << "Failed to create texture from mip chain: " << e.what() << std::endl;
         return false;
     }
 }
 
+void VulkanTexture::swapResources(VulkanTexture& other) {
+    std::swap(image, other.image);
+    std::swap(imageAllocation, other.imageAllocation);
+    std::swap(imageView, other.imageView);
+    std::swap(sampler, other.sampler);
+    std::swap(width, other.width);
+    std::swap(height, other.height);
+    std::swap(mipLevels, other.mipLevels);
+    std::swap(format, other.format);
+    std::swap(memorySize, other.memorySize);
+    std::swap(mipSource, other.mipSource);
+    ++residencyVersion;
+    ++other.residencyVersion;
+}
+
 void VulkanTexture::createDefaultTexture(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
     unsigned char pixels[4] = {r, g, b, a};
     createTextureImageFromMemory(pixels, 1, 1, 4);
@@ -73,7 +124,7 @@ std::unique_ptr<VulkanTexture> VulkanTexture::createDefaultTextureStatic(
     return texture;
 }
 
-void VulkanTexture::createTextureImage(const std::string& filepath) {
+void VulkanTexture::createTextureImage(const std::string& filepath, VkFormat format) {
     int texWidth, texHeight, texChannels;
     stbi_uc* pixels = stbi_load(filepath.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
     
@@ -86,80 +137,159 @@ void VulkanTexture::createTextureImage(const std::string& filepath) {
     
     std::cout << "Loaded texture: " << filepath << " (" << width << "x" << height << ")" << std::endl;
     
-    createTextureImageFromMemory(pixels, texWidth, texHeight, 4);
+    createTextureImageFromMemory(pixels, texWidth, texHeight, 4, format);
     
     stbi_image_free(pixels);
 }
 
 void VulkanTexture::createTextureImageFromMemory(const unsigned char* pixels, int texWidth, int texHeight, int channels, VkFormat format) {
-    VkDeviceSize imageSize = texWidth * texHeight * 4;
-    
     width = static_cast<uint32_t>(texWidth);
     height = static_cast<uint32_t>(texHeight);
-    
-    // 创建暂存缓冲区
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    
-    VkBufferCreateInfo bufferInfo{};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = imageSize;
-    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    
-    if (vkCreateBuffer(device->getDevice(), &bufferInfo, nullptr, &stagingBuffer) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create staging buffer!");
+    this->format = format;
+    mipLevels = MipmapGenerator::getMipLevelCount(width, height);
+    
+    // 优先在 GPU 上逐级 blit；格式不支持线性过滤 blit 时在 CPU 上生成整条 mip 链
+    const bool gpuBlit = mipLevels > 1 && supportsLinearBlit(*device, format);
+    std::vector<uint8_t> cpuMips;
+    std::vector<MipLevel> levels;
+    if (mipLevels > 1 && !gpuBlit) {
+        levels = MipmapGenerator::generate(pixels, width, height, format == VK_FORMAT_R8G8B8A8_SRGB, cpuMips);
+        mipSource = "CPU";
+    } else {
+        MipLevel base;
+        base.width = width;
+        base.height = height;
+        base.size = static_cast<size_t>(width) * height * 4;
+        levels.push_back(base);
+        mipSource = gpuBlit ? "GPU blit" : "none";
     }
-    
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(device->getDevice(), stagingBuffer, &memRequirements);
-    
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, 
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    
-    if (vkAllocateMemory(device->getDevice(), &allocInfo, nullptr, &stagingBufferMemory) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to allocate staging buffer memory!");
+    uploadMipChain(cpuMips.empty() ? pixels : cpuMips.data(), levels, gpuBlit);
+}
+
+void VulkanTexture::uploadMipChain(const uint8_t* uploadData, const std::vector<MipLevel>& levels, bool gpuBlit) {
+    TextureUploadBatch batch(device);
+    batch.record(*this, uploadData, levels, gpuBlit);
+    batch.submit();
+    batch.wait();
+}
+
+void VulkanTexture::recordUpload(VkCommandBuffer commandBuffer, VkBuffer stagingBuffer, VkDeviceSize stagingOffset,
+                                 const std::vector<MipLevel>& levels, bool gpuBlit) {
+    std::vector<VkBufferImageCopy> regions;
+    for (uint32_t level = 0; level < levels.size(); ++level) {
+        VkBufferImageCopy region{};
+        region.bufferOffset = stagingOffset + levels[level].offset;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = level;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = {0, 0, 0};
+        region.imageExtent = {levels[level].width, levels[level].height, 1};
+        regions.push_back(region);
     }
     
-    vkBindBufferMemory(device->getDevice(), stagingBuffer, stagingBufferMemory, 0);
-    
-    // 复制像素数据到暂存缓冲区
-    void* data;
-    vkMapMemory(device->getDevice(), stagingBufferMemory, 0, imageSize, 0, &data);
-    memcpy(data, pixels, static_cast<size_t>(imageSize));
-    vkUnmapMemory(device->getDevice(), stagingBufferMemory);
+    // 布局转换、拷贝和 mip 生成记录在同一个命令缓冲区中
+    transitionImageLayout(commandBuffer, image, mipLevels,
+                          VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    copyBufferToImage(commandBuffer, stagingBuffer, image, regions);
+    if (gpuBlit) {
+        generateMipmapsBlit(commandBuffer);
+    } else {
+        transitionImageLayout(commandBuffer, image, mipLevels,
+                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    }
+}
+
+bool VulkanTexture::supportsLinearBlit(VulkanDevice& device, VkFormat format) {
+    VkFormatProperties properties;
+    vkGetPhysicalDeviceFormatProperties(device.getPhysicalDevice(), format, &properties);
+    const VkFormatFeatureFlags required = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                          VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    return (properties.optimalTilingFeatures & required) == required;
+}
+
+void VulkanTexture::generateMipmapsBlit(VkCommandBuffer commandBuffer) {
+    // 进入时所有级别都是 TRANSFER_DST，LOD0 已写入；逐级从上一级线性 blit
+    // （sRGB 格式在 blit 时按线性空间过滤）
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+    barrier.subresourceRange.levelCount = 1;
     
-    // 创建纹理图像（使用传入的格式）
-    createImage(width, height, format, VK_IMAGE_TILING_OPTIMAL,
-                VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image, imageMemory);
+    int32_t mipWidth = static_cast<int32_t>(width);
+    int32_t mipHeight = static_cast<int32_t>(height);
     
-    // 转换图像布局并复制数据
-    transitionImageLayout(image, format, 
-                         VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    copyBufferToImage(stagingBuffer, image, width, height);
-    transitionImageLayout(image, format,
-                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    for (uint32_t level = 1; level < mipLevels; ++level) {
+        // 上一级：TRANSFER_DST -> TRANSFER_SRC
+        barrier.subresourceRange.baseMipLevel = level - 1;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+        
+        int32_t nextWidth = mipWidth > 1 ? mipWidth / 2 : 1;
+        int32_t nextHeight = mipHeight > 1 ? mipHeight / 2 : 1;
+        
+        VkImageBlit blit{};
+        blit.srcOffsets[0] = {0, 0, 0};
+        blit.srcOffsets[1] = {mipWidth, mipHeight, 1};
+        blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.srcSubresource.mipLevel = level - 1;
+        blit.srcSubresource.baseArrayLayer = 0;
+        blit.srcSubresource.layerCount = 1;
+        blit.dstOffsets[0] = {0, 0, 0};
+        blit.dstOffsets[1] = {nextWidth, nextHeight, 1};
+        blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.dstSubresource.mipLevel = level;
+        blit.dstSubresource.baseArrayLayer = 0;
+        blit.dstSubresource.layerCount = 1;
+        vkCmdBlitImage(commandBuffer,
+                       image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                       1, &blit, VK_FILTER_LINEAR);
+        
+        // 上一级已用完：TRANSFER_SRC -> SHADER_READ
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+        
+        mipWidth = nextWidth;
+        mipHeight = nextHeight;
+    }
     
-    // 清理暂存缓冲区
-    vkDestroyBuffer(device->getDevice(), stagingBuffer, nullptr);
-    vkFreeMemory(device->getDevice(), stagingBufferMemory, nullptr);
+    // 最后一级只被写入过
+    barrier.subresourceRange.baseMipLevel = mipLevels - 1;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
 }
 
-void VulkanTexture::createImage(uint32_t width, uint32_t height, VkFormat format,
+void VulkanTexture::createImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkFormat format,
                                 VkImageTiling tiling, VkImageUsageFlags usage,
                                 VkMemoryPropertyFlags properties, VkImage& image,
-                                VkDeviceMemory& imageMemory) {
+                                VulkanAllocation& imageAllocation) {
     VkImageCreateInfo imageInfo{};
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     imageInfo.imageType = VK_IMAGE_TYPE_2D;
     imageInfo.extent.width = width;
     imageInfo.extent.height = height;
     imageInfo.extent.depth = 1;
-    imageInfo.mipLevels = 1;
+    imageInfo.mipLevels = mipLevels;
     imageInfo.arrayLayers = 1;
     imageInfo.format = format;
     imageInfo.tiling = tiling;
@@ -172,25 +302,18 @@ void VulkanTexture::createImage(uint32_t width, uint32_t height, VkFormat format
         throw std::runtime_error("Failed to create image!");
     }
     
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(device->getDevice(), image, &memRequirements);
-    
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-    
-    if (vkAllocateMemory(device->getDevice(), &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to allocate image memory!");
+    try {
+        imageAllocation = device->getAllocator().allocateImage(image, properties, VulkanMemoryCategory::Texture);
+    } catch (...) {
+        vkDestroyImage(device->getDevice(), image, nullptr);
+        image = VK_NULL_HANDLE;
+        throw;
     }
-    
-    vkBindImageMemory(device->getDevice(), image, imageMemory, 0);
+    memorySize = imageAllocation.size;
 }
 
-void VulkanTexture::transitionImageLayout(VkImage image, VkFormat format,
+void VulkanTexture::transitionImageLayout(VkCommandBuffer commandBuffer, VkImage image, uint32_t mipLevels,
                                           VkImageLayout oldLayout, VkImageLayout newLayout) {
-    VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-    
     VkImageMemoryBarrier barrier{};
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrier.oldLayout = oldLayout;
@@ -200,7 +323,7 @@ void VulkanTexture::transitionImageLayout(VkImage image, VkFormat format,
     barrier.image = image;
     barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.levelCount = mipLevels;
     barrier.subresourceRange.baseArrayLayer = 0;
     barrier.subresourceRange.layerCount = 1;
     
@@ -223,27 +346,12 @@ void VulkanTexture::transitionImageLayout(VkImage image, VkFormat format,
     
     vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage,
                          0, 0, nullptr, 0, nullptr, 1, &barrier);
-    
-    endSingleTimeCommands(commandBuffer);
 }
 
-void VulkanTexture::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height) {
-    VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-    
-    VkBufferImageCopy region{};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-    region.imageOffset = {0, 0, 0};
-    region.imageExtent = {width, height, 1};
-    
-    vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-    
-    endSingleTimeCommands(commandBuffer);
+void VulkanTexture::copyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer buffer, VkImage image,
+                                      const std::vector<VkBufferImageCopy>& regions) {
+    vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(regions.size()), regions.data());
 }
 
 void VulkanTexture::createTextureImageView(VkFormat format) {
@@ -252,9 +360,13 @@ void VulkanTexture::createTextureImageView(VkFormat format) {
     viewInfo.image = image;
     viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
     viewInfo.format = format;  // 使用传入的格式
+    if (format == VK_FORMAT_BC4_UNORM_BLOCK) {
+        // 单通道遮罩：R 复制到 RGB，与原先的灰度 RGBA 贴图采样结果一致
+        viewInfo.components = {VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_ONE};
+    }
     viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.levelCount = mipLevels;
     viewInfo.subresourceRange.baseArrayLayer = 0;
     viewInfo.subresourceRange.layerCount = 1;
     
@@ -283,55 +395,74 @@ void VulkanTexture::createTextureSampler() {
     samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
     samplerInfo.mipLodBias = 0.0f;
     samplerInfo.minLod = 0.0f;
-    samplerInfo.maxLod = 0.0f;
+    samplerInfo.maxLod = static_cast<float>(mipLevels);
     
     if (vkCreateSampler(device->getDevice(), &samplerInfo, nullptr, &sampler) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create texture sampler!");
     }
 }
 
-VkCommandBuffer VulkanTexture::beginSingleTimeCommands() {
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = device->getCommandPool();
-    allocInfo.commandBufferCount = 1;
+TextureUploadBatch::TextureUploadBatch(std::shared_ptr<VulkanDevice> device)
+    : device(device) {
+}
+
+TextureUploadBatch::~TextureUploadBatch() {
+    // 已记录但未提交的命令引用了本批纹理的图像，同样需要执行完毕
+    if (textureCount > 0 && !complete) {
+        wait();
+    }
+}
+
+void TextureUploadBatch::record(VulkanTexture& texture, const uint8_t* data, const std::vector<MipLevel>& levels, bool gpuBlit) {
+    if (submitted) {
+        throw std::logic_error("Texture upload batch already submitted!");
+    }
     
-    VkCommandBuffer commandBuffer;
-    vkAllocateCommandBuffers(device->getDevice(), &allocInfo, &commandBuffer);
+    const VkDeviceSize dataSize = levels.back().offset + levels.back().size;
     
-    VkCommandBufferBeginInfo beginInfo{};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    // 16 字节对齐满足 BC 块大小和 4 字节拷贝对齐要求；分配可能提前提交暂存环中较早的命令
+    UploadManager& uploads = device->getUploadManager();
+    UploadManager::StagingAllocation staging = uploads.allocateStaging(dataSize, 16);
+    memcpy(staging.mapped, data, static_cast<size_t>(dataSize));
     
-    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    // 图像创建在录制之前，blit 需要 TRANSFER_SRC
+    VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    if (gpuBlit) {
+        usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+    texture.createImage(texture.width, texture.height, texture.mipLevels, texture.format, VK_IMAGE_TILING_OPTIMAL,
+                        usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, texture.image, texture.imageAllocation);
     
-    return commandBuffer;
+    texture.recordUpload(uploads.getCommandBuffer(), staging.buffer, staging.offset, levels, gpuBlit);
+    ++textureCount;
+    uploadSize += dataSize;
 }
 
-void VulkanTexture::endSingleTimeCommands(VkCommandBuffer commandBuffer) {
-    vkEndCommandBuffer(commandBuffer);
-    
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-    
-    vkQueueSubmit(device->getGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(device->getGraphicsQueue());
-    
-    vkFreeCommandBuffers(device->getDevice(), device->getCommandPool(), 1, &commandBuffer);
+void TextureUploadBatch::submit() {
+    if (submitted) {
+        return;
+    }
+    submitted = true;
+    if (textureCount == 0) {
+        complete = true;
+        return;
+    }
+    ticket = device->getUploadManager().flush();
 }
 
-uint32_t VulkanTexture::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-    VkPhysicalDeviceMemoryProperties memProperties;
-    vkGetPhysicalDeviceMemoryProperties(device->getPhysicalDevice(), &memProperties);
-    
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-            return i;
-        }
+bool TextureUploadBatch::isComplete() {
+    if (!complete && submitted) {
+        complete = device->getUploadManager().isComplete(ticket);
+    }
+    return complete;
+}
+
+void TextureUploadBatch::wait() {
+    if (!submitted) {
+        submit();
+    }
+    if (!complete) {
+        device->getUploadManager().wait(ticket);
+        complete = true;
     }
-    
-    throw std::runtime_error("Failed to find suitable memory type!");
 }
@@ -1,10 +1,14 @@
 #pragma once
 
+#include "MipmapGenerator.h"
+#include "VulkanAllocator.h"
 #include <vulkan/vulkan.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 class VulkanDevice;
+class TextureUploadBatch;
 
 class VulkanTexture {
 public:
@@ -20,8 +24,16 @@ public:
     VulkanTexture(const VulkanTexture&) = delete;
     VulkanTexture& operator=(const VulkanTexture&) = delete;
 
-    // 从文件加载纹理
-    bool loadFromFile(const std::string& filepath);
+    // 从文件加载纹理（颜色贴图用 SRGB，法线/遮罩等数据贴图用 UNORM）
+    bool loadFromFile(const std::string& filepath, VkFormat format = VK_FORMAT_R8G8B8A8_SRGB);
+    
+    // 从已生成的完整 mip 链创建纹理（如烘焙好的 BC 压缩数据），levels 的偏移相对于 data
+    bool loadFromMipChain(const uint8_t* data, const std::vector<MipLevel>& levels, VkFormat format);
+    
+    // 批量上传：创建图像、视图和采样器，上传命令记录到 batch 中，batch 完成前不能被采样。
+    // gpuBlit 时 levels 只含 LOD0，其余级别在同一命令缓冲区中 blit 生成（需 supportsLinearBlit）
+    bool loadFromMipChain(TextureUploadBatch& batch, const uint8_t* data, const std::vector<MipLevel>& levels,
+                          VkFormat format, bool gpuBlit = false);
     
     // 创建默认白色纹理（1x1）
     void createDefaultTexture(uint8_t r = 255, uint8_t g = 255, uint8_t b = 255, uint8_t a = 255);
@@ -35,6 +47,28 @@ public:
     
     uint32_t getWidth() const { return width; }
     uint32_t getHeight() const { return height; }
+    uint32_t getMipLevels() const { return mipLevels; }
+    VkFormat getFormat() const { return format; }
+    
+    // 图像实际占用的设备内存（含所有 mip 级别与驱动对齐）
+    VkDeviceSize getMemorySize() const { return memorySize; }
+    
+    // mip 链来源："GPU blit" / "CPU" / "cooked" / "none"
+    const char* getMipSource() const { return mipSource; }
+    
+    // 资源版本：每次 swapResources 后递增，描述符集据此判断是否需要重写
+    uint64_t getResidencyVersion() const { return residencyVersion; }
+    
+    // 与 other 交换 GPU 资源（图像、视图、采样器与尺寸信息），用于流式替换驻留的 mip 级别。
+    // 交换后 other 持有旧资源，必须等引用旧资源的帧执行完毕后再销毁
+    void swapResources(VulkanTexture& other);
+    
+    // bindless 纹理数组中的槽位（由 TextureManager 分配，未分配时为 UINT32_MAX），swapResources 不交换槽位
+    uint32_t getBindlessIndex() const { return bindlessIndex; }
+    void setBindlessIndex(uint32_t index) { bindlessIndex = index; }
+    
+    // 格式是否支持线性过滤 blit（可在 GPU 上生成 mip 链）
+    static bool supportsLinearBlit(VulkanDevice& device, VkFormat format);
     
     // 静态工厂方法：创建默认纹理
     static std::unique_ptr<VulkanTexture> createDefaultTextureStatic(
@@ -42,31 +76,85 @@ public:
         uint8_t r = 255, uint8_t g = 255, uint8_t b = 255, uint8_t a = 255);
 
 private:
-    void createTextureImage(const std::string& filepath);
+    friend class TextureUploadBatch;
+    
+    void createTextureImage(const std::string& filepath, VkFormat format);
     // format 参数：默认 SRGB 用于颜色贴图，法线贴图应使用 UNORM
+    // 生成完整 mip 链：格式支持线性过滤 blit 时在 GPU 上逐级 blit，否则在 CPU 上生成后一次上传
     void createTextureImageFromMemory(const unsigned char* pixels, int width, int height, int channels,
                                       VkFormat format = VK_FORMAT_R8G8B8A8_SRGB);
-    void createImage(uint32_t width, uint32_t height, VkFormat format, 
+    // 经暂存缓冲区上传 levels 描述的数据并等待完成；gpuBlit 时只上传 LOD0，其余级别由 blit 生成
+    void uploadMipChain(const uint8_t* data, const std::vector<MipLevel>& levels, bool gpuBlit);
+    // 记录从暂存缓冲区到图像的布局转换、拷贝和 mip 生成命令（图像需已创建）
+    void recordUpload(VkCommandBuffer commandBuffer, VkBuffer stagingBuffer, VkDeviceSize stagingOffset,
+                      const std::vector<MipLevel>& levels, bool gpuBlit);
+    void createImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkFormat format, 
                     VkImageTiling tiling, VkImageUsageFlags usage,
                     VkMemoryPropertyFlags properties, VkImage& image, 
-                    VkDeviceMemory& imageMemory);
-    void transitionImageLayout(VkImage image, VkFormat format, 
+                    VulkanAllocation& imageAllocation);
+    void transitionImageLayout(VkCommandBuffer commandBuffer, VkImage image, uint32_t mipLevels,
                               VkImageLayout oldLayout, VkImageLayout newLayout);
-    void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
+    void copyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer buffer, VkImage image,
+                           const std::vector<VkBufferImageCopy>& regions);
+    void generateMipmapsBlit(VkCommandBuffer commandBuffer);
     void createTextureImageView(VkFormat format = VK_FORMAT_R8G8B8A8_SRGB);
     void createTextureSampler();
-    
-    VkCommandBuffer beginSingleTimeCommands();
-    void endSingleTimeCommands(VkCommandBuffer commandBuffer);
-    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 
     std::shared_ptr<VulkanDevice> device;
     
     VkImage image = VK_NULL_HANDLE;
-    VkDeviceMemory imageMemory = VK_NULL_HANDLE;
+    VulkanAllocation imageAllocation;
     VkImageView imageView = VK_NULL_HANDLE;
     VkSampler sampler = VK_NULL_HANDLE;
     
     uint32_t width = 0;
     uint32_t height = 0;
-};
\ No newline at end of file
+    uint32_t mipLevels = 1;
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkDeviceSize memorySize = 0;
+    const char* mipSource = "none";
+    uint64_t residencyVersion = 0;
+    uint32_t bindlessIndex = UINT32_MAX;
+};
+
+/**
+ * 纹理批量上传（经由设备的 UploadManager）
+ * 多个纹理的暂存数据写入同一个暂存环，布局转换、拷贝和 mip 生成记录在 UploadManager 的当前批次中，
+ * 与同一帧的缓冲区上传共用命令缓冲区和栅栏。submit() 不阻塞，调用方通过 isComplete() 轮询或
+ * wait() 等待；暂存环空间不足时 UploadManager 会提前提交，完成以本批最后一条命令所在的批次为准。
+ * 析构时若仍未完成会等待。只在主线程使用。
+ */
+class TextureUploadBatch {
+public:
+    explicit TextureUploadBatch(std::shared_ptr<VulkanDevice> device);
+    ~TextureUploadBatch();
+    
+    TextureUploadBatch(const TextureUploadBatch&) = delete;
+    TextureUploadBatch& operator=(const TextureUploadBatch&) = delete;
+    
+    // 提交已记录的命令（无纹理时为空操作）
+    void submit();
+    
+    // 本批上传是否已执行完毕
+    bool isComplete();
+    
+    // 阻塞等待本批上传完成
+    void wait();
+    
+    bool isSubmitted() const { return submitted; }
+    uint32_t getTextureCount() const { return textureCount; }
+    VkDeviceSize getUploadSize() const { return uploadSize; }
+
+private:
+    friend class VulkanTexture;
+    
+    // 复制 levels 描述的数据到暂存区并记录 texture 的上传命令
+    void record(VulkanTexture& texture, const uint8_t* data, const std::vector<MipLevel>& levels, bool gpuBlit);
+    
+    std::shared_ptr<VulkanDevice> device;
+    uint64_t ticket = 0;               // UploadManager 批次号
+    bool submitted = false;
+    bool complete = false;
+    uint32_t textureCount = 0;
+    VkDeviceSize uploadSize = 0;
+};
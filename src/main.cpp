@@ -1,8 +1,51 @@
 #include "VulkanRenderer.h"
+#include "TextureCache.h"
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 
-int main() {
+// 离线烘焙纹理（不创建窗口和 Vulkan 设备，可在无显示的构建机上运行）
+// 用法：V-Engine --cook [--color|--normal|--mask|--metallic-roughness] <图片>...
+// 用途开关作用于其后的文件，未指定时按文件名推断
+static int cookTextures(int argc, char* argv[]) {
+    bool hasOverride = false;
+    VulkanEngine::TextureUsage usage = VulkanEngine::TextureUsage::Color;
+    int failed = 0;
+
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--color") == 0) {
+            hasOverride = true;
+            usage = VulkanEngine::TextureUsage::Color;
+        } else if (std::strcmp(argv[i], "--normal") == 0) {
+            hasOverride = true;
+            usage = VulkanEngine::TextureUsage::Normal;
+        } else if (std::strcmp(argv[i], "--mask") == 0) {
+            hasOverride = true;
+            usage = VulkanEngine::TextureUsage::Mask;
+        } else if (std::strcmp(argv[i], "--metallic-roughness") == 0) {
+            hasOverride = true;
+            usage = VulkanEngine::TextureUsage::MetallicRoughness;
+        } else {
+            const VulkanEngine::TextureUsage fileUsage =
+                hasOverride ? usage : VulkanEngine::TextureCache::guessUsage(argv[i]);
+            VulkanEngine::CookedTexture cooked;
+            if (VulkanEngine::TextureCache::load(argv[i], fileUsage, cooked)) {
+                std::cout << "Up to date: " << VulkanEngine::TextureCache::getCachePath(argv[i], fileUsage) << std::endl;
+            } else if (!VulkanEngine::TextureCache::cook(argv[i], fileUsage, cooked) ||
+                       !VulkanEngine::TextureCache::save(argv[i], fileUsage, cooked)) {
+                ++failed;
+            }
+        }
+    }
+
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "--cook") == 0) {
+        return cookTextures(argc, argv);
+    }
+
     try {
         VulkanRenderer renderer;
         renderer.run();
@@ -13,4 +56,4 @@ int main() {
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
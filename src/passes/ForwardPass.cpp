@@ -1,5 +1,6 @@
 #include "ForwardPass.h"
 #include "../core/VulkanDevice.h"
+#include "../core/FrameAllocator.h"
 #include "../resources/Mesh.h"
 #include <stdexcept>
 #include <iostream>
@@ -9,19 +10,19 @@
 ForwardPass::ForwardPass(std::shared_ptr<VulkanDevice> device,
                          VkRenderPass renderPass,
                          uint32_t width, uint32_t height,
-                         uint32_t maxFramesInFlight)
+                         VkDescriptorSetLayout bindlessSetLayout)
     : RenderPassBase(device, width, height)
     , device(device)
     , renderPass(renderPass)
     , width(width)
     , height(height)
-    , maxFramesInFlight(maxFramesInFlight) {
+    , maxFramesInFlight(device->getFrameAllocator().getFrameCount())
+    , bindlessSetLayout(bindlessSetLayout) {
     
     passName = "Forward Pass";
     
     createDescriptorSetLayouts();
     createPipeline();
-    createUniformBuffers();
     createDescriptorPools();
     createGlobalDescriptorSets();
     
@@ -40,6 +41,10 @@ void ForwardPass::recreate(VkRenderPass newRenderPass, uint32_t newWidth, uint32
         vkDestroyPipeline(device->getDevice(), pipeline, nullptr);
         pipeline = VK_NULL_HANDLE;
     }
+    if (compactPipeline != VK_NULL_HANDLE) {
+        vkDestroyPipeline(device->getDevice(), compactPipeline, nullptr);
+        compactPipeline = VK_NULL_HANDLE;
+    }
     if (pipelineLayout != VK_NULL_HANDLE) {
         vkDestroyPipelineLayout(device->getDevice(), pipelineLayout, nullptr);
         pipelineLayout = VK_NULL_HANDLE;
@@ -55,21 +60,9 @@ void ForwardPass::recreate(VkRenderPass newRenderPass, uint32_t newWidth, uint32
 void ForwardPass::cleanup() {
     VkDevice dev = device->getDevice();
     
-    // 销毁 Uniform Buffers
-    for (size_t i = 0; i < uniformBuffers.size(); i++) {
-        if (uniformBuffers[i] != VK_NULL_HANDLE) {
-            vkDestroyBuffer(dev, uniformBuffers[i], nullptr);
-        }
-        if (uniformBuffersMemory[i] != VK_NULL_HANDLE) {
-            vkFreeMemory(dev, uniformBuffersMemory[i], nullptr);
-        }
-    }
-    uniformBuffers.clear();
-    uniformBuffersMemory.clear();
-    uniformBuffersMapped.clear();
-    
     // 清除材质描述符缓存
-    materialDescriptorCache.clear();
+    materialDescriptors.clear();
+    bumpResourceGeneration();
     
     // 销毁材质描述符池
     for (auto pool : materialDescriptorPools) {
@@ -83,12 +76,17 @@ void ForwardPass::cleanup() {
     if (globalDescriptorPool != VK_NULL_HANDLE) {
         vkDestroyDescriptorPool(dev, globalDescriptorPool, nullptr);
         globalDescriptorPool = VK_NULL_HANDLE;
+        globalDescriptorSet = VK_NULL_HANDLE;
     }
     
     if (pipeline != VK_NULL_HANDLE) {
         vkDestroyPipeline(dev, pipeline, nullptr);
         pipeline = VK_NULL_HANDLE;
     }
+    if (compactPipeline != VK_NULL_HANDLE) {
+        vkDestroyPipeline(dev, compactPipeline, nullptr);
+        compactPipeline = VK_NULL_HANDLE;
+    }
     
     if (pipelineLayout != VK_NULL_HANDLE) {
         vkDestroyPipelineLayout(dev, pipelineLayout, nullptr);
@@ -107,19 +105,28 @@ void ForwardPass::cleanup() {
 }
 
 void ForwardPass::createDescriptorSetLayouts() {
-    // ========== Set 0: 全局 UBO ==========
+    // ========== Set 0: 全局 UBO + 逐实例数据（动态偏移） ==========
     {
-        VkDescriptorSetLayoutBinding uboBinding{};
-        uboBinding.binding = 0;
-        uboBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        uboBinding.descriptorCount = 1;
-        uboBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-        uboBinding.pImmutableSamplers = nullptr;
+        std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+        
+        // binding 0: 全局 UBO
+        bindings[0].binding = 0;
+        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        bindings[0].descriptorCount = 1;
+        bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        bindings[0].pImmutableSamplers = nullptr;
+        
+        // binding 1: 实例数据（model, normalMatrix）
+        bindings[1].binding = 1;
+        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        bindings[1].descriptorCount = 1;
+        bindings[1].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        bindings[1].pImmutableSamplers = nullptr;
         
         VkDescriptorSetLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        layoutInfo.bindingCount = 1;
-        layoutInfo.pBindings = &uboBinding;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
         
         if (vkCreateDescriptorSetLayout(device->getDevice(), &layoutInfo, nullptr, &globalSetLayout) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create global descriptor set layout!");
@@ -161,7 +168,7 @@ void ForwardPass::createDescriptorSetLayouts() {
         }
     }
     
-    std::cout << "ForwardPass descriptor set layouts created (Set 0: Global UBO, Set 1: Material)" << std::endl;
+    std::cout << "ForwardPass descriptor set layouts created (Set 0: Global UBO + Instances, Set 1: Material)" << std::endl;
 }
 
 void ForwardPass::createPipeline() {
@@ -169,7 +176,7 @@ void ForwardPass::createPipeline() {
     
     // 读取 PBR 着色器
     auto vertShaderCode = readFile("shaders/pbr_vert.spv");
-    auto fragShaderCode = readFile("shaders/pbr_frag.spv");
+    auto fragShaderCode = readFile(isBindless() ? "shaders/pbr_bindless_frag.spv" : "shaders/pbr_frag.spv");
     
     VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
     VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
@@ -190,36 +197,8 @@ void ForwardPass::createPipeline() {
     VkPipelineShaderStageCreateInfo shaderStages[] = { vertShaderStageInfo, fragShaderStageInfo };
     
     // 顶点输入 - 与 Vertex 结构体匹配
-    VkVertexInputBindingDescription bindingDescription{};
-    bindingDescription.binding = 0;
-    bindingDescription.stride = sizeof(float) * 11; // pos(3) + normal(3) + texCoord(2) + tangent(3)
-    bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-    
-    std::array<VkVertexInputAttributeDescription, 4> attributeDescriptions{};
-    
-    // Position
-    attributeDescriptions[0].binding = 0;
-    attributeDescriptions[0].location = 0;
-    attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-    attributeDescriptions[0].offset = 0;
-    
-    // Normal
-    attributeDescriptions[1].binding = 0;
-    attributeDescriptions[1].location = 1;
-    attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
-    attributeDescriptions[1].offset = sizeof(float) * 3;
-    
-    // TexCoord
-    attributeDescriptions[2].binding = 0;
-    attributeDescriptions[2].location = 2;
-    attributeDescriptions[2].format = VK_FORMAT_R32G32_SFLOAT;
-    attributeDescriptions[2].offset = sizeof(float) * 6;
-    
-    // Tangent
-    attributeDescriptions[3].binding = 0;
-    attributeDescriptions[3].location = 3;
-    attributeDescriptions[3].format = VK_FORMAT_R32G32B32_SFLOAT;
-    attributeDescriptions[3].offset = sizeof(float) * 8;
+    auto bindingDescription = Vertex::getBindingDescription();
+    auto attributeDescriptions = Vertex::getAttributeDescriptions();
     
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
@@ -289,21 +268,23 @@ void ForwardPass::createPipeline() {
     dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
     dynamicState.pDynamicStates = dynamicStates.data();
     
-    // Push Constants 范围定义
+    // Push Constants 范围定义（只有 bindless 片段着色器读取材质索引，变换矩阵在实例数据中）
     VkPushConstantRange pushConstantRange{};
-    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
     pushConstantRange.offset = 0;
-    pushConstantRange.size = sizeof(PushConstantData);  // 2 个 mat4 = 128 bytes
+    pushConstantRange.size = sizeof(PushConstantData);
     
     // Pipeline 布局 - 使用两个描述符集
-    std::array<VkDescriptorSetLayout, 2> setLayouts = { globalSetLayout, materialSetLayout };
+    std::array<VkDescriptorSetLayout, 2> setLayouts = {
+        globalSetLayout, isBindless() ? bindlessSetLayout : materialSetLayout
+    };
     
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
     pipelineLayoutInfo.pSetLayouts = setLayouts.data();
-    pipelineLayoutInfo.pushConstantRangeCount = 1;
-    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+    pipelineLayoutInfo.pushConstantRangeCount = isBindless() ? 1 : 0;
+    pipelineLayoutInfo.pPushConstantRanges = isBindless() ? &pushConstantRange : nullptr;
     
     if (vkCreatePipelineLayout(dev, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create ForwardPass pipeline layout!");
@@ -330,65 +311,52 @@ void ForwardPass::createPipeline() {
         throw std::runtime_error("Failed to create ForwardPass graphics pipeline!");
     }
     
+    // 紧凑顶点格式管线：相同布局，顶点输入改为 CompactVertex，着色器通过特化常量切换解码
+    auto compactBinding = CompactVertex::getBindingDescription();
+    auto compactAttributes = CompactVertex::getAttributeDescriptions();
+    vertexInputInfo.pVertexBindingDescriptions = &compactBinding;
+    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(compactAttributes.size());
+    vertexInputInfo.pVertexAttributeDescriptions = compactAttributes.data();
+    
+    VkBool32 compactVertex = VK_TRUE;
+    VkSpecializationMapEntry specEntry{};
+    specEntry.constantID = 0;
+    specEntry.offset = 0;
+    specEntry.size = sizeof(VkBool32);
+    
+    VkSpecializationInfo specInfo{};
+    specInfo.mapEntryCount = 1;
+    specInfo.pMapEntries = &specEntry;
+    specInfo.dataSize = sizeof(VkBool32);
+    specInfo.pData = &compactVertex;
+    shaderStages[0].pSpecializationInfo = &specInfo;
+    
+    if (vkCreateGraphicsPipelines(dev, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &compactPipeline) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create ForwardPass compact vertex pipeline!");
+    }
+    
     // 销毁着色器模块
     vkDestroyShaderModule(dev, fragShaderModule, nullptr);
     vkDestroyShaderModule(dev, vertShaderModule, nullptr);
     
-    std::cout << "ForwardPass pipeline created (2 descriptor sets: Global + Material)" << std::endl;
-}
-
-void ForwardPass::createUniformBuffers() {
-    VkDeviceSize bufferSize = sizeof(UniformBufferObject);
-    
-    uniformBuffers.resize(maxFramesInFlight);
-    uniformBuffersMemory.resize(maxFramesInFlight);
-    uniformBuffersMapped.resize(maxFramesInFlight);
-    
-    for (size_t i = 0; i < maxFramesInFlight; i++) {
-        // 创建 Buffer
-        VkBufferCreateInfo bufferInfo{};
-        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        bufferInfo.size = bufferSize;
-        bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        
-        if (vkCreateBuffer(device->getDevice(), &bufferInfo, nullptr, &uniformBuffers[i]) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to create uniform buffer!");
-        }
-        
-        // 分配内存
-        VkMemoryRequirements memRequirements;
-        vkGetBufferMemoryRequirements(device->getDevice(), uniformBuffers[i], &memRequirements);
-        
-        VkMemoryAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-        
-        if (vkAllocateMemory(device->getDevice(), &allocInfo, nullptr, &uniformBuffersMemory[i]) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to allocate uniform buffer memory!");
-        }
-        
-        vkBindBufferMemory(device->getDevice(), uniformBuffers[i], uniformBuffersMemory[i], 0);
-        
-        // 持久映射
-        vkMapMemory(device->getDevice(), uniformBuffersMemory[i], 0, bufferSize, 0, &uniformBuffersMapped[i]);
-    }
+    std::cout << "ForwardPass pipeline created (2 descriptor sets: Global + "
+              << (isBindless() ? "Bindless" : "Material") << ")" << std::endl;
 }
 
 void ForwardPass::createDescriptorPools() {
-    // ========== 全局描述符池 (UBO) ==========
+    // ========== 全局描述符池 (动态 UBO + 动态存储缓冲区) ==========
     {
-        VkDescriptorPoolSize poolSize{};
-        poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        poolSize.descriptorCount = maxFramesInFlight;
+        std::array<VkDescriptorPoolSize, 2> poolSizes{};
+        poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        poolSizes[0].descriptorCount = 1;
+        poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        poolSizes[1].descriptorCount = 1;
         
         VkDescriptorPoolCreateInfo poolInfo{};
         poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        poolInfo.poolSizeCount = 1;
-        poolInfo.pPoolSizes = &poolSize;
-        poolInfo.maxSets = maxFramesInFlight;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+        poolInfo.maxSets = 1;
         
         if (vkCreateDescriptorPool(device->getDevice(), &poolInfo, nullptr, &globalDescriptorPool) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create global descriptor pool!");
@@ -429,59 +397,76 @@ void ForwardPass::ensureMaterialPoolCapacity() {
 }
 
 void ForwardPass::createGlobalDescriptorSets() {
-    std::vector<VkDescriptorSetLayout> layouts(maxFramesInFlight, globalSetLayout);
-    
     VkDescriptorSetAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     allocInfo.descriptorPool = globalDescriptorPool;
-    allocInfo.descriptorSetCount = maxFramesInFlight;
-    allocInfo.pSetLayouts = layouts.data();
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &globalSetLayout;
     
-    globalDescriptorSets.resize(maxFramesInFlight);
-    if (vkAllocateDescriptorSets(device->getDevice(), &allocInfo, globalDescriptorSets.data()) != VK_SUCCESS) {
+    if (vkAllocateDescriptorSets(device->getDevice(), &allocInfo, &globalDescriptorSet) != VK_SUCCESS) {
         throw std::runtime_error("Failed to allocate global descriptor sets!");
     }
     
-    // 更新 UBO 绑定
-    for (size_t i = 0; i < maxFramesInFlight; i++) {
-        VkDescriptorBufferInfo bufferInfo{};
-        bufferInfo.buffer = uniformBuffers[i];
-        bufferInfo.offset = 0;
-        bufferInfo.range = sizeof(UniformBufferObject);
-        
-        VkWriteDescriptorSet descriptorWrite{};
-        descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrite.dstSet = globalDescriptorSets[i];
-        descriptorWrite.dstBinding = 0;
-        descriptorWrite.dstArrayElement = 0;
-        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        descriptorWrite.descriptorCount = 1;
-        descriptorWrite.pBufferInfo = &bufferInfo;
-        
-        vkUpdateDescriptorSets(device->getDevice(), 1, &descriptorWrite, 0, nullptr);
-    }
+    writeFrameAllocatorDescriptors();
     
-    std::cout << "Global descriptor sets created and bound to UBO" << std::endl;
+    std::cout << "Global descriptor set created and bound to frame allocator" << std::endl;
 }
 
-void ForwardPass::updateUniformBuffer(uint32_t currentFrame, const UniformBufferObject& ubo) {
-    memcpy(uniformBuffersMapped[currentFrame], &ubo, sizeof(ubo));
+void ForwardPass::writeFrameAllocatorDescriptors() {
+    // 指向 FrameAllocator 的整个缓冲区，只在创建和缓冲区重建后写入；每帧的位置由动态偏移决定。
+    // 实例数据的可见范围为一整个帧段（动态偏移为段起点）
+    const FrameAllocator& frameAllocator = device->getFrameAllocator();
+    VkDescriptorBufferInfo bufferInfo = frameAllocator.getDescriptorInfo(sizeof(UniformBufferObject));
+    VkDescriptorBufferInfo instanceInfo = frameAllocator.getDescriptorInfo(frameAllocator.getFrameSize());
+    
+    std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
+    descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[0].dstSet = globalDescriptorSet;
+    descriptorWrites[0].dstBinding = 0;
+    descriptorWrites[0].dstArrayElement = 0;
+    descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    descriptorWrites[0].descriptorCount = 1;
+    descriptorWrites[0].pBufferInfo = &bufferInfo;
+    
+    descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[1].dstSet = globalDescriptorSet;
+    descriptorWrites[1].dstBinding = 1;
+    descriptorWrites[1].dstArrayElement = 0;
+    descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    descriptorWrites[1].descriptorCount = 1;
+    descriptorWrites[1].pBufferInfo = &instanceInfo;
+    
+    vkUpdateDescriptorSets(device->getDevice(), static_cast<uint32_t>(descriptorWrites.size()),
+                           descriptorWrites.data(), 0, nullptr);
+    frameAllocatorVersion = frameAllocator.getVersion();
+}
+
+void ForwardPass::updateUniformBuffer(const UniformBufferObject& ubo) {
+    FrameAllocator& frameAllocator = device->getFrameAllocator();
+    // FrameAllocator 扩容后缓冲区已重建，重新写入指向它的描述符
+    if (frameAllocatorVersion != frameAllocator.getVersion()) {
+        writeFrameAllocatorDescriptors();
+    }
+    uniformOffset = frameAllocator.pushUniform(ubo);
+    instanceOffset = static_cast<uint32_t>(frameAllocator.getFrameOffset(frameAllocator.getCurrentFrame()));
 }
 
 // ========== 材质描述符管理 ==========
 
-ForwardPass::MaterialDescriptor* ForwardPass::allocateMaterialDescriptor(const std::string& materialId) {
+ForwardPass::MaterialDescriptor* ForwardPass::allocateMaterialDescriptor(VulkanEngine::MaterialHandle material) {
+    if (!material.isValid()) return nullptr;
+    
     // 检查是否已存在
-    auto it = materialDescriptorCache.find(materialId);
-    if (it != materialDescriptorCache.end()) {
-        return &it->second;
+    if (MaterialDescriptor* existing = getMaterialDescriptor(material)) {
+        return existing;
     }
     
     // 确保池有容量
     ensureMaterialPoolCapacity();
     
-    // 创建新的材质描述符
+    // 创建新的材质描述符（槽位被新材质复用时，旧描述符集可能仍被飞行中的帧引用，不重写，随池一起释放）
     MaterialDescriptor descriptor;
+    descriptor.material = material;
     descriptor.sets.resize(maxFramesInFlight);
     
     std::vector<VkDescriptorSetLayout> layouts(maxFramesInFlight, materialSetLayout);
@@ -493,18 +478,21 @@ ForwardPass::MaterialDescriptor* ForwardPass::allocateMaterialDescriptor(const s
     allocInfo.pSetLayouts = layouts.data();
     
     if (vkAllocateDescriptorSets(device->getDevice(), &allocInfo, descriptor.sets.data()) != VK_SUCCESS) {
-        std::cerr << "Failed to allocate material descriptor sets for: " << materialId << std::endl;
+        std::cerr << "Failed to allocate material descriptor sets for material " << material.index << std::endl;
         return nullptr;
     }
     
     allocatedMaterialSets += maxFramesInFlight;
     descriptor.valid = true;
     
-    materialDescriptorCache[materialId] = std::move(descriptor);
+    if (material.index >= materialDescriptors.size()) {
+        materialDescriptors.resize(material.index + 1);
+    }
+    materialDescriptors[material.index] = std::move(descriptor);
     
-    std::cout << "Allocated material descriptor: " << materialId << std::endl;
+    std::cout << "Allocated material descriptor: " << material.index << std::endl;
     
-    return &materialDescriptorCache[materialId];
+    return &materialDescriptors[material.index];
 }
 
 void ForwardPass::updateMaterialTextures(MaterialDescriptor* material,
@@ -514,47 +502,56 @@ void ForwardPass::updateMaterialTextures(MaterialDescriptor* material,
     if (!material || !material->valid) return;
     
     for (uint32_t i = 0; i < maxFramesInFlight; i++) {
-        std::array<VkDescriptorImageInfo, 3> imageInfos{};
-        
-        // Albedo (binding 0)
-        imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfos[0].imageView = albedoView;
-        imageInfos[0].sampler = albedoSampler;
-        
-        // Normal (binding 1)
-        imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfos[1].imageView = normalView;
-        imageInfos[1].sampler = normalSampler;
-        
-        // Specular (binding 2)
-        imageInfos[2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfos[2].imageView = specularView;
-        imageInfos[2].sampler = specularSampler;
-        
-        std::array<VkWriteDescriptorSet, 3> descriptorWrites{};
-        
-        for (int j = 0; j < 3; j++) {
-            descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[j].dstSet = material->sets[i];
-            descriptorWrites[j].dstBinding = j;
-            descriptorWrites[j].dstArrayElement = 0;
-            descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            descriptorWrites[j].descriptorCount = 1;
-            descriptorWrites[j].pImageInfo = &imageInfos[j];
-        }
-        
-        vkUpdateDescriptorSets(device->getDevice(), 
-                               static_cast<uint32_t>(descriptorWrites.size()),
-                               descriptorWrites.data(), 0, nullptr);
+        updateMaterialTextures(material, i, albedoView, albedoSampler, normalView, normalSampler,
+                               specularView, specularSampler);
     }
 }
 
-ForwardPass::MaterialDescriptor* ForwardPass::getMaterialDescriptor(const std::string& materialId) {
-    auto it = materialDescriptorCache.find(materialId);
-    if (it != materialDescriptorCache.end() && it->second.valid) {
-        return &it->second;
+void ForwardPass::updateMaterialTextures(MaterialDescriptor* material, uint32_t frameIndex,
+                                          VkImageView albedoView, VkSampler albedoSampler,
+                                          VkImageView normalView, VkSampler normalSampler,
+                                          VkImageView specularView, VkSampler specularSampler) {
+    if (!material || !material->valid || frameIndex >= material->sets.size()) return;
+    
+    std::array<VkDescriptorImageInfo, 3> imageInfos{};
+    
+    // Albedo (binding 0)
+    imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfos[0].imageView = albedoView;
+    imageInfos[0].sampler = albedoSampler;
+    
+    // Normal (binding 1)
+    imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfos[1].imageView = normalView;
+    imageInfos[1].sampler = normalSampler;
+    
+    // Specular (binding 2)
+    imageInfos[2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfos[2].imageView = specularView;
+    imageInfos[2].sampler = specularSampler;
+    
+    std::array<VkWriteDescriptorSet, 3> descriptorWrites{};
+    
+    for (int j = 0; j < 3; j++) {
+        descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[j].dstSet = material->sets[frameIndex];
+        descriptorWrites[j].dstBinding = j;
+        descriptorWrites[j].dstArrayElement = 0;
+        descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptorWrites[j].descriptorCount = 1;
+        descriptorWrites[j].pImageInfo = &imageInfos[j];
     }
-    return nullptr;
+    
+    vkUpdateDescriptorSets(device->getDevice(), 
+                           static_cast<uint32_t>(descriptorWrites.size()),
+                           descriptorWrites.data(), 0, nullptr);
+}
+
+ForwardPass::MaterialDescriptor* ForwardPass::getMaterialDescriptor(VulkanEngine::MaterialHandle material) {
+    if (material.index >= materialDescriptors.size()) return nullptr;
+    
+    MaterialDescriptor& descriptor = materialDescriptors[material.index];
+    return descriptor.valid && descriptor.material == material ? &descriptor : nullptr;
 }
 
 // ========== 渲染命令 ==========
@@ -580,9 +577,16 @@ void ForwardPass::bindPipeline(VkCommandBuffer cmd) {
     vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
 }
 
-void ForwardPass::bindGlobalDescriptorSet(VkCommandBuffer cmd, uint32_t frameIndex) {
+void ForwardPass::bindPipeline(VkCommandBuffer cmd, VertexFormat format) {
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                      format == VertexFormat::Compact ? compactPipeline : pipeline);
+}
+
+void ForwardPass::bindGlobalDescriptorSet(VkCommandBuffer cmd) {
+    // 动态偏移按绑定号顺序：binding 0 为 UBO，binding 1 为实例数据
+    const uint32_t dynamicOffsets[] = { uniformOffset, instanceOffset };
     vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
-                            0, 1, &globalDescriptorSets[frameIndex], 0, nullptr);
+                            0, 1, &globalDescriptorSet, 2, dynamicOffsets);
 }
 
 void ForwardPass::bindMaterialDescriptorSet(VkCommandBuffer cmd, uint32_t frameIndex, MaterialDescriptor* material) {
@@ -592,23 +596,35 @@ void ForwardPass::bindMaterialDescriptorSet(VkCommandBuffer cmd, uint32_t frameI
                             1, 1, &material->sets[frameIndex], 0, nullptr);
 }
 
-void ForwardPass::pushModelMatrix(VkCommandBuffer cmd, const glm::mat4& model) {
-    PushConstantData pushData{};
-    pushData.model = model;
-    pushData.normalMatrix = glm::transpose(glm::inverse(model));
+void ForwardPass::bindBindlessDescriptorSet(VkCommandBuffer cmd, VkDescriptorSet descriptorSet) {
+    if (!isBindless()) return;
     
-    vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 
-                       0, sizeof(PushConstantData), &pushData);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
+                            1, 1, &descriptorSet, 0, nullptr);
 }
 
-void ForwardPass::drawMesh(VkCommandBuffer cmd, VkBuffer vertexBuffer, VkBuffer indexBuffer, uint32_t indexCount) {
-    if (vertexBuffer == VK_NULL_HANDLE || indexBuffer == VK_NULL_HANDLE) return;
+void ForwardPass::pushMaterialIndex(VkCommandBuffer cmd, uint32_t materialIndex) {
+    if (!isBindless()) return;
     
+    PushConstantData pushData{};
+    pushData.materialIndex = materialIndex;
+    vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT,
+                       0, sizeof(PushConstantData), &pushData);
+}
+
+void ForwardPass::bindVertexBuffer(VkCommandBuffer cmd, VkBuffer vertexBuffer) {
     VkBuffer vertexBuffers[] = { vertexBuffer };
     VkDeviceSize offsets[] = { 0 };
     vkCmdBindVertexBuffers(cmd, 0, 1, vertexBuffers, offsets);
+}
+
+void ForwardPass::bindIndexBuffer(VkCommandBuffer cmd, VkBuffer indexBuffer) {
     vkCmdBindIndexBuffer(cmd, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
-    vkCmdDrawIndexed(cmd, indexCount, 1, 0, 0, 0);
+}
+
+void ForwardPass::drawIndexed(VkCommandBuffer cmd, uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset,
+                              uint32_t instanceCount, uint32_t firstInstance) {
+    vkCmdDrawIndexed(cmd, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
 
 VkShaderModule ForwardPass::createShaderModule(const std::vector<char>& code) {
@@ -641,17 +657,3 @@ std::vector<char> ForwardPass::readFile(const std::string& filename) {
     
     return buffer;
 }
-
-uint32_t ForwardPass::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-    VkPhysicalDeviceMemoryProperties memProperties;
-    vkGetPhysicalDeviceMemoryProperties(device->getPhysicalDevice(), &memProperties);
-    
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((typeFilter & (1 << i)) && 
-            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-            return i;
-        }
-    }
-    
-    throw std::runtime_error("Failed to find suitable memory type!");
-}
\ No newline at end of file
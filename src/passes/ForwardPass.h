@@ -2,6 +2,8 @@
 
 #include "RenderPassBase.h"
 #include "RenderContext.h"
+#include "../core/VulkanAllocator.h"
+#include "../resources/ResourceHandle.h"
 #include <vulkan/vulkan.h>
 #include <glm/glm.hpp>
 #include <memory>
@@ -14,20 +16,31 @@ class VulkanDevice;
 class Mesh;
 class Material;
 class VulkanTexture;
+enum class VertexFormat : uint32_t;
 
 /**
  * ForwardPass - 前向渲染通道
  * 
  * 使用两个描述符集布局：
- * - Set 0: 全局 UBO（view, proj, light）
+ * - Set 0: 全局 UBO（view, proj, light）- 动态 UBO，数据每帧写入 FrameAllocator，绑定时传入动态偏移
+ *          逐实例数据（model, normalMatrix）- 动态存储缓冲区，动态偏移为本帧段起点，
+ *          实例化绘制的 firstInstance 为实例在本帧段中的下标
  * - Set 1: 材质纹理（albedo, normal, specular）- 每个材质独立
+ * 
+ * Bindless 模式（构造时传入 BindlessDescriptors 的布局）：Set 1 为所有材质共用的纹理数组和
+ * 材质参数缓冲区，每个 Pass 只绑定一次，按材质通过 push constant 传递材质索引
  */
 class ForwardPass : public RenderPassBase {
 public:
-    // Push Constants 结构体 - 每个物体独立的变换数据
-    struct PushConstantData {
+    // 逐实例数据（与 pbr.vert 的 InstanceData 一致，std430）
+    struct InstanceData {
         alignas(16) glm::mat4 model;
-        alignas(16) glm::mat4 normalMatrix;
+        alignas(16) glm::mat4 normalMatrix;  // 着色器只使用左上 3x3
+    };
+    
+    // Push Constants 结构体 - bindless 材质索引（片段着色器）
+    struct PushConstantData {
+        uint32_t materialIndex;
     };
     
     // UBO 结构体 - 全局共享数据（相机、光照）
@@ -42,13 +55,15 @@ public:
     // 材质描述符数据 - 每个材质独立
     struct MaterialDescriptor {
         std::vector<VkDescriptorSet> sets;  // 每帧一个描述符集
+        VulkanEngine::MaterialHandle material;
         bool valid = false;
+        std::vector<uint64_t> textureVersions;  // 每帧描述符集写入时的纹理资源版本（见 VulkanTexture::getResidencyVersion）
     };
 
     ForwardPass(std::shared_ptr<VulkanDevice> device, 
                 VkRenderPass renderPass,
                 uint32_t width, uint32_t height,
-                uint32_t maxFramesInFlight = 2);
+                VkDescriptorSetLayout bindlessSetLayout = VK_NULL_HANDLE);
     ~ForwardPass();
 
     // 禁止拷贝
@@ -60,79 +75,95 @@ public:
 
     // 获取器
     VkPipeline getPipeline() const { return pipeline; }
+    VkPipeline getCompactPipeline() const { return compactPipeline; }
     VkPipelineLayout getPipelineLayout() const { return pipelineLayout; }
     VkDescriptorSetLayout getGlobalSetLayout() const { return globalSetLayout; }
     VkDescriptorSetLayout getMaterialSetLayout() const { return materialSetLayout; }
-    
-    // 获取 Uniform Buffers（供 GBuffer 等其他 Pass 共享使用）
-    const std::vector<VkBuffer>& getUniformBuffers() const { return uniformBuffers; }
-    VkDeviceSize getUniformBufferSize() const { return sizeof(UniformBufferObject); }
+    bool isBindless() const { return bindlessSetLayout != VK_NULL_HANDLE; }
 
-    // 更新全局 UBO
-    void updateUniformBuffer(uint32_t currentFrame, const UniformBufferObject& ubo);
+
+    // 更新全局 UBO：写入本帧的 FrameAllocator 段，记录动态偏移（每帧录制前调用）
+    void updateUniformBuffer(const UniformBufferObject& ubo);
 
     // ========== 材质描述符管理 ==========
     
-    // 为材质分配独立的描述符集
-    MaterialDescriptor* allocateMaterialDescriptor(const std::string& materialId);
+    // 为材质分配独立的描述符集（按 MaterialHandle::index 存放）
+    MaterialDescriptor* allocateMaterialDescriptor(VulkanEngine::MaterialHandle material);
     
     // 更新材质的纹理绑定
     void updateMaterialTextures(MaterialDescriptor* material,
                                 VkImageView albedoView, VkSampler albedoSampler,
                                 VkImageView normalView, VkSampler normalSampler,
                                 VkImageView specularView, VkSampler specularSampler);
+    // 只重写指定帧的描述符集（该帧的命令缓冲区已执行完毕、尚未绑定该集时调用）
+    void updateMaterialTextures(MaterialDescriptor* material, uint32_t frameIndex,
+                                VkImageView albedoView, VkSampler albedoSampler,
+                                VkImageView normalView, VkSampler normalSampler,
+                                VkImageView specularView, VkSampler specularSampler);
     
-    // 获取已分配的材质描述符
-    MaterialDescriptor* getMaterialDescriptor(const std::string& materialId);
+    // 获取已分配的材质描述符：按句柄直接索引，未分配或句柄已失效时返回 nullptr
+    MaterialDescriptor* getMaterialDescriptor(VulkanEngine::MaterialHandle material);
 
     // ========== 渲染命令 ==========
     
     void begin(VkCommandBuffer cmd);
     void bindPipeline(VkCommandBuffer cmd);
     
-    // 绑定全局描述符集 (Set 0)
-    void bindGlobalDescriptorSet(VkCommandBuffer cmd, uint32_t frameIndex);
+    // 按顶点格式绑定管线（两条管线共用同一布局，已绑定的描述符集保持有效）
+    void bindPipeline(VkCommandBuffer cmd, VertexFormat format);
+    
+    // 绑定全局描述符集 (Set 0)，使用本帧 UBO 和实例数据的动态偏移
+    void bindGlobalDescriptorSet(VkCommandBuffer cmd);
     
     // 绑定材质描述符集 (Set 1)
     void bindMaterialDescriptorSet(VkCommandBuffer cmd, uint32_t frameIndex, MaterialDescriptor* material);
     
-    // Push Constants - 推送每个物体的变换矩阵
-    void pushModelMatrix(VkCommandBuffer cmd, const glm::mat4& model);
+    // Bindless 模式：绑定共用的纹理数组和材质参数 (Set 1)，整个 Pass 只需一次
+    void bindBindlessDescriptorSet(VkCommandBuffer cmd, VkDescriptorSet descriptorSet);
+    
+    // Push Constants - bindless 模式下推送材质索引（材质切换时调用）
+    void pushMaterialIndex(VkCommandBuffer cmd, uint32_t materialIndex);
     
-    // 绘制网格
-    void drawMesh(VkCommandBuffer cmd, VkBuffer vertexBuffer, VkBuffer indexBuffer, uint32_t indexCount);
+    // 绑定共享几何缓冲区的页（顶点 / 索引分别只在页切换时调用），按区间绘制：
+    // firstIndex / vertexOffset 为网格在共享缓冲区中的位置加上网格内的索引区间，
+    // firstInstance 为第一个实例在本帧实例数据中的下标
+    void bindVertexBuffer(VkCommandBuffer cmd, VkBuffer vertexBuffer);
+    void bindIndexBuffer(VkCommandBuffer cmd, VkBuffer indexBuffer);
+    void drawIndexed(VkCommandBuffer cmd, uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset,
+                     uint32_t instanceCount, uint32_t firstInstance);
 
 private:
     void createDescriptorSetLayouts();
     void createPipeline();
-    void createUniformBuffers();
     void createDescriptorPools();
     void createGlobalDescriptorSets();
+    void writeFrameAllocatorDescriptors();
     void cleanup();
     void ensureMaterialPoolCapacity();
 
     VkShaderModule createShaderModule(const std::vector<char>& code);
     std::vector<char> readFile(const std::string& filename);
-    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 
     std::shared_ptr<VulkanDevice> device;
     VkRenderPass renderPass;
     
     uint32_t width;
     uint32_t height;
-    uint32_t maxFramesInFlight;
+    uint32_t maxFramesInFlight;   // 材质描述符集按帧分配（见 FrameAllocator::getFrameCount）
 
     // Pipeline
     VkPipeline pipeline = VK_NULL_HANDLE;
+    VkPipeline compactPipeline = VK_NULL_HANDLE;  // CompactVertex 输入
     VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
     
     // 两个描述符集布局
-    VkDescriptorSetLayout globalSetLayout = VK_NULL_HANDLE;    // Set 0: UBO
+    VkDescriptorSetLayout globalSetLayout = VK_NULL_HANDLE;    // Set 0: UBO + 实例数据
     VkDescriptorSetLayout materialSetLayout = VK_NULL_HANDLE;  // Set 1: 纹理
+    VkDescriptorSetLayout bindlessSetLayout = VK_NULL_HANDLE;  // Set 1（bindless 模式，不归本 Pass 所有）
 
-    // 全局描述符池和描述符集
+    // 全局描述符池和描述符集（动态 UBO，所有帧共用一个）
     VkDescriptorPool globalDescriptorPool = VK_NULL_HANDLE;
-    std::vector<VkDescriptorSet> globalDescriptorSets;  // 每帧一个
+    VkDescriptorSet globalDescriptorSet = VK_NULL_HANDLE;
 
     // 材质描述符池（可动态增长）
     std::vector<VkDescriptorPool> materialDescriptorPools;
@@ -140,11 +171,11 @@ private:
     uint32_t allocatedMaterialSets = 0;
     static constexpr uint32_t MATERIALS_PER_POOL = 64;
     
-    // 材质描述符缓存
-    std::unordered_map<std::string, MaterialDescriptor> materialDescriptorCache;
+    // 材质描述符表（下标为 MaterialHandle::index）
+    std::vector<MaterialDescriptor> materialDescriptors;
 
-    // Uniform Buffers
-    std::vector<VkBuffer> uniformBuffers;
-    std::vector<VkDeviceMemory> uniformBuffersMemory;
-    std::vector<void*> uniformBuffersMapped;
+    // 本帧全局 UBO 在 FrameAllocator 中的动态偏移，以及本帧段的起点（实例数据的动态偏移）
+    uint32_t uniformOffset = 0;
+    uint32_t instanceOffset = 0;
+    uint32_t frameAllocatorVersion = 0;   // 全局描述符集写入时的 FrameAllocator 版本
 };
@@ -1,14 +1,19 @@
 #include "GBufferPass.h"
 #include "../core/VulkanDevice.h"
+#include "../core/FrameAllocator.h"
+#include "../resources/Vertex.h"
 #include <stdexcept>
 #include <iostream>
 #include <fstream>
 
-GBufferPass::GBufferPass(std::shared_ptr<VulkanDevice> device, uint32_t width, uint32_t height)
+GBufferPass::GBufferPass(std::shared_ptr<VulkanDevice> device, uint32_t width, uint32_t height,
+                         VkDescriptorSetLayout bindlessSetLayout)
     : RenderPassBase(device, width, height)
     , device(device)
     , width(width)
-    , height(height) {
+    , height(height)
+    , bindlessSetLayout(bindlessSetLayout)
+    , frameCount(device->getFrameAllocator().getFrameCount()) {
     
     passName = "GBuffer Pass";
     
@@ -49,29 +54,15 @@ void GBufferPass::resize(uint32_t newWidth, uint32_t newHeight) {
 void GBufferPass::cleanup() {
     VkDevice dev = device->getDevice();
     
-    // 销毁 Uniform Buffers
-    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        if (uniformBuffers[i] != VK_NULL_HANDLE) {
-            vkDestroyBuffer(dev, uniformBuffers[i], nullptr);
-            uniformBuffers[i] = VK_NULL_HANDLE;
-        }
-        if (uniformBuffersMemory[i] != VK_NULL_HANDLE) {
-            vkFreeMemory(dev, uniformBuffersMemory[i], nullptr);
-            uniformBuffersMemory[i] = VK_NULL_HANDLE;
-        }
-        uniformBuffersMapped[i] = nullptr;
-    }
-    
     // 清空材质描述符缓存
-    materialDescriptorCache.clear();
+    materialDescriptors.clear();
+    bumpResourceGeneration();
     
     // 销毁描述符池（描述符集会自动释放）
     if (descriptorPool != VK_NULL_HANDLE) {
         vkDestroyDescriptorPool(dev, descriptorPool, nullptr);
         descriptorPool = VK_NULL_HANDLE;
-        for (auto& ds : globalDescriptorSets) {
-            ds = VK_NULL_HANDLE;
-        }
+        globalDescriptorSet = VK_NULL_HANDLE;
     }
     
     // 销毁 Pipeline
@@ -80,6 +71,11 @@ void GBufferPass::cleanup() {
         pipeline = VK_NULL_HANDLE;
     }
     
+    if (compactPipeline != VK_NULL_HANDLE) {
+        vkDestroyPipeline(dev, compactPipeline, nullptr);
+        compactPipeline = VK_NULL_HANDLE;
+    }
+    
     if (pipelineLayout != VK_NULL_HANDLE) {
         vkDestroyPipelineLayout(dev, pipelineLayout, nullptr);
         pipelineLayout = VK_NULL_HANDLE;
@@ -115,14 +111,7 @@ void GBufferPass::cleanup() {
             vkDestroyImageView(dev, attachmentViews[i], nullptr);
             attachmentViews[i] = VK_NULL_HANDLE;
         }
-        if (attachmentImages[i] != VK_NULL_HANDLE) {
-            vkDestroyImage(dev, attachmentImages[i], nullptr);
-            attachmentImages[i] = VK_NULL_HANDLE;
-        }
-        if (attachmentMemories[i] != VK_NULL_HANDLE) {
-            vkFreeMemory(dev, attachmentMemories[i], nullptr);
-            attachmentMemories[i] = VK_NULL_HANDLE;
-        }
+        device->destroyImage(attachmentImages[i], attachmentAllocations[i]);
     }
 }
 
@@ -172,21 +161,10 @@ void GBufferPass::createImage(VkFormat format, VkImageUsageFlags usage,
         throw std::runtime_error("Failed to create GBuffer image!");
     }
     
-    // 分配内存
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(dev, attachmentImages[index], &memRequirements);
-    
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
-                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    
-    if (vkAllocateMemory(dev, &allocInfo, nullptr, &attachmentMemories[index]) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to allocate GBuffer image memory!");
-    }
-    
-    vkBindImageMemory(dev, attachmentImages[index], attachmentMemories[index], 0);
+    // 分配并绑定内存（设备子分配器）
+    attachmentAllocations[index] = device->getAllocator().allocateImage(attachmentImages[index],
+                                                                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                                        VulkanMemoryCategory::GBuffer);
     
     // 创建图像视图
     VkImageViewCreateInfo viewInfo{};
@@ -405,20 +383,6 @@ std::array<VkClearValue, 4> GBufferPass::getClearValues() const {
     return clearValues;
 }
 
-uint32_t GBufferPass::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-    VkPhysicalDeviceMemoryProperties memProperties;
-    vkGetPhysicalDeviceMemoryProperties(device->getPhysicalDevice(), &memProperties);
-    
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((typeFilter & (1 << i)) && 
-            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-            return i;
-        }
-    }
-    
-    throw std::runtime_error("Failed to find suitable memory type!");
-}
-
 // ============================================
 // G-Buffer Pipeline 创建
 // ============================================
@@ -426,19 +390,28 @@ uint32_t GBufferPass::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags
 void GBufferPass::createDescriptorSetLayout() {
     VkDevice dev = device->getDevice();
     
-    // ========== Set 0: 全局 UBO ==========
+    // ========== Set 0: 全局 UBO + 逐实例数据 ==========
     {
-        VkDescriptorSetLayoutBinding uboBinding{};
-        uboBinding.binding = 0;
-        uboBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        uboBinding.descriptorCount = 1;
-        uboBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-        uboBinding.pImmutableSamplers = nullptr;
+        std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+        
+        // binding 0: 全局 UBO
+        bindings[0].binding = 0;
+        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        bindings[0].descriptorCount = 1;
+        bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        bindings[0].pImmutableSamplers = nullptr;
+        
+        // binding 1: 实例数据（model, normalMatrix）
+        bindings[1].binding = 1;
+        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        bindings[1].descriptorCount = 1;
+        bindings[1].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        bindings[1].pImmutableSamplers = nullptr;
         
         VkDescriptorSetLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        layoutInfo.bindingCount = 1;
-        layoutInfo.pBindings = &uboBinding;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
         
         if (vkCreateDescriptorSetLayout(dev, &layoutInfo, nullptr, &globalSetLayout) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create GBuffer global descriptor set layout!");
@@ -488,7 +461,7 @@ void GBufferPass::createPipeline() {
     
     // 读取着色器
     auto vertShaderCode = readFile("shaders/gbuffer_vert.spv");
-    auto fragShaderCode = readFile("shaders/gbuffer_frag.spv");
+    auto fragShaderCode = readFile(isBindless() ? "shaders/gbuffer_bindless_frag.spv" : "shaders/gbuffer_frag.spv");
     
     VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
     VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
@@ -508,37 +481,9 @@ void GBufferPass::createPipeline() {
     
     VkPipelineShaderStageCreateInfo shaderStages[] = { vertShaderStageInfo, fragShaderStageInfo };
     
-    // 顶点输入
-    VkVertexInputBindingDescription bindingDescription{};
-    bindingDescription.binding = 0;
-    bindingDescription.stride = sizeof(float) * 11; // pos(3) + normal(3) + texCoord(2) + tangent(3)
-    bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-    
-    std::array<VkVertexInputAttributeDescription, 4> attributeDescriptions{};
-    
-    // Position
-    attributeDescriptions[0].binding = 0;
-    attributeDescriptions[0].location = 0;
-    attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-    attributeDescriptions[0].offset = 0;
-    
-    // Normal
-    attributeDescriptions[1].binding = 0;
-    attributeDescriptions[1].location = 1;
-    attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
-    attributeDescriptions[1].offset = sizeof(float) * 3;
-    
-    // TexCoord
-    attributeDescriptions[2].binding = 0;
-    attributeDescriptions[2].location = 2;
-    attributeDescriptions[2].format = VK_FORMAT_R32G32_SFLOAT;
-    attributeDescriptions[2].offset = sizeof(float) * 6;
-    
-    // Tangent
-    attributeDescriptions[3].binding = 0;
-    attributeDescriptions[3].location = 3;
-    attributeDescriptions[3].format = VK_FORMAT_R32G32B32_SFLOAT;
-    attributeDescriptions[3].offset = sizeof(float) * 8;
+    // 顶点输入 - 与 Vertex 结构体匹配
+    auto bindingDescription = Vertex::getBindingDescription();
+    auto attributeDescriptions = Vertex::getAttributeDescriptions();
     
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
@@ -610,21 +555,23 @@ void GBufferPass::createPipeline() {
     dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
     dynamicState.pDynamicStates = dynamicStates.data();
     
-    // Push Constants 配置
+    // Push Constants 配置（只有 bindless 片段着色器读取材质索引，变换矩阵在实例数据中）
     VkPushConstantRange pushConstantRange{};
-    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
     pushConstantRange.offset = 0;
-    pushConstantRange.size = sizeof(PushConstantData);  // 2 个 mat4 = 128 bytes
+    pushConstantRange.size = sizeof(PushConstantData);
     
     // Pipeline 布局 - 使用双描述符集
-    std::array<VkDescriptorSetLayout, 2> setLayouts = { globalSetLayout, materialSetLayout };
+    std::array<VkDescriptorSetLayout, 2> setLayouts = {
+        globalSetLayout, isBindless() ? bindlessSetLayout : materialSetLayout
+    };
     
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
     pipelineLayoutInfo.pSetLayouts = setLayouts.data();
-    pipelineLayoutInfo.pushConstantRangeCount = 1;
-    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+    pipelineLayoutInfo.pushConstantRangeCount = isBindless() ? 1 : 0;
+    pipelineLayoutInfo.pPushConstantRanges = isBindless() ? &pushConstantRange : nullptr;
     
     if (vkCreatePipelineLayout(dev, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create GBuffer pipeline layout!");
@@ -651,6 +598,30 @@ void GBufferPass::createPipeline() {
         throw std::runtime_error("Failed to create GBuffer graphics pipeline!");
     }
     
+    // 紧凑顶点格式管线：相同布局，顶点输入改为 CompactVertex，着色器通过特化常量切换解码
+    auto compactBinding = CompactVertex::getBindingDescription();
+    auto compactAttributes = CompactVertex::getAttributeDescriptions();
+    vertexInputInfo.pVertexBindingDescriptions = &compactBinding;
+    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(compactAttributes.size());
+    vertexInputInfo.pVertexAttributeDescriptions = compactAttributes.data();
+    
+    VkBool32 compactVertex = VK_TRUE;
+    VkSpecializationMapEntry specEntry{};
+    specEntry.constantID = 0;
+    specEntry.offset = 0;
+    specEntry.size = sizeof(VkBool32);
+    
+    VkSpecializationInfo specInfo{};
+    specInfo.mapEntryCount = 1;
+    specInfo.pMapEntries = &specEntry;
+    specInfo.dataSize = sizeof(VkBool32);
+    specInfo.pData = &compactVertex;
+    shaderStages[0].pSpecializationInfo = &specInfo;
+    
+    if (vkCreateGraphicsPipelines(dev, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &compactPipeline) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create GBuffer compact vertex pipeline!");
+    }
+    
     // 销毁着色器模块
     vkDestroyShaderModule(dev, fragShaderModule, nullptr);
     vkDestroyShaderModule(dev, vertShaderModule, nullptr);
@@ -708,11 +679,7 @@ void GBufferPass::recordCommands(VkCommandBuffer cmd, const RenderContext& conte
     vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
     
     // 绑定描述符集（如果已设置�?
-    if (currentDescriptorSet != VK_NULL_HANDLE) {
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, 
-                               pipelineLayout, 0, 1, 
-                               &currentDescriptorSet, 0, nullptr);
-    }
+    bindGlobalDescriptorSet(cmd);
     
     // 绑定顶点和索引缓冲并绘制
     if (context.sceneVertexBuffer != VK_NULL_HANDLE && 
@@ -734,119 +701,92 @@ void GBufferPass::recordCommands(VkCommandBuffer cmd, const RenderContext& conte
 // 描述符集创建和更�?
 // ============================================
 
-void GBufferPass::createUniformBuffers() {
-    VkDevice dev = device->getDevice();
-    VkDeviceSize bufferSize = sizeof(UniformBufferObject);
-    
-    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        // 创建 Buffer
-        VkBufferCreateInfo bufferInfo{};
-        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        bufferInfo.size = bufferSize;
-        bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        
-        if (vkCreateBuffer(dev, &bufferInfo, nullptr, &uniformBuffers[i]) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to create GBuffer uniform buffer!");
-        }
-        
-        // 分配内存
-        VkMemoryRequirements memRequirements;
-        vkGetBufferMemoryRequirements(dev, uniformBuffers[i], &memRequirements);
-        
-        VkMemoryAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-        
-        if (vkAllocateMemory(dev, &allocInfo, nullptr, &uniformBuffersMemory[i]) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to allocate GBuffer uniform buffer memory!");
-        }
-        
-        vkBindBufferMemory(dev, uniformBuffers[i], uniformBuffersMemory[i], 0);
-        
-        // 映射内存
-        vkMapMemory(dev, uniformBuffersMemory[i], 0, bufferSize, 0, &uniformBuffersMapped[i]);
-    }
-    
-    std::cout << "GBuffer uniform buffers created" << std::endl;
-}
-
 void GBufferPass::createDescriptorSets() {
     VkDevice dev = device->getDevice();
     
-    // 先创建 Uniform Buffers
-    createUniformBuffers();
-    
     // 如果已存在描述符池，先销毁
     if (descriptorPool != VK_NULL_HANDLE) {
         vkDestroyDescriptorPool(dev, descriptorPool, nullptr);
         descriptorPool = VK_NULL_HANDLE;
-        for (auto& ds : globalDescriptorSets) {
-            ds = VK_NULL_HANDLE;
-        }
-        materialDescriptorCache.clear();
+        globalDescriptorSet = VK_NULL_HANDLE;
+        materialDescriptors.clear();
+        bumpResourceGeneration();
     }
     
     // 创建描述符池
-    // Set 0: MAX_FRAMES_IN_FLIGHT 个 UBO 描述符集
-    // Set 1: 每个材质需要 MAX_FRAMES_IN_FLIGHT 个描述符集，每个有 3 个纹理
-    std::array<VkDescriptorPoolSize, 2> poolSizes{};
-    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSizes[0].descriptorCount = MAX_FRAMES_IN_FLIGHT;
-    poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[1].descriptorCount = MAX_MATERIALS * MAX_FRAMES_IN_FLIGHT * 3; // 每材质3个纹理
+    // Set 0: 1 个描述符集（动态 UBO + 动态存储缓冲区，所有帧共用）
+    // Set 1: 每个材质需要 frameCount 个描述符集，每个有 3 个纹理
+    std::array<VkDescriptorPoolSize, 3> poolSizes{};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSizes[0].descriptorCount = 1;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    poolSizes[1].descriptorCount = 1;
+    poolSizes[2].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSizes[2].descriptorCount = MAX_MATERIALS * frameCount * 3; // 每材质3个纹理
     
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
     poolInfo.pPoolSizes = poolSizes.data();
-    poolInfo.maxSets = MAX_FRAMES_IN_FLIGHT + MAX_MATERIALS * MAX_FRAMES_IN_FLIGHT;
+    poolInfo.maxSets = 1 + MAX_MATERIALS * frameCount;
     
     if (vkCreateDescriptorPool(dev, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create GBuffer descriptor pool!");
     }
     
     // ========== 分配全局描述符集 (Set 0) ==========
-    std::vector<VkDescriptorSetLayout> globalLayouts(MAX_FRAMES_IN_FLIGHT, globalSetLayout);
-    
     VkDescriptorSetAllocateInfo globalAllocInfo{};
     globalAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     globalAllocInfo.descriptorPool = descriptorPool;
-    globalAllocInfo.descriptorSetCount = MAX_FRAMES_IN_FLIGHT;
-    globalAllocInfo.pSetLayouts = globalLayouts.data();
+    globalAllocInfo.descriptorSetCount = 1;
+    globalAllocInfo.pSetLayouts = &globalSetLayout;
     
-    if (vkAllocateDescriptorSets(dev, &globalAllocInfo, globalDescriptorSets.data()) != VK_SUCCESS) {
+    if (vkAllocateDescriptorSets(dev, &globalAllocInfo, &globalDescriptorSet) != VK_SUCCESS) {
         throw std::runtime_error("Failed to allocate GBuffer global descriptor sets!");
     }
     
-    // 更新全局描述符集 - 绑定 UBO
-    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        VkDescriptorBufferInfo bufferInfo{};
-        bufferInfo.buffer = uniformBuffers[i];
-        bufferInfo.offset = 0;
-        bufferInfo.range = sizeof(UniformBufferObject);
-        
-        VkWriteDescriptorSet descriptorWrite{};
-        descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrite.dstSet = globalDescriptorSets[i];
-        descriptorWrite.dstBinding = 0;
-        descriptorWrite.dstArrayElement = 0;
-        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        descriptorWrite.descriptorCount = 1;
-        descriptorWrite.pBufferInfo = &bufferInfo;
-        
-        vkUpdateDescriptorSets(dev, 1, &descriptorWrite, 0, nullptr);
-    }
+    writeFrameAllocatorDescriptors();
     
-    std::cout << "GBuffer global descriptor sets created and UBO bound" << std::endl;
+    std::cout << "GBuffer global descriptor set created and bound to frame allocator" << std::endl;
+}
+
+void GBufferPass::writeFrameAllocatorDescriptors() {
+    // 绑定 FrameAllocator 的缓冲区（只在创建和缓冲区重建后写入，每帧的位置由动态偏移决定），
+    // 实例数据的可见范围为一整个帧段（动态偏移为段起点）
+    VkDevice dev = device->getDevice();
+    const FrameAllocator& frameAllocator = device->getFrameAllocator();
+    VkDescriptorBufferInfo bufferInfo = frameAllocator.getDescriptorInfo(sizeof(UniformBufferObject));
+    VkDescriptorBufferInfo instanceInfo = frameAllocator.getDescriptorInfo(frameAllocator.getFrameSize());
+    
+    std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
+    descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[0].dstSet = globalDescriptorSet;
+    descriptorWrites[0].dstBinding = 0;
+    descriptorWrites[0].dstArrayElement = 0;
+    descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    descriptorWrites[0].descriptorCount = 1;
+    descriptorWrites[0].pBufferInfo = &bufferInfo;
+    
+    descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[1].dstSet = globalDescriptorSet;
+    descriptorWrites[1].dstBinding = 1;
+    descriptorWrites[1].dstArrayElement = 0;
+    descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    descriptorWrites[1].descriptorCount = 1;
+    descriptorWrites[1].pBufferInfo = &instanceInfo;
+    
+    vkUpdateDescriptorSets(dev, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+    frameAllocatorVersion = frameAllocator.getVersion();
 }
 
-void GBufferPass::updateUniformBuffer(uint32_t frameIndex, const UniformBufferObject& ubo) {
-    if (frameIndex < MAX_FRAMES_IN_FLIGHT && uniformBuffersMapped[frameIndex] != nullptr) {
-        memcpy(uniformBuffersMapped[frameIndex], &ubo, sizeof(ubo));
+void GBufferPass::updateUniformBuffer(const UniformBufferObject& ubo) {
+    FrameAllocator& frameAllocator = device->getFrameAllocator();
+    // FrameAllocator 扩容后缓冲区已重建，重新写入指向它的描述符
+    if (frameAllocatorVersion != frameAllocator.getVersion()) {
+        writeFrameAllocatorDescriptors();
     }
+    uniformOffset = frameAllocator.pushUniform(ubo);
+    instanceOffset = static_cast<uint32_t>(frameAllocator.getFrameOffset(frameAllocator.getCurrentFrame()));
 }
 
 // ============================================
@@ -857,20 +797,32 @@ void GBufferPass::bindPipeline(VkCommandBuffer cmd) const {
     vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
 }
 
-void GBufferPass::drawMesh(VkCommandBuffer cmd, VkBuffer vertexBuffer, VkBuffer indexBuffer, uint32_t indexCount) const {
+void GBufferPass::bindPipeline(VkCommandBuffer cmd, VertexFormat format) const {
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                      format == VertexFormat::Compact ? compactPipeline : pipeline);
+}
+
+void GBufferPass::bindVertexBuffer(VkCommandBuffer cmd, VkBuffer vertexBuffer) const {
     VkBuffer vertexBuffers[] = { vertexBuffer };
     VkDeviceSize offsets[] = { 0 };
     vkCmdBindVertexBuffers(cmd, 0, 1, vertexBuffers, offsets);
+}
+
+void GBufferPass::bindIndexBuffer(VkCommandBuffer cmd, VkBuffer indexBuffer) const {
     vkCmdBindIndexBuffer(cmd, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
-    vkCmdDrawIndexed(cmd, indexCount, 1, 0, 0, 0);
 }
 
-void GBufferPass::pushModelMatrix(VkCommandBuffer cmd, const glm::mat4& model) {
-    PushConstantData pushData{};
-    pushData.model = model;
-    pushData.normalMatrix = glm::transpose(glm::inverse(model));
+void GBufferPass::drawIndexed(VkCommandBuffer cmd, uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset,
+                              uint32_t instanceCount, uint32_t firstInstance) const {
+    vkCmdDrawIndexed(cmd, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+}
+
+void GBufferPass::pushMaterialIndex(VkCommandBuffer cmd, uint32_t materialIndex) const {
+    if (!isBindless()) return;
     
-    vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 
+    PushConstantData pushData{};
+    pushData.materialIndex = materialIndex;
+    vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT,
                        0, sizeof(PushConstantData), &pushData);
 }
 
@@ -878,11 +830,12 @@ void GBufferPass::pushModelMatrix(VkCommandBuffer cmd, const glm::mat4& model) {
 // 材质描述符管理
 // ============================================
 
-GBufferPass::MaterialDescriptor* GBufferPass::allocateMaterialDescriptor(const std::string& materialId) {
+GBufferPass::MaterialDescriptor* GBufferPass::allocateMaterialDescriptor(VulkanEngine::MaterialHandle material) {
+    if (!material.isValid()) return nullptr;
+    
     // 检查是否已存在
-    auto it = materialDescriptorCache.find(materialId);
-    if (it != materialDescriptorCache.end()) {
-        return &it->second;
+    if (MaterialDescriptor* existing = getMaterialDescriptor(material)) {
+        return existing;
     }
     
     if (descriptorPool == VK_NULL_HANDLE) {
@@ -892,36 +845,39 @@ GBufferPass::MaterialDescriptor* GBufferPass::allocateMaterialDescriptor(const s
     
     VkDevice dev = device->getDevice();
     
-    // 分配新的描述符集
-    MaterialDescriptor material;
-    material.sets.resize(MAX_FRAMES_IN_FLIGHT);
+    // 分配新的描述符集（槽位被新材质复用时不重写旧描述符集，飞行中的帧可能仍在引用）
+    MaterialDescriptor descriptor;
+    descriptor.material = material;
+    descriptor.sets.resize(frameCount);
     
-    std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, materialSetLayout);
+    std::vector<VkDescriptorSetLayout> layouts(frameCount, materialSetLayout);
     
     VkDescriptorSetAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     allocInfo.descriptorPool = descriptorPool;
-    allocInfo.descriptorSetCount = MAX_FRAMES_IN_FLIGHT;
+    allocInfo.descriptorSetCount = frameCount;
     allocInfo.pSetLayouts = layouts.data();
     
-    if (vkAllocateDescriptorSets(dev, &allocInfo, material.sets.data()) != VK_SUCCESS) {
-        std::cerr << "GBuffer: Failed to allocate material descriptor sets for: " << materialId << std::endl;
+    if (vkAllocateDescriptorSets(dev, &allocInfo, descriptor.sets.data()) != VK_SUCCESS) {
+        std::cerr << "GBuffer: Failed to allocate material descriptor sets for material " << material.index << std::endl;
         return nullptr;
     }
     
-    material.valid = true;
-    materialDescriptorCache[materialId] = std::move(material);
+    descriptor.valid = true;
+    if (material.index >= materialDescriptors.size()) {
+        materialDescriptors.resize(material.index + 1);
+    }
+    materialDescriptors[material.index] = std::move(descriptor);
     
-    std::cout << "GBuffer: Allocated material descriptor for: " << materialId << std::endl;
-    return &materialDescriptorCache[materialId];
+    std::cout << "GBuffer: Allocated material descriptor for material " << material.index << std::endl;
+    return &materialDescriptors[material.index];
 }
 
-GBufferPass::MaterialDescriptor* GBufferPass::getMaterialDescriptor(const std::string& materialId) {
-    auto it = materialDescriptorCache.find(materialId);
-    if (it != materialDescriptorCache.end() && it->second.valid) {
-        return &it->second;
-    }
-    return nullptr;
+GBufferPass::MaterialDescriptor* GBufferPass::getMaterialDescriptor(VulkanEngine::MaterialHandle material) {
+    if (material.index >= materialDescriptors.size()) return nullptr;
+    
+    MaterialDescriptor& descriptor = materialDescriptors[material.index];
+    return descriptor.valid && descriptor.material == material ? &descriptor : nullptr;
 }
 
 void GBufferPass::updateMaterialTextures(MaterialDescriptor* material,
@@ -933,57 +889,79 @@ void GBufferPass::updateMaterialTextures(MaterialDescriptor* material,
         return;
     }
     
+    for (uint32_t i = 0; i < frameCount; i++) {
+        updateMaterialTextures(material, i, albedoView, albedoSampler, normalView, normalSampler,
+                               specularView, specularSampler);
+    }
+}
+
+void GBufferPass::updateMaterialTextures(MaterialDescriptor* material, uint32_t frameIndex,
+                                         VkImageView albedoView, VkSampler albedoSampler,
+                                         VkImageView normalView, VkSampler normalSampler,
+                                         VkImageView specularView, VkSampler specularSampler) {
+    if (!material || !material->valid || frameIndex >= material->sets.size()) {
+        std::cerr << "GBuffer: Cannot update textures - invalid material descriptor!" << std::endl;
+        return;
+    }
+    
     VkDevice dev = device->getDevice();
     
-    for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        std::array<VkDescriptorImageInfo, 3> imageInfos{};
-        
-        // Albedo 贴图 (binding 0)
-        imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfos[0].imageView = albedoView;
-        imageInfos[0].sampler = albedoSampler;
-        
-        // Normal 贴图 (binding 1)
-        imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfos[1].imageView = normalView;
-        imageInfos[1].sampler = normalSampler;
-        
-        // Specular 贴图 (binding 2)
-        imageInfos[2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfos[2].imageView = specularView;
-        imageInfos[2].sampler = specularSampler;
-        
-        std::array<VkWriteDescriptorSet, 3> descriptorWrites{};
-        
-        for (uint32_t j = 0; j < 3; j++) {
-            descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[j].dstSet = material->sets[i];
-            descriptorWrites[j].dstBinding = j;  // binding 0, 1, 2
-            descriptorWrites[j].dstArrayElement = 0;
-            descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            descriptorWrites[j].descriptorCount = 1;
-            descriptorWrites[j].pImageInfo = &imageInfos[j];
-        }
-        
-        vkUpdateDescriptorSets(dev, static_cast<uint32_t>(descriptorWrites.size()), 
-                              descriptorWrites.data(), 0, nullptr);
+    std::array<VkDescriptorImageInfo, 3> imageInfos{};
+    
+    // Albedo 贴图 (binding 0)
+    imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfos[0].imageView = albedoView;
+    imageInfos[0].sampler = albedoSampler;
+    
+    // Normal 贴图 (binding 1)
+    imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfos[1].imageView = normalView;
+    imageInfos[1].sampler = normalSampler;
+    
+    // Specular 贴图 (binding 2)
+    imageInfos[2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfos[2].imageView = specularView;
+    imageInfos[2].sampler = specularSampler;
+    
+    std::array<VkWriteDescriptorSet, 3> descriptorWrites{};
+    
+    for (uint32_t j = 0; j < 3; j++) {
+        descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[j].dstSet = material->sets[frameIndex];
+        descriptorWrites[j].dstBinding = j;  // binding 0, 1, 2
+        descriptorWrites[j].dstArrayElement = 0;
+        descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptorWrites[j].descriptorCount = 1;
+        descriptorWrites[j].pImageInfo = &imageInfos[j];
     }
+    
+    vkUpdateDescriptorSets(dev, static_cast<uint32_t>(descriptorWrites.size()), 
+                          descriptorWrites.data(), 0, nullptr);
 }
 
 // ============================================
 // 新的绑定函数
 // ============================================
 
-void GBufferPass::bindGlobalDescriptorSet(VkCommandBuffer cmd, uint32_t frameIndex) const {
-    if (frameIndex < MAX_FRAMES_IN_FLIGHT && globalDescriptorSets[frameIndex] != VK_NULL_HANDLE) {
+void GBufferPass::bindGlobalDescriptorSet(VkCommandBuffer cmd) const {
+    if (globalDescriptorSet != VK_NULL_HANDLE) {
+        // 动态偏移按绑定号顺序：binding 0 为 UBO，binding 1 为实例数据
+        const uint32_t dynamicOffsets[] = { uniformOffset, instanceOffset };
         vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, 
-                                pipelineLayout, 0, 1, &globalDescriptorSets[frameIndex], 0, nullptr);
+                                pipelineLayout, 0, 1, &globalDescriptorSet, 2, dynamicOffsets);
     }
 }
 
 void GBufferPass::bindMaterialDescriptorSet(VkCommandBuffer cmd, uint32_t frameIndex, MaterialDescriptor* material) const {
-    if (material && material->valid && frameIndex < MAX_FRAMES_IN_FLIGHT) {
+    if (material && material->valid && frameIndex < material->sets.size()) {
         vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, 
                                 pipelineLayout, 1, 1, &material->sets[frameIndex], 0, nullptr);
     }
 }
+
+void GBufferPass::bindBindlessDescriptorSet(VkCommandBuffer cmd, VkDescriptorSet descriptorSet) const {
+    if (!isBindless()) return;
+    
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, 
+                            pipelineLayout, 1, 1, &descriptorSet, 0, nullptr);
+}
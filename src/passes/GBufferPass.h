@@ -2,6 +2,8 @@
 
 #include "RenderPassBase.h"
 #include "RenderContext.h"
+#include "../core/VulkanAllocator.h"
+#include "../resources/ResourceHandle.h"
 #include <vulkan/vulkan.h>
 #include <glm/glm.hpp>
 #include <memory>
@@ -12,6 +14,7 @@
 
 class VulkanDevice;
 class VulkanBuffer;
+enum class VertexFormat : uint32_t;
 
 /**
  * GBufferPass - 几何缓冲区渲染通道
@@ -23,8 +26,12 @@ class VulkanBuffer;
  * - Depth (D32F) - 深度缓冲
  * 
  * 描述符集架构：
- * - Set 0: 全局 UBO（view, proj, 光照）
+ * - Set 0: 全局 UBO（view, proj, 光照）- 动态 UBO，数据每帧写入 FrameAllocator
+ *          逐实例数据（model, normalMatrix）- 动态存储缓冲区，动态偏移为本帧段起点
  * - Set 1: 材质纹理（albedo, normal, specular）- 每个材质独立
+ * 
+ * Bindless 模式（构造时传入 BindlessDescriptors 的布局）：Set 1 为所有材质共用的纹理数组和
+ * 材质参数缓冲区，不再受 MAX_MATERIALS 限制，按材质通过 push constant 传递材质索引
  */
 class GBufferPass : public RenderPassBase {
 public:
@@ -37,16 +44,23 @@ public:
         COUNT = 4
     };
 
-    // Push Constants 结构体
-    struct PushConstantData {
+    // 逐实例数据（与 gbuffer.vert 的 InstanceData 一致，std430）
+    struct InstanceData {
         alignas(16) glm::mat4 model;
-        alignas(16) glm::mat4 normalMatrix;
+        alignas(16) glm::mat4 normalMatrix;  // 着色器只使用左上 3x3
+    };
+    
+    // Push Constants 结构体 - bindless 材质索引（片段着色器）
+    struct PushConstantData {
+        uint32_t materialIndex;
     };
     
     // 材质描述符结构体
     struct MaterialDescriptor {
         std::vector<VkDescriptorSet> sets;  // 每帧一个
+        VulkanEngine::MaterialHandle material;
         bool valid = false;
+        std::vector<uint64_t> textureVersions;  // 每帧描述符集写入时的纹理资源版本（见 VulkanTexture::getResidencyVersion）
     };
 
     // UBO 结构体
@@ -58,7 +72,8 @@ public:
         alignas(16) glm::vec4 lightColor;
     };
 
-    GBufferPass(std::shared_ptr<VulkanDevice> device, uint32_t width, uint32_t height);
+    GBufferPass(std::shared_ptr<VulkanDevice> device, uint32_t width, uint32_t height,
+                VkDescriptorSetLayout bindlessSetLayout = VK_NULL_HANDLE);
     ~GBufferPass();
 
     GBufferPass(const GBufferPass&) = delete;
@@ -91,30 +106,45 @@ public:
 
     // Pipeline 相关
     VkPipeline getPipeline() const { return pipeline; }
+    VkPipeline getCompactPipeline() const { return compactPipeline; }
     VkPipelineLayout getPipelineLayout() const { return pipelineLayout; }
+    bool isBindless() const { return bindlessSetLayout != VK_NULL_HANDLE; }
     void bindPipeline(VkCommandBuffer cmd) const;
+    void bindPipeline(VkCommandBuffer cmd, VertexFormat format) const;
     
     // 描述符绑定
-    void bindGlobalDescriptorSet(VkCommandBuffer cmd, uint32_t frameIndex) const;
+    void bindGlobalDescriptorSet(VkCommandBuffer cmd) const;
     void bindMaterialDescriptorSet(VkCommandBuffer cmd, uint32_t frameIndex, MaterialDescriptor* material) const;
+    void bindBindlessDescriptorSet(VkCommandBuffer cmd, VkDescriptorSet descriptorSet) const;
     
-    // 绘制
-    void drawMesh(VkCommandBuffer cmd, VkBuffer vertexBuffer, VkBuffer indexBuffer, uint32_t indexCount) const;
-    void pushModelMatrix(VkCommandBuffer cmd, const glm::mat4& model);
+    // 绘制（共享几何缓冲区：页切换时才重新绑定，顶点 / 索引缓冲区分别绑定，区间位置通过 firstIndex / vertexOffset 传递，
+    // firstInstance 为第一个实例在本帧实例数据中的下标）
+    void bindVertexBuffer(VkCommandBuffer cmd, VkBuffer vertexBuffer) const;
+    void bindIndexBuffer(VkCommandBuffer cmd, VkBuffer indexBuffer) const;
+    void drawIndexed(VkCommandBuffer cmd, uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset,
+                     uint32_t instanceCount, uint32_t firstInstance) const;
+    // bindless 模式下推送材质索引（材质切换时调用）
+    void pushMaterialIndex(VkCommandBuffer cmd, uint32_t materialIndex) const;
     
     // 初始化描述符
     void createDescriptorSets();
+    void writeFrameAllocatorDescriptors();
     
-    // 材质描述符管理
-    MaterialDescriptor* allocateMaterialDescriptor(const std::string& materialId);
-    MaterialDescriptor* getMaterialDescriptor(const std::string& materialId);
+    // 材质描述符管理（按 MaterialHandle::index 直接索引，句柄失效时视为未分配）
+    MaterialDescriptor* allocateMaterialDescriptor(VulkanEngine::MaterialHandle material);
+    MaterialDescriptor* getMaterialDescriptor(VulkanEngine::MaterialHandle material);
     void updateMaterialTextures(MaterialDescriptor* material,
                                 VkImageView albedoView, VkSampler albedoSampler,
                                 VkImageView normalView, VkSampler normalSampler,
                                 VkImageView specularView, VkSampler specularSampler);
+    // 只重写指定帧的描述符集（该帧的命令缓冲区已执行完毕、尚未绑定该集时调用）
+    void updateMaterialTextures(MaterialDescriptor* material, uint32_t frameIndex,
+                                VkImageView albedoView, VkSampler albedoSampler,
+                                VkImageView normalView, VkSampler normalSampler,
+                                VkImageView specularView, VkSampler specularSampler);
     
-    // UBO 更新
-    void updateUniformBuffer(uint32_t frameIndex, const UniformBufferObject& ubo);
+    // UBO 更新：写入本帧的 FrameAllocator 段，记录动态偏移（每帧录制前调用）
+    void updateUniformBuffer(const UniformBufferObject& ubo);
 
     // 基类接口实现
     void recordCommands(VkCommandBuffer cmd, uint32_t frameIndex) override;
@@ -127,11 +157,9 @@ private:
     void createSampler();
     void cleanup();
     void createImage(VkFormat format, VkImageUsageFlags usage, VkImageAspectFlags aspect, uint32_t index);
-    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
     
     void createDescriptorSetLayout();
     void createPipeline();
-    void createUniformBuffers();
     VkShaderModule createShaderModule(const std::vector<char>& code);
     std::vector<char> readFile(const std::string& filename);
 
@@ -141,7 +169,7 @@ private:
 
     // 附件资源
     std::array<VkImage, COUNT> attachmentImages = {};
-    std::array<VkDeviceMemory, COUNT> attachmentMemories = {};
+    std::array<VulkanAllocation, COUNT> attachmentAllocations = {};
     std::array<VkImageView, COUNT> attachmentViews = {};
     std::array<VkFormat, COUNT> attachmentFormats = {
         VK_FORMAT_R16G16B16A16_SFLOAT,
@@ -156,28 +184,27 @@ private:
     
     // Pipeline
     VkPipeline pipeline = VK_NULL_HANDLE;
+    VkPipeline compactPipeline = VK_NULL_HANDLE;  // CompactVertex 输入
     VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
     
     // 描述符集布局
-    VkDescriptorSetLayout globalSetLayout = VK_NULL_HANDLE;    // Set 0: UBO
+    VkDescriptorSetLayout globalSetLayout = VK_NULL_HANDLE;    // Set 0: UBO + 实例数据
     VkDescriptorSetLayout materialSetLayout = VK_NULL_HANDLE;  // Set 1: 纹理
+    VkDescriptorSetLayout bindlessSetLayout = VK_NULL_HANDLE;  // Set 1（bindless 模式，不归本 Pass 所有）
     
     // 描述符资源
-    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 2;
     static constexpr uint32_t MAX_MATERIALS = 100;
+    uint32_t frameCount;    // 材质描述符集按帧分配（见 FrameAllocator::getFrameCount）
     VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
     
-    // 全局描述符集 (Set 0)
-    std::array<VkDescriptorSet, MAX_FRAMES_IN_FLIGHT> globalDescriptorSets = {};
-    
-    // 材质描述符缓存 (Set 1)
-    std::unordered_map<std::string, MaterialDescriptor> materialDescriptorCache;
+    // 全局描述符集 (Set 0，动态 UBO + 实例数据，所有帧共用一个)
+    VkDescriptorSet globalDescriptorSet = VK_NULL_HANDLE;
+    uint32_t uniformOffset = 0;    // 本帧全局 UBO 的动态偏移
+    uint32_t instanceOffset = 0;   // 本帧段起点（实例数据的动态偏移）
+    uint32_t frameAllocatorVersion = 0;   // 全局描述符集写入时的 FrameAllocator 版本
     
-    // Uniform Buffers
-    std::array<VkBuffer, MAX_FRAMES_IN_FLIGHT> uniformBuffers = {};
-    std::array<VkDeviceMemory, MAX_FRAMES_IN_FLIGHT> uniformBuffersMemory = {};
-    std::array<void*, MAX_FRAMES_IN_FLIGHT> uniformBuffersMapped = {};
+    // 材质描述符表 (Set 1，下标为 MaterialHandle::index)
+    std::vector<MaterialDescriptor> materialDescriptors;
     
-    VkDescriptorSet currentDescriptorSet = VK_NULL_HANDLE;
     RenderContext currentContext;
 };
\ No newline at end of file
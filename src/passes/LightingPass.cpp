@@ -1,5 +1,7 @@
 #include "LightingPass.h"
 #include "../core/VulkanDevice.h"
+#include "../core/UploadManager.h"
+#include "../core/FrameAllocator.h"
 #include <fstream>
 #include <stdexcept>
 #include <iostream>
@@ -12,7 +14,6 @@ LightingPass::LightingPass(std::shared_ptr<VulkanDevice> deviceIn, uint32_t widt
     createDescriptorSetLayout();
     createDescriptorPool();
     createDescriptorSets();
-    createUniformBuffers();
     createPipeline();
     createFullscreenQuad();
     
@@ -28,34 +29,8 @@ void LightingPass::cleanup() {
     vkDeviceWaitIdle(vkDevice);
 
     // 清理全屏四边形
-    if (quadIndexBuffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(vkDevice, quadIndexBuffer, nullptr);
-        quadIndexBuffer = VK_NULL_HANDLE;
-    }
-    if (quadIndexMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(vkDevice, quadIndexMemory, nullptr);
-        quadIndexMemory = VK_NULL_HANDLE;
-    }
-    if (quadVertexBuffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(vkDevice, quadVertexBuffer, nullptr);
-        quadVertexBuffer = VK_NULL_HANDLE;
-    }
-    if (quadVertexMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(vkDevice, quadVertexMemory, nullptr);
-        quadVertexMemory = VK_NULL_HANDLE;
-    }
-
-    // 清理 Uniform Buffers
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        if (uniformBuffers[i] != VK_NULL_HANDLE) {
-            vkDestroyBuffer(vkDevice, uniformBuffers[i], nullptr);
-            uniformBuffers[i] = VK_NULL_HANDLE;
-        }
-        if (uniformBuffersMemory[i] != VK_NULL_HANDLE) {
-            vkFreeMemory(vkDevice, uniformBuffersMemory[i], nullptr);
-            uniformBuffersMemory[i] = VK_NULL_HANDLE;
-        }
-    }
+    device->destroyBuffer(quadIndexBuffer, quadIndexAllocation);
+    device->destroyBuffer(quadVertexBuffer, quadVertexAllocation);
 
     // 清理 Pipeline
     if (pipeline != VK_NULL_HANDLE) {
@@ -71,6 +46,7 @@ void LightingPass::cleanup() {
     if (descriptorPool != VK_NULL_HANDLE) {
         vkDestroyDescriptorPool(vkDevice, descriptorPool, nullptr);
         descriptorPool = VK_NULL_HANDLE;
+        descriptorSet = VK_NULL_HANDLE;
     }
     if (descriptorSetLayout != VK_NULL_HANDLE) {
         vkDestroyDescriptorSetLayout(vkDevice, descriptorSetLayout, nullptr);
@@ -83,7 +59,7 @@ void LightingPass::createDescriptorSetLayout() {
 
     // binding 0: UBO
     bindings[0].binding = 0;
-    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     bindings[0].descriptorCount = 1;
     bindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
     bindings[0].pImmutableSamplers = nullptr;
@@ -121,16 +97,16 @@ void LightingPass::createDescriptorSetLayout() {
 
 void LightingPass::createDescriptorPool() {
     std::array<VkDescriptorPoolSize, 2> poolSizes{};
-    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSizes[0].descriptorCount = MAX_FRAMES_IN_FLIGHT;
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSizes[0].descriptorCount = 1;
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[1].descriptorCount = MAX_FRAMES_IN_FLIGHT * 3;  // 3 G-Buffer textures
+    poolSizes[1].descriptorCount = 3;  // 3 G-Buffer textures
 
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
     poolInfo.pPoolSizes = poolSizes.data();
-    poolInfo.maxSets = MAX_FRAMES_IN_FLIGHT;
+    poolInfo.maxSets = 1;
 
     if (vkCreateDescriptorPool(device->getDevice(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create LightingPass descriptor pool!");
@@ -138,50 +114,35 @@ void LightingPass::createDescriptorPool() {
 }
 
 void LightingPass::createDescriptorSets() {
-    std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, descriptorSetLayout);
-
     VkDescriptorSetAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     allocInfo.descriptorPool = descriptorPool;
-    allocInfo.descriptorSetCount = MAX_FRAMES_IN_FLIGHT;
-    allocInfo.pSetLayouts = layouts.data();
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &descriptorSetLayout;
 
-    if (vkAllocateDescriptorSets(device->getDevice(), &allocInfo, descriptorSets.data()) != VK_SUCCESS) {
+    if (vkAllocateDescriptorSets(device->getDevice(), &allocInfo, &descriptorSet) != VK_SUCCESS) {
         throw std::runtime_error("Failed to allocate LightingPass descriptor sets!");
     }
+
+    writeFrameAllocatorDescriptors();
 }
 
-void LightingPass::createUniformBuffers() {
-    VkDeviceSize bufferSize = sizeof(LightingUBO);
-
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        device->createBuffer(
-            bufferSize,
-            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-            uniformBuffers[i],
-            uniformBuffersMemory[i]
-        );
-
-        vkMapMemory(device->getDevice(), uniformBuffersMemory[i], 0, bufferSize, 0, &uniformBuffersMapped[i]);
-
-        // 更新描述符集中的 UBO 绑定
-        VkDescriptorBufferInfo bufferInfo{};
-        bufferInfo.buffer = uniformBuffers[i];
-        bufferInfo.offset = 0;
-        bufferInfo.range = sizeof(LightingUBO);
-
-        VkWriteDescriptorSet descriptorWrite{};
-        descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrite.dstSet = descriptorSets[i];
-        descriptorWrite.dstBinding = 0;
-        descriptorWrite.dstArrayElement = 0;
-        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        descriptorWrite.descriptorCount = 1;
-        descriptorWrite.pBufferInfo = &bufferInfo;
-
-        vkUpdateDescriptorSets(device->getDevice(), 1, &descriptorWrite, 0, nullptr);
-    }
+void LightingPass::writeFrameAllocatorDescriptors() {
+    // UBO 绑定指向 FrameAllocator 的缓冲区，每帧的位置由动态偏移决定
+    const FrameAllocator& frameAllocator = device->getFrameAllocator();
+    VkDescriptorBufferInfo bufferInfo = frameAllocator.getDescriptorInfo(sizeof(LightingUBO));
+
+    VkWriteDescriptorSet descriptorWrite{};
+    descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.dstSet = descriptorSet;
+    descriptorWrite.dstBinding = 0;
+    descriptorWrite.dstArrayElement = 0;
+    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pBufferInfo = &bufferInfo;
+
+    vkUpdateDescriptorSets(device->getDevice(), 1, &descriptorWrite, 0, nullptr);
+    frameAllocatorVersion = frameAllocator.getVersion();
 }
 
 void LightingPass::setGBufferInputs(VkImageView positionView, VkImageView normalView,
@@ -191,39 +152,37 @@ void LightingPass::setGBufferInputs(VkImageView positionView, VkImageView normal
     cachedAlbedoView = albedoView;
     cachedSampler = sampler;
 
-    // 更新描述符集
-    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        std::array<VkDescriptorImageInfo, 3> imageInfos{};
-
-        imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfos[0].imageView = positionView;
-        imageInfos[0].sampler = sampler;
-
-        imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfos[1].imageView = normalView;
-        imageInfos[1].sampler = sampler;
-
-        imageInfos[2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfos[2].imageView = albedoView;
-        imageInfos[2].sampler = sampler;
-
-        std::array<VkWriteDescriptorSet, 3> descriptorWrites{};
-        for (int j = 0; j < 3; j++) {
-            descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[j].dstSet = descriptorSets[i];
-            descriptorWrites[j].dstBinding = j + 1;  // binding 1, 2, 3
-            descriptorWrites[j].dstArrayElement = 0;
-            descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            descriptorWrites[j].descriptorCount = 1;
-            descriptorWrites[j].pImageInfo = &imageInfos[j];
-        }
-
-        vkUpdateDescriptorSets(device->getDevice(), static_cast<uint32_t>(descriptorWrites.size()),
-                               descriptorWrites.data(), 0, nullptr);
+    // 更新描述符集（调用方在设备空闲时调用，例如窗口尺寸变化后）
+    std::array<VkDescriptorImageInfo, 3> imageInfos{};
+
+    imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfos[0].imageView = positionView;
+    imageInfos[0].sampler = sampler;
+
+    imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfos[1].imageView = normalView;
+    imageInfos[1].sampler = sampler;
+
+    imageInfos[2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfos[2].imageView = albedoView;
+    imageInfos[2].sampler = sampler;
+
+    std::array<VkWriteDescriptorSet, 3> descriptorWrites{};
+    for (int j = 0; j < 3; j++) {
+        descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[j].dstSet = descriptorSet;
+        descriptorWrites[j].dstBinding = j + 1;  // binding 1, 2, 3
+        descriptorWrites[j].dstArrayElement = 0;
+        descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptorWrites[j].descriptorCount = 1;
+        descriptorWrites[j].pImageInfo = &imageInfos[j];
     }
+
+    vkUpdateDescriptorSets(device->getDevice(), static_cast<uint32_t>(descriptorWrites.size()),
+                           descriptorWrites.data(), 0, nullptr);
 }
 
-void LightingPass::updateUniforms(uint32_t frameIndex, const glm::vec3& viewPos,
+void LightingPass::updateUniforms(const glm::vec3& viewPos,
                                    const glm::vec3& lightPos, const glm::vec3& lightColor,
                                    float lightIntensity) {
     LightingUBO ubo{};
@@ -233,7 +192,12 @@ void LightingPass::updateUniforms(uint32_t frameIndex, const glm::vec3& viewPos,
     ubo.ambientColor = glm::vec4(ambientColor, ambientIntensity);
     ubo.screenSize = glm::vec4(static_cast<float>(width), static_cast<float>(height), 0.0f, 0.0f);
 
-    memcpy(uniformBuffersMapped[frameIndex], &ubo, sizeof(ubo));
+    FrameAllocator& frameAllocator = device->getFrameAllocator();
+    // FrameAllocator 扩容后缓冲区已重建，重新写入指向它的描述符
+    if (frameAllocatorVersion != frameAllocator.getVersion()) {
+        writeFrameAllocatorDescriptors();
+    }
+    uniformOffset = frameAllocator.pushUniform(ubo);
 }
 
 void LightingPass::setAmbientLight(const glm::vec3& color, float intensity) {
@@ -391,61 +355,28 @@ void LightingPass::createFullscreenQuad() {
     VkDeviceSize vertexBufferSize = sizeof(quadVertices);
     VkDeviceSize indexBufferSize = sizeof(quadIndices);
 
-    // 创建顶点缓冲
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-
-    device->createBuffer(
-        vertexBufferSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-        stagingBuffer,
-        stagingBufferMemory
-    );
-
-    void* data;
-    vkMapMemory(device->getDevice(), stagingBufferMemory, 0, vertexBufferSize, 0, &data);
-    memcpy(data, quadVertices, vertexBufferSize);
-    vkUnmapMemory(device->getDevice(), stagingBufferMemory);
-
+    // 创建设备本地缓冲区，数据经 UploadManager 的暂存环上传（随下一次 flush 提交）
     device->createBuffer(
         vertexBufferSize,
         VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
         quadVertexBuffer,
-        quadVertexMemory
-    );
-
-    device->copyBuffer(stagingBuffer, quadVertexBuffer, vertexBufferSize);
-
-    vkDestroyBuffer(device->getDevice(), stagingBuffer, nullptr);
-    vkFreeMemory(device->getDevice(), stagingBufferMemory, nullptr);
-
-    // 创建索引缓冲
-    device->createBuffer(
-        indexBufferSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-        stagingBuffer,
-        stagingBufferMemory
+        quadVertexAllocation,
+        VulkanMemoryCategory::Mesh
     );
 
-    vkMapMemory(device->getDevice(), stagingBufferMemory, 0, indexBufferSize, 0, &data);
-    memcpy(data, quadIndices, indexBufferSize);
-    vkUnmapMemory(device->getDevice(), stagingBufferMemory);
-
     device->createBuffer(
         indexBufferSize,
         VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
         quadIndexBuffer,
-        quadIndexMemory
+        quadIndexAllocation,
+        VulkanMemoryCategory::Mesh
     );
 
-    device->copyBuffer(stagingBuffer, quadIndexBuffer, indexBufferSize);
-
-    vkDestroyBuffer(device->getDevice(), stagingBuffer, nullptr);
-    vkFreeMemory(device->getDevice(), stagingBufferMemory, nullptr);
+    UploadManager& uploads = device->getUploadManager();
+    uploads.uploadBuffer(quadVertexBuffer, quadVertices, vertexBufferSize);
+    uploads.uploadBuffer(quadIndexBuffer, quadIndices, indexBufferSize);
 }
 
 void LightingPass::recordCommands(VkCommandBuffer cmd, uint32_t frameIndex) {
@@ -473,7 +404,7 @@ void LightingPass::render(VkCommandBuffer cmd, uint32_t frameIndex) {
 
     // 绑定描述符集
     vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
-                            0, 1, &descriptorSets[frameIndex], 0, nullptr);
+                            0, 1, &descriptorSet, 1, &uniformOffset);
 
     // 绑定顶点和索引缓冲
     VkBuffer vertexBuffers[] = {quadVertexBuffer};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RenderPassBase.h"
+#include "../core/VulkanAllocator.h"
 #include <vulkan/vulkan.h>
 #include <glm/glm.hpp>
 #include <memory>
@@ -16,6 +17,7 @@ class GBufferPass;
  * 
  * 使用 G-Buffer 中的几何信息进行光照计算，
  * 渲染一个全屏四边形，在片段着色器中完成所有光照运算。
+ * 光照 UBO 为动态 UBO，每帧写入 FrameAllocator，只需一个描述符集。
  */
 class LightingPass : public RenderPassBase {
 public:
@@ -41,7 +43,7 @@ public:
                           VkImageView albedoView, VkSampler sampler);
 
     // 更新光照参数
-    void updateUniforms(uint32_t frameIndex, const glm::vec3& viewPos,
+    void updateUniforms(const glm::vec3& viewPos,
                         const glm::vec3& lightPos, const glm::vec3& lightColor,
                         float lightIntensity = 1.0f);
 
@@ -62,7 +64,7 @@ private:
     void createDescriptorSetLayout();
     void createDescriptorPool();
     void createDescriptorSets();
-    void createUniformBuffers();
+    void writeFrameAllocatorDescriptors();
     void createPipeline();
     void createFullscreenQuad();
     void cleanup();
@@ -78,20 +80,16 @@ private:
     VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
 
     // 描述符
-    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 2;
     VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
-    std::array<VkDescriptorSet, MAX_FRAMES_IN_FLIGHT> descriptorSets = {};
-
-    // Uniform Buffers
-    std::array<VkBuffer, MAX_FRAMES_IN_FLIGHT> uniformBuffers = {};
-    std::array<VkDeviceMemory, MAX_FRAMES_IN_FLIGHT> uniformBuffersMemory = {};
-    std::array<void*, MAX_FRAMES_IN_FLIGHT> uniformBuffersMapped = {};
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+    uint32_t uniformOffset = 0;    // 本帧光照 UBO 的动态偏移
+    uint32_t frameAllocatorVersion = 0;   // UBO 描述符写入时的 FrameAllocator 版本
 
     // 全屏四边形
     VkBuffer quadVertexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory quadVertexMemory = VK_NULL_HANDLE;
+    VulkanAllocation quadVertexAllocation;
     VkBuffer quadIndexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory quadIndexMemory = VK_NULL_HANDLE;
+    VulkanAllocation quadIndexAllocation;
 
     // 缓存的 G-Buffer 视图
     VkImageView cachedPositionView = VK_NULL_HANDLE;
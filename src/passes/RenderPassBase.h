@@ -58,11 +58,27 @@ public:
     // 是否启用
     bool isEnabled() const { return enabled; }
     void setEnabled(bool enable) { enabled = enable; }
+    
+    /**
+     * 资源代数：Pass 销毁了外部可能缓存引用的资源（如材质描述符）后变化。
+     * 取全局递增值，同一地址上重建的 Pass 也不会与旧值相同
+     */
+    uint64_t getResourceGeneration() const { return resourceGeneration; }
 
 protected:
+    void bumpResourceGeneration() { resourceGeneration = nextResourceGeneration(); }
+    
     std::shared_ptr<VulkanDevice> device;
     uint32_t width;
     uint32_t height;
     std::string passName = "Unnamed Pass";
     bool enabled = true;
+
+private:
+    static uint64_t nextResourceGeneration() {
+        static uint64_t counter = 0;
+        return ++counter;
+    }
+    
+    uint64_t resourceGeneration = nextResourceGeneration();
 };
@@ -1,7 +1,7 @@
 #include "SSRPass.h"
 #include "GBufferPass.h"
 #include "VulkanDevice.h"
-#include "VulkanBuffer.h"
+#include "FrameAllocator.h"
 #include "VulkanPipeline.h"
 #include "Utils.h"
 #include <stdexcept>
@@ -29,7 +29,6 @@ SSRPass::SSRPass(std::shared_ptr<VulkanDevice> device, uint32_t width, uint32_t
     createFramebuffer();
     createDescriptorSetLayout();
     createDescriptorPool();
-    createUniformBuffers();
     createDescriptorSets();
     createPipeline();
     
@@ -55,8 +54,6 @@ void SSRPass::cleanup() {
         pipelineLayout = VK_NULL_HANDLE;
     }
     
-    uniformBuffers.clear();
-    
     if (descriptorPool != VK_NULL_HANDLE) {
         vkDestroyDescriptorPool(dev, descriptorPool, nullptr);
         descriptorPool = VK_NULL_HANDLE;
@@ -87,15 +84,7 @@ void SSRPass::cleanup() {
         outputImageView = VK_NULL_HANDLE;
     }
     
-    if (outputImage != VK_NULL_HANDLE) {
-        vkDestroyImage(dev, outputImage, nullptr);
-        outputImage = VK_NULL_HANDLE;
-    }
-    
-    if (outputImageMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(dev, outputImageMemory, nullptr);
-        outputImageMemory = VK_NULL_HANDLE;
-    }
+    device->destroyImage(outputImage, outputImageAllocation);
 }
 
 void SSRPass::resize(uint32_t newWidth, uint32_t newHeight) {
@@ -114,7 +103,6 @@ void SSRPass::resize(uint32_t newWidth, uint32_t newHeight) {
     createFramebuffer();
     createDescriptorSetLayout();
     createDescriptorPool();
-    createUniformBuffers();
     createDescriptorSets();
     createPipeline();
     
@@ -144,21 +132,9 @@ void SSRPass::createOutputImage() {
         throw std::runtime_error("Failed to create SSR output image!");
     }
     
-    // 分配内存
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(dev, outputImage, &memRequirements);
-    
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
-                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    
-    if (vkAllocateMemory(dev, &allocInfo, nullptr, &outputImageMemory) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to allocate SSR output image memory!");
-    }
-    
-    vkBindImageMemory(dev, outputImage, outputImageMemory, 0);
+    // 分配并绑定内存（设备子分配器）
+    outputImageAllocation = device->getAllocator().allocateImage(outputImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                                 VulkanMemoryCategory::SSR);
     
     // 创建图像视图
     VkImageViewCreateInfo viewInfo{};
@@ -299,7 +275,7 @@ void SSRPass::createDescriptorSetLayout() {
     
     // Binding 5: SSR Params UBO
     bindings[5].binding = 5;
-    bindings[5].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    bindings[5].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     bindings[5].descriptorCount = 1;
     bindings[5].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
     
@@ -314,52 +290,37 @@ void SSRPass::createDescriptorSetLayout() {
 }
 
 void SSRPass::createDescriptorPool() {
+    const uint32_t frameCount = device->getFrameAllocator().getFrameCount();
+    
     std::array<VkDescriptorPoolSize, 2> poolSizes{};
     poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[0].descriptorCount = 5 * MAX_FRAMES_IN_FLIGHT;  // 5 textures per frame
+    poolSizes[0].descriptorCount = 5 * frameCount;  // 5 textures per frame
     
-    poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSizes[1].descriptorCount = 1 * MAX_FRAMES_IN_FLIGHT;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSizes[1].descriptorCount = 1 * frameCount;
     
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
     poolInfo.pPoolSizes = poolSizes.data();
-    poolInfo.maxSets = MAX_FRAMES_IN_FLIGHT;
+    poolInfo.maxSets = frameCount;
     
     if (vkCreateDescriptorPool(device->getDevice(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create SSR descriptor pool!");
     }
 }
 
-void SSRPass::createUniformBuffers() {
-    VkDeviceSize bufferSize = sizeof(SSRParams);
-    
-    uniformBuffers.resize(MAX_FRAMES_IN_FLIGHT);
-    uniformBuffersMapped.resize(MAX_FRAMES_IN_FLIGHT);
-    
-    for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        uniformBuffers[i] = std::make_unique<VulkanBuffer>(
-            device,
-            bufferSize,
-            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-        );
-        
-        vkMapMemory(device->getDevice(), uniformBuffers[i]->getMemory(), 0, bufferSize, 0, &uniformBuffersMapped[i]);
-    }
-}
-
 void SSRPass::createDescriptorSets() {
-    std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, descriptorSetLayout);
+    const uint32_t frameCount = device->getFrameAllocator().getFrameCount();
+    std::vector<VkDescriptorSetLayout> layouts(frameCount, descriptorSetLayout);
     
     VkDescriptorSetAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     allocInfo.descriptorPool = descriptorPool;
-    allocInfo.descriptorSetCount = MAX_FRAMES_IN_FLIGHT;
+    allocInfo.descriptorSetCount = frameCount;
     allocInfo.pSetLayouts = layouts.data();
     
-    descriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
+    descriptorSets.resize(frameCount);
     if (vkAllocateDescriptorSets(device->getDevice(), &allocInfo, descriptorSets.data()) != VK_SUCCESS) {
         throw std::runtime_error("Failed to allocate SSR descriptor sets!");
     }
@@ -476,14 +437,14 @@ void SSRPass::createPipeline() {
 }
 
 void SSRPass::updateParams(const glm::mat4& projection, const glm::mat4& view,
-                           const glm::vec3& cameraPos, uint32_t frameIndex) {
+                           const glm::vec3& cameraPos) {
     params.projection = projection;
     params.view = view;
     params.invProjection = glm::inverse(projection);
     params.invView = glm::inverse(view);
     params.cameraPos = glm::vec4(cameraPos, 1.0f);
     
-    memcpy(uniformBuffersMapped[frameIndex], &params, sizeof(SSRParams));
+    paramsOffset = device->getFrameAllocator().pushUniform(params);
 }
 
 void SSRPass::execute(VkCommandBuffer cmd, GBufferPass* gbuffer, 
@@ -511,10 +472,7 @@ void SSRPass::execute(VkCommandBuffer cmd, GBufferPass* gbuffer,
     imageInfos[4].imageView = sceneColorView;
     imageInfos[4].sampler = gbuffer->getSampler();
     
-    VkDescriptorBufferInfo bufferInfo{};
-    bufferInfo.buffer = uniformBuffers[frameIndex]->getBuffer();
-    bufferInfo.offset = 0;
-    bufferInfo.range = sizeof(SSRParams);
+    VkDescriptorBufferInfo bufferInfo = device->getFrameAllocator().getDescriptorInfo(sizeof(SSRParams));
     
     std::array<VkWriteDescriptorSet, 6> descriptorWrites{};
     
@@ -532,7 +490,7 @@ void SSRPass::execute(VkCommandBuffer cmd, GBufferPass* gbuffer,
     descriptorWrites[5].dstSet = descriptorSets[frameIndex];
     descriptorWrites[5].dstBinding = 5;
     descriptorWrites[5].dstArrayElement = 0;
-    descriptorWrites[5].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorWrites[5].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     descriptorWrites[5].descriptorCount = 1;
     descriptorWrites[5].pBufferInfo = &bufferInfo;
     
@@ -571,24 +529,10 @@ void SSRPass::execute(VkCommandBuffer cmd, GBufferPass* gbuffer,
     vkCmdSetScissor(cmd, 0, 1, &scissor);
     
     vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1,
-                            &descriptorSets[frameIndex], 0, nullptr);
+                            &descriptorSets[frameIndex], 1, &paramsOffset);
     
     // 绘制全屏三角形
     vkCmdDraw(cmd, 3, 1, 0, 0);
     
     vkCmdEndRenderPass(cmd);
 }
-
-uint32_t SSRPass::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-    VkPhysicalDeviceMemoryProperties memProperties;
-    vkGetPhysicalDeviceMemoryProperties(device->getPhysicalDevice(), &memProperties);
-    
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((typeFilter & (1 << i)) && 
-            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-            return i;
-        }
-    }
-    
-    throw std::runtime_error("Failed to find suitable memory type!");
-}
@@ -2,18 +2,19 @@
 
 #include "RenderPassBase.h"
 #include "RenderContext.h"
+#include "../core/VulkanAllocator.h"
 #include <vulkan/vulkan.h>
 #include <glm/glm.hpp>
 #include <memory>
 
 class VulkanDevice;
-class VulkanBuffer;
 class GBufferPass;
 
 /**
  * SSRPass - 屏幕空间反射渲染通道
  * 
  * 基于 G-Buffer 信息进行光线步进，计算屏幕空间反射
+ * SSR 参数为动态 UBO，每帧写入 FrameAllocator
  */
 class SSRPass : public RenderPassBase {
 public:
@@ -43,7 +44,7 @@ public:
 
     // 更新 SSR 参数
     void updateParams(const glm::mat4& projection, const glm::mat4& view,
-                      const glm::vec3& cameraPos, uint32_t frameIndex);
+                      const glm::vec3& cameraPos);
 
     // 设置 SSR 参数
     void setMaxDistance(float distance) { params.maxDistance = distance; }
@@ -69,10 +70,7 @@ private:
     void createDescriptorPool();
     void createDescriptorSets();
     void createPipeline();
-    void createUniformBuffers();
     void cleanup();
-    
-    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 
     std::shared_ptr<VulkanDevice> device;
     
@@ -84,7 +82,7 @@ private:
 
     // 输出图像
     VkImage outputImage = VK_NULL_HANDLE;
-    VkDeviceMemory outputImageMemory = VK_NULL_HANDLE;
+    VulkanAllocation outputImageAllocation;
     VkImageView outputImageView = VK_NULL_HANDLE;
     VkSampler outputSampler = VK_NULL_HANDLE;
 
@@ -97,11 +95,6 @@ private:
     // 描述符
     VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
     VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
-    std::vector<VkDescriptorSet> descriptorSets;
-    
-    // Uniform Buffers
-    std::vector<std::unique_ptr<VulkanBuffer>> uniformBuffers;
-    std::vector<void*> uniformBuffersMapped;
-    
-    static const int MAX_FRAMES_IN_FLIGHT = 2;
+    std::vector<VkDescriptorSet> descriptorSets;   // 每帧一个（纹理绑定在 execute 中重写）
+    uint32_t paramsOffset = 0;                     // 本帧 SSR 参数的动态偏移
 };
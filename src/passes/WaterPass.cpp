@@ -1,6 +1,8 @@
 #include "WaterPass.h"
 #include "GBufferPass.h"
 #include "VulkanDevice.h"
+#include "UploadManager.h"
+#include "FrameAllocator.h"
 #include "VulkanBuffer.h"
 #include "VulkanPipeline.h"
 #include "Mesh.h"
@@ -28,7 +30,6 @@ WaterPass::WaterPass(std::shared_ptr<VulkanDevice> device, uint32_t width, uint3
     createIndexBuffer();
     createDescriptorSetLayout();
     createDescriptorPool();
-    createUniformBuffers();
     createDescriptorSets();
     createPipeline();
     
@@ -54,8 +55,6 @@ void WaterPass::cleanup() {
         pipelineLayout = VK_NULL_HANDLE;
     }
     
-    uniformBuffers.clear();
-    
     if (descriptorPool != VK_NULL_HANDLE) {
         vkDestroyDescriptorPool(dev, descriptorPool, nullptr);
         descriptorPool = VK_NULL_HANDLE;
@@ -141,67 +140,29 @@ void WaterPass::createVertexBuffer() {
     const auto& vertices = waterMesh->getVertices();
     VkDeviceSize bufferSize = sizeof(Vertex) * vertices.size();
     
-    // 创建暂存缓冲区
-    auto stagingBuffer = std::make_unique<VulkanBuffer>(
-        device,
-        bufferSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-    );
-    
-    void* data;
-    vkMapMemory(device->getDevice(), stagingBuffer->getMemory(), 0, bufferSize, 0, &data);
-    memcpy(data, vertices.data(), bufferSize);
-    vkUnmapMemory(device->getDevice(), stagingBuffer->getMemory());
-    
-    // 创建设备本地缓冲区
+    // 创建设备本地缓冲区，数据经 UploadManager 的暂存环上传
     vertexBuffer = std::make_unique<VulkanBuffer>(
         device,
         bufferSize,
         VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        VulkanMemoryCategory::Mesh
     );
-    
-    // 复制数据
-    VkCommandBuffer commandBuffer = device->beginSingleTimeCommands();
-    
-    VkBufferCopy copyRegion{};
-    copyRegion.size = bufferSize;
-    vkCmdCopyBuffer(commandBuffer, stagingBuffer->getBuffer(), vertexBuffer->getBuffer(), 1, &copyRegion);
-    
-    device->endSingleTimeCommands(commandBuffer);
+    device->getUploadManager().uploadBuffer(vertexBuffer->getBuffer(), vertices.data(), bufferSize);
 }
 
 void WaterPass::createIndexBuffer() {
     const auto& indices = waterMesh->getIndices();
     VkDeviceSize bufferSize = sizeof(uint32_t) * indices.size();
     
-    auto stagingBuffer = std::make_unique<VulkanBuffer>(
-        device,
-        bufferSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-    );
-    
-    void* data;
-    vkMapMemory(device->getDevice(), stagingBuffer->getMemory(), 0, bufferSize, 0, &data);
-    memcpy(data, indices.data(), bufferSize);
-    vkUnmapMemory(device->getDevice(), stagingBuffer->getMemory());
-    
     indexBuffer = std::make_unique<VulkanBuffer>(
         device,
         bufferSize,
         VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        VulkanMemoryCategory::Mesh
     );
-    
-    VkCommandBuffer commandBuffer = device->beginSingleTimeCommands();
-    
-    VkBufferCopy copyRegion{};
-    copyRegion.size = bufferSize;
-    vkCmdCopyBuffer(commandBuffer, stagingBuffer->getBuffer(), indexBuffer->getBuffer(), 1, &copyRegion);
-    
-    device->endSingleTimeCommands(commandBuffer);
+    device->getUploadManager().uploadBuffer(indexBuffer->getBuffer(), indices.data(), bufferSize);
 }
 
 void WaterPass::createDescriptorSetLayout() {
@@ -216,7 +177,7 @@ void WaterPass::createDescriptorSetLayout() {
     
     // Binding 0: Water UBO
     bindings[0].binding = 0;
-    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     bindings[0].descriptorCount = 1;
     bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
     
@@ -255,18 +216,20 @@ void WaterPass::createDescriptorSetLayout() {
 }
 
 void WaterPass::createDescriptorPool() {
+    const uint32_t frameCount = device->getFrameAllocator().getFrameCount();
+    
     std::array<VkDescriptorPoolSize, 2> poolSizes{};
-    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSizes[0].descriptorCount = 1 * MAX_FRAMES_IN_FLIGHT;
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSizes[0].descriptorCount = 1 * frameCount;
     
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[1].descriptorCount = 4 * MAX_FRAMES_IN_FLIGHT;  // 4 textures per frame
+    poolSizes[1].descriptorCount = 4 * frameCount;  // 4 textures per frame
     
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
     poolInfo.pPoolSizes = poolSizes.data();
-    poolInfo.maxSets = MAX_FRAMES_IN_FLIGHT;
+    poolInfo.maxSets = frameCount;
     poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
     
     if (vkCreateDescriptorPool(device->getDevice(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
@@ -274,56 +237,42 @@ void WaterPass::createDescriptorPool() {
     }
 }
 
-void WaterPass::createUniformBuffers() {
-    VkDeviceSize bufferSize = sizeof(WaterUBO);
-    
-    uniformBuffers.resize(MAX_FRAMES_IN_FLIGHT);
-    uniformBuffersMapped.resize(MAX_FRAMES_IN_FLIGHT);
-    
-    for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        uniformBuffers[i] = std::make_unique<VulkanBuffer>(
-            device,
-            bufferSize,
-            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-        );
-        
-        vkMapMemory(device->getDevice(), uniformBuffers[i]->getMemory(), 0, bufferSize, 0, &uniformBuffersMapped[i]);
-    }
-}
-
 void WaterPass::createDescriptorSets() {
-    std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, descriptorSetLayout);
+    const uint32_t frameCount = device->getFrameAllocator().getFrameCount();
+    std::vector<VkDescriptorSetLayout> layouts(frameCount, descriptorSetLayout);
     
     VkDescriptorSetAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     allocInfo.descriptorPool = descriptorPool;
-    allocInfo.descriptorSetCount = MAX_FRAMES_IN_FLIGHT;
+    allocInfo.descriptorSetCount = frameCount;
     allocInfo.pSetLayouts = layouts.data();
     
-    descriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
+    descriptorSets.resize(frameCount);
     if (vkAllocateDescriptorSets(device->getDevice(), &allocInfo, descriptorSets.data()) != VK_SUCCESS) {
         throw std::runtime_error("Failed to allocate water descriptor sets!");
     }
     
-    // 更新 UBO 绑定
-    for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-        VkDescriptorBufferInfo bufferInfo{};
-        bufferInfo.buffer = uniformBuffers[i]->getBuffer();
-        bufferInfo.offset = 0;
-        bufferInfo.range = sizeof(WaterUBO);
+    writeFrameAllocatorDescriptors();
+}
+
+void WaterPass::writeFrameAllocatorDescriptors() {
+    // 更新 UBO 绑定（指向 FrameAllocator 的缓冲区，每帧的位置由动态偏移决定）
+    const FrameAllocator& frameAllocator = device->getFrameAllocator();
+    for (size_t i = 0; i < descriptorSets.size(); i++) {
+        VkDescriptorBufferInfo bufferInfo = frameAllocator.getDescriptorInfo(sizeof(WaterUBO));
         
         VkWriteDescriptorSet descriptorWrite{};
         descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         descriptorWrite.dstSet = descriptorSets[i];
         descriptorWrite.dstBinding = 0;
         descriptorWrite.dstArrayElement = 0;
-        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         descriptorWrite.descriptorCount = 1;
         descriptorWrite.pBufferInfo = &bufferInfo;
         
         vkUpdateDescriptorSets(device->getDevice(), 1, &descriptorWrite, 0, nullptr);
     }
+    frameAllocatorVersion = frameAllocator.getVersion();
 }
 
 void WaterPass::createPipeline() {
@@ -456,7 +405,7 @@ void WaterPass::createPipeline() {
 }
 
 void WaterPass::updateUniforms(const glm::mat4& view, const glm::mat4& projection,
-                                const glm::vec3& cameraPos, float time, uint32_t frameIndex) {
+                                const glm::vec3& cameraPos, float time) {
     WaterUBO ubo{};
     
     // 水面模型矩阵 - 放置在水面高度
@@ -471,11 +420,16 @@ void WaterPass::updateUniforms(const glm::mat4& view, const glm::mat4& projectio
     ubo.screenSize = glm::vec4(width, height, 0.0f, 0.0f);
     ubo.ssrParams = glm::vec4(ssrMaxDistance, ssrMaxSteps, ssrThickness, 0.0f);
     
-    memcpy(uniformBuffersMapped[frameIndex], &ubo, sizeof(WaterUBO));
+    FrameAllocator& frameAllocator = device->getFrameAllocator();
+    // FrameAllocator 扩容后缓冲区已重建，重新写入指向它的描述符
+    if (frameAllocatorVersion != frameAllocator.getVersion()) {
+        writeFrameAllocatorDescriptors();
+    }
+    uniformOffset = frameAllocator.pushUniform(ubo);
 }
 
 void WaterPass::updateDescriptorSets(GBufferPass* gbuffer, VkImageView sceneColorView, VkSampler sampler) {
-    for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+    for (size_t i = 0; i < descriptorSets.size(); i++) {
         std::array<VkDescriptorImageInfo, 4> imageInfos{};
         
         // Binding 1: G-Buffer Position
@@ -521,12 +475,16 @@ void WaterPass::render(VkCommandBuffer cmd, uint32_t frameIndex) {
     VkBuffer vb;
     VkBuffer ib;
     uint32_t indexCount;
+    uint32_t firstIndex = 0;
+    int32_t vertexOffset = 0;
     
     if (useExternalMesh && externalMesh && externalMesh->isValid()) {
-        // 使用外部网格
+        // 使用外部网格（位于 MeshManager 的共享几何缓冲区中）
         vb = externalMesh->getVertexBufferHandle();
         ib = externalMesh->getIndexBufferHandle();
         indexCount = externalMesh->getIndexCount();
+        firstIndex = externalMesh->getFirstIndex();
+        vertexOffset = externalMesh->getVertexOffset();
     } else {
         // 使用内置网格
         vb = vertexBuffer->getBuffer();
@@ -540,9 +498,9 @@ void WaterPass::render(VkCommandBuffer cmd, uint32_t frameIndex) {
     vkCmdBindIndexBuffer(cmd, ib, 0, VK_INDEX_TYPE_UINT32);
     
     vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1,
-                            &descriptorSets[frameIndex], 0, nullptr);
+                            &descriptorSets[frameIndex], 1, &uniformOffset);
     
-    vkCmdDrawIndexed(cmd, indexCount, 1, 0, 0, 0);
+    vkCmdDrawIndexed(cmd, indexCount, 1, firstIndex, vertexOffset, 0);
 }
 
 // ============================================================
@@ -22,6 +22,7 @@ namespace VulkanEngine {
  * 
  * 直接对水面 mesh 进行 SSR 光线步进，只计算水面覆盖的像素
  * 比全屏 SSR 后处理效率更高
+ * 水面 UBO 为动态 UBO，每帧写入 FrameAllocator
  */
 class WaterPass : public RenderPassBase {
 public:
@@ -64,7 +65,7 @@ public:
 
     // 更新 Uniform Buffer
     void updateUniforms(const glm::mat4& view, const glm::mat4& projection,
-                        const glm::vec3& cameraPos, float time, uint32_t frameIndex);
+                        const glm::vec3& cameraPos, float time);
 
     // 更新描述符集 - 需要 G-Buffer 用于 SSR
     void updateDescriptorSets(GBufferPass* gbuffer, VkImageView sceneColorView, VkSampler sampler);
@@ -111,8 +112,8 @@ private:
     void createDescriptorSetLayout();
     void createDescriptorPool();
     void createDescriptorSets();
+    void writeFrameAllocatorDescriptors();
     void createPipeline();
-    void createUniformBuffers();
     void cleanup();
 
     std::shared_ptr<VulkanDevice> device;
@@ -150,11 +151,7 @@ private:
     // 描述符
     VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
     VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
-    std::vector<VkDescriptorSet> descriptorSets;
-    
-    // Uniform Buffers
-    std::vector<std::unique_ptr<VulkanBuffer>> uniformBuffers;
-    std::vector<void*> uniformBuffersMapped;
-    
-    static const int MAX_FRAMES_IN_FLIGHT = 2;
+    std::vector<VkDescriptorSet> descriptorSets;   // 每帧一个
+    uint32_t uniformOffset = 0;                    // 本帧水面 UBO 的动态偏移
+    uint32_t frameAllocatorVersion = 0;            // UBO 描述符写入时的 FrameAllocator 版本
 };
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "VulkanRenderer.h"
 #include "VulkanTexture.h"
+#include "UploadManager.h"
 #include "Mesh.h"
+#include "GltfLoader.h"
 #include "GBufferPass.h"
 #include "SSRPass.h"
 #include "WaterPass.h"
@@ -21,6 +23,8 @@
 #include <chrono>
 #include <thread>
 #include <filesystem>
+#include <fstream>
+#include <algorithm>
 #include <glm/gtc/type_ptr.hpp>
 
 // 静态回调函数实现
@@ -79,6 +83,9 @@ void VulkanRenderer::keyCallback(GLFWwindow* window, int key, int scancode, int
                 renderer->showUI = !renderer->showUI;
                 std::cout << "UI " << (renderer->showUI ? "enabled" : "disabled") << std::endl;
                 break;
+            case GLFW_KEY_F9:
+                renderer->dumpMemoryReport("memory_report.json");
+                break;
         }
     }
 }
@@ -100,11 +107,68 @@ void VulkanRenderer::dropCallback(GLFWwindow* window, int count, const char** pa
         auto newEntity = renderer->scene->createEntity("Dropped Model");
         newEntity.addComponent<VulkanEngine::MeshRendererComponent>(filePath, "default_material");
         std::cout << "Created new entity for dropped OBJ file" << std::endl;
+    } else if (extension == ".glb") {
+        std::cout << "Loading GLB file via drag & drop: " << filePath << std::endl;
+        renderer->importGLB(filePath);
     } else {
-        std::cout << "Unsupported file format: " << extension << " (only .obj files are supported)" << std::endl;
+        std::cout << "Unsupported file format: " << extension << " (only .obj and .glb files are supported)" << std::endl;
     }
 }
 
+void VulkanRenderer::importGLB(const std::string& filePath) {
+    GltfLoader gltf;
+    std::string error;
+    if (!gltf.open(filePath, error)) {
+        std::cerr << "Failed to import GLB file: " << filePath << " (" << error << ")" << std::endl;
+        return;
+    }
+    
+    const auto& items = gltf.getDrawItems();
+    const std::vector<GltfMaterial> materials = gltf.loadMaterials();
+    
+    // 图元网格保持场景坐标，所有实体共用同一个变换，把整个模型居中并缩放到单位大小
+    // （与 OBJ 加载时的 centerAndNormalize 一致）
+    glm::vec3 minBounds, maxBounds;
+    gltf.getSceneBounds(minBounds, maxBounds);
+    glm::vec3 size = maxBounds - minBounds;
+    float maxDim = std::max({size.x, size.y, size.z});
+    float scale = maxDim > 0.0f ? 2.0f / maxDim : 1.0f;
+    glm::vec3 center = (minBounds + maxBounds) * 0.5f;
+    
+    for (size_t i = 0; i < items.size(); ++i) {
+        const GltfDrawItem& item = items[i];
+        auto entity = scene->createEntity(item.name);
+        entity.addComponent<VulkanEngine::MeshRendererComponent>(
+            GltfLoader::makeMeshId(filePath, i), "glb_material_" + std::to_string(item.material));
+        
+        auto& transform = entity.getComponent<VulkanEngine::TransformComponent>();
+        transform.position = -center * scale;
+        transform.scale = glm::vec3(scale);
+        
+        // glTF 金属度/粗糙度在同一张贴图（B/G 通道），两个路径指向同一文件
+        auto& material = entity.addComponent<VulkanEngine::PBRMaterialComponent>();
+        if (item.material >= 0 && static_cast<size_t>(item.material) < materials.size()) {
+            const GltfMaterial& source = materials[item.material];
+            material.albedo = glm::vec3(source.baseColorFactor);
+            material.metallic = source.metallicFactor;
+            material.roughness = source.roughnessFactor;
+            material.ao = source.occlusionStrength;
+            material.emissive = source.emissiveFactor;
+            material.emissiveStrength = (source.emissiveFactor == glm::vec3(0.0f) && source.emissiveTexture.empty()) ? 0.0f : 1.0f;
+            material.albedoMap = source.baseColorTexture;
+            material.normalMap = source.normalTexture;
+            // 金属度/粗糙度共用一张贴图（B/G 通道），RenderSystem 据此按 MetallicRoughness 用途烘焙
+            material.metallicMap = source.metallicRoughnessTexture;
+            material.roughnessMap = source.metallicRoughnessTexture;
+            material.aoMap = source.occlusionTexture;
+            material.emissiveMap = source.emissiveTexture;
+        }
+    }
+    
+    std::cout << "Imported GLB: " << filePath << " (" << items.size() << " primitives, "
+              << materials.size() << " materials)" << std::endl;
+}
+
 void VulkanRenderer::mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
     auto renderer = reinterpret_cast<VulkanRenderer*>(glfwGetWindowUserPointer(window));
     if (!renderer) return;
@@ -188,13 +252,27 @@ void VulkanRenderer::initVulkan() {
     // 创建命令缓冲
     createCommandBuffers();
     
+    // 初始化多物体渲染系统（同时初始化 TextureManager，Pass 创建前需要确定是否启用 bindless）
+    auto deviceShared = std::shared_ptr<VulkanDevice>(device.get(), [](VulkanDevice*){});
+    renderSystem = std::make_unique<VulkanEngine::RenderSystem>();
+    renderSystem->init(deviceShared);
+    std::cout << "RenderSystem initialized" << std::endl;
+    
+    // Bindless 材质：设备支持 descriptor indexing 且 bindless 着色器已编译时启用，否则按材质绑定描述符集
+    BindlessDescriptors* bindless = nullptr;
+    if (std::filesystem::exists("shaders/pbr_bindless_frag.spv") &&
+        std::filesystem::exists("shaders/gbuffer_bindless_frag.spv")) {
+        bindless = VulkanEngine::TextureManager::getInstance().enableBindless(MAX_FRAMES_IN_FLIGHT);
+    }
+    bindlessSetLayout = bindless ? bindless->getSetLayout() : VK_NULL_HANDLE;
+    
     // 创建 ForwardPass（前向渲染）- 它会管理自己的 Pipeline、Descriptor Pool 和 UBO
     forwardPass = std::make_unique<ForwardPass>(
-        std::shared_ptr<VulkanDevice>(device.get(), [](VulkanDevice*){}),
+        deviceShared,
         swapChain->getRenderPass(),
         swapChain->getExtent().width,
         swapChain->getExtent().height,
-        MAX_FRAMES_IN_FLIGHT
+        bindlessSetLayout
     );
     
     // 注意：新架构中，材质描述符由 RenderSystem::updateRenderables 自动分配
@@ -207,12 +285,6 @@ void VulkanRenderer::initVulkan() {
     // 初始化 ECS 场景
     scene = std::make_unique<VulkanEngine::Scene>();
     
-    // 初始化多物体渲染系统
-    auto deviceShared = std::shared_ptr<VulkanDevice>(device.get(), [](VulkanDevice*){});
-    renderSystem = std::make_unique<VulkanEngine::RenderSystem>();
-    renderSystem->init(deviceShared);
-    std::cout << "RenderSystem initialized" << std::endl;
-    
     // 创建一个代表当前网格的实体（球体）
     auto sphereEntity = scene->createEntity("Sphere");
     sphereEntity.addComponent<VulkanEngine::MeshRendererComponent>("sphere", "earth_material");
@@ -315,6 +387,7 @@ void VulkanRenderer::mainLoop() {
     std::cout << "  Mouse scroll - Zoom in/out" << std::endl;
     std::cout << "  5 - Toggle Water Scene (SSR reflection)" << std::endl;
     std::cout << "  F1 - Toggle UI" << std::endl;
+    std::cout << "  F9 - Dump GPU memory report (memory_report.json)" << std::endl;
     std::cout << "  Drag & Drop - Load OBJ file as new entity" << std::endl;
     std::cout << "  ESC - Exit" << std::endl;
     
@@ -474,6 +547,11 @@ void VulkanRenderer::handleMousePicking() {
         auto& transform = ecsView.get<VulkanEngine::TransformComponent>(entity);
         auto& meshRenderer = ecsView.get<VulkanEngine::MeshRendererComponent>(entity);
         
+        // 仍在后台加载的网格尚未显示，不参与拾取
+        if (meshManager && !meshManager->isMeshResident(meshRenderer.meshPath)) {
+            continue;
+        }
+        
         // 从 MeshManager 获取该实体网格的包围盒
         VulkanEngine::AABB meshAABB;
         if (meshManager) {
@@ -569,6 +647,13 @@ void VulkanRenderer::drawFrame() {
     totalTime = std::chrono::duration<float>(currentTime - startTime).count();
     
     vkWaitForFences(device->getDevice(), 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+    
+    // 该帧上一次提交已完成，重置其每帧常量段（各 Pass 的 UBO 从这里分配）
+    device->getFrameAllocator().beginFrame(currentFrame);
+    if (renderSystem) {
+        // 按可渲染实体数提前扩容，避免本帧的实例 / 剔除数据分配失败
+        device->getFrameAllocator().reserve(renderSystem->getFrameDataEstimate());
+    }
 
     uint32_t imageIndex;
     VkResult result = vkAcquireNextImageKHR(device->getDevice(), swapChain->getSwapChain(), UINT64_MAX,
@@ -615,6 +700,9 @@ void VulkanRenderer::drawFrame() {
     } else {
         recordCommandBuffer(commandBuffers[currentFrame], imageIndex);
     }
+    
+    // 本帧记录的网格 / 纹理 / 缓冲区上传在渲染命令之前提交（同一队列，批次末尾有内存屏障）
+    device->getUploadManager().flush();
 
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -689,6 +777,11 @@ void VulkanRenderer::updateUniformBuffer(uint32_t currentImage) {
     glm::vec3 camPos = camera ? camera->getPosition() : glm::vec3(0.0f, 0.0f, 5.0f);
     ubo.viewPos = glm::vec4(camPos, 1.0f);
     
+    // 同一相机用于网格簇剔除和 LOD 选择
+    if (renderSystem) {
+        renderSystem->setCamera(ubo.view, ubo.proj, camPos, static_cast<float>(swapChain->getExtent().height));
+    }
+    
     // 光源绕球体旋转
     float lightRadius = 5.0f;  // 灯光距离球体中心的距离
     float lightSpeed = 0.5f;   // 旋转速度（每秒弧度数）
@@ -705,7 +798,7 @@ void VulkanRenderer::updateUniformBuffer(uint32_t currentImage) {
     ubo.lightColor = glm::vec4(300.0f, 300.0f, 300.0f, 1.0f); // 高强度点光源
     
     // 更新 ForwardPass 的 UBO（不再包含 model 和 normalMatrix，这些通过 Push Constants 传递）
-    forwardPass->updateUniformBuffer(currentImage, ubo);
+    forwardPass->updateUniformBuffer(ubo);
 }
 
 void VulkanRenderer::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
@@ -730,6 +823,11 @@ void VulkanRenderer::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t
     renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
     renderPassInfo.pClearValues = clearValues.data();
 
+    // GPU 剔除的计算调度必须位于渲染通道之外
+    if (renderSystem && scene) {
+        renderSystem->recordGpuCulling(commandBuffer);
+    }
+
     vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
     // 使用 ForwardPass 进行渲染（每个 Pass 管理自己的 Pipeline 和 Descriptor）
@@ -869,12 +967,41 @@ void VulkanRenderer::updateUI() {
         debugPanel->setVertices(vertexCount);
         debugPanel->setTriangles(triangleCount);
         debugPanel->setDrawCalls(drawCalls);
+        if (renderSystem) {
+            debugPanel->setDrawSubmitStats(renderSystem->getDrawSubmitStats());
+        }
+        
+        // 纹理驻留与显存预算
+        auto& textureManager = VulkanEngine::TextureManager::getInstance();
+        VulkanEngine::TextureResidencyStats residency = textureManager.getResidencyStats();
+        debugPanel->setTextureMemory(static_cast<size_t>(textureManager.getTotalMemory()),
+                                     static_cast<size_t>(residency.budgetBytes));
+        debugPanel->setTextureCounts(residency.textureCount, residency.streamingCount, residency.reducedCount);
+
+        // 显存分类统计与堆预算
+        memoryReportTimer += deltaTime;
+        if (memoryReportTimer >= MEMORY_REPORT_INTERVAL) {
+            memoryReportTimer = 0.0f;
+            VulkanMemoryReport report = device->getAllocator().getMemoryReport();
+            debugPanel->setGPUMemory(static_cast<size_t>(report.allocator.reservedBytes));
+            debugPanel->setMemoryReport(report);
+        }
     }
     
     // SceneHierarchyPanel 现在会自动从 ECS 场景获取实体列表
     // 不再需要手动添加示例对象
 }
 
+void VulkanRenderer::dumpMemoryReport(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open " << path << " for writing" << std::endl;
+        return;
+    }
+    device->getAllocator().getMemoryReport().writeJson(file);
+    std::cout << "GPU memory report written to " << path << std::endl;
+}
+
 void VulkanRenderer::renderUI(VkCommandBuffer commandBuffer) {
     if (!imguiLayer || !uiManager || !showUI) return;
     
@@ -900,6 +1027,12 @@ void VulkanRenderer::cleanup() {
     // 清理水面场景资源
     cleanupWaterScene();
     
+    // 释放网格和纹理（设备销毁之前）；未提交的上传命令可能引用它们，先执行完毕
+    device->getUploadManager().waitIdle();
+    if (renderSystem) {
+        renderSystem->cleanup();
+    }
+    
     // 清理同步对象
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
         vkDestroySemaphore(device->getDevice(), renderFinishedSemaphores[i], nullptr);
@@ -926,7 +1059,7 @@ void VulkanRenderer::initWaterScene() {
     
     try {
         // 1. 创建 G-Buffer
-        gbuffer = std::make_unique<GBufferPass>(devicePtr, width, height);
+        gbuffer = std::make_unique<GBufferPass>(devicePtr, width, height, bindlessSetLayout);
         std::cout << "  G-Buffer created" << std::endl;
         
         // 2. 创建 SSR Pass
@@ -1000,14 +1133,7 @@ void VulkanRenderer::cleanupWaterScene() {
         vkDestroyImageView(device->getDevice(), sceneColorView, nullptr);
         sceneColorView = VK_NULL_HANDLE;
     }
-    if (sceneColorImage != VK_NULL_HANDLE) {
-        vkDestroyImage(device->getDevice(), sceneColorImage, nullptr);
-        sceneColorImage = VK_NULL_HANDLE;
-    }
-    if (sceneColorMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(device->getDevice(), sceneColorMemory, nullptr);
-        sceneColorMemory = VK_NULL_HANDLE;
-    }
+    device->destroyImage(sceneColorImage, sceneColorAllocation);
     
     // 清理渲染通道
     waterPass.reset();
@@ -1040,33 +1166,9 @@ void VulkanRenderer::createSceneColorImage() {
         throw std::runtime_error("Failed to create scene color image!");
     }
     
-    // 分配内存
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(device->getDevice(), sceneColorImage, &memRequirements);
-    
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    
-    // 查找合适的内存类型
-    VkPhysicalDeviceMemoryProperties memProperties;
-    vkGetPhysicalDeviceMemoryProperties(device->getPhysicalDevice(), &memProperties);
-    
-    uint32_t memoryTypeIndex = 0;
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((memRequirements.memoryTypeBits & (1 << i)) &&
-            (memProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)) {
-            memoryTypeIndex = i;
-            break;
-        }
-    }
-    allocInfo.memoryTypeIndex = memoryTypeIndex;
-    
-    if (vkAllocateMemory(device->getDevice(), &allocInfo, nullptr, &sceneColorMemory) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to allocate scene color image memory!");
-    }
-    
-    vkBindImageMemory(device->getDevice(), sceneColorImage, sceneColorMemory, 0);
+    // 分配并绑定内存（设备子分配器）
+    sceneColorAllocation = device->getAllocator().allocateImage(sceneColorImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                                VulkanMemoryCategory::RenderTarget);
     
     // 创建图像视图
     VkImageViewCreateInfo viewInfo{};
@@ -1113,11 +1215,11 @@ void VulkanRenderer::updateWaterUniforms(uint32_t frameIndex) {
     glm::mat4 projection = glm::perspective(fov, aspect, 0.1f, 100.0f);
     projection[1][1] *= -1;  // Vulkan Y 轴翻转
     
-    waterPass->updateUniforms(view, projection, camera->getPosition(), totalTime, frameIndex);
+    waterPass->updateUniforms(view, projection, camera->getPosition(), totalTime);
     
     // 更新 SSR Pass 参数
     if (ssrPass) {
-        ssrPass->updateParams(projection, view, camera->getPosition(), frameIndex);
+        ssrPass->updateParams(projection, view, camera->getPosition());
     }
 }
 
@@ -1191,7 +1293,12 @@ void VulkanRenderer::recordWaterSceneCommandBuffer(VkCommandBuffer commandBuffer
         gbufferUBO.lightColor = glm::vec4(300.0f, 300.0f, 300.0f, 1.0f);
         
         // 更新 GBuffer 的 UBO（只包含全局数据）
-        gbuffer->updateUniformBuffer(currentFrame, gbufferUBO);
+        gbuffer->updateUniformBuffer(gbufferUBO);
+        
+        // GPU 剔除的计算调度必须位于渲染通道之外（本帧后续的 Pass 共用结果）
+        if (renderSystem) {
+            renderSystem->recordGpuCulling(commandBuffer);
+        }
         
         // 开始 GBuffer RenderPass
         gbuffer->beginRenderPass(commandBuffer);
@@ -1312,7 +1419,7 @@ void VulkanRenderer::recordWaterSceneCommandBuffer(VkCommandBuffer commandBuffer
             
             // 更新 LightingPass 的 Uniform
             glm::vec3 camPos = camera ? camera->getPosition() : glm::vec3(0.0f, 0.0f, 5.0f);
-            lightingPass->updateUniforms(currentFrame, camPos, lightPosition, 
+            lightingPass->updateUniforms(camPos, lightPosition, 
                                          glm::vec3(300.0f, 300.0f, 300.0f), 1.0f);
             
             // 渲染全屏光照四边形
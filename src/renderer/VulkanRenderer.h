@@ -13,6 +13,7 @@
 #include "VulkanDevice.h"
 #include "VulkanSwapChain.h"
 #include "VulkanBuffer.h"
+#include "FrameAllocator.h"
 #include "Camera.h"
 #include "../scene/Scene.h"
 #include "../resources/RenderSystem.h"
@@ -60,6 +61,12 @@ private:
     
     // 射线拾取（鼠标点击选择物体）
     void handleMousePicking();
+    
+    // 导入 GLB：每个图元一个实体，材质映射到 PBRMaterialComponent
+    void importGLB(const std::string& filePath);
+
+    // 显存报告以 JSON 写入文件（F9），供容量规划使用
+    void dumpMemoryReport(const std::string& path);
 
     // Window
     GLFWwindow* window;
@@ -115,6 +122,9 @@ private:
     // Forward Pass（前向渲染通道）
     std::unique_ptr<ForwardPass> forwardPass;
     
+    // Bindless 材质描述符集布局（未启用时为 VK_NULL_HANDLE，由 TextureManager 持有）
+    VkDescriptorSetLayout bindlessSetLayout = VK_NULL_HANDLE;
+    
     // Lighting Pass（延迟渲染光照阶段）
     std::unique_ptr<LightingPass> lightingPass;
     
@@ -128,7 +138,7 @@ private:
     
     // 场景颜色纹理 (用于 SSR 采样)
     VkImage sceneColorImage = VK_NULL_HANDLE;
-    VkDeviceMemory sceneColorMemory = VK_NULL_HANDLE;
+    VulkanAllocation sceneColorAllocation;
     VkImageView sceneColorView = VK_NULL_HANDLE;
     VkSampler sceneColorSampler = VK_NULL_HANDLE;
     
@@ -142,7 +152,7 @@ private:
     void recordWaterSceneCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
     void updateWaterUniforms(uint32_t frameIndex);
     
-    static const int MAX_FRAMES_IN_FLIGHT = 2;
+    static const int MAX_FRAMES_IN_FLIGHT = FrameAllocator::FRAMES_IN_FLIGHT;
     
     // ========== UI 系统 ==========
     std::unique_ptr<ImGuiLayer> imguiLayer;
@@ -158,6 +168,10 @@ private:
     float deltaTime = 0.0f;
     float lastFrameTime = 0.0f;
     float fps = 0.0f;
+
+    // 显存报告刷新间隔（查询预算有一定开销，不必每帧刷新）
+    static constexpr float MEMORY_REPORT_INTERVAL = 0.5f;
+    float memoryReportTimer = MEMORY_REPORT_INTERVAL;
     
     // UI 是否显示
     bool showUI = true;
@@ -0,0 +1,339 @@
+#include "BlockCompressor.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// BC7 4 位索引插值权重（/64）
+constexpr int BC7_WEIGHTS4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// 按 LSB 优先顺序写入 128 位块（单次写入不超过 32 位）
+class BitWriter {
+public:
+    void write(uint32_t value, uint32_t bits) {
+        const uint64_t field = static_cast<uint64_t>(value) & ((1ull << bits) - 1);
+        if (position < 64) {
+            low |= field << position;
+            if (position + bits > 64) high |= field >> (64 - position);
+        } else {
+            high |= field << (position - 64);
+        }
+        position += bits;
+    }
+
+    void store(uint8_t* out) const {
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<uint8_t>(low >> (i * 8));
+            out[8 + i] = static_cast<uint8_t>(high >> (i * 8));
+        }
+    }
+
+private:
+    uint64_t low = 0;
+    uint64_t high = 0;
+    uint32_t position = 0;
+};
+
+// 7 位端点 + p 位，所有通道共享 p 位，展开后为 (q << 1) | p
+struct Bc7Endpoint {
+    int q[4] = {};
+    int p = 0;
+
+    int value(int c) const { return (q[c] << 1) | p; }
+};
+
+Bc7Endpoint quantizeEndpoint(const float color[4]) {
+    Bc7Endpoint best;
+    float bestError = -1.0f;
+    for (int p = 0; p < 2; ++p) {
+        Bc7Endpoint candidate;
+        candidate.p = p;
+        float error = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            float v = std::min(std::max(color[c], 0.0f), 255.0f);
+            candidate.q[c] = std::min(std::max(static_cast<int>((v - p) * 0.5f + 0.5f), 0), 127);
+            float d = static_cast<float>(candidate.value(c)) - v;
+            error += d * d;
+        }
+        if (bestError < 0.0f || error < bestError) {
+            bestError = error;
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+// 选择每个像素最接近的调色板项，返回总平方误差
+// 先按在端点连线上的投影位置估计索引，再在相邻三项中比较实际误差
+uint32_t assignIndicesBC7(const uint8_t* block, const Bc7Endpoint& e0, const Bc7Endpoint& e1, uint8_t indices[16]) {
+    // 投影位置（0..64）-> 最近的权重索引
+    static const auto nearestIndex = [] {
+        std::array<uint8_t, 65> table{};
+        for (int t = 0; t <= 64; ++t) {
+            int best = 0;
+            for (int i = 1; i < 16; ++i) {
+                if (std::abs(BC7_WEIGHTS4[i] - t) < std::abs(BC7_WEIGHTS4[best] - t)) best = i;
+            }
+            table[t] = static_cast<uint8_t>(best);
+        }
+        return table;
+    }();
+
+    int palette[16][4];
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            palette[i][c] = ((64 - BC7_WEIGHTS4[i]) * e0.value(c) + BC7_WEIGHTS4[i] * e1.value(c) + 32) >> 6;
+        }
+    }
+
+    int direction[4];
+    int lengthSquared = 0;
+    for (int c = 0; c < 4; ++c) {
+        direction[c] = e1.value(c) - e0.value(c);
+        lengthSquared += direction[c] * direction[c];
+    }
+    const float scale = lengthSquared > 0 ? 64.0f / lengthSquared : 0.0f;
+
+    uint32_t total = 0;
+    for (int p = 0; p < 16; ++p) {
+        const uint8_t* pixel = block + p * 4;
+        int dot = 0;
+        for (int c = 0; c < 4; ++c) dot += (pixel[c] - e0.value(c)) * direction[c];
+        const float position = dot * scale;
+        const int t = position <= 0.0f ? 0 : std::min(static_cast<int>(position + 0.5f), 64);
+        const int guess = nearestIndex[t];
+
+        uint32_t bestError = UINT32_MAX;
+        uint8_t bestIndex = 0;
+        for (int i = std::max(guess - 1, 0); i <= std::min(guess + 1, 15); ++i) {
+            uint32_t error = 0;
+            for (int c = 0; c < 4; ++c) {
+                int d = palette[i][c] - pixel[c];
+                error += static_cast<uint32_t>(d * d);
+            }
+            if (error < bestError) {
+                bestError = error;
+                bestIndex = static_cast<uint8_t>(i);
+            }
+        }
+        indices[p] = bestIndex;
+        total += bestError;
+    }
+    return total;
+}
+
+// 固定索引，按最小二乘重新求解两个端点（每通道独立的 2x2 方程）
+bool refitEndpoints(const uint8_t* block, const uint8_t indices[16], float e0[4], float e1[4]) {
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ax[4] = {}, bx[4] = {};
+    for (int p = 0; p < 16; ++p) {
+        float w = BC7_WEIGHTS4[indices[p]] / 64.0f;
+        float a = 1.0f - w;
+        aa += a * a;
+        ab += a * w;
+        bb += w * w;
+        for (int c = 0; c < 4; ++c) {
+            ax[c] += a * block[p * 4 + c];
+            bx[c] += w * block[p * 4 + c];
+        }
+    }
+
+    float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) {
+        return false;
+    }
+    float inv = 1.0f / det;
+    for (int c = 0; c < 4; ++c) {
+        e0[c] = (ax[c] * bb - bx[c] * ab) * inv;
+        e1[c] = (bx[c] * aa - ax[c] * ab) * inv;
+    }
+    return true;
+}
+
+// 取出 4x4 块（边缘重复最后一行/列）
+void loadBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t bx, uint32_t by, uint8_t block[64]) {
+    for (uint32_t y = 0; y < 4; ++y) {
+        const uint32_t sy = std::min(by * 4 + y, height - 1);
+        for (uint32_t x = 0; x < 4; ++x) {
+            const uint32_t sx = std::min(bx * 4 + x, width - 1);
+            std::memcpy(block + (y * 4 + x) * 4, rgba + (static_cast<size_t>(sy) * width + sx) * 4, 4);
+        }
+    }
+}
+
+template <typename EncodeBlock>
+void encodeImage(const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* out, size_t blockSize,
+                 EncodeBlock encodeBlock) {
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+
+    auto processRows = [&](size_t begin, size_t end) {
+        uint8_t block[64];
+        for (size_t by = begin; by < end; ++by) {
+            uint8_t* row = out + by * blocksX * blockSize;
+            for (uint32_t bx = 0; bx < blocksX; ++bx) {
+                loadBlock(rgba, width, height, bx, static_cast<uint32_t>(by), block);
+                encodeBlock(block, row + bx * blockSize);
+            }
+        }
+    };
+
+    ThreadPool& pool = ThreadPool::getShared();
+    if (blocksY >= BlockCompressor::PARALLEL_MIN_BLOCK_ROWS && pool.getThreadCount() >= 2) {
+        pool.parallelFor(blocksY, 1, processRows);
+    } else {
+        processRows(0, blocksY);
+    }
+}
+
+} // namespace
+
+size_t BlockCompressor::getCompressedSize(uint32_t width, uint32_t height, size_t blockSize) {
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+}
+
+void BlockCompressor::encodeBlockBC7(const uint8_t* block, uint8_t* out) {
+    // 主成分方向：均值 + 协方差幂迭代
+    float mean[4] = {};
+    for (int p = 0; p < 16; ++p) {
+        for (int c = 0; c < 4; ++c) mean[c] += block[p * 4 + c];
+    }
+    for (int c = 0; c < 4; ++c) mean[c] /= 16.0f;
+
+    float cov[4][4] = {};
+    for (int p = 0; p < 16; ++p) {
+        float d[4];
+        for (int c = 0; c < 4; ++c) d[c] = block[p * 4 + c] - mean[c];
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) cov[i][j] += d[i] * d[j];
+        }
+    }
+
+    float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[4] = {};
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) next[i] += cov[i][j] * axis[j];
+        }
+        float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2] + next[3] * next[3]);
+        if (length < 1e-6f) break;
+        for (int c = 0; c < 4; ++c) axis[c] = next[c] / length;
+    }
+
+    float minT = 0.0f, maxT = 0.0f;
+    for (int p = 0; p < 16; ++p) {
+        float t = 0.0f;
+        for (int c = 0; c < 4; ++c) t += (block[p * 4 + c] - mean[c]) * axis[c];
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+
+    float c0[4], c1[4];
+    for (int c = 0; c < 4; ++c) {
+        c0[c] = mean[c] + axis[c] * minT;
+        c1[c] = mean[c] + axis[c] * maxT;
+    }
+
+    Bc7Endpoint e0 = quantizeEndpoint(c0);
+    Bc7Endpoint e1 = quantizeEndpoint(c1);
+    uint8_t indices[16];
+    uint32_t error = assignIndicesBC7(block, e0, e1, indices);
+
+    // 按当前索引做一次最小二乘修正，误差更小时采用
+    if (error > 0 && refitEndpoints(block, indices, c0, c1)) {
+        Bc7Endpoint r0 = quantizeEndpoint(c0);
+        Bc7Endpoint r1 = quantizeEndpoint(c1);
+        uint8_t refined[16];
+        uint32_t refinedError = assignIndicesBC7(block, r0, r1, refined);
+        if (refinedError < error) {
+            e0 = r0;
+            e1 = r1;
+            std::memcpy(indices, refined, sizeof(indices));
+        }
+    }
+
+    // 锚点（第 0 个像素）索引最高位隐含为 0：必要时交换端点并反转索引
+    if (indices[0] & 8) {
+        std::swap(e0, e1);
+        for (uint8_t& index : indices) index = static_cast<uint8_t>(15 - index);
+    }
+
+    BitWriter writer;
+    writer.write(1u << 6, 7);   // 模式 6
+    for (int c = 0; c < 4; ++c) {
+        writer.write(static_cast<uint32_t>(e0.q[c]), 7);
+        writer.write(static_cast<uint32_t>(e1.q[c]), 7);
+    }
+    writer.write(static_cast<uint32_t>(e0.p), 1);
+    writer.write(static_cast<uint32_t>(e1.p), 1);
+    writer.write(indices[0], 3);
+    for (int p = 1; p < 16; ++p) {
+        writer.write(indices[p], 4);
+    }
+    writer.store(out);
+}
+
+void BlockCompressor::encodeBlockBC4(const uint8_t* block, int channel, uint8_t* out) {
+    int minValue = 255, maxValue = 0;
+    for (int p = 0; p < 16; ++p) {
+        int v = block[p * 4 + channel];
+        minValue = std::min(minValue, v);
+        maxValue = std::max(maxValue, v);
+    }
+
+    // e0 > e1 时为 8 级模式：0 = e0，1 = e1，2..7 为 (8 - i) / 7 处的插值；
+    // e0 == e1 时所有像素取索引 0
+    out[0] = static_cast<uint8_t>(maxValue);
+    out[1] = static_cast<uint8_t>(minValue);
+
+    float palette[8];
+    palette[0] = static_cast<float>(maxValue);
+    palette[1] = static_cast<float>(minValue);
+    for (int i = 2; i < 8; ++i) {
+        palette[i] = ((8 - i) * maxValue + (i - 1) * minValue) / 7.0f;
+    }
+
+    uint64_t bits = 0;
+    if (maxValue > minValue) {
+        for (int p = 0; p < 16; ++p) {
+            float v = block[p * 4 + channel];
+            int bestIndex = 0;
+            float bestError = std::fabs(palette[0] - v);
+            for (int i = 1; i < 8; ++i) {
+                float error = std::fabs(palette[i] - v);
+                if (error < bestError) {
+                    bestError = error;
+                    bestIndex = i;
+                }
+            }
+            bits |= static_cast<uint64_t>(bestIndex) << (p * 3);
+        }
+    }
+    for (int i = 0; i < 6; ++i) {
+        out[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+    }
+}
+
+void BlockCompressor::encodeBC7(const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* out) {
+    encodeImage(rgba, width, height, out, BC7_BLOCK_SIZE, [](const uint8_t* block, uint8_t* dst) {
+        encodeBlockBC7(block, dst);
+    });
+}
+
+void BlockCompressor::encodeBC5(const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* out) {
+    encodeImage(rgba, width, height, out, BC5_BLOCK_SIZE, [](const uint8_t* block, uint8_t* dst) {
+        encodeBlockBC4(block, 0, dst);
+        encodeBlockBC4(block, 1, dst + BC4_BLOCK_SIZE);
+    });
+}
+
+void BlockCompressor::encodeBC4(const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* out) {
+    encodeImage(rgba, width, height, out, BC4_BLOCK_SIZE, [](const uint8_t* block, uint8_t* dst) {
+        encodeBlockBC4(block, 0, dst);
+    });
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * CPU 端 BC 块压缩编码器（纯 CPU 实现，不依赖 GPU，可在无显示环境下烘焙纹理）
+ *
+ * 输入均为 RGBA8 紧密排列的像素，输出为按行排列的 4x4 块，块行数 ceil(h/4)，
+ * 每行 ceil(w/4) 块；不足 4 像素的边缘块重复最后一行/列填充。
+ * - BC7：只使用模式 6（单子集，RGBA 端点 7 位 + 每端点 p 位，4 位索引）。
+ *   端点取主成分方向上的投影极值，量化后按索引做一次最小二乘修正
+ * - BC4：R 通道，端点取块内最小/最大值，8 级插值
+ * - BC5：R、G 两个通道各一个 BC4 块（用于法线贴图，Z 在着色器中重建）
+ * 块行数超过 PARALLEL_MIN_BLOCK_ROWS 且共享线程池至少有两个工作线程时按块行并行
+ */
+class BlockCompressor {
+public:
+    static constexpr size_t PARALLEL_MIN_BLOCK_ROWS = 16;
+
+    static constexpr size_t BC4_BLOCK_SIZE = 8;
+    static constexpr size_t BC5_BLOCK_SIZE = 16;
+    static constexpr size_t BC7_BLOCK_SIZE = 16;
+
+    /**
+     * @brief 压缩后数据大小
+     */
+    static size_t getCompressedSize(uint32_t width, uint32_t height, size_t blockSize);
+
+    static void encodeBC7(const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* out);
+    static void encodeBC5(const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* out);
+    static void encodeBC4(const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* out);
+
+    /**
+     * @brief 单块编码（block 为 16 个 RGBA8 像素，行优先）
+     */
+    static void encodeBlockBC7(const uint8_t* block, uint8_t* out);
+    static void encodeBlockBC4(const uint8_t* block, int channel, uint8_t* out);
+};
@@ -0,0 +1,92 @@
+#include "DrawSort.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace VulkanEngine {
+
+namespace {
+
+// 少量绘制时插入排序更快（同样稳定）
+constexpr size_t INSERTION_SORT_THRESHOLD = 64;
+
+uint64_t field(uint32_t value, uint32_t bits) {
+    return static_cast<uint64_t>(value) & ((1ull << bits) - 1);
+}
+
+} // namespace
+
+uint64_t DrawSort::makeKey(uint32_t pass, uint32_t pipeline, uint32_t material,
+                           uint32_t vertexPage, uint32_t indexPage, uint32_t mesh, float depth) {
+    uint64_t key = field(pass, PASS_BITS);
+    key = (key << PIPELINE_BITS) | field(pipeline, PIPELINE_BITS);
+    key = (key << MATERIAL_BITS) | field(material, MATERIAL_BITS);
+    key = (key << PAGE_BITS) | std::min<uint64_t>(vertexPage, (1u << PAGE_BITS) - 1);
+    key = (key << PAGE_BITS) | std::min<uint64_t>(indexPage, (1u << PAGE_BITS) - 1);
+    key = (key << MESH_BITS) | field(mesh, MESH_BITS);
+    key = (key << DEPTH_BITS) | quantizeDepth(depth);
+    return key;
+}
+
+uint32_t DrawSort::quantizeDepth(float depth) {
+    // 非负 float 的位模式按数值单调递增；NaN 视为 0
+    if (!(depth > 0.0f)) return 0;
+
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return bits >> (31 - DEPTH_BITS);
+}
+
+void DrawSort::sort(std::vector<DrawPacket>& packets, std::vector<DrawPacket>& scratch) {
+    const size_t count = packets.size();
+    if (count < 2) return;
+
+    if (count <= INSERTION_SORT_THRESHOLD) {
+        for (size_t i = 1; i < count; ++i) {
+            DrawPacket packet = packets[i];
+            size_t j = i;
+            for (; j > 0 && packets[j - 1].key > packet.key; --j) {
+                packets[j] = packets[j - 1];
+            }
+            packets[j] = packet;
+        }
+        return;
+    }
+
+    // 一次遍历统计 8 个字节的直方图
+    uint32_t histograms[8][256] = {};
+    for (const DrawPacket& packet : packets) {
+        for (uint32_t byte = 0; byte < 8; ++byte) {
+            ++histograms[byte][(packet.key >> (byte * 8)) & 0xFF];
+        }
+    }
+
+    scratch.resize(count);
+    DrawPacket* source = packets.data();
+    DrawPacket* destination = scratch.data();
+
+    for (uint32_t byte = 0; byte < 8; ++byte) {
+        uint32_t* histogram = histograms[byte];
+
+        // 所有键在该字节上相同：本趟不改变顺序
+        const uint32_t first = static_cast<uint32_t>((source[0].key >> (byte * 8)) & 0xFF);
+        if (histogram[first] == count) continue;
+
+        uint32_t offset = 0;
+        for (uint32_t bucket = 0; bucket < 256; ++bucket) {
+            const uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            destination[histogram[(source[i].key >> (byte * 8)) & 0xFF]++] = source[i];
+        }
+        std::swap(source, destination);
+    }
+
+    if (source != packets.data()) {
+        std::copy(source, source + count, packets.data());
+    }
+}
+
+} // namespace VulkanEngine
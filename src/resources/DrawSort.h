@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace VulkanEngine {
+
+/**
+ * @brief 一次绘制：排序键 + 可渲染实体下标
+ */
+struct DrawPacket {
+    uint64_t key = 0;
+    uint32_t renderable = 0;
+};
+
+/**
+ * @brief 绘制提交统计（每帧，所有 Pass 累计）：skipped 为与上一次绑定相同而省去的调用
+ */
+struct DrawSubmitStats {
+    uint32_t draws = 0;
+    uint32_t instances = 0;          // 绘制的实体实例数
+    uint32_t instancedDraws = 0;     // 合并了多个实例的绘制批次
+    uint32_t indirectDraws = 0;      // GPU 驱动路径提交的间接绘制命令（instances 为剔除前的候选数）
+    uint32_t pipelineBinds = 0;
+    uint32_t pipelineBindsSkipped = 0;
+    uint32_t descriptorBinds = 0;
+    uint32_t descriptorBindsSkipped = 0;
+    uint32_t vertexBufferBinds = 0;
+    uint32_t vertexBufferBindsSkipped = 0;
+    uint32_t indexBufferBinds = 0;
+    uint32_t indexBufferBindsSkipped = 0;
+
+    uint32_t getBindsSaved() const {
+        return pipelineBindsSkipped + descriptorBindsSkipped + vertexBufferBindsSkipped + indexBufferBindsSkipped;
+    }
+};
+
+/**
+ * 绘制排序：64 位键从高到低依次为
+ *   pass(4) | pipeline(2) | material(20) | 顶点页(4) | 索引页(4) | mesh(14) | depth(16)
+ * 按状态切换代价从高到低排列，排序后相同管线 / 材质 / 几何缓冲区的绘制相邻，
+ * 提交时跳过重复绑定；同一状态内按网格聚集（实例化合并只看相邻的绘制包），再按深度从近到远（不透明物体减少过度绘制）。
+ * 超出位宽的字段截断，只影响分组效果，不影响正确性（绑定跳过和实例化合并都比较实际状态）。
+ * 深度取非负 float 的位模式高 16 位（8 位指数 + 8 位尾数），相对精度约 0.4%，与数值单调一致。
+ * 排序为 LSD 基数排序（8 位一趟，所有键在某一字节上相同时跳过该趟），稳定，O(n)
+ */
+class DrawSort {
+public:
+    static constexpr uint32_t PASS_BITS = 4;
+    static constexpr uint32_t PIPELINE_BITS = 2;
+    static constexpr uint32_t MATERIAL_BITS = 20;
+    static constexpr uint32_t PAGE_BITS = 4;
+    static constexpr uint32_t MESH_BITS = 14;
+    static constexpr uint32_t DEPTH_BITS = 16;
+
+    static_assert(PASS_BITS + PIPELINE_BITS + MATERIAL_BITS + 2 * PAGE_BITS + MESH_BITS + DEPTH_BITS == 64,
+                  "Draw sort key fields must fill exactly 64 bits");
+
+    /**
+     * @brief 组合排序键
+     *
+     * mesh 为网格句柄的槽位下标，只保留低 MESH_BITS 位（16384 个网格槽位）。超过后相差 16384 的网格
+     * 共用同一字段值，同一状态内会按深度交错，实例化批次被拆散；material 同理（约 100 万个槽位）。
+     * 页号超过 15 时取 15。
+     */
+    static uint64_t makeKey(uint32_t pass, uint32_t pipeline, uint32_t material,
+                            uint32_t vertexPage, uint32_t indexPage, uint32_t mesh, float depth);
+
+    /**
+     * @brief 把到相机的距离量化为 DEPTH_BITS 位（负数按 0 处理）
+     */
+    static uint32_t quantizeDepth(float depth);
+
+    /**
+     * @brief 按 key 升序排序，scratch 为同样大小的临时数组（跨帧复用避免分配）
+     */
+    static void sort(std::vector<DrawPacket>& packets, std::vector<DrawPacket>& scratch);
+};
+
+} // namespace VulkanEngine
@@ -0,0 +1,144 @@
+#include "GeometryArena.h"
+#include "VulkanDevice.h"
+#include "UploadManager.h"
+#include <algorithm>
+#include <iostream>
+
+namespace VulkanEngine {
+
+GeometryArena::GeometryArena(std::shared_ptr<VulkanDevice> device, VkBufferUsageFlags usage,
+                             uint32_t elementSize, uint32_t pageElements)
+    : m_device(device)
+    , m_usage(usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT)
+    , m_elementSize(elementSize)
+    , m_pageElements(pageElements) {
+}
+
+GeometryArena::Range GeometryArena::allocate(uint32_t count) {
+    Range range;
+    if (count == 0) return range;
+
+    for (uint32_t i = 0; i < m_pages.size(); ++i) {
+        if (allocateFromPage(i, count, range)) {
+            return range;
+        }
+    }
+
+    const uint32_t page = createPage(std::max(count, m_pageElements));
+    allocateFromPage(page, count, range);
+    return range;
+}
+
+void GeometryArena::free(Range& range) {
+    if (!range.isValid()) return;
+
+    Page& page = m_pages[range.page];
+    page.used -= range.count;
+    --page.rangeCount;
+
+    // 插入空闲区间并与前后相邻的空闲区间合并
+    auto it = page.freeRanges.emplace(range.first, range.count).first;
+    auto next = std::next(it);
+    if (next != page.freeRanges.end() && it->first + it->second == next->first) {
+        it->second += next->second;
+        page.freeRanges.erase(next);
+    }
+    if (it != page.freeRanges.begin()) {
+        auto prev = std::prev(it);
+        if (prev->first + prev->second == it->first) {
+            prev->second += it->second;
+            page.freeRanges.erase(it);
+        }
+    }
+
+    // 单独占页的超大区间释放后归还整页内存（保留页索引，仍在使用的区间不受影响）
+    if (page.rangeCount == 0 && page.capacity > m_pageElements) {
+        page.buffer.reset();
+        page.capacity = 0;
+        page.freeRanges.clear();
+    }
+    range = Range{};
+}
+
+void GeometryArena::retire(Range& range) {
+    if (!range.isValid()) return;
+    m_retiredRanges.emplace_back(m_frame + RETIRE_DELAY_FRAMES, range);
+    range = Range{};
+}
+
+void GeometryArena::beginFrame() {
+    ++m_frame;
+    while (!m_retiredRanges.empty() && m_retiredRanges.front().first <= m_frame) {
+        free(m_retiredRanges.front().second);
+        m_retiredRanges.pop_front();
+    }
+}
+
+void GeometryArena::upload(const Range& range, const void* data, uint32_t count, uint32_t elementOffset) {
+    if (!range.isValid() || count == 0) return;
+
+    const VkDeviceSize offset = static_cast<VkDeviceSize>(range.first + elementOffset) * m_elementSize;
+    m_device->getUploadManager().uploadBuffer(getBuffer(range.page), data,
+                                              static_cast<VkDeviceSize>(count) * m_elementSize, offset);
+}
+
+GeometryArenaStats GeometryArena::getStats() const {
+    GeometryArenaStats stats;
+    for (const Page& page : m_pages) {
+        if (!page.buffer) continue;
+        ++stats.pageCount;
+        stats.rangeCount += page.rangeCount;
+        stats.capacityElements += page.capacity;
+        stats.usedElements += page.used;
+        stats.freeRangeCount += static_cast<uint32_t>(page.freeRanges.size());
+    }
+    return stats;
+}
+
+bool GeometryArena::allocateFromPage(uint32_t pageIndex, uint32_t count, Range& range) {
+    Page& page = m_pages[pageIndex];
+    if (!page.buffer || page.capacity - page.used < count) return false;
+
+    for (auto it = page.freeRanges.begin(); it != page.freeRanges.end(); ++it) {
+        if (it->second < count) continue;
+
+        range.page = pageIndex;
+        range.first = it->first;
+        range.count = count;
+
+        const uint32_t remaining = it->second - count;
+        const uint32_t next = it->first + count;
+        page.freeRanges.erase(it);
+        if (remaining > 0) {
+            page.freeRanges.emplace(next, remaining);
+        }
+        page.used += count;
+        ++page.rangeCount;
+        return true;
+    }
+    return false;
+}
+
+uint32_t GeometryArena::createPage(uint32_t capacity) {
+    // 优先复用已释放的页槽位
+    auto slot = std::find_if(m_pages.begin(), m_pages.end(), [](const Page& page) { return !page.buffer; });
+    if (slot == m_pages.end()) {
+        m_pages.emplace_back();
+        slot = m_pages.end() - 1;
+    }
+
+    slot->buffer = std::make_unique<VulkanBuffer>(m_device, static_cast<VkDeviceSize>(capacity) * m_elementSize,
+                                                  m_usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                  VulkanMemoryCategory::Mesh);
+    slot->capacity = capacity;
+    slot->used = 0;
+    slot->rangeCount = 0;
+    slot->freeRanges.clear();
+    slot->freeRanges.emplace(0u, capacity);
+
+    std::cout << "[GeometryArena] New page: " << ((static_cast<uint64_t>(capacity) * m_elementSize) >> 20)
+              << " MB (" << m_elementSize << "-byte elements)" << std::endl;
+    return static_cast<uint32_t>(slot - m_pages.begin());
+}
+
+} // namespace VulkanEngine
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "VulkanBuffer.h"
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+class VulkanDevice;
+
+namespace VulkanEngine {
+
+/**
+ * @brief 几何缓冲区统计
+ */
+struct GeometryArenaStats {
+    uint32_t pageCount = 0;
+    uint32_t rangeCount = 0;
+    uint64_t capacityElements = 0;
+    uint64_t usedElements = 0;
+    uint32_t freeRangeCount = 0;
+};
+
+/**
+ * @brief 共享几何缓冲区（顶点或索引）
+ *
+ * 由若干设备本地的大缓冲区（页）组成，按元素（顶点 / 索引）为单位分配区间，
+ * 这样顶点区间的起点可直接作为 vkCmdDrawIndexed 的 vertexOffset，索引区间的起点作为 firstIndex 的基址。
+ * 页内空闲区间按起点排序，首次适配分配，释放时与相邻空闲区间合并。
+ * 放不下时新建一页（超过页容量的网格单独占一页），绘制时只有页切换才需要重新绑定缓冲区。
+ * 数据经 UploadManager 的暂存环上传。只在主线程使用。
+ * 已提交的帧可能仍在读取网格的区间，卸载时用 retire 延迟 RETIRE_DELAY_FRAMES 帧再归还（beginFrame 中释放）。
+ */
+class GeometryArena {
+public:
+    static constexpr uint64_t RETIRE_DELAY_FRAMES = 3;      // 大于渲染器的 MAX_FRAMES_IN_FLIGHT
+
+    struct Range {
+        uint32_t page = UINT32_MAX;
+        uint32_t first = 0;       // 页内起始元素
+        uint32_t count = 0;
+
+        bool isValid() const { return page != UINT32_MAX; }
+    };
+
+    /**
+     * @param elementSize 元素字节数（顶点步长或 sizeof(uint32_t)）
+     * @param pageElements 每页的元素数
+     */
+    GeometryArena(std::shared_ptr<VulkanDevice> device, VkBufferUsageFlags usage,
+                  uint32_t elementSize, uint32_t pageElements);
+
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    Range allocate(uint32_t count);
+    void free(Range& range);
+
+    /**
+     * @brief 延迟释放：区间在 RETIRE_DELAY_FRAMES 帧后才可重新分配（调用后 range 置为无效）
+     */
+    void retire(Range& range);
+
+    /**
+     * @brief 推进帧计数并释放到期的区间（主线程每帧调用）
+     */
+    void beginFrame();
+
+    /**
+     * @brief 上传数据到区间内（elementOffset 为区间内的元素偏移）
+     */
+    void upload(const Range& range, const void* data, uint32_t count, uint32_t elementOffset = 0);
+
+    VkBuffer getBuffer(uint32_t page) const {
+        return page < m_pages.size() && m_pages[page].buffer ? m_pages[page].buffer->getBuffer() : VK_NULL_HANDLE;
+    }
+
+    uint32_t getElementSize() const { return m_elementSize; }
+    GeometryArenaStats getStats() const;
+
+private:
+    struct Page {
+        std::unique_ptr<VulkanBuffer> buffer;
+        uint32_t capacity = 0;
+        uint32_t used = 0;
+        uint32_t rangeCount = 0;
+        std::map<uint32_t, uint32_t> freeRanges;   // 起点 -> 元素数
+    };
+
+    bool allocateFromPage(uint32_t pageIndex, uint32_t count, Range& range);
+    uint32_t createPage(uint32_t capacity);
+
+    std::shared_ptr<VulkanDevice> m_device;
+    VkBufferUsageFlags m_usage;
+    uint32_t m_elementSize;
+    uint32_t m_pageElements;
+    std::vector<Page> m_pages;
+    uint64_t m_frame = 0;
+    std::deque<std::pair<uint64_t, Range>> m_retiredRanges;   // (可释放的帧, 区间)
+};
+
+} // namespace VulkanEngine
@@ -0,0 +1,969 @@
+#include "GltfLoader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+namespace {
+
+constexpr uint32_t GLB_MAGIC = 0x46546C67;       // "glTF"
+constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;  // "JSON"
+constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;   // "BIN\0"
+
+constexpr uint32_t COMPONENT_BYTE = 5120;
+constexpr uint32_t COMPONENT_UNSIGNED_BYTE = 5121;
+constexpr uint32_t COMPONENT_SHORT = 5122;
+constexpr uint32_t COMPONENT_UNSIGNED_SHORT = 5123;
+constexpr uint32_t COMPONENT_UNSIGNED_INT = 5125;
+constexpr uint32_t COMPONENT_FLOAT = 5126;
+
+constexpr int64_t MODE_TRIANGLES = 4;
+constexpr int MAX_JSON_DEPTH = 64;
+constexpr int MAX_NODE_DEPTH = 256;
+
+// ============================================================
+// 最小 JSON DOM（只用于 glTF 描述块，数据量小，不追求解析速度）
+// ============================================================
+
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    bool isNumber() const { return type == Type::Number; }
+    bool isString() const { return type == Type::String; }
+    bool isArray() const { return type == Type::Array; }
+    bool isObject() const { return type == Type::Object; }
+
+    const JsonValue* find(const char* key) const {
+        if (type != Type::Object) return nullptr;
+        for (const auto& member : object) {
+            if (member.first == key) return &member.second;
+        }
+        return nullptr;
+    }
+
+    const std::vector<JsonValue>& items(const char* key) const {
+        static const std::vector<JsonValue> empty;
+        const JsonValue* value = find(key);
+        return value && value->isArray() ? value->array : empty;
+    }
+
+    double getNumber(const char* key, double fallback) const {
+        const JsonValue* value = find(key);
+        return value && value->isNumber() ? value->number : fallback;
+    }
+
+    int32_t getIndex(const char* key) const {
+        const JsonValue* value = find(key);
+        return value && value->isNumber() && value->number >= 0.0 ? static_cast<int32_t>(value->number) : -1;
+    }
+
+    std::string getString(const char* key) const {
+        const JsonValue* value = find(key);
+        return value && value->isString() ? value->string : std::string();
+    }
+};
+
+class JsonReader {
+public:
+    JsonReader(const char* begin, const char* end) : p(begin), end(end) {}
+
+    bool parse(JsonValue& out, std::string& error) {
+        if (!parseValue(out, 0)) {
+            error = "invalid JSON: " + message;
+            return false;
+        }
+        skipSpace();
+        // GLB 的 JSON 块以空格补齐到 4 字节
+        while (p < end && *p == '\0') ++p;
+        if (p != end) {
+            error = "invalid JSON: trailing data";
+            return false;
+        }
+        return true;
+    }
+
+private:
+    const char* p;
+    const char* end;
+    std::string message;
+
+    bool fail(const char* text) {
+        if (message.empty()) message = text;
+        return false;
+    }
+
+    void skipSpace() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) ++p;
+    }
+
+    bool consume(const char* literal) {
+        size_t length = std::strlen(literal);
+        if (static_cast<size_t>(end - p) < length || std::memcmp(p, literal, length) != 0) return false;
+        p += length;
+        return true;
+    }
+
+    bool parseValue(JsonValue& out, int depth) {
+        if (depth > MAX_JSON_DEPTH) return fail("nesting too deep");
+        skipSpace();
+        if (p >= end) return fail("unexpected end");
+
+        switch (*p) {
+            case '{': return parseObject(out, depth);
+            case '[': return parseArray(out, depth);
+            case '"':
+                out.type = JsonValue::Type::String;
+                return parseString(out.string);
+            case 't':
+                out.type = JsonValue::Type::Bool;
+                out.boolean = true;
+                return consume("true") || fail("bad literal");
+            case 'f':
+                out.type = JsonValue::Type::Bool;
+                out.boolean = false;
+                return consume("false") || fail("bad literal");
+            case 'n':
+                out.type = JsonValue::Type::Null;
+                return consume("null") || fail("bad literal");
+            default:
+                return parseNumber(out);
+        }
+    }
+
+    bool parseObject(JsonValue& out, int depth) {
+        out.type = JsonValue::Type::Object;
+        ++p;
+        skipSpace();
+        if (p < end && *p == '}') {
+            ++p;
+            return true;
+        }
+        while (true) {
+            skipSpace();
+            std::string key;
+            if (p >= end || *p != '"' || !parseString(key)) return fail("expected object key");
+            skipSpace();
+            if (p >= end || *p != ':') return fail("expected ':'");
+            ++p;
+            out.object.emplace_back(std::move(key), JsonValue());
+            if (!parseValue(out.object.back().second, depth + 1)) return false;
+            skipSpace();
+            if (p < end && *p == ',') {
+                ++p;
+                continue;
+            }
+            if (p < end && *p == '}') {
+                ++p;
+                return true;
+            }
+            return fail("expected ',' or '}'");
+        }
+    }
+
+    bool parseArray(JsonValue& out, int depth) {
+        out.type = JsonValue::Type::Array;
+        ++p;
+        skipSpace();
+        if (p < end && *p == ']') {
+            ++p;
+            return true;
+        }
+        while (true) {
+            out.array.emplace_back();
+            if (!parseValue(out.array.back(), depth + 1)) return false;
+            skipSpace();
+            if (p < end && *p == ',') {
+                ++p;
+                continue;
+            }
+            if (p < end && *p == ']') {
+                ++p;
+                return true;
+            }
+            return fail("expected ',' or ']'");
+        }
+    }
+
+    bool parseHex4(uint32_t& value) {
+        if (end - p < 4) return false;
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = *p++;
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= c - '0';
+            else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    bool parseString(std::string& out) {
+        ++p;  // '"'
+        while (p < end) {
+            char c = *p++;
+            if (c == '"') return true;
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (p >= end) break;
+            char escape = *p++;
+            switch (escape) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    uint32_t code = 0;
+                    if (!parseHex4(code)) return fail("bad \\u escape");
+                    // 代理对
+                    if (code >= 0xD800 && code <= 0xDBFF && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                        p += 2;
+                        uint32_t low = 0;
+                        if (!parseHex4(low) || low < 0xDC00 || low > 0xDFFF) return fail("bad surrogate pair");
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default:
+                    return fail("bad escape");
+            }
+        }
+        return fail("unterminated string");
+    }
+
+    bool parseNumber(JsonValue& out) {
+        const char* begin = p;
+        if (p < end && (*p == '-' || *p == '+')) ++p;
+        while (p < end && (std::isdigit(static_cast<unsigned char>(*p)) || *p == '.' || *p == 'e' ||
+                           *p == 'E' || *p == '-' || *p == '+')) {
+            ++p;
+        }
+        if (p == begin) return fail("unexpected character");
+
+        std::string text(begin, p);
+        char* parsed = nullptr;
+        out.type = JsonValue::Type::Number;
+        out.number = std::strtod(text.c_str(), &parsed);
+        return (parsed == text.c_str() + text.size()) || fail("bad number");
+    }
+};
+
+// ============================================================
+// 辅助函数
+// ============================================================
+
+inline uint32_t readU32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+size_t componentSize(uint32_t componentType) {
+    switch (componentType) {
+        case COMPONENT_BYTE:
+        case COMPONENT_UNSIGNED_BYTE: return 1;
+        case COMPONENT_SHORT:
+        case COMPONENT_UNSIGNED_SHORT: return 2;
+        case COMPONENT_UNSIGNED_INT:
+        case COMPONENT_FLOAT: return 4;
+        default: return 0;
+    }
+}
+
+uint32_t componentCount(const std::string& type) {
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4") return 4;
+    if (type == "MAT4") return 16;
+    return 0;
+}
+
+bool readVec3(const JsonValue* value, glm::vec3& out) {
+    if (!value || !value->isArray() || value->array.size() < 3) return false;
+    for (int i = 0; i < 3; ++i) {
+        out[i] = static_cast<float>(value->array[i].number);
+    }
+    return true;
+}
+
+// 节点局部变换：matrix 优先，否则按 T * R * S 组合
+glm::mat4 nodeMatrix(const JsonValue& node) {
+    glm::mat4 result(1.0f);
+
+    const JsonValue* matrix = node.find("matrix");
+    if (matrix && matrix->isArray() && matrix->array.size() == 16) {
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 4; ++row) {
+                result[column][row] = static_cast<float>(matrix->array[column * 4 + row].number);
+            }
+        }
+        return result;
+    }
+
+    glm::vec3 translation(0.0f);
+    glm::vec3 scale(1.0f);
+    float q[4] = { 0.0f, 0.0f, 0.0f, 1.0f };  // x, y, z, w
+    readVec3(node.find("translation"), translation);
+    readVec3(node.find("scale"), scale);
+    const JsonValue* rotation = node.find("rotation");
+    if (rotation && rotation->isArray() && rotation->array.size() == 4) {
+        for (int i = 0; i < 4; ++i) {
+            q[i] = static_cast<float>(rotation->array[i].number);
+        }
+    }
+
+    const float x = q[0], y = q[1], z = q[2], w = q[3];
+    glm::vec3 axisX(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + z * w), 2.0f * (x * z - y * w));
+    glm::vec3 axisY(2.0f * (x * y - z * w), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + x * w));
+    glm::vec3 axisZ(2.0f * (x * z + y * w), 2.0f * (y * z - x * w), 1.0f - 2.0f * (x * x + y * y));
+
+    result[0] = glm::vec4(axisX * scale.x, 0.0f);
+    result[1] = glm::vec4(axisY * scale.y, 0.0f);
+    result[2] = glm::vec4(axisZ * scale.z, 0.0f);
+    result[3] = glm::vec4(translation, 1.0f);
+    return result;
+}
+
+bool isIdentity(const glm::mat4& m) {
+    for (int column = 0; column < 4; ++column) {
+        for (int row = 0; row < 4; ++row) {
+            if (m[column][row] != (column == row ? 1.0f : 0.0f)) return false;
+        }
+    }
+    return true;
+}
+
+void transformBounds(const glm::mat4& m, const glm::vec3& minValue, const glm::vec3& maxValue,
+                     glm::vec3& outMin, glm::vec3& outMax) {
+    outMin = glm::vec3(std::numeric_limits<float>::max());
+    outMax = glm::vec3(std::numeric_limits<float>::lowest());
+    for (int corner = 0; corner < 8; ++corner) {
+        glm::vec3 local((corner & 1) ? maxValue.x : minValue.x,
+                        (corner & 2) ? maxValue.y : minValue.y,
+                        (corner & 4) ? maxValue.z : minValue.z);
+        glm::vec3 world(m * glm::vec4(local, 1.0f));
+        outMin = glm::min(outMin, world);
+        outMax = glm::max(outMax, world);
+    }
+}
+
+// 归一化整数分量按 glTF 规范转换到浮点
+inline float readComponent(const uint8_t* p, uint32_t componentType, bool normalized) {
+    switch (componentType) {
+        case COMPONENT_FLOAT: {
+            float value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+        case COMPONENT_UNSIGNED_BYTE:
+            return normalized ? *p / 255.0f : static_cast<float>(*p);
+        case COMPONENT_BYTE: {
+            float value = static_cast<float>(static_cast<int8_t>(*p));
+            return normalized ? std::max(value / 127.0f, -1.0f) : value;
+        }
+        case COMPONENT_UNSIGNED_SHORT: {
+            uint16_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return normalized ? value / 65535.0f : static_cast<float>(value);
+        }
+        case COMPONENT_SHORT: {
+            int16_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return normalized ? std::max(value / 32767.0f, -1.0f) : static_cast<float>(value);
+        }
+        default:
+            return 0.0f;
+    }
+}
+
+std::string percentDecode(const std::string& uri) {
+    std::string result;
+    result.reserve(uri.size());
+    for (size_t i = 0; i < uri.size(); ++i) {
+        if (uri[i] == '%' && i + 2 < uri.size() &&
+            std::isxdigit(static_cast<unsigned char>(uri[i + 1])) &&
+            std::isxdigit(static_cast<unsigned char>(uri[i + 2]))) {
+            result += static_cast<char>(std::stoi(uri.substr(i + 1, 2), nullptr, 16));
+            i += 2;
+        } else {
+            result += uri[i];
+        }
+    }
+    return result;
+}
+
+std::string imageExtension(const std::string& mimeType) {
+    if (mimeType == "image/png") return ".png";
+    if (mimeType == "image/jpeg") return ".jpg";
+    return ".bin";
+}
+
+} // namespace
+
+// ============================================================
+// GltfLoader
+// ============================================================
+
+bool GltfLoader::open(const std::string& filepath, std::string& error) {
+    path = filepath;
+    if (!file.open(filepath)) {
+        error = "cannot map file";
+        return false;
+    }
+
+    const uint8_t* data = file.getData();
+    const size_t size = file.getSize();
+    if (size < 20 || readU32(data) != GLB_MAGIC) {
+        error = "not a GLB file (only binary glTF is supported)";
+        return false;
+    }
+    if (readU32(data + 4) != 2) {
+        error = "unsupported glTF version " + std::to_string(readU32(data + 4));
+        return false;
+    }
+    const size_t totalLength = std::min<size_t>(readU32(data + 8), size);
+
+    // 第一个块必须是 JSON，可选的第二个块为 BIN
+    const char* jsonBegin = nullptr;
+    size_t jsonLength = 0;
+    size_t offset = 12;
+    while (offset + 8 <= totalLength) {
+        const size_t chunkLength = readU32(data + offset);
+        const uint32_t chunkType = readU32(data + offset + 4);
+        const size_t chunkBegin = offset + 8;
+        if (chunkLength > totalLength - chunkBegin) {
+            error = "truncated chunk";
+            return false;
+        }
+        if (chunkType == GLB_CHUNK_JSON && !jsonBegin) {
+            jsonBegin = reinterpret_cast<const char*>(data + chunkBegin);
+            jsonLength = chunkLength;
+        } else if (chunkType == GLB_CHUNK_BIN && !binChunk) {
+            binChunk = data + chunkBegin;
+            binSize = chunkLength;
+        }
+        offset = chunkBegin + ((chunkLength + 3) & ~size_t(3));
+    }
+    if (!jsonBegin) {
+        error = "missing JSON chunk";
+        return false;
+    }
+
+    JsonValue root;
+    JsonReader reader(jsonBegin, jsonBegin + jsonLength);
+    if (!reader.parse(root, error)) {
+        return false;
+    }
+
+    // 缓冲区：只支持引用 BIN 块的 buffer 0
+    const auto& buffers = root.items("buffers");
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        if (buffers[i].find("uri")) {
+            error = "external or data URI buffers are not supported (buffer " + std::to_string(i) + ")";
+            return false;
+        }
+    }
+
+    for (const JsonValue& view : root.items("bufferViews")) {
+        BufferView bufferView;
+        bufferView.byteOffset = static_cast<size_t>(view.getNumber("byteOffset", 0.0));
+        bufferView.byteLength = static_cast<size_t>(view.getNumber("byteLength", 0.0));
+        bufferView.byteStride = static_cast<size_t>(view.getNumber("byteStride", 0.0));
+        if (view.getIndex("buffer") != 0 || bufferView.byteOffset > binSize ||
+            bufferView.byteLength > binSize - bufferView.byteOffset) {
+            error = "bufferView " + std::to_string(bufferViews.size()) + " is outside the BIN chunk";
+            return false;
+        }
+        bufferViews.push_back(bufferView);
+    }
+
+    for (const JsonValue& desc : root.items("accessors")) {
+        Accessor accessor;
+        accessor.bufferView = desc.getIndex("bufferView");
+        accessor.byteOffset = static_cast<size_t>(desc.getNumber("byteOffset", 0.0));
+        accessor.componentType = static_cast<uint32_t>(desc.getNumber("componentType", 0.0));
+        accessor.components = componentCount(desc.getString("type"));
+        const JsonValue* normalized = desc.find("normalized");
+        accessor.normalized = normalized && normalized->boolean;
+        accessor.count = static_cast<size_t>(desc.getNumber("count", 0.0));
+        accessor.hasBounds = readVec3(desc.find("min"), accessor.minValue) &&
+                             readVec3(desc.find("max"), accessor.maxValue);
+        if (desc.find("sparse")) {
+            accessor.bufferView = -2;  // 标记为不支持，读取时报错
+        }
+        accessors.push_back(accessor);
+    }
+
+    for (const JsonValue& mesh : root.items("meshes")) {
+        std::vector<Primitive> primitives;
+        for (const JsonValue& desc : mesh.items("primitives")) {
+            Primitive primitive;
+            if (desc.getNumber("mode", static_cast<double>(MODE_TRIANGLES)) != MODE_TRIANGLES) {
+                primitive.position = -1;  // 非三角形图元，展开节点时跳过
+            } else if (const JsonValue* attributes = desc.find("attributes")) {
+                primitive.position = attributes->getIndex("POSITION");
+                primitive.normal = attributes->getIndex("NORMAL");
+                primitive.texCoord = attributes->getIndex("TEXCOORD_0");
+            }
+            primitive.indices = desc.getIndex("indices");
+            primitive.material = desc.getIndex("material");
+            primitives.push_back(primitive);
+        }
+        meshes.push_back(std::move(primitives));
+    }
+
+    for (const JsonValue& desc : root.items("materials")) {
+        MaterialDesc material;
+        material.factors.name = desc.getString("name");
+        if (const JsonValue* pbr = desc.find("pbrMetallicRoughness")) {
+            const JsonValue* color = pbr->find("baseColorFactor");
+            if (color && color->isArray() && color->array.size() == 4) {
+                for (int i = 0; i < 4; ++i) {
+                    material.factors.baseColorFactor[i] = static_cast<float>(color->array[i].number);
+                }
+            }
+            material.factors.metallicFactor = static_cast<float>(pbr->getNumber("metallicFactor", 1.0));
+            material.factors.roughnessFactor = static_cast<float>(pbr->getNumber("roughnessFactor", 1.0));
+            if (const JsonValue* texture = pbr->find("baseColorTexture")) {
+                material.baseColor = texture->getIndex("index");
+            }
+            if (const JsonValue* texture = pbr->find("metallicRoughnessTexture")) {
+                material.metallicRoughness = texture->getIndex("index");
+            }
+        }
+        readVec3(desc.find("emissiveFactor"), material.factors.emissiveFactor);
+        if (const JsonValue* texture = desc.find("normalTexture")) {
+            material.normal = texture->getIndex("index");
+        }
+        if (const JsonValue* texture = desc.find("occlusionTexture")) {
+            material.occlusion = texture->getIndex("index");
+            material.factors.occlusionStrength = static_cast<float>(texture->getNumber("strength", 1.0));
+        }
+        if (const JsonValue* texture = desc.find("emissiveTexture")) {
+            material.emissive = texture->getIndex("index");
+        }
+        materials.push_back(material);
+    }
+
+    for (const JsonValue& desc : root.items("textures")) {
+        Texture texture;
+        texture.image = desc.getIndex("source");
+        textures.push_back(texture);
+    }
+
+    for (const JsonValue& desc : root.items("images")) {
+        Image image;
+        image.uri = desc.getString("uri");
+        image.bufferView = desc.getIndex("bufferView");
+        image.mimeType = desc.getString("mimeType");
+        images.push_back(image);
+    }
+
+    // 展开节点层级：默认场景的根节点；没有场景时取所有不是子节点的节点
+    const auto& nodes = root.items("nodes");
+    std::vector<int32_t> roots;
+    const auto& scenes = root.items("scenes");
+    if (!scenes.empty()) {
+        int32_t sceneIndex = std::max(root.getIndex("scene"), 0);
+        if (static_cast<size_t>(sceneIndex) >= scenes.size()) sceneIndex = 0;
+        for (const JsonValue& node : scenes[sceneIndex].items("nodes")) {
+            roots.push_back(static_cast<int32_t>(node.number));
+        }
+    } else {
+        std::vector<bool> isChild(nodes.size(), false);
+        for (const JsonValue& node : nodes) {
+            for (const JsonValue& child : node.items("children")) {
+                size_t index = static_cast<size_t>(child.number);
+                if (index < isChild.size()) isChild[index] = true;
+            }
+        }
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (!isChild[i]) roots.push_back(static_cast<int32_t>(i));
+        }
+    }
+
+    struct PendingNode {
+        int32_t node;
+        glm::mat4 parent;
+        int depth;
+    };
+    std::vector<PendingNode> stack;
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it) {
+        stack.push_back({ *it, glm::mat4(1.0f), 0 });
+    }
+
+    while (!stack.empty()) {
+        PendingNode pending = stack.back();
+        stack.pop_back();
+        if (pending.node < 0 || static_cast<size_t>(pending.node) >= nodes.size() || pending.depth > MAX_NODE_DEPTH) {
+            continue;
+        }
+
+        const JsonValue& node = nodes[pending.node];
+        const glm::mat4 world = pending.parent * nodeMatrix(node);
+
+        const int32_t meshIndex = node.getIndex("mesh");
+        if (meshIndex >= 0 && static_cast<size_t>(meshIndex) < meshes.size()) {
+            const std::string nodeName = node.getString("name");
+            const auto& primitives = meshes[meshIndex];
+            for (size_t p = 0; p < primitives.size(); ++p) {
+                const Primitive& primitive = primitives[p];
+                if (primitive.position < 0 || static_cast<size_t>(primitive.position) >= accessors.size()) {
+                    continue;
+                }
+
+                GltfDrawItem item;
+                item.name = nodeName.empty() ? "mesh" + std::to_string(meshIndex) : nodeName;
+                if (primitives.size() > 1) item.name += "_" + std::to_string(p);
+                item.mesh = static_cast<uint32_t>(meshIndex);
+                item.primitive = static_cast<uint32_t>(p);
+                item.material = primitive.material;
+                item.transform = world;
+
+                const Accessor& position = accessors[primitive.position];
+                item.vertexCount = static_cast<uint32_t>(position.count);
+                if (primitive.indices >= 0 && static_cast<size_t>(primitive.indices) < accessors.size()) {
+                    item.indexCount = static_cast<uint32_t>(accessors[primitive.indices].count);
+                } else {
+                    item.indexCount = item.vertexCount;
+                }
+                if (position.hasBounds) {
+                    transformBounds(world, position.minValue, position.maxValue, item.minBounds, item.maxBounds);
+                }
+                drawItems.push_back(item);
+            }
+        }
+
+        const auto& children = node.items("children");
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            stack.push_back({ static_cast<int32_t>(it->number), world, pending.depth + 1 });
+        }
+    }
+
+    return true;
+}
+
+void GltfLoader::getSceneBounds(glm::vec3& minBounds, glm::vec3& maxBounds) const {
+    if (drawItems.empty()) {
+        minBounds = maxBounds = glm::vec3(0.0f);
+        return;
+    }
+    minBounds = drawItems[0].minBounds;
+    maxBounds = drawItems[0].maxBounds;
+    for (const GltfDrawItem& item : drawItems) {
+        minBounds = glm::min(minBounds, item.minBounds);
+        maxBounds = glm::max(maxBounds, item.maxBounds);
+    }
+}
+
+bool GltfLoader::locate(int32_t accessorIndex, uint32_t components, const uint8_t*& data, size_t& stride,
+                        std::string& error) const {
+    if (accessorIndex < 0 || static_cast<size_t>(accessorIndex) >= accessors.size()) {
+        error = "accessor index out of range";
+        return false;
+    }
+    const Accessor& accessor = accessors[accessorIndex];
+    if (accessor.bufferView == -2) {
+        error = "sparse accessors are not supported";
+        return false;
+    }
+    if (accessor.bufferView < 0 || static_cast<size_t>(accessor.bufferView) >= bufferViews.size()) {
+        error = "accessor without bufferView";
+        return false;
+    }
+    const size_t elementSize = componentSize(accessor.componentType) * accessor.components;
+    if (elementSize == 0 || accessor.components != components) {
+        error = "unexpected accessor type";
+        return false;
+    }
+
+    const BufferView& view = bufferViews[accessor.bufferView];
+    stride = view.byteStride ? view.byteStride : elementSize;
+    if (accessor.count > 0 &&
+        (accessor.byteOffset > view.byteLength || elementSize > view.byteLength - accessor.byteOffset ||
+         (accessor.count - 1) > (view.byteLength - accessor.byteOffset - elementSize) / stride)) {
+        error = "accessor exceeds its bufferView";
+        return false;
+    }
+
+    data = binChunk + view.byteOffset + accessor.byteOffset;
+    return true;
+}
+
+bool GltfLoader::readDrawItem(size_t itemIndex, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+                              bool& hasNormals, std::string& error) const {
+    if (itemIndex >= drawItems.size()) {
+        error = "draw item " + std::to_string(itemIndex) + " out of range";
+        return false;
+    }
+    const GltfDrawItem& item = drawItems[itemIndex];
+    const Primitive& primitive = meshes[item.mesh][item.primitive];
+
+    // POSITION 只支持浮点（不支持 KHR_mesh_quantization）
+    const uint8_t* positionData = nullptr;
+    size_t positionStride = 0;
+    if (!locate(primitive.position, 3, positionData, positionStride, error)) return false;
+    if (accessors[primitive.position].componentType != COMPONENT_FLOAT) {
+        error = "quantized positions are not supported";
+        return false;
+    }
+
+    // 可选属性无效时按缺失处理
+    auto matchesVertexCount = [&](int32_t index) {
+        return index >= 0 && static_cast<size_t>(index) < accessors.size() &&
+               accessors[index].count == item.vertexCount;
+    };
+
+    const uint8_t* normalData = nullptr;
+    size_t normalStride = 0;
+    hasNormals = matchesVertexCount(primitive.normal) &&
+                 accessors[primitive.normal].componentType == COMPONENT_FLOAT &&
+                 locate(primitive.normal, 3, normalData, normalStride, error);
+
+    const uint8_t* texCoordData = nullptr;
+    size_t texCoordStride = 0;
+    uint32_t texCoordType = 0;
+    bool texCoordNormalized = false;
+    bool hasTexCoords = matchesVertexCount(primitive.texCoord) &&
+                        locate(primitive.texCoord, 2, texCoordData, texCoordStride, error);
+    if (hasTexCoords) {
+        texCoordType = accessors[primitive.texCoord].componentType;
+        texCoordNormalized = accessors[primitive.texCoord].normalized;
+    }
+    error.clear();
+
+    const size_t baseVertex = vertices.size();
+    const size_t vertexCount = item.vertexCount;
+    vertices.resize(baseVertex + vertexCount);
+    Vertex* out = vertices.data() + baseVertex;
+
+    // 单次带步长转换：每个属性从映射内存直接写入 Vertex
+    for (size_t i = 0; i < vertexCount; ++i) {
+        std::memcpy(&out[i].pos, positionData + i * positionStride, sizeof(glm::vec3));
+    }
+    if (hasNormals) {
+        for (size_t i = 0; i < vertexCount; ++i) {
+            std::memcpy(&out[i].normal, normalData + i * normalStride, sizeof(glm::vec3));
+        }
+    } else {
+        for (size_t i = 0; i < vertexCount; ++i) {
+            out[i].normal = glm::vec3(0.0f, 1.0f, 0.0f);  // 后面会重新计算
+        }
+    }
+    if (hasTexCoords && texCoordType == COMPONENT_FLOAT) {
+        for (size_t i = 0; i < vertexCount; ++i) {
+            std::memcpy(&out[i].texCoord, texCoordData + i * texCoordStride, sizeof(glm::vec2));
+        }
+    } else if (hasTexCoords) {
+        const size_t size = componentSize(texCoordType);
+        for (size_t i = 0; i < vertexCount; ++i) {
+            const uint8_t* src = texCoordData + i * texCoordStride;
+            out[i].texCoord = glm::vec2(readComponent(src, texCoordType, texCoordNormalized),
+                                        readComponent(src + size, texCoordType, texCoordNormalized));
+        }
+    } else {
+        for (size_t i = 0; i < vertexCount; ++i) {
+            out[i].texCoord = glm::vec2(0.0f);
+        }
+    }
+    // glTF 与 Vulkan 的 UV 原点都在左上角，无需翻转 V
+    for (size_t i = 0; i < vertexCount; ++i) {
+        out[i].tangent = glm::vec3(1.0f, 0.0f, 0.0f);
+    }
+
+    // 变换到场景空间，法线使用逆转置矩阵
+    bool flipWinding = false;
+    if (!isIdentity(item.transform)) {
+        const glm::mat4& m = item.transform;
+        const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(m)));
+        flipWinding = glm::determinant(glm::mat3(m)) < 0.0f;
+        for (size_t i = 0; i < vertexCount; ++i) {
+            out[i].pos = glm::vec3(m * glm::vec4(out[i].pos, 1.0f));
+            if (hasNormals) {
+                glm::vec3 n = normalMatrix * out[i].normal;
+                float length = glm::length(n);
+                out[i].normal = length > 0.0f ? n / length : glm::vec3(0.0f, 1.0f, 0.0f);
+            }
+        }
+    }
+
+    // 索引：32 位连续索引整段拷贝，其余逐个扩展
+    const size_t baseIndex = indices.size();
+    if (primitive.indices >= 0) {
+        const uint8_t* indexData = nullptr;
+        size_t indexStride = 0;
+        if (!locate(primitive.indices, 1, indexData, indexStride, error)) {
+            vertices.resize(baseVertex);
+            return false;
+        }
+        const uint32_t indexType = accessors[primitive.indices].componentType;
+        const size_t indexCount = item.indexCount;
+        indices.resize(baseIndex + indexCount);
+        uint32_t* dst = indices.data() + baseIndex;
+
+        if (indexType == COMPONENT_UNSIGNED_INT && indexStride == 4) {
+            std::memcpy(dst, indexData, indexCount * sizeof(uint32_t));
+        } else if (indexType == COMPONENT_UNSIGNED_INT) {
+            for (size_t i = 0; i < indexCount; ++i) dst[i] = readU32(indexData + i * indexStride);
+        } else if (indexType == COMPONENT_UNSIGNED_SHORT) {
+            for (size_t i = 0; i < indexCount; ++i) {
+                uint16_t value;
+                std::memcpy(&value, indexData + i * indexStride, sizeof(value));
+                dst[i] = value;
+            }
+        } else if (indexType == COMPONENT_UNSIGNED_BYTE) {
+            for (size_t i = 0; i < indexCount; ++i) dst[i] = indexData[i * indexStride];
+        } else {
+            error = "unsupported index component type";
+            vertices.resize(baseVertex);
+            indices.resize(baseIndex);
+            return false;
+        }
+
+        for (size_t i = 0; i < indexCount; ++i) {
+            if (dst[i] >= vertexCount) {
+                error = "index out of range";
+                vertices.resize(baseVertex);
+                indices.resize(baseIndex);
+                return false;
+            }
+            dst[i] += static_cast<uint32_t>(baseVertex);
+        }
+    } else {
+        indices.resize(baseIndex + vertexCount);
+        for (size_t i = 0; i < vertexCount; ++i) {
+            indices[baseIndex + i] = static_cast<uint32_t>(baseVertex + i);
+        }
+    }
+
+    // 不完整的三角形直接丢弃
+    indices.resize(baseIndex + (indices.size() - baseIndex) / 3 * 3);
+    if (flipWinding) {
+        for (size_t i = baseIndex; i < indices.size(); i += 3) {
+            std::swap(indices[i + 1], indices[i + 2]);
+        }
+    }
+    return true;
+}
+
+std::string GltfLoader::resolveImage(int32_t textureIndex) const {
+    if (textureIndex < 0 || static_cast<size_t>(textureIndex) >= textures.size()) return {};
+    const int32_t imageIndex = textures[textureIndex].image;
+    if (imageIndex < 0 || static_cast<size_t>(imageIndex) >= images.size()) return {};
+    const Image& image = images[imageIndex];
+
+    if (!image.uri.empty()) {
+        if (image.uri.compare(0, 5, "data:") == 0) {
+            std::cerr << "[GltfLoader] data URI images are not supported (image " << imageIndex << ")" << std::endl;
+            return {};
+        }
+        std::filesystem::path base = std::filesystem::path(path).parent_path();
+        return (base / std::filesystem::u8path(percentDecode(image.uri))).string();
+    }
+
+    if (image.bufferView < 0 || static_cast<size_t>(image.bufferView) >= bufferViews.size()) return {};
+    const BufferView& view = bufferViews[image.bufferView];
+    const std::string imagePath = path + ".image" + std::to_string(imageIndex) + imageExtension(image.mimeType);
+
+    std::error_code ec;
+    auto existingSize = std::filesystem::file_size(imagePath, ec);
+    if (!ec && existingSize == view.byteLength) {
+        return imagePath;
+    }
+
+    std::ofstream out(imagePath, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(binChunk + view.byteOffset), static_cast<std::streamsize>(view.byteLength));
+    if (!out) {
+        std::cerr << "[GltfLoader] Failed to write embedded image: " << imagePath << std::endl;
+        return {};
+    }
+    return imagePath;
+}
+
+std::vector<GltfMaterial> GltfLoader::loadMaterials() const {
+    std::vector<GltfMaterial> result;
+    result.reserve(materials.size());
+    for (const MaterialDesc& desc : materials) {
+        GltfMaterial material = desc.factors;
+        material.baseColorTexture = resolveImage(desc.baseColor);
+        material.normalTexture = resolveImage(desc.normal);
+        material.metallicRoughnessTexture = resolveImage(desc.metallicRoughness);
+        material.occlusionTexture = resolveImage(desc.occlusion);
+        material.emissiveTexture = resolveImage(desc.emissive);
+        result.push_back(std::move(material));
+    }
+    return result;
+}
+
+bool GltfLoader::isGlbMeshId(const std::string& meshId) {
+    std::string filepath;
+    int drawItem = -1;
+    if (!parseMeshId(meshId, filepath, drawItem) || filepath.size() < 4) return false;
+
+    std::string extension = filepath.substr(filepath.size() - 4);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".glb";
+}
+
+bool GltfLoader::parseMeshId(const std::string& meshId, std::string& filepath, int& drawItem) {
+    drawItem = -1;
+    const size_t hash = meshId.rfind('#');
+    if (hash == std::string::npos) {
+        filepath = meshId;
+        return true;
+    }
+
+    filepath = meshId.substr(0, hash);
+    const std::string suffix = meshId.substr(hash + 1);
+    if (suffix.empty() || suffix.size() > 9 ||
+        !std::all_of(suffix.begin(), suffix.end(), [](unsigned char c) { return std::isdigit(c) != 0; })) {
+        return false;
+    }
+    drawItem = std::stoi(suffix);
+    return true;
+}
+
+std::string GltfLoader::makeMeshId(const std::string& filepath, size_t drawItem) {
+    return filepath + "#" + std::to_string(drawItem);
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "Vertex.h"
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * glTF 材质（metallic-roughness 模型），纹理为已解析的文件路径，缺失时为空
+ */
+struct GltfMaterial {
+    std::string name;
+    glm::vec4 baseColorFactor = glm::vec4(1.0f);
+    float metallicFactor = 1.0f;
+    float roughnessFactor = 1.0f;
+    glm::vec3 emissiveFactor = glm::vec3(0.0f);
+    float occlusionStrength = 1.0f;
+
+    std::string baseColorTexture;
+    std::string normalTexture;
+    std::string metallicRoughnessTexture;   // G 通道粗糙度，B 通道金属度
+    std::string occlusionTexture;
+    std::string emissiveTexture;
+};
+
+/**
+ * 场景中的一个可绘制图元（节点 × 网格图元），顶点读取时已变换到场景空间
+ */
+struct GltfDrawItem {
+    std::string name;
+    uint32_t mesh = 0;
+    uint32_t primitive = 0;
+    int32_t material = -1;          // -1 表示使用默认材质
+    glm::mat4 transform = glm::mat4(1.0f);
+    glm::vec3 minBounds = glm::vec3(0.0f);   // 场景空间包围盒（来自 POSITION 访问器的 min/max）
+    glm::vec3 maxBounds = glm::vec3(0.0f);
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+};
+
+/**
+ * GLB（二进制 glTF 2.0）加载器
+ *
+ * 文件通过内存映射读入，open() 只解析 JSON 块并展开节点层级得到图元列表；
+ * 顶点/索引在 readDrawItem() 时从 BIN 块按访问器步长直接转换到 Vertex/索引数组，
+ * 每个属性只做一次带步长的拷贝，32 位连续索引直接整段拷贝。
+ *
+ * 支持：三角形图元、POSITION/NORMAL/TEXCOORD_0（浮点或归一化 8/16 位）、
+ * 8/16/32 位索引、matrix 或 TRS 节点变换。不支持稀疏访问器、外部/data URI 缓冲区、
+ * 非三角形图元（跳过）和 KHR_mesh_quantization 等扩展。
+ * 切线不从文件读取，导入后按 UV 重新计算，与 OBJ 路径一致。
+ *
+ * 网格 ID 约定："model.glb" 表示合并所有图元，"model.glb#N" 表示第 N 个图元
+ */
+class GltfLoader {
+public:
+    GltfLoader() = default;
+    GltfLoader(const GltfLoader&) = delete;
+    GltfLoader& operator=(const GltfLoader&) = delete;
+
+    /**
+     * @brief 映射文件并解析 JSON 块
+     */
+    bool open(const std::string& filepath, std::string& error);
+
+    const std::string& getPath() const { return path; }
+    const std::vector<GltfDrawItem>& getDrawItems() const { return drawItems; }
+
+    /**
+     * @brief 场景空间包围盒（所有图元）
+     */
+    void getSceneBounds(glm::vec3& minBounds, glm::vec3& maxBounds) const;
+
+    /**
+     * @brief 读取一个图元，追加到 vertices/indices（索引已加上原有顶点数）
+     * @param hasNormals 输出：文件是否提供了法线
+     */
+    bool readDrawItem(size_t item, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+                      bool& hasNormals, std::string& error) const;
+
+    /**
+     * @brief 解析材质并解析纹理路径
+     * 外部图片按 GLB 所在目录解析；嵌入 BIN 块的图片导出为 "<model>.glb.image<N>.<ext>"
+     * （文件已存在且大小一致时跳过），供 TextureManager 按路径加载
+     */
+    std::vector<GltfMaterial> loadMaterials() const;
+
+    /**
+     * @brief 是否为 GLB 网格 ID（忽略 '#' 后缀，扩展名不区分大小写）
+     */
+    static bool isGlbMeshId(const std::string& meshId);
+
+    /**
+     * @brief 拆分网格 ID，drawItem 为 -1 表示合并所有图元
+     */
+    static bool parseMeshId(const std::string& meshId, std::string& filepath, int& drawItem);
+
+    /**
+     * @brief 生成单个图元的网格 ID
+     */
+    static std::string makeMeshId(const std::string& filepath, size_t drawItem);
+
+private:
+    struct BufferView {
+        size_t byteOffset = 0;
+        size_t byteLength = 0;
+        size_t byteStride = 0;
+    };
+
+    struct Accessor {
+        int32_t bufferView = -1;
+        size_t byteOffset = 0;
+        uint32_t componentType = 0;
+        uint32_t components = 0;
+        bool normalized = false;
+        size_t count = 0;
+        bool hasBounds = false;
+        glm::vec3 minValue = glm::vec3(0.0f);
+        glm::vec3 maxValue = glm::vec3(0.0f);
+    };
+
+    struct Primitive {
+        int32_t position = -1;
+        int32_t normal = -1;
+        int32_t texCoord = -1;
+        int32_t indices = -1;
+        int32_t material = -1;
+    };
+
+    struct Image {
+        std::string uri;
+        int32_t bufferView = -1;
+        std::string mimeType;
+    };
+
+    struct Texture {
+        int32_t image = -1;
+    };
+
+    // 材质原始描述（纹理为 texture 索引），loadMaterials 时再解析路径
+    struct MaterialDesc {
+        GltfMaterial factors;
+        int32_t baseColor = -1;
+        int32_t normal = -1;
+        int32_t metallicRoughness = -1;
+        int32_t occlusion = -1;
+        int32_t emissive = -1;
+    };
+
+    // 访问器数据的起始地址与步长（已做范围检查）
+    bool locate(int32_t accessor, uint32_t components, const uint8_t*& data, size_t& stride,
+                std::string& error) const;
+    std::string resolveImage(int32_t texture) const;
+
+    std::string path;
+    MappedFile file;
+    const uint8_t* binChunk = nullptr;
+    size_t binSize = 0;
+
+    std::vector<BufferView> bufferViews;
+    std::vector<Accessor> accessors;
+    std::vector<std::vector<Primitive>> meshes;
+    std::vector<MaterialDesc> materials;
+    std::vector<Texture> textures;
+    std::vector<Image> images;
+    std::vector<GltfDrawItem> drawItems;
+};
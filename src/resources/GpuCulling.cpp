@@ -0,0 +1,356 @@
+#include "GpuCulling.h"
+#include "VulkanDevice.h"
+#include "FrameAllocator.h"
+#include "VulkanPipeline.h"
+#include "Utils.h"
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace VulkanEngine {
+
+namespace {
+
+constexpr uint32_t BINDING_COUNT = 4;   // 对象、命令、实例、批次信息 / 计数
+constexpr VkDeviceSize COMMAND_STRIDE = sizeof(VkDrawIndexedIndirectCommand);
+constexpr VkDeviceSize INSTANCE_SIZE = 2 * sizeof(glm::mat4);   // 与 ForwardPass / GBufferPass 的 InstanceData 一致
+
+uint32_t groupCountFor(uint32_t count) {
+    return (count + GpuCulling::WORKGROUP_SIZE - 1) / GpuCulling::WORKGROUP_SIZE;
+}
+
+} // namespace
+
+GpuCulling::GpuCulling(std::shared_ptr<VulkanDevice> device)
+    : device(device) {
+    createDescriptorSet();
+    createPipelines();
+
+    std::cout << "GpuCulling created (draw count: "
+              << (device->supportsDrawIndirectCount() ? "yes" : "no")
+              << ", multi draw: " << (device->supportsMultiDrawIndirect() ? "yes" : "no") << ")" << std::endl;
+}
+
+GpuCulling::~GpuCulling() {
+    VkDevice dev = device->getDevice();
+
+    if (cullPipeline != VK_NULL_HANDLE) {
+        vkDestroyPipeline(dev, cullPipeline, nullptr);
+    }
+    if (compactPipeline != VK_NULL_HANDLE) {
+        vkDestroyPipeline(dev, compactPipeline, nullptr);
+    }
+    if (pipelineLayout != VK_NULL_HANDLE) {
+        vkDestroyPipelineLayout(dev, pipelineLayout, nullptr);
+    }
+    // 销毁描述符池（描述符集会自动释放）
+    if (descriptorPool != VK_NULL_HANDLE) {
+        vkDestroyDescriptorPool(dev, descriptorPool, nullptr);
+    }
+    if (setLayout != VK_NULL_HANDLE) {
+        vkDestroyDescriptorSetLayout(dev, setLayout, nullptr);
+    }
+}
+
+bool GpuCulling::isSupported(const VulkanDevice& device) {
+    return device.supportsComputeOnGraphicsQueue() && device.supportsDrawIndirectFirstInstance();
+}
+
+VkDeviceSize GpuCulling::getFrameBytes(uint32_t objectCount) {
+    // 对象 + 实例 + 命令与紧凑命令 + 批次信息（2 个字）与状态组计数；每次分配最多一个元素的对齐填充
+    const VkDeviceSize element = sizeof(GpuCullObject) + INSTANCE_SIZE + 2 * COMMAND_STRIDE + 3 * sizeof(uint32_t);
+    return (static_cast<VkDeviceSize>(objectCount) + 1) * element;
+}
+
+void GpuCulling::createDescriptorSet() {
+    VkDevice dev = device->getDevice();
+
+    std::array<VkDescriptorSetLayoutBinding, BINDING_COUNT> bindings{};
+    for (uint32_t i = 0; i < BINDING_COUNT; i++) {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+
+    if (vkCreateDescriptorSetLayout(dev, &layoutInfo, nullptr, &setLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create GPU culling descriptor set layout!");
+    }
+
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    poolSize.descriptorCount = BINDING_COUNT;
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+    poolInfo.maxSets = 1;
+
+    if (vkCreateDescriptorPool(dev, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create GPU culling descriptor pool!");
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &setLayout;
+
+    if (vkAllocateDescriptorSets(dev, &allocInfo, &descriptorSet) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate GPU culling descriptor set!");
+    }
+
+    writeDescriptorSet();
+}
+
+void GpuCulling::writeDescriptorSet() {
+    const FrameAllocator& frameAllocator = device->getFrameAllocator();
+
+    // 四个绑定都指向整个帧段，动态偏移为本帧段起点，各数组的下标基准由 push constant 给出
+    VkDescriptorBufferInfo bufferInfo = frameAllocator.getDescriptorInfo(frameAllocator.getFrameSize());
+
+    std::array<VkWriteDescriptorSet, BINDING_COUNT> writes{};
+    for (uint32_t i = 0; i < BINDING_COUNT; i++) {
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = descriptorSet;
+        writes[i].dstBinding = i;
+        writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        writes[i].descriptorCount = 1;
+        writes[i].pBufferInfo = &bufferInfo;
+    }
+
+    vkUpdateDescriptorSets(device->getDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    frameAllocatorVersion = frameAllocator.getVersion();
+}
+
+void GpuCulling::createPipelines() {
+    VkDevice dev = device->getDevice();
+
+    VkPushConstantRange pushRange{};
+    pushRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushRange.offset = 0;
+    pushRange.size = sizeof(CullPushConstants);
+
+    VkPipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &setLayout;
+    layoutInfo.pushConstantRangeCount = 1;
+    layoutInfo.pPushConstantRanges = &pushRange;
+
+    if (vkCreatePipelineLayout(dev, &layoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create GPU culling pipeline layout!");
+    }
+
+    auto shaderCode = Utils::readFile(SHADER_PATH);
+    VkShaderModule shaderModule = VulkanPipeline::createShaderModule(dev, shaderCode);
+
+    // 剔除与压缩共用一个着色器，通过特化常量切换
+    VkBool32 compactPass = VK_FALSE;
+    VkSpecializationMapEntry specEntry{};
+    specEntry.constantID = 0;
+    specEntry.offset = 0;
+    specEntry.size = sizeof(VkBool32);
+
+    VkSpecializationInfo specInfo{};
+    specInfo.mapEntryCount = 1;
+    specInfo.pMapEntries = &specEntry;
+    specInfo.dataSize = sizeof(VkBool32);
+    specInfo.pData = &compactPass;
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = shaderModule;
+    pipelineInfo.stage.pName = "main";
+    pipelineInfo.stage.pSpecializationInfo = &specInfo;
+    pipelineInfo.layout = pipelineLayout;
+
+    if (vkCreateComputePipelines(dev, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &cullPipeline) != VK_SUCCESS) {
+        vkDestroyShaderModule(dev, shaderModule, nullptr);
+        throw std::runtime_error("Failed to create GPU culling pipeline!");
+    }
+
+    // 压缩阶段只在支持 draw indirect count 时使用
+    if (device->supportsDrawIndirectCount()) {
+        compactPass = VK_TRUE;
+        if (vkCreateComputePipelines(dev, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &compactPipeline) != VK_SUCCESS) {
+            vkDestroyShaderModule(dev, shaderModule, nullptr);
+            throw std::runtime_error("Failed to create GPU culling compact pipeline!");
+        }
+    }
+
+    vkDestroyShaderModule(dev, shaderModule, nullptr);
+}
+
+bool GpuCulling::beginFrame(uint32_t count) {
+    FrameAllocator& frameAllocator = device->getFrameAllocator();
+    // FrameAllocator 扩容后缓冲区已重建，重新写入指向它的描述符
+    if (frameAllocatorVersion != frameAllocator.getVersion()) {
+        writeDescriptorSet();
+    }
+    segmentOffset = static_cast<uint32_t>(frameAllocator.getFrameOffset(frameAllocator.getCurrentFrame()));
+
+    commands.clear();
+    batchGroups.clear();
+    groups.clear();
+    objectCount = 0;
+    objectCapacity = count;
+    objects = nullptr;
+    if (count == 0) return true;
+
+    // 分配按元素大小对齐（对齐相对段起点），下标 = 段内偏移 / 元素大小
+    FrameAllocation objectAllocation = frameAllocator.allocate(count * sizeof(GpuCullObject), sizeof(GpuCullObject));
+    FrameAllocation instanceAllocation = frameAllocator.allocate(count * INSTANCE_SIZE, INSTANCE_SIZE);
+    if (!objectAllocation.isValid() || !instanceAllocation.isValid()) {
+        objectCapacity = 0;
+        return false;
+    }
+
+    objects = reinterpret_cast<GpuCullObject*>(objectAllocation.mapped);
+    objectBase = static_cast<uint32_t>((objectAllocation.offset - segmentOffset) / sizeof(GpuCullObject));
+    instanceBase = static_cast<uint32_t>((instanceAllocation.offset - segmentOffset) / INSTANCE_SIZE);
+    return true;
+}
+
+uint32_t GpuCulling::addGroup() {
+    Group group;
+    group.firstBatch = static_cast<uint32_t>(commands.size());
+    groups.push_back(group);
+    return static_cast<uint32_t>(groups.size() - 1);
+}
+
+uint32_t GpuCulling::addBatch(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset) {
+    // 批次的实例区间从当前对象开始，长度不超过批次内的对象数
+    VkDrawIndexedIndirectCommand command{};
+    command.indexCount = indexCount;
+    command.instanceCount = 0;
+    command.firstIndex = firstIndex;
+    command.vertexOffset = vertexOffset;
+    command.firstInstance = instanceBase + objectCount;
+    commands.push_back(command);
+
+    batchGroups.push_back(static_cast<uint32_t>(groups.size() - 1));
+    groups.back().batchCount++;
+    return static_cast<uint32_t>(commands.size() - 1);
+}
+
+void GpuCulling::addObject(const glm::mat4& model, const glm::mat4& normalMatrix, const glm::vec4& boundingSphere) {
+    if (objectCount >= objectCapacity) {
+        throw std::runtime_error("GpuCulling: object count exceeds the capacity given to beginFrame");
+    }
+
+    GpuCullObject& object = objects[objectCount++];
+    object.model = model;
+    object.normalMatrix = normalMatrix;
+    object.boundingSphere = boundingSphere;
+    object.batch = static_cast<uint32_t>(commands.size() - 1);
+}
+
+bool GpuCulling::record(VkCommandBuffer cmd, const Frustum& frustum) {
+    if (objectCount == 0 || commands.empty()) return true;
+
+    FrameAllocator& frameAllocator = device->getFrameAllocator();
+    const bool drawCount = compactPipeline != VK_NULL_HANDLE;
+    const uint32_t batchCount = static_cast<uint32_t>(commands.size());
+    const uint32_t groupCount = static_cast<uint32_t>(groups.size());
+
+    // 间接命令（instanceCount 为 0，由剔除阶段累加）
+    FrameAllocation commandAllocation = frameAllocator.allocate(batchCount * COMMAND_STRIDE, COMMAND_STRIDE);
+    if (!commandAllocation.isValid()) return false;
+    std::memcpy(commandAllocation.mapped, commands.data(), batchCount * COMMAND_STRIDE);
+    commandOffset = commandAllocation.offset;
+
+    CullPushConstants push{};
+    for (int i = 0; i < 6; i++) {
+        push.planes[i] = frustum.planes[i];
+    }
+    push.objectBase = objectBase;
+    push.objectCount = objectCount;
+    push.commandBase = static_cast<uint32_t>((commandAllocation.offset - segmentOffset) / COMMAND_STRIDE);
+    push.batchCount = batchCount;
+
+    if (drawCount) {
+        // 紧凑命令由压缩阶段写入；批次信息之后是各状态组的绘制数量（清零）
+        FrameAllocation compactAllocation = frameAllocator.allocate(batchCount * COMMAND_STRIDE, COMMAND_STRIDE);
+        FrameAllocation wordAllocation = frameAllocator.allocate((batchCount * 2 + groupCount) * sizeof(uint32_t),
+                                                                 sizeof(uint32_t));
+        if (!compactAllocation.isValid() || !wordAllocation.isValid()) return false;
+        uint32_t* words = reinterpret_cast<uint32_t*>(wordAllocation.mapped);
+        for (uint32_t batch = 0; batch < batchCount; batch++) {
+            words[batch * 2] = batchGroups[batch];
+            words[batch * 2 + 1] = groups[batchGroups[batch]].firstBatch;
+        }
+        std::memset(words + batchCount * 2, 0, groupCount * sizeof(uint32_t));
+
+        compactOffset = compactAllocation.offset;
+        countOffset = wordAllocation.offset + batchCount * 2 * sizeof(uint32_t);
+        push.compactBase = static_cast<uint32_t>((compactAllocation.offset - segmentOffset) / COMMAND_STRIDE);
+        push.batchInfoBase = static_cast<uint32_t>((wordAllocation.offset - segmentOffset) / sizeof(uint32_t));
+        push.countBase = push.batchInfoBase + batchCount * 2;
+    }
+
+    std::array<uint32_t, BINDING_COUNT> dynamicOffsets;
+    dynamicOffsets.fill(segmentOffset);
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipeline);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet,
+                            static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+    vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &push);
+    vkCmdDispatch(cmd, groupCountFor(objectCount), 1, 1);
+
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+
+    if (drawCount) {
+        // 压缩阶段读取剔除阶段累加后的 instanceCount
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        // 布局相同，描述符集与 push constant 保持有效
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, compactPipeline);
+        vkCmdDispatch(cmd, groupCountFor(batchCount), 1, 1);
+    }
+
+    // 命令与计数供间接绘制读取，实例数据供顶点着色器读取
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                         0, 1, &barrier, 0, nullptr, 0, nullptr);
+    return true;
+}
+
+void GpuCulling::drawGroup(VkCommandBuffer cmd, uint32_t group) const {
+    const Group& entry = groups[group];
+    if (entry.batchCount == 0) return;
+
+    VkBuffer buffer = device->getFrameAllocator().getBuffer();
+
+    if (compactPipeline != VK_NULL_HANDLE) {
+        // 只提交本组可见的命令，数量由压缩阶段写入
+        device->getCmdDrawIndexedIndirectCount()(cmd, buffer, compactOffset + entry.firstBatch * COMMAND_STRIDE,
+                                                 buffer, countOffset + group * sizeof(uint32_t),
+                                                 entry.batchCount, static_cast<uint32_t>(COMMAND_STRIDE));
+    } else if (device->supportsMultiDrawIndirect()) {
+        vkCmdDrawIndexedIndirect(cmd, buffer, commandOffset + entry.firstBatch * COMMAND_STRIDE,
+                                 entry.batchCount, static_cast<uint32_t>(COMMAND_STRIDE));
+    } else {
+        for (uint32_t batch = 0; batch < entry.batchCount; batch++) {
+            vkCmdDrawIndexedIndirect(cmd, buffer, commandOffset + (entry.firstBatch + batch) * COMMAND_STRIDE,
+                                     1, static_cast<uint32_t>(COMMAND_STRIDE));
+        }
+    }
+}
+
+} // namespace VulkanEngine
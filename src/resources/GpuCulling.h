@@ -0,0 +1,127 @@
+#pragma once
+
+#include "../scene/Frustum.h"
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class VulkanDevice;
+
+namespace VulkanEngine {
+
+/**
+ * @brief GPU 剔除的输入对象（与 cull.comp 的 ObjectData 一致，std430）
+ */
+struct GpuCullObject {
+    glm::mat4 model;
+    glm::mat4 normalMatrix;
+    glm::vec4 boundingSphere;   // 世界空间球心 + 半径
+    uint32_t batch = 0;
+    uint32_t padding[3] = {};
+};
+
+/**
+ * GpuCulling - 计算着色器视锥剔除 + 间接绘制（GPU 驱动渲染）
+ *
+ * 每帧：
+ * 1. beginFrame(objectCount)：在 FrameAllocator 本帧段中分配对象数组和实例数组（段空间不足时返回 false，
+ *    调用方本帧回退到 CPU 提交，FrameAllocator 在下一帧扩容）
+ * 2. addGroup / addBatch / addObject：按绘制顺序登记状态组（共用管线、材质、几何缓冲区）、
+ *    批次（同一网格区间，对应一条 VkDrawIndexedIndirectCommand）和批次内的对象
+ * 3. record(cmd, frustum)：在渲染通道之外录制剔除（与命令压缩）调度以及到间接绘制 / 顶点着色器的屏障
+ *    （命令数组分配失败时同样返回 false，不录制任何命令）
+ * 4. 各 Pass 绑定状态组的管线、材质和几何缓冲区后调用 drawGroup(cmd, group)
+ *
+ * 剔除阶段每个线程处理一个对象，可见时把实例数据写入所属批次的实例区间并原子递增 instanceCount；
+ * 支持 VK_KHR_draw_indirect_count 时压缩阶段把非空命令按状态组紧凑排列并写入绘制数量，
+ * 否则提交全部命令（实例数为 0 的命令不产生图元），不支持 multiDrawIndirect 时逐条提交。
+ * 命令中的 firstInstance 为实例在本帧段中的下标（与各 Pass 的实例数据绑定一致），需要 drawIndirectFirstInstance。
+ * 剔除本身只使用核心计算着色器功能和存储缓冲区原子操作，不依赖扩展
+ */
+class GpuCulling {
+public:
+    static constexpr uint32_t WORKGROUP_SIZE = 64;   // 与 cull.comp 的 local_size_x 一致
+    static constexpr const char* SHADER_PATH = "shaders/cull_comp.spv";
+
+    explicit GpuCulling(std::shared_ptr<VulkanDevice> device);
+    ~GpuCulling();
+
+    GpuCulling(const GpuCulling&) = delete;
+    GpuCulling& operator=(const GpuCulling&) = delete;
+
+    // 设备是否支持（图形队列支持计算、drawIndirectFirstInstance）
+    static bool isSupported(const VulkanDevice& device);
+
+    // 本帧剔除的输入（需在 FrameAllocator::beginFrame 之后调用），objectCount 为本帧对象数的上限
+    // 返回 false 表示本帧段空间不足，本帧不能使用 GPU 剔除
+    bool beginFrame(uint32_t objectCount);
+    // 开始新的状态组，返回组下标
+    uint32_t addGroup();
+    // 在当前状态组中开始新的批次，返回批次下标
+    uint32_t addBatch(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset);
+    // 向当前批次添加对象
+    void addObject(const glm::mat4& model, const glm::mat4& normalMatrix, const glm::vec4& boundingSphere);
+
+    // 录制剔除调度，必须在渲染通道之外调用；没有对象时不录制任何命令。段空间不足时返回 false
+    bool record(VkCommandBuffer cmd, const Frustum& frustum);
+
+    // 绘制一个状态组的所有批次（调用方已绑定该组的管线、描述符集和几何缓冲区）
+    void drawGroup(VkCommandBuffer cmd, uint32_t group) const;
+
+    uint32_t getObjectCount() const { return objectCount; }
+    uint32_t getBatchCount() const { return static_cast<uint32_t>(commands.size()); }
+    uint32_t getGroupCount() const { return static_cast<uint32_t>(groups.size()); }
+    
+    // objectCount 个对象一帧最多从 FrameAllocator 分配的字节数（批次、状态组数不超过对象数，含对齐填充）
+    static VkDeviceSize getFrameBytes(uint32_t objectCount);
+
+private:
+    struct Group {
+        uint32_t firstBatch = 0;
+        uint32_t batchCount = 0;
+    };
+
+    // 与 cull.comp 的 PushConstants 一致（124 字节）
+    struct CullPushConstants {
+        glm::vec4 planes[6];
+        uint32_t objectBase;
+        uint32_t objectCount;
+        uint32_t commandBase;
+        uint32_t batchCount;
+        uint32_t compactBase;
+        uint32_t batchInfoBase;
+        uint32_t countBase;
+    };
+
+    void createDescriptorSet();
+    void writeDescriptorSet();
+    void createPipelines();
+
+    std::shared_ptr<VulkanDevice> device;
+
+    VkDescriptorSetLayout setLayout = VK_NULL_HANDLE;
+    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;   // 四个动态存储缓冲区，均指向 FrameAllocator 的整段
+    uint32_t frameAllocatorVersion = 0;               // 描述符集写入时的 FrameAllocator 版本
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    VkPipeline cullPipeline = VK_NULL_HANDLE;
+    VkPipeline compactPipeline = VK_NULL_HANDLE;
+
+    // 本帧数据：下标相对本帧段起点，偏移为缓冲区内的绝对偏移
+    uint32_t segmentOffset = 0;
+    GpuCullObject* objects = nullptr;
+    uint32_t objectCapacity = 0;
+    uint32_t objectCount = 0;
+    uint32_t objectBase = 0;
+    uint32_t instanceBase = 0;
+    std::vector<VkDrawIndexedIndirectCommand> commands;
+    std::vector<uint32_t> batchGroups;
+    std::vector<Group> groups;
+    VkDeviceSize commandOffset = 0;
+    VkDeviceSize compactOffset = 0;
+    VkDeviceSize countOffset = 0;
+};
+
+} // namespace VulkanEngine
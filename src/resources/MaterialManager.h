@@ -0,0 +1,108 @@
+#pragma once
+
+#include "ResourceHandle.h"
+#include <cstdint>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <unordered_map>
+
+namespace VulkanEngine {
+
+/**
+ * @brief 材质引用的纹理组合（无效句柄表示该用途的默认纹理）
+ */
+struct MaterialTextures {
+    TextureHandle albedo;
+    TextureHandle normal;
+    TextureHandle metallic;
+
+    bool operator==(const MaterialTextures& other) const {
+        return albedo == other.albedo && normal == other.normal && metallic == other.metallic;
+    }
+};
+
+/**
+ * @brief 材质资源管理器
+ * 把纹理句柄组合驻留为 MaterialHandle：同一组合始终得到同一句柄，
+ * 各 Pass 以 MaterialHandle::index 直接索引自己的材质描述符表，查找和绘制都不涉及字符串。
+ * 三个纹理句柄都无效的组合为默认材质（纹理加载期间所有实体共用）。
+ * 单例模式，只在主线程访问
+ */
+class MaterialManager {
+public:
+    static MaterialManager& getInstance() {
+        static MaterialManager instance;
+        return instance;
+    }
+
+    // 禁止拷贝和移动
+    MaterialManager(const MaterialManager&) = delete;
+    MaterialManager& operator=(const MaterialManager&) = delete;
+
+    /**
+     * @brief 获取纹理组合对应的材质句柄，不存在时创建
+     */
+    MaterialHandle acquireMaterial(const MaterialTextures& textures) {
+        auto it = m_materialHandles.find(textures);
+        if (it != m_materialHandles.end()) {
+            return it->second;
+        }
+
+        MaterialHandle handle = m_materials.add(textures);
+        m_materialHandles.emplace(textures, handle);
+        return handle;
+    }
+
+    MaterialHandle getDefaultMaterial() {
+        return acquireMaterial(MaterialTextures());
+    }
+
+    const MaterialTextures* getMaterial(MaterialHandle handle) const {
+        return m_materials.get(handle);
+    }
+
+    bool isHandleValid(MaterialHandle handle) const {
+        return m_materials.contains(handle);
+    }
+
+    /**
+     * @brief 材质表的槽位数（按句柄 index 建立的描述符表不超过该大小）
+     */
+    uint32_t getCapacity() const {
+        return m_materials.getCapacity();
+    }
+
+    size_t getMaterialCount() const {
+        return m_materials.size();
+    }
+
+    /**
+     * @brief 释放所有材质，已发出的句柄全部失效
+     */
+    void cleanup() {
+        std::cout << "[MaterialManager] Cleaning up " << m_materials.size() << " materials..." << std::endl;
+        m_materials.clear();
+        m_materialHandles.clear();
+    }
+
+private:
+    MaterialManager() = default;
+    ~MaterialManager() = default;
+
+    struct MaterialTexturesHash {
+        size_t operator()(const MaterialTextures& textures) const {
+            uint64_t hash = 1469598103934665603ull;
+            for (const TextureHandle* handle : { &textures.albedo, &textures.normal, &textures.metallic }) {
+                hash = (hash ^ handle->index) * 1099511628211ull;
+                hash = (hash ^ handle->generation) * 1099511628211ull;
+            }
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    HandlePool<MaterialHandleTag, MaterialTextures> m_materials;
+    std::unordered_map<MaterialTextures, MaterialHandle, MaterialTexturesHash> m_materialHandles;
+};
+
+} // namespace VulkanEngine
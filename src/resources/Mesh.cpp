@@ -1,4 +1,7 @@
 #include "Mesh.h"
+#include "ObjParser.h"
+#include "GltfLoader.h"
+#include "MeshKernels.h"
 
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "tiny_obj_loader.h"
@@ -8,6 +11,7 @@
 #include <iostream>
 #include <unordered_map>
 #include <algorithm>
+#include <chrono>
 
 const float PI = 3.14159265359f;
 
@@ -22,6 +26,8 @@ Mesh::~Mesh() {
 void Mesh::createCube() {
     vertices.clear();
     indices.clear();
+    lods.clear();
+    lodIndices.clear();
     name = "Cube";
 
     // 立方体顶点数据 (位置, 法线, 纹理坐标, 切线)
@@ -88,6 +94,8 @@ void Mesh::createCube() {
 void Mesh::createSphere(int segments) {
     vertices.clear();
     indices.clear();
+    lods.clear();
+    lodIndices.clear();
     name = "Sphere";
 
     // 球体生成 (UV Sphere)
@@ -141,6 +149,8 @@ void Mesh::createSphere(int segments) {
 void Mesh::createPlane(float size, int subdivisions) {
     vertices.clear();
     indices.clear();
+    lods.clear();
+    lodIndices.clear();
     name = "Plane";
     
     float halfSize = size * 0.5f;
@@ -189,17 +199,117 @@ void Mesh::createPlane(float size, int subdivisions) {
     calculateBounds();
 }
 
-bool Mesh::loadFromOBJ(const std::string& filepath) {
+namespace {
+
+std::string extractModelName(const std::string& filepath) {
+    size_t lastSlash = filepath.find_last_of("/\\");
+    size_t lastDot = filepath.find_last_of('.');
+    if (lastSlash != std::string::npos && lastDot != std::string::npos) {
+        return filepath.substr(lastSlash + 1, lastDot - lastSlash - 1);
+    }
+    return filepath;
+}
+
+} // namespace
+
+bool Mesh::loadFromOBJ(const std::string& filepath, const VertexWelder::Options& weldOptions) {
+    vertices.clear();
+    indices.clear();
+    lods.clear();
+    lodIndices.clear();
+    
+    std::cout << "Loading OBJ file: " << filepath << std::endl;
+    
+    auto startTime = std::chrono::steady_clock::now();
+    
+    ObjData obj;
+    std::string error;
+    if (!ObjParser::parseFile(filepath, obj, error)) {
+        // 原生解析器不支持的写法交给 tinyobj 兜底
+        std::cout << "Native OBJ parser failed (" << error << "), falling back to tinyobj" << std::endl;
+        return loadFromOBJTinyObj(filepath);
+    }
+    
+    auto parseTime = std::chrono::steady_clock::now();
+    
+    name = extractModelName(filepath);
+    
+    std::cout << "Model name: " << name << std::endl;
+    std::cout << "Vertices: " << obj.getPositionCount() << std::endl;
+    std::cout << "Normals: " << obj.getNormalCount() << std::endl;
+    std::cout << "TexCoords: " << obj.getTexCoordCount() << std::endl;
+    std::cout << "Triangles: " << obj.getTriangleCount() << std::endl;
+    
+    bool hasNormals = !obj.normals.empty();
+    bool hasTexCoords = !obj.texCoords.empty();
+    
+    // 按 (v, vt, vn) 索引三元组焊接，索引相同即顶点相同，无需比较浮点属性
+    std::vector<uint32_t> uniqueCorners;
+    VertexWelder::Stats weldStats = VertexWelder::weldCorners(obj.corners.data(), obj.corners.size(),
+                                                               indices, uniqueCorners);
+    VertexWelder::printStats("Index weld", weldStats);
+    
+    vertices.resize(uniqueCorners.size());
+    for (size_t i = 0; i < uniqueCorners.size(); ++i) {
+        const ObjCorner& corner = obj.corners[uniqueCorners[i]];
+        Vertex& vertex = vertices[i];
+        
+        vertex.pos = {
+            obj.positions[3 * corner.position + 0],
+            obj.positions[3 * corner.position + 1],
+            obj.positions[3 * corner.position + 2]
+        };
+        
+        if (hasNormals && corner.normal >= 0) {
+            vertex.normal = {
+                obj.normals[3 * corner.normal + 0],
+                obj.normals[3 * corner.normal + 1],
+                obj.normals[3 * corner.normal + 2]
+            };
+        } else {
+            vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);  // 默认法线，后面会重新计算
+        }
+        
+        if (hasTexCoords && corner.texCoord >= 0) {
+            vertex.texCoord = {
+                obj.texCoords[2 * corner.texCoord + 0],
+                1.0f - obj.texCoords[2 * corner.texCoord + 1]  // 翻转 V 坐标（OBJ 通常是左下角为原点）
+            };
+        } else {
+            vertex.texCoord = glm::vec2(0.0f, 0.0f);
+        }
+        
+        vertex.tangent = glm::vec3(1.0f, 0.0f, 0.0f);
+    }
+    
+    // CAD 导出的模型常把同一位置拆成多个顶点，可选容差焊接
+    if (weldOptions.positionEpsilon > 0.0f) {
+        VertexWelder::printStats("Epsilon weld", VertexWelder::weldVertices(vertices, indices, weldOptions));
+    }
+    
+    auto buildTime = std::chrono::steady_clock::now();
+    
+    std::cout << "Unique vertices: " << vertices.size() << std::endl;
+    std::cout << "Indices: " << indices.size() << std::endl;
+    std::cout << "OBJ parse: " << std::chrono::duration<double, std::milli>(parseTime - startTime).count()
+              << " ms, vertex build: " << std::chrono::duration<double, std::milli>(buildTime - parseTime).count()
+              << " ms" << std::endl;
+    
+    finishImport(hasNormals);
+    return true;
+}
+
+bool Mesh::loadFromOBJTinyObj(const std::string& filepath) {
     vertices.clear();
     indices.clear();
+    lods.clear();
+    lodIndices.clear();
     
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
     std::vector<tinyobj::material_t> materials;
     std::string warn, err;
     
-    std::cout << "Loading OBJ file: " << filepath << std::endl;
-    
     if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, filepath.c_str())) {
         std::cerr << "Failed to load OBJ file: " << filepath << std::endl;
         if (!err.empty()) {
@@ -212,14 +322,7 @@ bool Mesh::loadFromOBJ(const std::string& filepath) {
         std::cout << "Warning: " << warn << std::endl;
     }
     
-    // 从文件路径提取名称
-    size_t lastSlash = filepath.find_last_of("/\\");
-    size_t lastDot = filepath.find_last_of('.');
-    if (lastSlash != std::string::npos && lastDot != std::string::npos) {
-        name = filepath.substr(lastSlash + 1, lastDot - lastSlash - 1);
-    } else {
-        name = filepath;
-    }
+    name = extractModelName(filepath);
     
     std::cout << "Model name: " << name << std::endl;
     std::cout << "Shapes: " << shapes.size() << std::endl;
@@ -283,9 +386,83 @@ bool Mesh::loadFromOBJ(const std::string& filepath) {
     std::cout << "Unique vertices: " << vertices.size() << std::endl;
     std::cout << "Indices: " << indices.size() << std::endl;
     
+    finishImport(hasNormals);
+    return true;
+}
+
+bool Mesh::loadFromGLB(const std::string& filepath, int drawItem) {
+    vertices.clear();
+    indices.clear();
+    lods.clear();
+    lodIndices.clear();
+    
+    std::cout << "Loading GLB file: " << filepath;
+    if (drawItem >= 0) std::cout << " (primitive " << drawItem << ")";
+    std::cout << std::endl;
+    
+    auto startTime = std::chrono::steady_clock::now();
+    
+    GltfLoader gltf;
+    std::string error;
+    if (!gltf.open(filepath, error)) {
+        std::cerr << "Failed to load GLB file: " << filepath << " (" << error << ")" << std::endl;
+        return false;
+    }
+    
+    const auto& items = gltf.getDrawItems();
+    size_t first = 0;
+    size_t last = items.size();
+    if (drawItem >= 0) {
+        if (static_cast<size_t>(drawItem) >= items.size()) {
+            std::cerr << "GLB primitive " << drawItem << " out of range (" << items.size() << " primitives)" << std::endl;
+            return false;
+        }
+        first = static_cast<size_t>(drawItem);
+        last = first + 1;
+    }
+    
+    // 先按访问器数量预留，避免追加时反复扩容
+    size_t vertexTotal = 0;
+    size_t indexTotal = 0;
+    for (size_t i = first; i < last; ++i) {
+        vertexTotal += items[i].vertexCount;
+        indexTotal += items[i].indexCount;
+    }
+    vertices.reserve(vertexTotal);
+    indices.reserve(indexTotal);
+    
+    bool hasNormals = true;
+    for (size_t i = first; i < last; ++i) {
+        bool itemNormals = false;
+        if (!gltf.readDrawItem(i, vertices, indices, itemNormals, error)) {
+            std::cerr << "Failed to read GLB primitive " << i << ": " << error << std::endl;
+            return false;
+        }
+        hasNormals = hasNormals && itemNormals;
+    }
+    
+    if (vertices.empty() || indices.empty()) {
+        std::cerr << "GLB file contains no triangle geometry: " << filepath << std::endl;
+        return false;
+    }
+    
+    name = drawItem >= 0 ? items[first].name : extractModelName(filepath);
+    
+    std::cout << "Model name: " << name << std::endl;
+    std::cout << "Primitives: " << (last - first) << std::endl;
+    std::cout << "Vertices: " << vertices.size() << std::endl;
+    std::cout << "Indices: " << indices.size() << std::endl;
+    std::cout << "GLB read: " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count()
+              << " ms" << std::endl;
+    
+    finishImport(hasNormals);
+    return true;
+}
+
+void Mesh::finishImport(bool hasNormals) {
     // 如果没有法线，计算它们
     if (!hasNormals) {
-        std::cout << "No normals in OBJ, calculating..." << std::endl;
+        std::cout << "No normals in source file, calculating..." << std::endl;
         calculateNormals();
     }
     
@@ -297,34 +474,14 @@ bool Mesh::loadFromOBJ(const std::string& filepath) {
     
     std::cout << "Bounds: min(" << minBounds.x << ", " << minBounds.y << ", " << minBounds.z << ")"
               << " max(" << maxBounds.x << ", " << maxBounds.y << ", " << maxBounds.z << ")" << std::endl;
-    
-    return true;
 }
 
 void Mesh::calculateBounds() {
-    if (vertices.empty()) {
-        minBounds = maxBounds = glm::vec3(0.0f);
-        return;
-    }
-    
-    minBounds = maxBounds = vertices[0].pos;
-    
-    for (const auto& vertex : vertices) {
-        minBounds = glm::min(minBounds, vertex.pos);
-        maxBounds = glm::max(maxBounds, vertex.pos);
-    }
+    MeshKernels::computeBounds(vertices, minBounds, maxBounds);
 }
 
 float Mesh::getBoundingSphereRadius() const {
-    glm::vec3 center = getCenter();
-    float maxDist = 0.0f;
-    
-    for (const auto& vertex : vertices) {
-        float dist = glm::length(vertex.pos - center);
-        maxDist = std::max(maxDist, dist);
-    }
-    
-    return maxDist;
+    return MeshKernels::computeMaxDistance(vertices, getCenter());
 }
 
 void Mesh::centerAndNormalize() {
@@ -354,96 +511,18 @@ void Mesh::centerAndNormalize() {
 }
 
 void Mesh::calculateNormals() {
-    // 重置所有法线为零
-    for (auto& vertex : vertices) {
-        vertex.normal = glm::vec3(0.0f);
-    }
-    
-    // 计算面法线并累加到顶点
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        uint32_t i0 = indices[i];
-        uint32_t i1 = indices[i + 1];
-        uint32_t i2 = indices[i + 2];
-        
-        glm::vec3& v0 = vertices[i0].pos;
-        glm::vec3& v1 = vertices[i1].pos;
-        glm::vec3& v2 = vertices[i2].pos;
-        
-        glm::vec3 edge1 = v1 - v0;
-        glm::vec3 edge2 = v2 - v0;
-        glm::vec3 faceNormal = glm::cross(edge1, edge2);
-        
-        // 累加到每个顶点（加权平均会自动根据面积加权）
-        vertices[i0].normal += faceNormal;
-        vertices[i1].normal += faceNormal;
-        vertices[i2].normal += faceNormal;
-    }
-    
-    // 归一化所有法线
-    for (auto& vertex : vertices) {
-        if (glm::length(vertex.normal) > 0.0001f) {
-            vertex.normal = glm::normalize(vertex.normal);
-        } else {
-            vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
-        }
-    }
+    // 面法线未归一化直接累加，结果按面积加权
+    MeshKernels::computeNormals(vertices, indices);
 }
 
 void Mesh::calculateTangents() {
-    // 重置所有切线
-    for (auto& vertex : vertices) {
-        vertex.tangent = glm::vec3(0.0f);
-    }
-    
-    // 计算每个三角形的切线并累加
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        uint32_t i0 = indices[i];
-        uint32_t i1 = indices[i + 1];
-        uint32_t i2 = indices[i + 2];
-        
-        Vertex& v0 = vertices[i0];
-        Vertex& v1 = vertices[i1];
-        Vertex& v2 = vertices[i2];
-        
-        glm::vec3 edge1 = v1.pos - v0.pos;
-        glm::vec3 edge2 = v2.pos - v0.pos;
-        
-        glm::vec2 deltaUV1 = v1.texCoord - v0.texCoord;
-        glm::vec2 deltaUV2 = v2.texCoord - v0.texCoord;
-        
-        float f = deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y;
-        
-        if (std::abs(f) > 0.0001f) {
-            f = 1.0f / f;
-            
-            glm::vec3 tangent;
-            tangent.x = f * (deltaUV2.y * edge1.x - deltaUV1.y * edge2.x);
-            tangent.y = f * (deltaUV2.y * edge1.y - deltaUV1.y * edge2.y);
-            tangent.z = f * (deltaUV2.y * edge1.z - deltaUV1.y * edge2.z);
-            
-            v0.tangent += tangent;
-            v1.tangent += tangent;
-            v2.tangent += tangent;
-        }
-    }
-    
-    // Gram-Schmidt 正交化并归一化
-    for (auto& vertex : vertices) {
-        if (glm::length(vertex.tangent) > 0.0001f) {
-            // 正交化：T' = T - N * dot(N, T)
-            vertex.tangent = glm::normalize(vertex.tangent - vertex.normal * glm::dot(vertex.normal, vertex.tangent));
-        } else {
-            // 如果切线为零，创建一个默认切线
-            if (std::abs(vertex.normal.x) < 0.9f) {
-                vertex.tangent = glm::normalize(glm::cross(vertex.normal, glm::vec3(1.0f, 0.0f, 0.0f)));
-            } else {
-                vertex.tangent = glm::normalize(glm::cross(vertex.normal, glm::vec3(0.0f, 1.0f, 0.0f)));
-            }
-        }
-    }
+    // 按 UV 梯度累加切线，再对法线做 Gram-Schmidt 正交化
+    MeshKernels::computeTangents(vertices, indices);
 }
 
 void Mesh::cleanup() {
     vertices.clear();
     indices.clear();
+    lods.clear();
+    lodIndices.clear();
 }
\ No newline at end of file
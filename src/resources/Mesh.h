@@ -1,72 +1,10 @@
 #pragma once
 
+#include "Vertex.h"
+#include "MeshSimplifier.h"
+#include "VertexWelder.h"
 #include <vector>
 #include <string>
-#include <glm/glm.hpp>
-#include <vulkan/vulkan.h>
-
-struct Vertex {
-    glm::vec3 pos;
-    glm::vec3 normal;
-    glm::vec2 texCoord;
-    glm::vec3 tangent;
-
-    static VkVertexInputBindingDescription getBindingDescription() {
-        VkVertexInputBindingDescription bindingDescription{};
-        bindingDescription.binding = 0;
-        bindingDescription.stride = sizeof(Vertex);
-        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-        return bindingDescription;
-    }
-
-    static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions() {
-        std::vector<VkVertexInputAttributeDescription> attributeDescriptions(4);
-
-        // Position
-        attributeDescriptions[0].binding = 0;
-        attributeDescriptions[0].location = 0;
-        attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-        attributeDescriptions[0].offset = offsetof(Vertex, pos);
-
-        // Normal
-        attributeDescriptions[1].binding = 0;
-        attributeDescriptions[1].location = 1;
-        attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
-        attributeDescriptions[1].offset = offsetof(Vertex, normal);
-
-        // Texture coordinate
-        attributeDescriptions[2].binding = 0;
-        attributeDescriptions[2].location = 2;
-        attributeDescriptions[2].format = VK_FORMAT_R32G32_SFLOAT;
-        attributeDescriptions[2].offset = offsetof(Vertex, texCoord);
-
-        // Tangent
-        attributeDescriptions[3].binding = 0;
-        attributeDescriptions[3].location = 3;
-        attributeDescriptions[3].format = VK_FORMAT_R32G32B32_SFLOAT;
-        attributeDescriptions[3].offset = offsetof(Vertex, tangent);
-
-        return attributeDescriptions;
-    }
-    
-    // 用于去重的比较运算符
-    bool operator==(const Vertex& other) const {
-        return pos == other.pos && normal == other.normal && 
-               texCoord == other.texCoord && tangent == other.tangent;
-    }
-};
-
-// Vertex 的哈希函数（用于 unordered_map）
-namespace std {
-    template<> struct hash<Vertex> {
-        size_t operator()(Vertex const& vertex) const {
-            size_t h1 = hash<float>()(vertex.pos.x) ^ (hash<float>()(vertex.pos.y) << 1) ^ (hash<float>()(vertex.pos.z) << 2);
-            size_t h2 = hash<float>()(vertex.normal.x) ^ (hash<float>()(vertex.normal.y) << 1) ^ (hash<float>()(vertex.normal.z) << 2);
-            size_t h3 = hash<float>()(vertex.texCoord.x) ^ (hash<float>()(vertex.texCoord.y) << 1);
-            return h1 ^ (h2 << 1) ^ (h3 << 2);
-        }
-    };
-}
 
 class Mesh {
 public:
@@ -78,8 +16,12 @@ public:
     void createSphere(int segments = 32);
     void createPlane(float size = 10.0f, int subdivisions = 1);
     
-    // OBJ 文件加载
-    bool loadFromOBJ(const std::string& filepath);
+    // OBJ 文件加载（weldOptions.positionEpsilon > 0 时额外做容差焊接）
+    bool loadFromOBJ(const std::string& filepath,
+                     const VertexWelder::Options& weldOptions = VertexWelder::Options());
+    
+    // GLB 文件加载（drawItem < 0 时合并所有图元，否则只加载指定图元；顶点位于场景空间）
+    bool loadFromGLB(const std::string& filepath, int drawItem = -1);
     
     // 清理
     void cleanup();
@@ -89,14 +31,53 @@ public:
     const std::vector<uint32_t>& getIndices() const { return indices; }
     const std::string& getName() const { return name; }
     
+    // LOD1..N：简化后的索引拼接在 LOD0 索引之后，共用同一组顶点
+    const std::vector<MeshLod>& getLods() const { return lods; }
+    const std::vector<uint32_t>& getLodIndices() const { return lodIndices; }
+    void setLods(std::vector<MeshLod>&& levels, std::vector<uint32_t>&& levelIndices) {
+        lods = std::move(levels);
+        lodIndices = std::move(levelIndices);
+    }
+    
     // Setters - 用于程序化生成网格
     void setVertices(const std::vector<Vertex>& verts) { 
         vertices = verts; 
         calculateBounds();
     }
-    void setIndices(const std::vector<uint32_t>& inds) { indices = inds; }
+    // 三角形列表（每 3 个顶点一个三角形）经焊接后生成索引
+    void setVertices(const std::vector<Vertex>& verts, const VertexWelder::Options& weldOptions) {
+        vertices = verts;
+        indices.clear();
+        VertexWelder::weldVertices(vertices, indices, weldOptions);
+        calculateBounds();
+    }
+    void setIndices(const std::vector<uint32_t>& inds) {
+        indices = inds;
+        lods.clear();
+        lodIndices.clear();
+    }
+    
+    // 对当前顶点/索引数据焊接
+    VertexWelder::Stats weld(const VertexWelder::Options& options = VertexWelder::Options()) {
+        VertexWelder::Stats stats = VertexWelder::weldVertices(vertices, indices, options);
+        lods.clear();
+        lodIndices.clear();
+        calculateBounds();
+        return stats;
+    }
     void setName(const std::string& n) { name = n; }
     
+    // 直接接管已处理好的几何数据（二进制缓存加载使用，不重新计算包围盒）
+    void setGeometry(std::vector<Vertex>&& verts, std::vector<uint32_t>&& inds,
+                     const glm::vec3& minB, const glm::vec3& maxB) {
+        vertices = std::move(verts);
+        indices = std::move(inds);
+        lods.clear();
+        lodIndices.clear();
+        minBounds = minB;
+        maxBounds = maxB;
+    }
+    
     // 获取包围盒信息
     glm::vec3 getMinBounds() const { return minBounds; }
     glm::vec3 getMaxBounds() const { return maxBounds; }
@@ -110,6 +91,8 @@ private:
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
     std::string name;
+    std::vector<MeshLod> lods;
+    std::vector<uint32_t> lodIndices;
     
     // 包围盒
     glm::vec3 minBounds;
@@ -123,4 +106,10 @@ private:
     
     // 如果 OBJ 没有法线，计算顶点法线
     void calculateNormals();
+    
+    // tinyobj 解析路径（原生解析器失败时的兜底）
+    bool loadFromOBJTinyObj(const std::string& filepath);
+    
+    // 导入收尾：补全法线、切线和包围盒
+    void finishImport(bool hasNormals);
 };
\ No newline at end of file
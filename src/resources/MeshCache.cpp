@@ -0,0 +1,294 @@
+#include "MeshCache.h"
+#include "GltfLoader.h"
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+
+namespace VulkanEngine {
+
+namespace {
+
+struct MeshCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertexStride;
+    uint32_t layoutSignature;
+    uint64_t processKey;
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    uint64_t sourceHash;
+    uint64_t vertexCount;
+    uint64_t indexCount;
+    float minBounds[3];
+    float maxBounds[3];
+    uint32_t nameLength;
+    uint32_t lodCount;
+};
+static_assert(sizeof(MeshCacheHeader) == 96, "MeshCacheHeader layout changed, bump FORMAT_VERSION");
+static_assert(sizeof(MeshLod) == 16, "MeshLod layout changed, bump FORMAT_VERSION");
+
+struct SourceStamp {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+};
+
+// GLB 图元的网格 ID 带 "#<图元>" 后缀，文件校验使用 '#' 之前的路径；其他路径中的 '#' 是文件名的一部分
+std::string getSourceFile(const std::string& sourcePath) {
+    std::string file;
+    int drawItem = -1;
+    if (GltfLoader::isGlbMeshId(sourcePath) && GltfLoader::parseMeshId(sourcePath, file, drawItem)) {
+        return file;
+    }
+    return sourcePath;
+}
+
+bool statSource(const std::string& path, SourceStamp& stamp) {
+    const std::string file = getSourceFile(path);
+    std::error_code ec;
+    auto size = std::filesystem::file_size(file, ec);
+    if (ec) return false;
+    auto time = std::filesystem::last_write_time(file, ec);
+    if (ec) return false;
+
+    stamp.size = static_cast<uint64_t>(size);
+    stamp.mtime = static_cast<int64_t>(time.time_since_epoch().count());
+    return true;
+}
+
+bool hashSource(const std::string& path, uint64_t& hash) {
+    MappedFile source(getSourceFile(path));
+    if (!source.isOpen()) return false;
+    hash = MeshCache::hashBytes(source.getData(), source.getSize());
+    return true;
+}
+
+} // namespace
+
+std::string MeshCache::getCachePath(const std::string& sourcePath) {
+    return sourcePath + ".vmesh";
+}
+
+uint32_t MeshCache::getVertexLayoutSignature() {
+    const uint32_t fields[] = {
+        static_cast<uint32_t>(sizeof(Vertex)),
+        static_cast<uint32_t>(offsetof(Vertex, pos)),
+        static_cast<uint32_t>(offsetof(Vertex, normal)),
+        static_cast<uint32_t>(offsetof(Vertex, texCoord)),
+        static_cast<uint32_t>(offsetof(Vertex, tangent)),
+    };
+    return static_cast<uint32_t>(hashBytes(fields, sizeof(fields)));
+}
+
+uint64_t MeshCache::hashBytes(const void* data, size_t size) {
+    const uint64_t prime = 0x100000001B3ull;
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        hash ^= word;
+        hash *= prime;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= prime;
+    }
+    return hash ^ static_cast<uint64_t>(size);
+}
+
+bool MeshCache::load(const std::string& sourcePath, Mesh& mesh, uint64_t processKey) {
+    const std::string cachePath = getCachePath(sourcePath);
+
+    SourceStamp stamp;
+    if (!statSource(sourcePath, stamp)) {
+        return false;
+    }
+
+    MappedFile cache(cachePath);
+    if (!cache.isOpen() || cache.getSize() < sizeof(MeshCacheHeader)) {
+        return false;
+    }
+
+    MeshCacheHeader header;
+    std::memcpy(&header, cache.getData(), sizeof(header));
+
+    if (header.magic != MAGIC ||
+        header.version != FORMAT_VERSION ||
+        header.vertexStride != sizeof(Vertex) ||
+        header.layoutSignature != getVertexLayoutSignature() ||
+        header.processKey != processKey ||
+        header.sourceSize != stamp.size) {
+        std::cout << "[MeshCache] Stale cache, rebuilding: " << cachePath << std::endl;
+        return false;
+    }
+
+    const uint64_t vertexBytes = header.vertexCount * sizeof(Vertex);
+    const uint64_t indexBytes = header.indexCount * sizeof(uint32_t);
+    const uint64_t lodBytes = static_cast<uint64_t>(header.lodCount) * sizeof(MeshLod);
+    if (sizeof(MeshCacheHeader) + vertexBytes + indexBytes + lodBytes > cache.getSize()) {
+        std::cerr << "[MeshCache] Corrupted cache file: " << cachePath << std::endl;
+        return false;
+    }
+
+    // LOD 表紧跟在索引之后，LOD 索引总数由各级区间累加得到（区间必须首尾相接）
+    std::vector<MeshLod> lods(header.lodCount);
+    std::memcpy(lods.data(), cache.getData() + sizeof(MeshCacheHeader) + vertexBytes + indexBytes,
+                static_cast<size_t>(lodBytes));
+    uint64_t lodIndexCount = 0;
+    for (const MeshLod& lod : lods) {
+        if (lod.firstIndex != header.indexCount + lodIndexCount || lod.indexCount % 3 != 0) {
+            std::cerr << "[MeshCache] Corrupted LOD table in cache file: " << cachePath << std::endl;
+            return false;
+        }
+        lodIndexCount += lod.indexCount;
+    }
+    const uint64_t lodIndexBytes = lodIndexCount * sizeof(uint32_t);
+
+    const uint64_t expectedSize = sizeof(MeshCacheHeader) + vertexBytes + indexBytes + lodBytes + lodIndexBytes +
+                                  header.nameLength;
+    if (expectedSize != cache.getSize() || header.vertexCount == 0 || header.indexCount % 3 != 0) {
+        std::cerr << "[MeshCache] Corrupted cache file: " << cachePath << std::endl;
+        return false;
+    }
+
+    // 修改时间变化（如 git checkout）但内容未变时仍可复用缓存
+    bool refreshStamp = false;
+    if (header.sourceMtime != stamp.mtime) {
+        uint64_t sourceHash = 0;
+        if (!hashSource(sourcePath, sourceHash) || sourceHash != header.sourceHash) {
+            std::cout << "[MeshCache] Source modified, rebuilding: " << cachePath << std::endl;
+            return false;
+        }
+        refreshStamp = true;
+    }
+
+    const uint8_t* cursor = cache.getData() + sizeof(MeshCacheHeader);
+
+    std::vector<Vertex> vertices(static_cast<size_t>(header.vertexCount));
+    std::memcpy(vertices.data(), cursor, static_cast<size_t>(vertexBytes));
+    cursor += vertexBytes;
+
+    std::vector<uint32_t> indices(static_cast<size_t>(header.indexCount));
+    std::memcpy(indices.data(), cursor, static_cast<size_t>(indexBytes));
+    cursor += indexBytes + lodBytes;
+
+    std::vector<uint32_t> lodIndices(static_cast<size_t>(lodIndexCount));
+    std::memcpy(lodIndices.data(), cursor, static_cast<size_t>(lodIndexBytes));
+    cursor += lodIndexBytes;
+
+    std::string name(reinterpret_cast<const char*>(cursor), header.nameLength);
+
+    // 索引越界会直接导致 GPU 访问越界，这里做一次线性校验
+    const uint32_t vertexCount = static_cast<uint32_t>(header.vertexCount);
+    for (const std::vector<uint32_t>* list : { &indices, &lodIndices }) {
+        for (uint32_t index : *list) {
+            if (index >= vertexCount) {
+                std::cerr << "[MeshCache] Index out of range in cache file: " << cachePath << std::endl;
+                return false;
+            }
+        }
+    }
+
+    cache.close();
+
+    mesh.setGeometry(std::move(vertices), std::move(indices),
+                     glm::vec3(header.minBounds[0], header.minBounds[1], header.minBounds[2]),
+                     glm::vec3(header.maxBounds[0], header.maxBounds[1], header.maxBounds[2]));
+    mesh.setLods(std::move(lods), std::move(lodIndices));
+    mesh.setName(name);
+
+    if (refreshStamp) {
+        std::fstream file(cachePath, std::ios::in | std::ios::out | std::ios::binary);
+        if (file) {
+            file.seekp(offsetof(MeshCacheHeader, sourceMtime));
+            file.write(reinterpret_cast<const char*>(&stamp.mtime), sizeof(stamp.mtime));
+        }
+    }
+
+    return true;
+}
+
+bool MeshCache::save(const std::string& sourcePath, const Mesh& mesh, uint64_t processKey) {
+    const auto& vertices = mesh.getVertices();
+    const auto& indices = mesh.getIndices();
+    if (vertices.empty() || indices.empty()) {
+        return false;
+    }
+
+    SourceStamp stamp;
+    uint64_t sourceHash = 0;
+    if (!statSource(sourcePath, stamp) || !hashSource(sourcePath, sourceHash)) {
+        return false;
+    }
+
+    MeshCacheHeader header{};
+    header.magic = MAGIC;
+    header.version = FORMAT_VERSION;
+    header.vertexStride = sizeof(Vertex);
+    header.layoutSignature = getVertexLayoutSignature();
+    header.processKey = processKey;
+    header.sourceSize = stamp.size;
+    header.sourceMtime = stamp.mtime;
+    header.sourceHash = sourceHash;
+    header.vertexCount = vertices.size();
+    header.indexCount = indices.size();
+
+    const glm::vec3 minBounds = mesh.getMinBounds();
+    const glm::vec3 maxBounds = mesh.getMaxBounds();
+    for (int i = 0; i < 3; ++i) {
+        header.minBounds[i] = minBounds[i];
+        header.maxBounds[i] = maxBounds[i];
+    }
+    header.nameLength = static_cast<uint32_t>(mesh.getName().size());
+    header.lodCount = static_cast<uint32_t>(mesh.getLods().size());
+
+    const std::string cachePath = getCachePath(sourcePath);
+    const std::string tempPath = cachePath + ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "[MeshCache] Cannot write cache file: " << tempPath << std::endl;
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(Vertex));
+        file.write(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(uint32_t));
+        file.write(reinterpret_cast<const char*>(mesh.getLods().data()), mesh.getLods().size() * sizeof(MeshLod));
+        file.write(reinterpret_cast<const char*>(mesh.getLodIndices().data()),
+                   mesh.getLodIndices().size() * sizeof(uint32_t));
+        file.write(mesh.getName().data(), mesh.getName().size());
+
+        if (!file) {
+            std::cerr << "[MeshCache] Failed writing cache file: " << tempPath << std::endl;
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec) {
+        std::cerr << "[MeshCache] Failed to replace cache file: " << cachePath
+                  << " (" << ec.message() << ")" << std::endl;
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    std::cout << "[MeshCache] Wrote " << cachePath << " (" << vertices.size() << " vertices, "
+              << indices.size() << " indices, " << mesh.getLods().size() << " LODs)" << std::endl;
+    return true;
+}
+
+} // namespace VulkanEngine
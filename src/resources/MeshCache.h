@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Mesh.h"
+#include <cstdint>
+#include <string>
+
+namespace VulkanEngine {
+
+/**
+ * @brief 二进制网格缓存
+ *
+ * 首次加载源文件（如 .obj、.glb）并完成所有 CPU 处理后，将结果写入源文件旁边的
+ * "<source>.vmesh" 文件（"model.glb#N" 这类子资源 ID 对应 "model.glb#N.vmesh"，
+ * 失效检查使用 '#' 之前的源文件）；之后的加载通过内存映射读取，直接拷贝到顶点/索引数组，
+ * 跳过文本解析、去重、切线计算和归一化。
+ *
+ * 文件布局（小端）：
+ *   MeshCacheHeader | Vertex[vertexCount] | uint32_t[indexCount]
+ *   | MeshLod[lodCount] | uint32_t[LOD 索引总数] | name
+ *
+ * 失效条件：
+ *   - 格式版本或 Vertex 内存布局变化
+ *   - 调用方传入的处理参数 key 变化
+ *   - 源文件大小变化；修改时间变化且内容哈希也不同
+ */
+class MeshCache {
+public:
+    static constexpr uint32_t MAGIC = 0x48534D56;  // "VMSH"
+    static constexpr uint32_t FORMAT_VERSION = 2;
+
+    /**
+     * @brief 获取源文件对应的缓存文件路径
+     */
+    static std::string getCachePath(const std::string& sourcePath);
+
+    /**
+     * @brief 尝试从缓存加载网格
+     * @param sourcePath 源文件路径
+     * @param mesh 输出网格
+     * @param processKey 生成缓存时使用的处理参数摘要，不一致则视为失效
+     * @return 缓存有效且加载成功返回 true
+     */
+    static bool load(const std::string& sourcePath, Mesh& mesh, uint64_t processKey = 0);
+
+    /**
+     * @brief 将处理后的网格写入缓存（先写临时文件再重命名）
+     */
+    static bool save(const std::string& sourcePath, const Mesh& mesh, uint64_t processKey = 0);
+
+    /**
+     * @brief Vertex 布局签名（stride 与各字段偏移），布局改变后旧缓存自动失效
+     */
+    static uint32_t getVertexLayoutSignature();
+
+    /**
+     * @brief 64 位内容哈希（按 8 字节分块的 FNV-1a 变体）
+     */
+    static uint64_t hashBytes(const void* data, size_t size);
+};
+
+} // namespace VulkanEngine
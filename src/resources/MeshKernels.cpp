@@ -0,0 +1,477 @@
+#include "MeshKernels.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MESH_KERNELS_AVX2 1
+#define MESH_KERNELS_SSE 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MESH_KERNELS_SSE 1
+#endif
+
+namespace {
+
+constexpr size_t VERTEX_GRAIN = 1 << 15;
+
+// 小网格或线程池只有一个工作线程时直接在调用线程执行
+bool runsParallel(size_t count) {
+    return count >= MeshKernels::PARALLEL_MIN_ELEMENTS && ThreadPool::getShared().getThreadCount() >= 2;
+}
+
+// 串行时 fn 只会收到一个 [0, count) 区间
+void forRanges(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    if (!runsParallel(count)) {
+        fn(0, count);
+        return;
+    }
+    ThreadPool::getShared().parallelFor(count, grain, fn);
+}
+
+// ============================================================
+// 宽向量封装：8 路 AVX2 / 4 路 SSE2，只提供内核用到的运算
+// ============================================================
+#if defined(MESH_KERNELS_AVX2)
+struct Wide {
+    using F = __m256;
+    using I = __m256i;
+    static constexpr size_t WIDTH = 8;
+
+    // tri 指向 WIDTH 个连续三角形的索引，取出第 corner 个角
+    static I loadCorner(const uint32_t* tri, int corner) {
+        const __m256i stride = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+        return _mm256_i32gather_epi32(reinterpret_cast<const int*>(tri + corner), stride, 4);
+    }
+    static F gather(const float* src, I index) { return _mm256_i32gather_ps(src, index, 4); }
+    static void store(float* dst, F v) { _mm256_storeu_ps(dst, v); }
+    static F add(F a, F b) { return _mm256_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+    static F div(F a, F b) { return _mm256_div_ps(a, b); }
+    static F set1(float s) { return _mm256_set1_ps(s); }
+    static F abs(F a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static int greaterMask(F a, F b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+};
+#elif defined(MESH_KERNELS_SSE)
+struct Wide {
+    using F = __m128;
+    struct I { uint32_t lane[4]; };
+    static constexpr size_t WIDTH = 4;
+
+    static I loadCorner(const uint32_t* tri, int corner) {
+        return { { tri[corner], tri[3 + corner], tri[6 + corner], tri[9 + corner] } };
+    }
+    static F gather(const float* src, const I& index) {
+        return _mm_setr_ps(src[index.lane[0]], src[index.lane[1]], src[index.lane[2]], src[index.lane[3]]);
+    }
+    static void store(float* dst, F v) { _mm_storeu_ps(dst, v); }
+    static F add(F a, F b) { return _mm_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+    static F div(F a, F b) { return _mm_div_ps(a, b); }
+    static F set1(float s) { return _mm_set1_ps(s); }
+    static F abs(F a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static int greaterMask(F a, F b) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)); }
+};
+#endif
+
+// 顶点按 float 数组访问：索引 * VERTEX_FLOATS + 字段偏移
+constexpr uint32_t VERTEX_FLOATS = sizeof(Vertex) / sizeof(float);
+constexpr uint32_t POS_OFFSET = offsetof(Vertex, pos) / sizeof(float);
+constexpr uint32_t TEXCOORD_OFFSET = offsetof(Vertex, texCoord) / sizeof(float);
+static_assert(sizeof(Vertex) % sizeof(float) == 0, "Vertex must be an array of floats");
+
+// 串行路径每次处理的三角形数（面向量临时数组常驻 L1/L2）
+constexpr size_t FACE_BLOCK = 1024;
+
+/**
+ * 一段三角形的面向量（SoA），valid 为 0 的三角形不参与累加
+ */
+struct FaceVectors {
+    std::vector<float> x, y, z;
+    std::vector<uint8_t> valid;
+    size_t base = 0;   // 第一个元素对应的三角形编号
+
+    void resize(size_t count, bool withValidity) {
+        x.resize(count);
+        y.resize(count);
+        z.resize(count);
+        if (withValidity) valid.resize(count);
+    }
+};
+
+#if defined(MESH_KERNELS_AVX2)
+inline Wide::I scaleIndex(Wide::I index) {
+    return _mm256_mullo_epi32(index, _mm256_set1_epi32(static_cast<int>(VERTEX_FLOATS)));
+}
+#elif defined(MESH_KERNELS_SSE)
+inline Wide::I scaleIndex(Wide::I index) {
+    for (uint32_t& lane : index.lane) lane *= VERTEX_FLOATS;
+    return index;
+}
+#endif
+
+// ------------------------------------------------------------
+// 面法线：cross(p1 - p0, p2 - p0)，与 glm::cross 的运算顺序一致
+// ------------------------------------------------------------
+void faceNormals(const Vertex* vertices, const uint32_t* indices, size_t begin, size_t end, FaceVectors& out) {
+    size_t t = begin;
+#if defined(MESH_KERNELS_SSE)
+    using W = Wide;
+    const float* px = reinterpret_cast<const float*>(vertices) + POS_OFFSET;
+    const float* py = px + 1;
+    const float* pz = px + 2;
+    for (; t + W::WIDTH <= end; t += W::WIDTH) {
+        const uint32_t* tri = indices + t * 3;
+        W::I i0 = scaleIndex(W::loadCorner(tri, 0));
+        W::I i1 = scaleIndex(W::loadCorner(tri, 1));
+        W::I i2 = scaleIndex(W::loadCorner(tri, 2));
+
+        W::F x0 = W::gather(px, i0), y0 = W::gather(py, i0), z0 = W::gather(pz, i0);
+        W::F e1x = W::sub(W::gather(px, i1), x0);
+        W::F e1y = W::sub(W::gather(py, i1), y0);
+        W::F e1z = W::sub(W::gather(pz, i1), z0);
+        W::F e2x = W::sub(W::gather(px, i2), x0);
+        W::F e2y = W::sub(W::gather(py, i2), y0);
+        W::F e2z = W::sub(W::gather(pz, i2), z0);
+
+        size_t o = t - out.base;
+        W::store(&out.x[o], W::sub(W::mul(e1y, e2z), W::mul(e2y, e1z)));
+        W::store(&out.y[o], W::sub(W::mul(e1z, e2x), W::mul(e2z, e1x)));
+        W::store(&out.z[o], W::sub(W::mul(e1x, e2y), W::mul(e2x, e1y)));
+    }
+#endif
+    for (; t < end; ++t) {
+        const uint32_t* tri = indices + t * 3;
+        glm::vec3 n = glm::cross(vertices[tri[1]].pos - vertices[tri[0]].pos, vertices[tri[2]].pos - vertices[tri[0]].pos);
+        size_t o = t - out.base;
+        out.x[o] = n.x;
+        out.y[o] = n.y;
+        out.z[o] = n.z;
+    }
+}
+
+// ------------------------------------------------------------
+// 面切线：f = 1 / (du1 * dv2 - du2 * dv1)，T = f * (dv2 * e1 - dv1 * e2)
+// ------------------------------------------------------------
+constexpr float TANGENT_EPSILON = 0.0001f;
+
+void faceTangents(const Vertex* vertices, const uint32_t* indices, size_t begin, size_t end, FaceVectors& out) {
+    size_t t = begin;
+#if defined(MESH_KERNELS_SSE)
+    using W = Wide;
+    const float* px = reinterpret_cast<const float*>(vertices) + POS_OFFSET;
+    const float* py = px + 1;
+    const float* pz = px + 2;
+    const float* tu = reinterpret_cast<const float*>(vertices) + TEXCOORD_OFFSET;
+    const float* tv = tu + 1;
+    const W::F epsilon = W::set1(TANGENT_EPSILON);
+    const W::F one = W::set1(1.0f);
+    for (; t + W::WIDTH <= end; t += W::WIDTH) {
+        const uint32_t* tri = indices + t * 3;
+        W::I i0 = scaleIndex(W::loadCorner(tri, 0));
+        W::I i1 = scaleIndex(W::loadCorner(tri, 1));
+        W::I i2 = scaleIndex(W::loadCorner(tri, 2));
+
+        W::F u0 = W::gather(tu, i0), v0 = W::gather(tv, i0);
+        W::F du1 = W::sub(W::gather(tu, i1), u0);
+        W::F dv1 = W::sub(W::gather(tv, i1), v0);
+        W::F du2 = W::sub(W::gather(tu, i2), u0);
+        W::F dv2 = W::sub(W::gather(tv, i2), v0);
+
+        size_t o = t - out.base;
+        W::F f = W::sub(W::mul(du1, dv2), W::mul(du2, dv1));
+        int mask = W::greaterMask(W::abs(f), epsilon);
+        for (size_t j = 0; j < W::WIDTH; ++j) {
+            out.valid[o + j] = static_cast<uint8_t>((mask >> j) & 1);
+        }
+        if (mask == 0) continue;
+        f = W::div(one, f);
+
+        W::F x0 = W::gather(px, i0), y0 = W::gather(py, i0), z0 = W::gather(pz, i0);
+        W::F e1x = W::sub(W::gather(px, i1), x0);
+        W::F e1y = W::sub(W::gather(py, i1), y0);
+        W::F e1z = W::sub(W::gather(pz, i1), z0);
+        W::F e2x = W::sub(W::gather(px, i2), x0);
+        W::F e2y = W::sub(W::gather(py, i2), y0);
+        W::F e2z = W::sub(W::gather(pz, i2), z0);
+
+        W::store(&out.x[o], W::mul(f, W::sub(W::mul(dv2, e1x), W::mul(dv1, e2x))));
+        W::store(&out.y[o], W::mul(f, W::sub(W::mul(dv2, e1y), W::mul(dv1, e2y))));
+        W::store(&out.z[o], W::mul(f, W::sub(W::mul(dv2, e1z), W::mul(dv1, e2z))));
+    }
+#endif
+    for (; t < end; ++t) {
+        const Vertex& v0 = vertices[indices[t * 3 + 0]];
+        const Vertex& v1 = vertices[indices[t * 3 + 1]];
+        const Vertex& v2 = vertices[indices[t * 3 + 2]];
+        glm::vec3 edge1 = v1.pos - v0.pos;
+        glm::vec3 edge2 = v2.pos - v0.pos;
+        glm::vec2 deltaUV1 = v1.texCoord - v0.texCoord;
+        glm::vec2 deltaUV2 = v2.texCoord - v0.texCoord;
+
+        size_t o = t - out.base;
+        float f = deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y;
+        out.valid[o] = std::abs(f) > TANGENT_EPSILON ? 1 : 0;
+        if (!out.valid[o]) continue;
+
+        f = 1.0f / f;
+        out.x[o] = f * (deltaUV2.y * edge1.x - deltaUV1.y * edge2.x);
+        out.y[o] = f * (deltaUV2.y * edge1.y - deltaUV1.y * edge2.y);
+        out.z[o] = f * (deltaUV2.y * edge1.z - deltaUV1.y * edge2.z);
+    }
+}
+
+/**
+ * 每个线程负责的一段三角形及其累加结果。
+ * 经过顶点读取优化的网格中，一段连续三角形引用的顶点集中在一个较小的索引窗口内，
+ * 因此每段只为 [firstVertex, lastVertex] 分配累加数组
+ */
+struct FaceChunk {
+    size_t beginTriangle = 0;
+    size_t endTriangle = 0;
+    uint32_t firstVertex = 0;
+    uint32_t lastVertex = 0;
+    std::vector<glm::vec3> sums;
+};
+
+// 各段顶点窗口总大小超过顶点数的该倍数时（索引局部性差）退回串行
+constexpr size_t MAX_WINDOW_OVERLAP = 4;
+
+/**
+ * 按块计算 [begin, end) 的面向量，按三角形顺序累加到 sums[index - firstVertex]
+ */
+template<typename FaceKernel, typename Sum>
+void scatterFaces(const Vertex* vertices, const uint32_t* indices, size_t begin, size_t end, bool withValidity,
+                  const FaceKernel& kernel, uint32_t firstVertex, const Sum& sum) {
+    FaceVectors faces;
+    faces.resize(FACE_BLOCK, withValidity);
+    for (size_t blockBegin = begin; blockBegin < end; blockBegin += FACE_BLOCK) {
+        size_t blockEnd = std::min(blockBegin + FACE_BLOCK, end);
+        faces.base = blockBegin;
+        kernel(vertices, indices, blockBegin, blockEnd, faces);
+
+        for (size_t t = blockBegin; t < blockEnd; ++t) {
+            size_t o = t - blockBegin;
+            if (withValidity && !faces.valid[o]) continue;
+            glm::vec3 face(faces.x[o], faces.y[o], faces.z[o]);
+            sum(indices[t * 3 + 0] - firstVertex) += face;
+            sum(indices[t * 3 + 1] - firstVertex) += face;
+            sum(indices[t * 3 + 2] - firstVertex) += face;
+        }
+    }
+}
+
+/**
+ * 计算面向量并累加到各顶点，最后对每个顶点调用 finish(v, sum)。
+ * - 串行：直接累加到 vertex.*target，加法顺序与逐三角形的标量写法相同，结果逐位一致
+ * - 并行：每个线程处理一段三角形并累加到自己的顶点窗口，再按段顺序合并；
+ *   同一顶点的部分和分段相加，与串行结果只有舍入误差
+ */
+template<typename FaceKernel, typename Finish>
+void accumulateFaces(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, bool withValidity,
+                     const FaceKernel& kernel, glm::vec3 Vertex::*target, const Finish& finish) {
+    const size_t vertexCount = vertices.size();
+    const size_t triangleCount = indices.size() / 3;
+    ThreadPool& pool = ThreadPool::getShared();
+
+    std::vector<FaceChunk> chunks;
+    if (runsParallel(triangleCount)) {
+        const size_t chunkCount = pool.getThreadCount() + 1;
+        const size_t chunkSize = (triangleCount + chunkCount - 1) / chunkCount;
+        chunks.resize(chunkCount);
+        pool.parallelFor(chunkCount, 1, [&](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c) {
+                FaceChunk& chunk = chunks[c];
+                chunk.beginTriangle = std::min(c * chunkSize, triangleCount);
+                chunk.endTriangle = std::min(chunk.beginTriangle + chunkSize, triangleCount);
+                if (chunk.beginTriangle == chunk.endTriangle) continue;
+
+                auto range = std::minmax_element(indices.begin() + chunk.beginTriangle * 3,
+                                                 indices.begin() + chunk.endTriangle * 3);
+                chunk.firstVertex = *range.first;
+                chunk.lastVertex = *range.second;
+            }
+        });
+
+        size_t windowTotal = 0;
+        for (const FaceChunk& chunk : chunks) {
+            if (chunk.beginTriangle != chunk.endTriangle) {
+                windowTotal += chunk.lastVertex - chunk.firstVertex + 1;
+            }
+        }
+        if (windowTotal > vertexCount * MAX_WINDOW_OVERLAP) {
+            chunks.clear();
+        }
+    }
+
+    if (chunks.empty()) {
+        for (Vertex& vertex : vertices) {
+            vertex.*target = glm::vec3(0.0f);
+        }
+        scatterFaces(vertices.data(), indices.data(), 0, triangleCount, withValidity, kernel, 0,
+                     [&](uint32_t v) -> glm::vec3& { return vertices[v].*target; });
+        for (size_t v = 0; v < vertexCount; ++v) {
+            finish(v, glm::vec3(vertices[v].*target));
+        }
+        return;
+    }
+
+    pool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            FaceChunk& chunk = chunks[c];
+            if (chunk.beginTriangle == chunk.endTriangle) continue;
+            chunk.sums.assign(chunk.lastVertex - chunk.firstVertex + 1, glm::vec3(0.0f));
+            scatterFaces(vertices.data(), indices.data(), chunk.beginTriangle, chunk.endTriangle, withValidity,
+                         kernel, chunk.firstVertex, [&](uint32_t v) -> glm::vec3& { return chunk.sums[v]; });
+        }
+    });
+
+    pool.parallelFor(vertexCount, VERTEX_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            glm::vec3 sum(0.0f);
+            for (const FaceChunk& chunk : chunks) {
+                if (!chunk.sums.empty() && v >= chunk.firstVertex && v <= chunk.lastVertex) {
+                    sum += chunk.sums[v - chunk.firstVertex];
+                }
+            }
+            finish(v, sum);
+        }
+    });
+}
+
+// ------------------------------------------------------------
+// 包围盒 / 半径：顶点为 AoS，逐顶点读取 16 字节（pos + 下一个字段，第 4 个分量忽略）
+// ------------------------------------------------------------
+void boundsRange(const Vertex* vertices, size_t begin, size_t end, glm::vec3& minBounds, glm::vec3& maxBounds) {
+#if defined(MESH_KERNELS_SSE)
+    static_assert(sizeof(Vertex) >= offsetof(Vertex, pos) + 4 * sizeof(float), "Vertex too small for 16-byte loads");
+    __m128 lo = _mm_loadu_ps(&vertices[begin].pos.x);
+    __m128 hi = lo;
+    for (size_t i = begin + 1; i < end; ++i) {
+        __m128 p = _mm_loadu_ps(&vertices[i].pos.x);
+        // 参数顺序与 glm::min/max 一致：相等时保留先出现的值
+        lo = _mm_min_ps(p, lo);
+        hi = _mm_max_ps(p, hi);
+    }
+    alignas(16) float l[4];
+    alignas(16) float h[4];
+    _mm_store_ps(l, lo);
+    _mm_store_ps(h, hi);
+    minBounds = glm::vec3(l[0], l[1], l[2]);
+    maxBounds = glm::vec3(h[0], h[1], h[2]);
+#else
+    minBounds = maxBounds = vertices[begin].pos;
+    for (size_t i = begin + 1; i < end; ++i) {
+        minBounds = glm::min(minBounds, vertices[i].pos);
+        maxBounds = glm::max(maxBounds, vertices[i].pos);
+    }
+#endif
+}
+
+// 返回最大平方距离（sqrt 单调，最后开方与逐顶点开方取最大结果相同）
+float maxDistanceSquaredRange(const Vertex* vertices, size_t begin, size_t end, const glm::vec3& center) {
+    size_t i = begin;
+    float result = 0.0f;
+#if defined(MESH_KERNELS_SSE)
+    const __m128 cx = _mm_set1_ps(center.x);
+    const __m128 cy = _mm_set1_ps(center.y);
+    const __m128 cz = _mm_set1_ps(center.z);
+    __m128 best = _mm_setzero_ps();
+    for (; i + 4 <= end; i += 4) {
+        // 4 个顶点转置为 SoA 后纵向计算
+        __m128 r0 = _mm_loadu_ps(&vertices[i + 0].pos.x);
+        __m128 r1 = _mm_loadu_ps(&vertices[i + 1].pos.x);
+        __m128 r2 = _mm_loadu_ps(&vertices[i + 2].pos.x);
+        __m128 r3 = _mm_loadu_ps(&vertices[i + 3].pos.x);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+        __m128 dx = _mm_sub_ps(r0, cx);
+        __m128 dy = _mm_sub_ps(r1, cy);
+        __m128 dz = _mm_sub_ps(r2, cz);
+        __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        best = _mm_max_ps(best, d2);
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, best);
+    result = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#endif
+    for (; i < end; ++i) {
+        glm::vec3 d = vertices[i].pos - center;
+        result = std::max(result, glm::dot(d, d));
+    }
+    return result;
+}
+
+} // namespace
+
+const char* MeshKernels::getInstructionSet() {
+#if defined(MESH_KERNELS_AVX2)
+    return "AVX2";
+#elif defined(MESH_KERNELS_SSE)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+
+void MeshKernels::computeBounds(const std::vector<Vertex>& vertices, glm::vec3& minBounds, glm::vec3& maxBounds) {
+    if (vertices.empty()) {
+        minBounds = maxBounds = glm::vec3(0.0f);
+        return;
+    }
+
+    // 每个区间独立归约，再按区间顺序合并
+    const size_t chunkCount = (vertices.size() + VERTEX_GRAIN - 1) / VERTEX_GRAIN;
+    std::vector<glm::vec3> chunkMin(chunkCount, vertices[0].pos);
+    std::vector<glm::vec3> chunkMax(chunkCount, vertices[0].pos);
+    forRanges(vertices.size(), VERTEX_GRAIN, [&](size_t begin, size_t end) {
+        boundsRange(vertices.data(), begin, end, chunkMin[begin / VERTEX_GRAIN], chunkMax[begin / VERTEX_GRAIN]);
+    });
+
+    minBounds = maxBounds = vertices[0].pos;
+    for (size_t c = 0; c < chunkCount; ++c) {
+        minBounds = glm::min(minBounds, chunkMin[c]);
+        maxBounds = glm::max(maxBounds, chunkMax[c]);
+    }
+}
+
+float MeshKernels::computeMaxDistance(const std::vector<Vertex>& vertices, const glm::vec3& center) {
+    if (vertices.empty()) return 0.0f;
+
+    const size_t chunkCount = (vertices.size() + VERTEX_GRAIN - 1) / VERTEX_GRAIN;
+    std::vector<float> chunkMax(chunkCount, 0.0f);
+    forRanges(vertices.size(), VERTEX_GRAIN, [&](size_t begin, size_t end) {
+        chunkMax[begin / VERTEX_GRAIN] = maxDistanceSquaredRange(vertices.data(), begin, end, center);
+    });
+    return std::sqrt(*std::max_element(chunkMax.begin(), chunkMax.end()));
+}
+
+void MeshKernels::computeNormals(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    accumulateFaces(vertices, indices, false, faceNormals, &Vertex::normal, [&](size_t v, const glm::vec3& normal) {
+        if (glm::length(normal) > 0.0001f) {
+            vertices[v].normal = glm::normalize(normal);
+        } else {
+            vertices[v].normal = glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+    });
+}
+
+void MeshKernels::computeTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    accumulateFaces(vertices, indices, true, faceTangents, &Vertex::tangent, [&](size_t v, const glm::vec3& tangent) {
+        // Gram-Schmidt 正交化：T' = T - N * dot(N, T)
+        const glm::vec3& normal = vertices[v].normal;
+        if (glm::length(tangent) > 0.0001f) {
+            vertices[v].tangent = glm::normalize(tangent - normal * glm::dot(normal, tangent));
+        } else if (std::abs(normal.x) < 0.9f) {
+            vertices[v].tangent = glm::normalize(glm::cross(normal, glm::vec3(1.0f, 0.0f, 0.0f)));
+        } else {
+            vertices[v].tangent = glm::normalize(glm::cross(normal, glm::vec3(0.0f, 1.0f, 0.0f)));
+        }
+    });
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Vertex.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 网格批量计算内核（包围盒、包围球半径、顶点法线、切线）
+ *
+ * 按编译目标选择指令集：定义 __AVX2__ 时 8 路（/arch:AVX2 或 -mavx2），
+ * x86-64 默认 SSE2 4 路，其他平台为标量实现。元素数超过 PARALLEL_MIN_ELEMENTS
+ * 且共享线程池至少有两个工作线程时按区间并行。
+ *
+ * 法线/切线按三角形宽向量读取顶点，面向量按块写入 SoA 临时数组后累加：
+ * - 串行时按三角形顺序直接累加，加法顺序与原标量实现相同且不使用 FMA，结果逐位一致
+ * - 并行时每个线程处理一段三角形，累加到该段引用的顶点索引窗口，再按段顺序合并，
+ *   分段边界上的顶点与串行结果只有舍入误差。索引局部性差（窗口重叠过多）时退回串行
+ * 包围盒/半径按区间归约后合并，与原实现逐位一致
+ */
+class MeshKernels {
+public:
+    static constexpr size_t PARALLEL_MIN_ELEMENTS = 1 << 16;
+
+    /**
+     * @brief 当前编译使用的指令集（"AVX2" / "SSE2" / "Scalar"）
+     */
+    static const char* getInstructionSet();
+
+    /**
+     * @brief 顶点位置的 AABB（空数组返回零向量）
+     */
+    static void computeBounds(const std::vector<Vertex>& vertices, glm::vec3& minBounds, glm::vec3& maxBounds);
+
+    /**
+     * @brief 顶点到 center 的最大距离
+     */
+    static float computeMaxDistance(const std::vector<Vertex>& vertices, const glm::vec3& center);
+
+    /**
+     * @brief 面积加权顶点法线（面法线未归一化直接累加），长度过小时取 (0, 1, 0)
+     */
+    static void computeNormals(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+
+    /**
+     * @brief 按 UV 梯度累加切线并对法线做 Gram-Schmidt 正交化
+     */
+    static void computeTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+};
@@ -1,27 +1,116 @@
 #pragma once
 
 #include "Mesh.h"
+#include "MeshCache.h"
+#include "GeometryArena.h"
+#include "GltfLoader.h"
+#include "MeshKernels.h"
+#include "MeshOptimizer.h"
+#include "MeshletBuilder.h"
+#include "MeshSimplifier.h"
+#include "ResourceHandle.h"
+#include "VertexQuantizer.h"
 #include "VulkanBuffer.h"
 #include "VulkanDevice.h"
+#include "UploadManager.h"
+#include "ThreadPool.h"
 #include "../scene/RayPicker.h"  // for AABB
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <future>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <iostream>
 
 namespace VulkanEngine {
 
+/**
+ * @brief 网格加载参数
+ * 可以为单个网格单独设置（MeshManager::setLoadOptions），未设置时使用默认参数
+ */
+struct MeshLoadOptions {
+    bool optimize = true;       // 顶点缓存 / 过度绘制 / 顶点读取重排
+    WeldOptions weld;           // OBJ 导入时的焊接参数
+    VertexFormat vertexFormat = VertexFormat::Standard;  // GPU 顶点格式（上传时转换，不影响二进制缓存）
+    uint32_t meshletMinTriangles = 4096;  // 三角形数达到该值时生成网格簇用于簇级剔除，0 表示禁用
+    uint32_t maxLodLevels = 4;            // 自动生成的 LOD 级数上限（不含 LOD0），0 表示禁用
+    uint32_t lodMinTriangles = 256;       // 简化目标低于该三角形数时停止生成下一级
+    
+    /**
+     * @brief 参数摘要，写入二进制缓存，参数变化后缓存自动失效
+     */
+    uint64_t getCacheKey() const {
+        // 处理流程本身变化时递增
+        const uint32_t PIPELINE_VERSION = 2;
+        
+        uint32_t fields[8] = {};
+        fields[0] = PIPELINE_VERSION;
+        fields[1] = optimize ? 1u : 0u;
+        std::memcpy(&fields[2], &weld.positionEpsilon, sizeof(float));
+        std::memcpy(&fields[3], &weld.normalCosTolerance, sizeof(float));
+        std::memcpy(&fields[4], &weld.texCoordEpsilon, sizeof(float));
+        fields[5] = weld.removeDegenerate ? 1u : 0u;
+        fields[6] = maxLodLevels;
+        fields[7] = lodMinTriangles;
+        return MeshCache::hashBytes(fields, sizeof(fields));
+    }
+};
+
 /**
  * @brief GPU Mesh 数据结构
- * 包含 Mesh 几何数据以及 Vulkan 顶点/索引缓冲区
+ * 包含 Mesh 几何数据以及在 MeshManager 共享几何缓冲区中的位置：
+ * 绘制时绑定所在页的缓冲区，以 getFirstIndex() + 区间起点为 firstIndex、getVertexOffset() 为 vertexOffset
  */
 struct GPUMesh {
     std::shared_ptr<Mesh> mesh;
-    std::shared_ptr<VulkanBuffer> vertexBuffer;
-    std::shared_ptr<VulkanBuffer> indexBuffer;
+    
+    // 共享几何缓冲区中的区间（销毁时归还）
+    GeometryArena::Range vertexRange;
+    GeometryArena::Range indexRange;
+    std::weak_ptr<GeometryArena> vertexArena;
+    std::weak_ptr<GeometryArena> indexArena;
+    
+    // 区间所在页的缓冲区
+    VkBuffer vertexBuffer = VK_NULL_HANDLE;
+    VkBuffer indexBuffer = VK_NULL_HANDLE;
+    
+    // 顶点缓冲区格式；Compact 时 dequantizeMatrix 需右乘到模型矩阵上
+    VertexFormat vertexFormat = VertexFormat::Standard;
+    glm::mat4 dequantizeMatrix = glm::mat4(1.0f);
+    
+    // 网格簇（为空时整体绘制）
+    std::vector<Meshlet> meshlets;
+    
+    // 局部空间包围球（LOD 选择使用）
+    glm::vec3 boundsCenter = glm::vec3(0.0f);
+    float boundsRadius = 0.0f;
+    
+    GPUMesh() = default;
+    GPUMesh(const GPUMesh&) = delete;
+    GPUMesh& operator=(const GPUMesh&) = delete;
+    
+    ~GPUMesh() {
+        releaseGeometry();
+    }
+    
+    /**
+     * @brief 把区间归还共享几何缓冲区（已提交的帧可能仍在使用，延迟若干帧后才可重新分配；
+     *        MeshManager 已清理时无需归还）
+     */
+    void releaseGeometry() {
+        if (auto arena = vertexArena.lock()) arena->retire(vertexRange);
+        if (auto arena = indexArena.lock()) arena->retire(indexRange);
+        vertexRange = GeometryArena::Range{};
+        indexRange = GeometryArena::Range{};
+        vertexBuffer = VK_NULL_HANDLE;
+        indexBuffer = VK_NULL_HANDLE;
+    }
     
     bool isValid() const {
-        return mesh && vertexBuffer && indexBuffer;
+        return mesh && vertexBuffer != VK_NULL_HANDLE && indexBuffer != VK_NULL_HANDLE;
     }
     
     uint32_t getIndexCount() const {
@@ -32,12 +121,34 @@ struct GPUMesh {
         return mesh ? static_cast<uint32_t>(mesh->getVertices().size()) : 0;
     }
     
+    /**
+     * @brief LOD1..N 在索引缓冲区中的区间（LOD0 为 [0, getIndexCount())）
+     */
+    const std::vector<MeshLod>& getLods() const {
+        static const std::vector<MeshLod> empty;
+        return mesh ? mesh->getLods() : empty;
+    }
+    
     VkBuffer getVertexBufferHandle() const {
-        return vertexBuffer ? vertexBuffer->getBuffer() : VK_NULL_HANDLE;
+        return vertexBuffer;
     }
     
     VkBuffer getIndexBufferHandle() const {
-        return indexBuffer ? indexBuffer->getBuffer() : VK_NULL_HANDLE;
+        return indexBuffer;
+    }
+    
+    /**
+     * @brief 顶点区间在页内的起点（vkCmdDrawIndexed 的 vertexOffset）
+     */
+    int32_t getVertexOffset() const {
+        return static_cast<int32_t>(vertexRange.first);
+    }
+    
+    /**
+     * @brief 索引区间在页内的起点（网格内的 firstIndex 需加上该值）
+     */
+    uint32_t getFirstIndex() const {
+        return indexRange.first;
     }
     
     /**
@@ -45,12 +156,9 @@ struct GPUMesh {
      */
     AABB calculateAABB() const {
         AABB aabb;
-        if (!mesh) return aabb;
+        if (!mesh || mesh->getVertices().empty()) return aabb;
         
-        const auto& vertices = mesh->getVertices();
-        for (const auto& vertex : vertices) {
-            aabb.expand(vertex.pos);
-        }
+        MeshKernels::computeBounds(mesh->getVertices(), aabb.min, aabb.max);
         return aabb;
     }
 };
@@ -59,6 +167,13 @@ struct GPUMesh {
  * @brief 网格资源管理器
  * 负责加载、缓存和管理所有网格资源
  * 单例模式，全局访问
+ *
+ * 两种加载方式：
+ * - getMesh：同步加载，返回时网格已驻留
+ * - requestMesh / getMeshIfResident：解析和 CPU 处理在共享线程池上执行，
+ *   主线程每帧调用 processPendingLoads 创建 GPU 缓冲区，渲染循环不被阻塞
+ * 渲染路径通过 acquireMeshHandle 把标识符解析为代数化句柄，之后按句柄直接索引槽位
+ * 除 CPU 处理任务外，所有成员只在主线程访问
  */
 class MeshManager {
 public:
@@ -77,6 +192,18 @@ public:
      */
     void init(std::shared_ptr<VulkanDevice> device) {
         m_device = device;
+        
+        // 共享几何缓冲区：每种顶点格式一个（vertexOffset 以顶点为单位，步长必须一致），索引共用一个
+        const uint32_t vertexStrides[] = { sizeof(Vertex), sizeof(CompactVertex) };
+        for (uint32_t i = 0; i < 2; ++i) {
+            m_vertexArenas[i] = std::make_shared<GeometryArena>(
+                device, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, vertexStrides[i],
+                static_cast<uint32_t>(GEOMETRY_PAGE_SIZE / vertexStrides[i]));
+        }
+        m_indexArena = std::make_shared<GeometryArena>(
+            device, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, static_cast<uint32_t>(sizeof(uint32_t)),
+            static_cast<uint32_t>(GEOMETRY_PAGE_SIZE / sizeof(uint32_t)));
+        
         std::cout << "[MeshManager] Initialized" << std::endl;
     }
     
@@ -93,14 +220,158 @@ public:
             return it->second;
         }
         
+        // 已在后台加载：等待 CPU 处理完成后立即上传
+        auto pending = m_pendingLoads.find(meshId);
+        if (pending != m_pendingLoads.end()) {
+            pending->second->cpuResult.wait();
+            finishPendingLoad(pending->first, *pending->second);
+            m_pendingLoads.erase(pending);
+            it = m_meshCache.find(meshId);
+            return it != m_meshCache.end() ? it->second : nullptr;
+        }
+        
         // 加载网格
         auto gpuMesh = loadMesh(meshId);
         if (gpuMesh) {
             m_meshCache[meshId] = gpuMesh;
+            updateMeshSlot(meshId);
         }
         return gpuMesh;
     }
     
+    /**
+     * @brief 异步请求网格
+     * 未驻留时在后台线程解析和处理，CPU 阶段完成后由 processPendingLoads 上传。
+     * 返回的 future 在网格驻留后就绪（加载失败时值为 nullptr）
+     */
+    std::shared_future<std::shared_ptr<GPUMesh>> requestMesh(const std::string& meshId) {
+        auto it = m_meshCache.find(meshId);
+        if (it != m_meshCache.end() || m_failedMeshes.count(meshId) > 0) {
+            std::promise<std::shared_ptr<GPUMesh>> ready;
+            ready.set_value(it != m_meshCache.end() ? it->second : nullptr);
+            return ready.get_future().share();
+        }
+        
+        auto pending = m_pendingLoads.find(meshId);
+        if (pending != m_pendingLoads.end()) {
+            return pending->second->resident;
+        }
+        
+        auto load = std::make_unique<PendingMeshLoad>();
+        load->options = getLoadOptions(meshId);
+        load->resident = load->promise.get_future().share();
+        load->startTime = std::chrono::steady_clock::now();
+        
+        // 任务只使用值拷贝的参数，不访问管理器状态
+        const MeshLoadOptions options = load->options;
+        load->cpuResult = ThreadPool::getShared().submit([meshId, options]() {
+            return loadMeshData(meshId, options);
+        });
+        
+        auto result = load->resident;
+        std::cout << "[MeshManager] Queued background load: " << meshId << std::endl;
+        m_pendingLoads.emplace(meshId, std::move(load));
+        return result;
+    }
+    
+    /**
+     * @brief 获取已驻留的网格；未驻留时发起异步请求并返回 nullptr
+     */
+    std::shared_ptr<GPUMesh> getMeshIfResident(const std::string& meshId) {
+        auto it = m_meshCache.find(meshId);
+        if (it != m_meshCache.end()) {
+            return it->second;
+        }
+        if (m_failedMeshes.count(meshId) == 0) {
+            requestMesh(meshId);
+        }
+        return nullptr;
+    }
+    
+    /**
+     * @brief 检查网格是否已驻留（不发起加载）
+     */
+    bool isMeshResident(const std::string& meshId) const {
+        return m_meshCache.find(meshId) != m_meshCache.end();
+    }
+    
+    /**
+     * @brief 网格是否加载失败（unloadMesh 后可重试）
+     */
+    bool isMeshFailed(const std::string& meshId) const {
+        return m_failedMeshes.count(meshId) > 0;
+    }
+    
+    /**
+     * @brief 网格标识符对应的句柄（同一标识符始终返回同一句柄，直到 unloadMesh 使其失效）
+     * 在组件赋值时解析一次，之后按句柄访问，不再做字符串查找
+     */
+    MeshHandle acquireMeshHandle(const std::string& meshId) {
+        auto it = m_meshHandles.find(meshId);
+        if (it != m_meshHandles.end()) {
+            return it->second;
+        }
+        
+        MeshSlot slot;
+        slot.meshId = meshId;
+        MeshHandle handle = m_meshSlots.add(std::move(slot));
+        m_meshHandles.emplace(meshId, handle);
+        updateMeshSlot(meshId);
+        return handle;
+    }
+    
+    bool isHandleValid(MeshHandle handle) const {
+        return m_meshSlots.contains(handle);
+    }
+    
+    /**
+     * @brief 按句柄获取已驻留的网格；未驻留时（首次）发起异步请求并返回 nullptr
+     */
+    std::shared_ptr<GPUMesh> getMeshIfResident(MeshHandle handle) {
+        MeshSlot* slot = m_meshSlots.get(handle);
+        if (!slot || slot->failed) return nullptr;
+        if (!slot->mesh && !slot->requested) {
+            slot->requested = true;
+            requestMesh(slot->meshId);
+        }
+        return slot->mesh;
+    }
+    
+    bool isMeshFailed(MeshHandle handle) const {
+        const MeshSlot* slot = m_meshSlots.get(handle);
+        return slot && slot->failed;
+    }
+    
+    /**
+     * @brief 正在后台加载的网格数量
+     */
+    size_t getPendingLoadCount() const {
+        return m_pendingLoads.size();
+    }
+    
+    /**
+     * @brief 上传 CPU 阶段已完成的网格（主线程每帧调用）
+     * @param maxUploads 本帧最多上传的网格数，避免多个大网格同时完成时单帧卡顿
+     */
+    void processPendingLoads(uint32_t maxUploads = 2) {
+        // 释放卸载网格留下的区间（引用它们的帧均已执行完毕）
+        for (auto& arena : m_vertexArenas) {
+            if (arena) arena->beginFrame();
+        }
+        if (m_indexArena) m_indexArena->beginFrame();
+        
+        uint32_t uploads = 0;
+        for (auto it = m_pendingLoads.begin(); it != m_pendingLoads.end() && uploads < maxUploads;) {
+            if (it->second->cpuResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                ++it;
+                continue;
+            }
+            finishPendingLoad(it->first, *it->second);
+            it = m_pendingLoads.erase(it);
+            ++uploads;
+        }
+    }
+    
     /**
      * @brief 预加载网格（不返回，仅缓存）
      */
@@ -119,6 +390,14 @@ public:
      * @brief 卸载指定网格
      */
     void unloadMesh(const std::string& meshId) {
+        m_failedMeshes.erase(meshId);
+        
+        // 已发出的句柄失效，再次使用时需重新解析
+        auto handle = m_meshHandles.find(meshId);
+        if (handle != m_meshHandles.end()) {
+            m_meshSlots.remove(handle->second);
+            m_meshHandles.erase(handle);
+        }
         auto it = m_meshCache.find(meshId);
         if (it != m_meshCache.end()) {
             std::cout << "[MeshManager] Unloading mesh: " << meshId << std::endl;
@@ -131,7 +410,23 @@ public:
      */
     void cleanup() {
         std::cout << "[MeshManager] Cleaning up " << m_meshCache.size() << " meshes..." << std::endl;
+        
+        // 等待后台任务结束，未上传的结果直接丢弃
+        for (auto& pending : m_pendingLoads) {
+            pending.second->cpuResult.wait();
+            pending.second->promise.set_value(nullptr);
+        }
+        m_pendingLoads.clear();
+        m_failedMeshes.clear();
         m_meshCache.clear();
+        m_meshSlots.clear();
+        m_meshHandles.clear();
+        
+        // 仍被外部持有的 GPUMesh 在共享缓冲区释放后不再归还区间
+        for (auto& arena : m_vertexArenas) {
+            arena.reset();
+        }
+        m_indexArena.reset();
         m_device.reset();
     }
     
@@ -142,6 +437,32 @@ public:
         return m_meshCache.size();
     }
     
+    /**
+     * @brief 共享几何缓冲区统计
+     */
+    GeometryArenaStats getVertexArenaStats(VertexFormat format) const {
+        const auto& arena = m_vertexArenas[static_cast<uint32_t>(format)];
+        return arena ? arena->getStats() : GeometryArenaStats{};
+    }
+    
+    GeometryArenaStats getIndexArenaStats() const {
+        return m_indexArena ? m_indexArena->getStats() : GeometryArenaStats{};
+    }
+    
+    /**
+     * @brief 设置默认加载参数（对之后加载的网格生效）
+     */
+    void setDefaultLoadOptions(const MeshLoadOptions& options) {
+        m_defaultLoadOptions = options;
+    }
+    
+    /**
+     * @brief 为指定网格设置加载参数（需在首次加载前设置）
+     */
+    void setLoadOptions(const std::string& meshId, const MeshLoadOptions& options) {
+        m_loadOptions[meshId] = options;
+    }
+    
     /**
      * @brief 获取指定网格的 AABB 包围盒
      * @param meshId 网格标识符
@@ -164,7 +485,26 @@ private:
     ~MeshManager() { cleanup(); }
     
     /**
-     * @brief 实际加载网格的内部方法
+     * @brief 后台加载任务的状态
+     */
+    // 句柄槽位：缓存驻留的网格，按句柄访问无需字符串查找
+    struct MeshSlot {
+        std::string meshId;
+        std::shared_ptr<GPUMesh> mesh;
+        bool requested = false;
+        bool failed = false;
+    };
+    
+    struct PendingMeshLoad {
+        MeshLoadOptions options;
+        std::future<std::shared_ptr<GPUMesh>> cpuResult;
+        std::promise<std::shared_ptr<GPUMesh>> promise;
+        std::shared_future<std::shared_ptr<GPUMesh>> resident;
+        std::chrono::steady_clock::time_point startTime;
+    };
+    
+    /**
+     * @brief 同步加载：CPU 阶段 + GPU 上传
      */
     std::shared_ptr<GPUMesh> loadMesh(const std::string& meshId) {
         if (!m_device) {
@@ -172,6 +512,54 @@ private:
             return nullptr;
         }
         
+        const MeshLoadOptions options = getLoadOptions(meshId);
+        auto gpuMesh = loadMeshData(meshId, options);
+        if (!gpuMesh || !uploadMesh(meshId, gpuMesh, options)) {
+            return nullptr;
+        }
+        return gpuMesh;
+    }
+    
+    /**
+     * @brief 后台任务完成后在主线程上传并写入缓存，同时兑现 requestMesh 返回的 future
+     */
+    void finishPendingLoad(const std::string& meshId, PendingMeshLoad& load) {
+        std::shared_ptr<GPUMesh> gpuMesh;
+        try {
+            gpuMesh = load.cpuResult.get();
+        } catch (const std::exception& e) {
+            std::cerr << "[MeshManager] Background load failed: " << meshId << " (" << e.what() << ")" << std::endl;
+        }
+        
+        if (gpuMesh && m_device && uploadMesh(meshId, gpuMesh, load.options)) {
+            m_meshCache[meshId] = gpuMesh;
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load.startTime).count();
+            std::cout << "[MeshManager] Background load finished: " << meshId << " (" << ms << " ms)" << std::endl;
+        } else {
+            gpuMesh.reset();
+            m_failedMeshes.insert(meshId);
+        }
+        updateMeshSlot(meshId);
+        load.promise.set_value(gpuMesh);
+    }
+    
+    /**
+     * @brief 网格进入缓存或加载失败时同步到对应的句柄槽位
+     */
+    void updateMeshSlot(const std::string& meshId) {
+        auto handle = m_meshHandles.find(meshId);
+        if (handle == m_meshHandles.end()) return;
+        
+        MeshSlot* slot = m_meshSlots.get(handle->second);
+        auto cached = m_meshCache.find(meshId);
+        slot->mesh = cached != m_meshCache.end() ? cached->second : nullptr;
+        slot->failed = m_failedMeshes.count(meshId) > 0;
+    }
+    
+    /**
+     * @brief CPU 阶段：解析/缓存读取、处理、网格簇与包围球（可在工作线程执行，不访问 Vulkan）
+     */
+    static std::shared_ptr<GPUMesh> loadMeshData(const std::string& meshId, const MeshLoadOptions& options) {
         auto gpuMesh = std::make_shared<GPUMesh>();
         gpuMesh->mesh = std::make_shared<Mesh>();
         
@@ -180,24 +568,37 @@ private:
         // 处理预设网格
         if (meshId == "sphere") {
             gpuMesh->mesh->createSphere(64);
+            processMesh(meshId, *gpuMesh->mesh, options);
             loadSuccess = true;
         }
         else if (meshId == "cube") {
             gpuMesh->mesh->createCube();
+            processMesh(meshId, *gpuMesh->mesh, options);
             loadSuccess = true;
         }
         else if (meshId == "plane") {
             gpuMesh->mesh->createPlane(10.0f, 10);
+            processMesh(meshId, *gpuMesh->mesh, options);
             loadSuccess = true;
         }
-        // 处理 OBJ 文件路径
-        else if (meshId.find(".obj") != std::string::npos || 
-                 meshId.find(".OBJ") != std::string::npos) {
-            if (gpuMesh->mesh->loadFromOBJ(meshId)) {
-                gpuMesh->mesh->centerAndNormalize();
+        // 处理 OBJ / GLB 文件路径
+        else if (isObjMeshId(meshId) || GltfLoader::isGlbMeshId(meshId)) {
+            if (MeshCache::load(meshId, *gpuMesh->mesh, options.getCacheKey())) {
+                std::cout << "[MeshManager] Loaded from cache: " << MeshCache::getCachePath(meshId) << std::endl;
+                loadSuccess = true;
+            }
+            else if (loadSourceFile(meshId, options, *gpuMesh->mesh)) {
+                processMesh(meshId, *gpuMesh->mesh, options);
+                MeshCache::save(meshId, *gpuMesh->mesh, options.getCacheKey());
+                
+                // 未启用紧凑格式时也输出量化精度，便于逐资源决定是否启用
+                if (options.vertexFormat == VertexFormat::Standard) {
+                    VertexQuantizer::printReport(meshId.c_str(),
+                                                 VertexQuantizer::analyze(gpuMesh->mesh->getVertices()));
+                }
                 loadSuccess = true;
             } else {
-                std::cerr << "[MeshManager] Failed to load OBJ: " << meshId << std::endl;
+                std::cerr << "[MeshManager] Failed to load mesh file: " << meshId << std::endl;
             }
         }
         else {
@@ -208,22 +609,106 @@ private:
             return nullptr;
         }
         
-        // 创建 GPU 缓冲区
-        if (!createGPUBuffers(gpuMesh)) {
-            return nullptr;
+        // 大网格生成网格簇（基于最终索引顺序，缓存命中后同样需要生成）
+        const auto& indices = gpuMesh->mesh->getIndices();
+        if (options.meshletMinTriangles > 0 && indices.size() / 3 >= options.meshletMinTriangles) {
+            MeshletStats meshletStats;
+            gpuMesh->meshlets = MeshletBuilder::build(gpuMesh->mesh->getVertices(), indices, &meshletStats);
+            MeshletBuilder::printStats(meshId.c_str(), meshletStats);
+        }
+        
+        gpuMesh->boundsCenter = gpuMesh->mesh->getCenter();
+        gpuMesh->boundsRadius = gpuMesh->mesh->getBoundingSphereRadius();
+        return gpuMesh;
+    }
+    
+    static bool isObjMeshId(const std::string& meshId) {
+        return meshId.find(".obj") != std::string::npos || meshId.find(".OBJ") != std::string::npos;
+    }
+    
+    /**
+     * @brief 解析源文件并归一化到单位大小
+     * GLB 单个图元（"model.glb#N"）保持场景坐标，由导入时的实体变换统一归一化，
+     * 这样同一模型的各个图元仍能拼在一起
+     */
+    static bool loadSourceFile(const std::string& meshId, const MeshLoadOptions& options, Mesh& mesh) {
+        if (GltfLoader::isGlbMeshId(meshId)) {
+            std::string filepath;
+            int drawItem = -1;
+            GltfLoader::parseMeshId(meshId, filepath, drawItem);
+            if (!mesh.loadFromGLB(filepath, drawItem)) {
+                return false;
+            }
+            if (drawItem < 0) {
+                mesh.centerAndNormalize();
+            }
+            return true;
+        }
+        
+        if (!mesh.loadFromOBJ(meshId, options.weld)) {
+            return false;
+        }
+        mesh.centerAndNormalize();
+        return true;
+    }
+    
+    /**
+     * @brief GPU 阶段：创建缓冲区（主线程）
+     */
+    bool uploadMesh(const std::string& meshId, const std::shared_ptr<GPUMesh>& gpuMesh, const MeshLoadOptions& options) {
+        if (!createGPUBuffers(meshId, gpuMesh, options.vertexFormat)) {
+            return false;
         }
         
         std::cout << "[MeshManager] Loaded mesh: " << meshId 
                   << " (vertices: " << gpuMesh->mesh->getVertices().size()
-                  << ", indices: " << gpuMesh->mesh->getIndices().size() << ")" << std::endl;
+                  << ", indices: " << gpuMesh->mesh->getIndices().size()
+                  << ", LODs: " << gpuMesh->getLods().size() << ")" << std::endl;
+        return true;
+    }
+    
+    /**
+     * @brief 获取网格的加载参数
+     */
+    MeshLoadOptions getLoadOptions(const std::string& meshId) const {
+        auto it = m_loadOptions.find(meshId);
+        return it != m_loadOptions.end() ? it->second : m_defaultLoadOptions;
+    }
+    
+    /**
+     * @brief 加载后的 CPU 处理阶段（结果会写入二进制缓存）
+     */
+    static void processMesh(const std::string& meshId, Mesh& mesh, const MeshLoadOptions& options) {
+        if (options.optimize) {
+            MeshOptimizeStats stats = MeshOptimizer::optimize(mesh);
+            std::cout << "[MeshManager] Optimized " << meshId
+                      << ": ACMR " << stats.before.acmr << " -> " << stats.after.acmr
+                      << ", ATVR " << stats.before.atvr << " -> " << stats.after.atvr
+                      << ", overdraw clusters " << stats.clusterCount
+                      << " (" << stats.milliseconds << " ms)" << std::endl;
+        }
         
-        return gpuMesh;
+        // LOD 链在最终索引顺序上生成，与 LOD0 共用顶点
+        if (options.maxLodLevels > 0) {
+            std::vector<uint32_t> lodIndices;
+            LodChainStats lodStats;
+            std::vector<MeshLod> lods = MeshSimplifier::buildLodChain(mesh.getVertices(), mesh.getIndices(),
+                                                                      options.maxLodLevels, options.lodMinTriangles,
+                                                                      lodIndices, &lodStats);
+            if (!lods.empty()) {
+                std::cout << "[MeshManager] Generated " << lodStats.levels << " LODs for " << meshId
+                          << ": " << lodStats.sourceTriangles << " -> " << lodStats.lastTriangles
+                          << " triangles, max error " << lods.back().error
+                          << " (" << lodStats.milliseconds << " ms)" << std::endl;
+            }
+            mesh.setLods(std::move(lods), std::move(lodIndices));
+        }
     }
     
     /**
      * @brief 为网格创建 GPU 缓冲区
      */
-    bool createGPUBuffers(std::shared_ptr<GPUMesh> gpuMesh) {
+    bool createGPUBuffers(const std::string& meshId, const std::shared_ptr<GPUMesh>& gpuMesh, VertexFormat format) {
         if (!gpuMesh || !gpuMesh->mesh) return false;
         
         const auto& vertices = gpuMesh->mesh->getVertices();
@@ -234,31 +719,66 @@ private:
             return false;
         }
         
-        // 创建顶点缓冲区
+        // 创建顶点缓冲区（紧凑格式在上传前量化）
+        std::vector<CompactVertex> compactVertices;
+        const void* vertexData = vertices.data();
         VkDeviceSize vertexBufferSize = sizeof(vertices[0]) * vertices.size();
-        gpuMesh->vertexBuffer = std::make_shared<VulkanBuffer>(
-            m_device,
-            vertexBufferSize,
-            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-        );
-        gpuMesh->vertexBuffer->copyFrom(vertices.data(), vertexBufferSize);
-        
-        // 创建索引缓冲区
-        VkDeviceSize indexBufferSize = sizeof(indices[0]) * indices.size();
-        gpuMesh->indexBuffer = std::make_shared<VulkanBuffer>(
-            m_device,
-            indexBufferSize,
-            VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-        );
-        gpuMesh->indexBuffer->copyFrom(indices.data(), indexBufferSize);
+        
+        gpuMesh->vertexFormat = format;
+        gpuMesh->dequantizeMatrix = glm::mat4(1.0f);
+        if (format == VertexFormat::Compact) {
+            QuantizationReport report;
+            compactVertices = VertexQuantizer::quantize(vertices, gpuMesh->dequantizeMatrix, &report);
+            VertexQuantizer::printReport(meshId.c_str(), report);
+            
+            vertexData = compactVertices.data();
+            vertexBufferSize = sizeof(CompactVertex) * compactVertices.size();
+        }
+        
+        // 从设备本地的共享几何缓冲区分配区间，数据经 UploadManager 的暂存环上传；
+        // 拷贝随本帧提交前的 flush 执行，渲染命令在同一队列上之后提交，可以直接使用
+        const auto& vertexArena = m_vertexArenas[static_cast<uint32_t>(format)];
+        const uint32_t vertexCount = static_cast<uint32_t>(vertexBufferSize / vertexArena->getElementSize());
+        gpuMesh->vertexArena = vertexArena;
+        gpuMesh->vertexRange = vertexArena->allocate(vertexCount);
+        gpuMesh->vertexBuffer = vertexArena->getBuffer(gpuMesh->vertexRange.page);
+        vertexArena->upload(gpuMesh->vertexRange, vertexData, vertexCount);
+        
+        // 索引区间：LOD0 索引之后拼接 LOD1..N 索引（索引值相对网格自身，绘制时加 vertexOffset）
+        const auto& lodIndices = gpuMesh->mesh->getLodIndices();
+        const uint32_t lod0Count = static_cast<uint32_t>(indices.size());
+        const uint32_t lodCount = static_cast<uint32_t>(lodIndices.size());
+        gpuMesh->indexArena = m_indexArena;
+        gpuMesh->indexRange = m_indexArena->allocate(lod0Count + lodCount);
+        gpuMesh->indexBuffer = m_indexArena->getBuffer(gpuMesh->indexRange.page);
+        m_indexArena->upload(gpuMesh->indexRange, indices.data(), lod0Count);
+        if (lodCount > 0) {
+            m_indexArena->upload(gpuMesh->indexRange, lodIndices.data(), lodCount, lod0Count);
+        }
         
         return true;
     }
     
+    // 共享几何缓冲区的页大小
+    static constexpr VkDeviceSize GEOMETRY_PAGE_SIZE = 64ull * 1024 * 1024;
+    
     std::shared_ptr<VulkanDevice> m_device;
     std::unordered_map<std::string, std::shared_ptr<GPUMesh>> m_meshCache;
+    
+    // 共享几何缓冲区（按 VertexFormat 索引）
+    std::shared_ptr<GeometryArena> m_vertexArenas[2];
+    std::shared_ptr<GeometryArena> m_indexArena;
+    
+    MeshLoadOptions m_defaultLoadOptions;
+    std::unordered_map<std::string, MeshLoadOptions> m_loadOptions;
+    
+    // 异步加载
+    std::unordered_map<std::string, std::unique_ptr<PendingMeshLoad>> m_pendingLoads;
+    std::unordered_set<std::string> m_failedMeshes;   // 后台加载失败的网格不再自动重试
+    
+    // 网格句柄
+    HandlePool<MeshHandleTag, MeshSlot> m_meshSlots;
+    std::unordered_map<std::string, MeshHandle> m_meshHandles;
 };
 
 } // namespace VulkanEngine
@@ -0,0 +1,292 @@
+#include "MeshOptimizer.h"
+#include "Mesh.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+constexpr uint32_t INVALID_VERTEX = std::numeric_limits<uint32_t>::max();
+
+// 过度绘制排序允许的 ACMR 退化上限（相对仅做缓存优化的结果）
+constexpr double OVERDRAW_ACMR_THRESHOLD = 1.05;
+
+/**
+ * FIFO 缓存模拟器：时间戳表示顶点进入缓存时的"变换序号"
+ */
+class FifoCache {
+public:
+    FifoCache(size_t vertexCount, uint32_t cacheSize)
+        : timestamps(vertexCount, 0), size(cacheSize), time(cacheSize + 1) {}
+
+    // 返回是否未命中（未命中时顶点进入缓存）
+    bool access(uint32_t vertex) {
+        if (time - timestamps[vertex] > size) {
+            timestamps[vertex] = time++;
+            return true;
+        }
+        return false;
+    }
+
+    uint32_t getTransforms() const { return time - (size + 1); }
+
+private:
+    std::vector<uint32_t> timestamps;
+    uint32_t size;
+    uint32_t time;
+};
+
+} // namespace
+
+std::vector<uint32_t> MeshOptimizer::optimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                                         uint32_t cacheSize) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0) {
+        return indices;
+    }
+
+    // 顶点 -> 三角形邻接表（CSR 形式）
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        ++liveTriangles[indices[i]];
+    }
+
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] = offsets[v] + liveTriangles[v];
+    }
+
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int j = 0; j < 3; ++j) {
+                adjacency[cursor[indices[t * 3 + j]]++] = static_cast<uint32_t>(t);
+            }
+        }
+    }
+
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint32_t> deadEndStack;
+    std::vector<uint32_t> candidates;
+    deadEndStack.reserve(triangleCount * 3);
+    candidates.reserve(64);
+
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+
+    uint32_t time = cacheSize + 1;
+    uint32_t scanCursor = 0;
+    uint32_t fanVertex = 0;
+
+    while (fanVertex != INVALID_VERTEX) {
+        candidates.clear();
+
+        // 输出当前扇心顶点的所有未输出三角形
+        for (uint32_t a = offsets[fanVertex]; a < offsets[fanVertex + 1]; ++a) {
+            uint32_t triangle = adjacency[a];
+            if (emitted[triangle]) continue;
+            emitted[triangle] = 1;
+
+            for (int j = 0; j < 3; ++j) {
+                uint32_t v = indices[triangle * 3 + j];
+                output.push_back(v);
+                deadEndStack.push_back(v);
+                candidates.push_back(v);
+                --liveTriangles[v];
+
+                if (time - cacheTime[v] > cacheSize) {
+                    cacheTime[v] = time++;
+                }
+            }
+        }
+
+        // 选择下一个扇心：优先仍在缓存中、且扇出后不会把自己挤出缓存的顶点
+        uint32_t best = INVALID_VERTEX;
+        int64_t bestPriority = -1;
+        for (uint32_t v : candidates) {
+            if (liveTriangles[v] == 0) continue;
+
+            int64_t priority = 0;
+            if (time - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize) {
+                priority = time - cacheTime[v];
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                best = v;
+            }
+        }
+
+        if (best == INVALID_VERTEX) {
+            // 死路：先回溯最近输出过的顶点，再顺序扫描
+            while (!deadEndStack.empty()) {
+                uint32_t v = deadEndStack.back();
+                deadEndStack.pop_back();
+                if (liveTriangles[v] > 0) {
+                    best = v;
+                    break;
+                }
+            }
+            while (best == INVALID_VERTEX && scanCursor < vertexCount) {
+                if (liveTriangles[scanCursor] > 0) {
+                    best = scanCursor;
+                }
+                ++scanCursor;
+            }
+        }
+
+        fanVertex = best;
+    }
+
+    return output;
+}
+
+std::vector<uint32_t> MeshOptimizer::optimizeOverdraw(const std::vector<uint32_t>& indices,
+                                                      const std::vector<Vertex>& vertices,
+                                                      uint32_t cacheSize, size_t* clusterCount) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        if (clusterCount) *clusterCount = 0;
+        return indices;
+    }
+
+    // 三个顶点全部未命中的三角形是"硬边界"，从这里切开不会额外损失缓存命中
+    std::vector<uint32_t> clusterStarts;
+    {
+        FifoCache cache(vertices.size(), cacheSize);
+        uint32_t lastStart = 0;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            int misses = 0;
+            for (int j = 0; j < 3; ++j) {
+                misses += cache.access(indices[t * 3 + j]) ? 1 : 0;
+            }
+            if (t == 0 || (misses == 3 && t - lastStart >= MIN_CLUSTER_TRIANGLES)) {
+                clusterStarts.push_back(static_cast<uint32_t>(t));
+                lastStart = static_cast<uint32_t>(t);
+            }
+        }
+    }
+    clusterStarts.push_back(static_cast<uint32_t>(triangleCount));
+    const size_t clusters = clusterStarts.size() - 1;
+    if (clusterCount) *clusterCount = clusters;
+
+    // 网格面积加权中心
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+
+    std::vector<glm::vec3> clusterCentroid(clusters, glm::vec3(0.0f));
+    std::vector<glm::vec3> clusterNormal(clusters, glm::vec3(0.0f));
+    std::vector<float> clusterArea(clusters, 0.0f);
+
+    for (size_t c = 0; c < clusters; ++c) {
+        for (uint32_t t = clusterStarts[c]; t < clusterStarts[c + 1]; ++t) {
+            const glm::vec3& p0 = vertices[indices[t * 3 + 0]].pos;
+            const glm::vec3& p1 = vertices[indices[t * 3 + 1]].pos;
+            const glm::vec3& p2 = vertices[indices[t * 3 + 2]].pos;
+
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float area = glm::length(normal);
+            glm::vec3 center = (p0 + p1 + p2) / 3.0f;
+
+            clusterCentroid[c] += center * area;
+            clusterNormal[c] += normal;
+            clusterArea[c] += area;
+        }
+        meshCentroid += clusterCentroid[c];
+        meshArea += clusterArea[c];
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid = meshCentroid / meshArea;
+    }
+
+    // 排序键：簇中心相对网格中心在簇平均法线方向上的投影，越朝外越先画
+    std::vector<float> sortKey(clusters, 0.0f);
+    for (size_t c = 0; c < clusters; ++c) {
+        if (clusterArea[c] <= 0.0f) continue;
+        glm::vec3 centroid = clusterCentroid[c] / clusterArea[c];
+        float normalLength = glm::length(clusterNormal[c]);
+        if (normalLength > 0.0f) {
+            sortKey[c] = glm::dot(centroid - meshCentroid, clusterNormal[c] / normalLength);
+        }
+    }
+
+    std::vector<uint32_t> order(clusters);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return sortKey[a] > sortKey[b];
+    });
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    for (uint32_t c : order) {
+        output.insert(output.end(),
+                      indices.begin() + clusterStarts[c] * 3,
+                      indices.begin() + clusterStarts[c + 1] * 3);
+    }
+    return output;
+}
+
+void MeshOptimizer::optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    std::vector<uint32_t> remap(vertices.size(), INVALID_VERTEX);
+    std::vector<Vertex> reordered;
+    reordered.reserve(vertices.size());
+
+    for (uint32_t& index : indices) {
+        if (remap[index] == INVALID_VERTEX) {
+            remap[index] = static_cast<uint32_t>(reordered.size());
+            reordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    vertices.swap(reordered);
+}
+
+VertexCacheStats MeshOptimizer::analyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                                   uint32_t cacheSize) {
+    VertexCacheStats stats;
+    if (indices.empty() || vertexCount == 0) return stats;
+
+    FifoCache cache(vertexCount, cacheSize);
+    for (uint32_t index : indices) {
+        cache.access(index);
+    }
+
+    stats.transforms = cache.getTransforms();
+    stats.acmr = static_cast<double>(stats.transforms) / static_cast<double>(indices.size() / 3);
+    stats.atvr = static_cast<double>(stats.transforms) / static_cast<double>(vertexCount);
+    return stats;
+}
+
+MeshOptimizeStats MeshOptimizer::optimize(Mesh& mesh) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<Vertex> vertices = mesh.getVertices();
+    std::vector<uint32_t> indices = mesh.getIndices();
+
+    MeshOptimizeStats stats;
+    stats.before = analyzeVertexCache(indices, vertices.size());
+
+    indices = optimizeVertexCache(indices, vertices.size());
+    VertexCacheStats cacheOnly = analyzeVertexCache(indices, vertices.size());
+
+    std::vector<uint32_t> overdrawOrdered = optimizeOverdraw(indices, vertices, DEFAULT_CACHE_SIZE, &stats.clusterCount);
+    VertexCacheStats withOverdraw = analyzeVertexCache(overdrawOrdered, vertices.size());
+    if (withOverdraw.acmr <= cacheOnly.acmr * OVERDRAW_ACMR_THRESHOLD) {
+        indices.swap(overdrawOrdered);
+    } else {
+        stats.clusterCount = 0;
+    }
+
+    optimizeVertexFetch(vertices, indices);
+    stats.after = analyzeVertexCache(indices, vertices.size());
+
+    mesh.setGeometry(std::move(vertices), std::move(indices), mesh.getMinBounds(), mesh.getMaxBounds());
+
+    stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
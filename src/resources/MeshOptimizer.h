@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Vertex.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Mesh;
+
+/**
+ * 顶点后变换缓存统计
+ * ACMR: 每个三角形平均变换的顶点数（越低越好，理论下限约 0.5）
+ * ATVR: 变换次数 / 顶点总数（越接近 1 越好）
+ */
+struct VertexCacheStats {
+    double acmr = 0.0;
+    double atvr = 0.0;
+    size_t transforms = 0;
+};
+
+/**
+ * 网格优化统计（优化前后对比）
+ */
+struct MeshOptimizeStats {
+    VertexCacheStats before;
+    VertexCacheStats after;
+    size_t clusterCount = 0;
+    double milliseconds = 0.0;
+};
+
+/**
+ * 网格索引/顶点重排
+ *
+ * 三个阶段依次执行：
+ * 1. optimizeVertexCache - Tipsify 算法，按顶点扇面输出三角形以提高后变换缓存命中率
+ * 2. optimizeOverdraw    - 在缓存全部未命中的位置把索引流切成簇（簇太小则并入前一个），
+ *    簇内保持顺序，簇之间按朝外程度降序排列，外侧面先画以减少过度绘制
+ * 3. optimizeVertexFetch - 按首次使用顺序重排顶点，提高顶点读取的内存局部性
+ */
+class MeshOptimizer {
+public:
+    // Tipsify 的目标缓存大小，同时用于统计时的 FIFO 模拟
+    static constexpr uint32_t DEFAULT_CACHE_SIZE = 16;
+
+    // 过度绘制优化时簇的最小三角形数，避免簇过碎破坏缓存局部性
+    static constexpr uint32_t MIN_CLUSTER_TRIANGLES = 64;
+
+    /**
+     * @brief 顶点缓存优化（Tipsify）
+     */
+    static std::vector<uint32_t> optimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                                     uint32_t cacheSize = DEFAULT_CACHE_SIZE);
+
+    /**
+     * @brief 过度绘制优化（输入应为已做缓存优化的索引）
+     * @param clusterCount 可选输出：簇数量
+     */
+    static std::vector<uint32_t> optimizeOverdraw(const std::vector<uint32_t>& indices,
+                                                  const std::vector<Vertex>& vertices,
+                                                  uint32_t cacheSize = DEFAULT_CACHE_SIZE,
+                                                  size_t* clusterCount = nullptr);
+
+    /**
+     * @brief 顶点读取优化：按首次使用顺序重排顶点并改写索引，丢弃未引用的顶点
+     */
+    static void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    /**
+     * @brief FIFO 缓存模拟，计算 ACMR/ATVR
+     */
+    static VertexCacheStats analyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                               uint32_t cacheSize = DEFAULT_CACHE_SIZE);
+
+    /**
+     * @brief 对网格依次执行三个优化阶段
+     */
+    static MeshOptimizeStats optimize(Mesh& mesh);
+};
@@ -0,0 +1,532 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace {
+
+constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+// 每级 LOD 至少减少的三角形比例，否则认为已无法继续简化
+constexpr double MIN_LEVEL_REDUCTION = 0.9;
+
+// 属性接缝边约束平面的权重（乘以边长平方）
+constexpr double SEAM_EDGE_WEIGHT = 1.0;
+
+/**
+ * 对称 4x4 二次误差矩阵（平面 ax + by + cz + d = 0 的外积累加），附带面积权重
+ */
+struct Quadric {
+    double a2 = 0, ab = 0, ac = 0, ad = 0;
+    double b2 = 0, bc = 0, bd = 0;
+    double c2 = 0, cd = 0;
+    double d2 = 0;
+    double weight = 0;
+
+    void addPlane(const glm::vec3& n, double d, double w) {
+        a2 += w * n.x * n.x; ab += w * n.x * n.y; ac += w * n.x * n.z; ad += w * n.x * d;
+        b2 += w * n.y * n.y; bc += w * n.y * n.z; bd += w * n.y * d;
+        c2 += w * n.z * n.z; cd += w * n.z * d;
+        d2 += w * d * d;
+        weight += w;
+    }
+
+    Quadric& operator+=(const Quadric& o) {
+        a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad;
+        b2 += o.b2; bc += o.bc; bd += o.bd;
+        c2 += o.c2; cd += o.cd;
+        d2 += o.d2;
+        weight += o.weight;
+        return *this;
+    }
+
+    double evaluate(const glm::vec3& p) const {
+        double x = p.x, y = p.y, z = p.z;
+        return a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x
+             + b2 * y * y + 2 * bc * y * z + 2 * bd * y
+             + c2 * z * z + 2 * cd * z
+             + d2;
+    }
+};
+
+// 两个二次误差之和在 p 处的平均平方距离
+double collapseError(const Quadric& a, const Quadric& b, const glm::vec3& p) {
+    double weight = a.weight + b.weight;
+    double value = a.evaluate(p) + b.evaluate(p);
+    return weight > 0.0 ? std::max(value / weight, 0.0) : 0.0;
+}
+
+struct PositionKey {
+    uint32_t x, y, z;
+    bool operator==(const PositionKey& o) const { return x == o.x && y == o.y && z == o.z; }
+};
+
+struct PositionKeyHash {
+    size_t operator()(const PositionKey& k) const {
+        uint64_t h = 0x9E3779B97F4A7C15ull;
+        h = (h ^ k.x) * 0xFF51AFD7ED558CCDull;
+        h = (h ^ k.y) * 0xFF51AFD7ED558CCDull;
+        h = (h ^ k.z) * 0xFF51AFD7ED558CCDull;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+};
+
+inline PositionKey makeKey(const glm::vec3& p) {
+    // +0.0f 把 -0.0 归一为 0.0
+    float x = p.x + 0.0f, y = p.y + 0.0f, z = p.z + 0.0f;
+    PositionKey key;
+    std::memcpy(&key.x, &x, sizeof(float));
+    std::memcpy(&key.y, &y, sizeof(float));
+    std::memcpy(&key.z, &z, sizeof(float));
+    return key;
+}
+
+struct Candidate {
+    float error;
+    uint32_t from;
+    uint32_t to;
+};
+
+struct EdgeRef {
+    uint64_t key;       // 位置编号对 (min << 32 | max)
+    uint32_t triangle;
+    uint32_t corner;    // 边起点在三角形中的角序号
+};
+
+struct WedgeMapping {
+    uint32_t from;
+    uint32_t to;
+};
+
+/**
+ * 折叠状态：拓扑在"位置编号"空间上处理，三角形仍保存原始顶点索引
+ */
+class Simplifier {
+public:
+    Simplifier(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+        : vertices(vertices), triangles(indices) {
+        triangleCount = triangles.size() / 3;
+        triangles.resize(triangleCount * 3);
+        alive.assign(triangleCount, 1);
+        aliveCount = triangleCount;
+
+        buildPositions();
+        buildQuadrics();
+        classifyEdges();
+    }
+
+    float run(size_t targetIndexCount, float targetError) {
+        const double maxErrorSquared = static_cast<double>(targetError) * targetError;
+        double worst = 0.0;
+
+        while (aliveCount * 3 > targetIndexCount) {
+            buildAdjacency();
+            collectCandidates();
+
+            touched.assign(positionCount, 0);
+            size_t collapses = 0;
+            for (const Candidate& candidate : candidates) {
+                if (candidate.error > maxErrorSquared) break;
+                if (touched[candidate.from] || touched[candidate.to]) continue;
+                if (!tryCollapse(candidate.from, candidate.to)) continue;
+
+                worst = std::max(worst, static_cast<double>(candidate.error));
+                ++collapses;
+                if (aliveCount * 3 <= targetIndexCount) break;
+            }
+
+            if (collapses == 0) break;
+        }
+
+        return static_cast<float>(std::sqrt(worst));
+    }
+
+    std::vector<uint32_t> getIndices() const {
+        std::vector<uint32_t> result;
+        result.reserve(aliveCount * 3);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            if (!alive[t]) continue;
+            result.insert(result.end(), triangles.begin() + t * 3, triangles.begin() + t * 3 + 3);
+        }
+        return result;
+    }
+
+private:
+    void buildPositions() {
+        positionOf.assign(vertices.size(), INVALID_INDEX);
+        std::unordered_map<PositionKey, uint32_t, PositionKeyHash> lookup;
+        lookup.reserve(vertices.size());
+
+        for (size_t i = 0; i < triangles.size(); ++i) {
+            uint32_t v = triangles[i];
+            if (positionOf[v] != INVALID_INDEX) continue;
+
+            auto inserted = lookup.emplace(makeKey(vertices[v].pos), static_cast<uint32_t>(positions.size()));
+            if (inserted.second) {
+                positions.push_back(vertices[v].pos);
+            }
+            positionOf[v] = inserted.first->second;
+        }
+        locked.assign(positions.size(), 0);
+        positionCount = static_cast<uint32_t>(positions.size());
+    }
+
+    void buildQuadrics() {
+        quadrics.assign(positionCount, Quadric());
+        for (size_t t = 0; t < triangleCount; ++t) {
+            const glm::vec3& p0 = vertices[triangles[t * 3 + 0]].pos;
+            const glm::vec3& p1 = vertices[triangles[t * 3 + 1]].pos;
+            const glm::vec3& p2 = vertices[triangles[t * 3 + 2]].pos;
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float length = glm::length(normal);
+            if (length <= 0.0f) continue;
+            normal = normal / length;
+
+            double d = -glm::dot(normal, p0);
+            double area = 0.5 * length;
+            for (int j = 0; j < 3; ++j) {
+                quadrics[positionOf[triangles[t * 3 + j]]].addPlane(normal, d, area);
+            }
+        }
+    }
+
+    /**
+     * 边分类：
+     * - 只被一个三角形使用（边界）或被两个以上使用（非流形）：两端顶点锁定
+     * - 两侧三角形使用不同的顶点索引（属性接缝）：加入垂直于面的约束平面，
+     *   使接缝顶点只能沿接缝折叠且保持接缝形状
+     */
+    void classifyEdges() {
+        std::vector<EdgeRef> edges;
+        edges.reserve(triangleCount * 3);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (uint32_t j = 0; j < 3; ++j) {
+                uint32_t a = positionOf[triangles[t * 3 + j]];
+                uint32_t b = positionOf[triangles[t * 3 + (j + 1) % 3]];
+                if (a == b) continue;
+                if (a > b) std::swap(a, b);
+                edges.push_back({ (static_cast<uint64_t>(a) << 32) | b, static_cast<uint32_t>(t), j });
+            }
+        }
+        std::sort(edges.begin(), edges.end(), [](const EdgeRef& x, const EdgeRef& y) { return x.key < y.key; });
+
+        for (size_t i = 0; i < edges.size();) {
+            size_t j = i;
+            while (j < edges.size() && edges[j].key == edges[i].key) ++j;
+
+            uint32_t a = static_cast<uint32_t>(edges[i].key >> 32);
+            uint32_t b = static_cast<uint32_t>(edges[i].key & 0xFFFFFFFFu);
+            if (j - i != 2) {
+                locked[a] = 1;
+                locked[b] = 1;
+            } else if (!sameWedges(edges[i], edges[i + 1])) {
+                addSeamConstraint(edges[i]);
+                addSeamConstraint(edges[i + 1]);
+            }
+            i = j;
+        }
+    }
+
+    // 两侧三角形在这条边两端使用的顶点索引是否一致
+    bool sameWedges(const EdgeRef& x, const EdgeRef& y) const {
+        uint32_t x0 = triangles[x.triangle * 3 + x.corner];
+        uint32_t x1 = triangles[x.triangle * 3 + (x.corner + 1) % 3];
+        uint32_t y0 = triangles[y.triangle * 3 + y.corner];
+        uint32_t y1 = triangles[y.triangle * 3 + (y.corner + 1) % 3];
+        return (x0 == y0 && x1 == y1) || (x0 == y1 && x1 == y0);
+    }
+
+    void addSeamConstraint(const EdgeRef& edge) {
+        const uint32_t* corners = &triangles[edge.triangle * 3];
+        const glm::vec3& p0 = vertices[corners[edge.corner]].pos;
+        const glm::vec3& p1 = vertices[corners[(edge.corner + 1) % 3]].pos;
+        const glm::vec3& p2 = vertices[corners[(edge.corner + 2) % 3]].pos;
+
+        glm::vec3 direction = p1 - p0;
+        glm::vec3 faceNormal = glm::cross(direction, p2 - p0);
+        glm::vec3 normal = glm::cross(direction, faceNormal);
+        float length = glm::length(normal);
+        if (length <= 0.0f) return;
+        normal = normal / length;
+
+        double d = -glm::dot(normal, p0);
+        double weight = glm::dot(direction, direction) * SEAM_EDGE_WEIGHT;
+        quadrics[positionOf[corners[edge.corner]]].addPlane(normal, d, weight);
+        quadrics[positionOf[corners[(edge.corner + 1) % 3]]].addPlane(normal, d, weight);
+    }
+
+    void buildAdjacency() {
+        offsets.assign(positionCount + 1, 0);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            if (!alive[t]) continue;
+            for (int j = 0; j < 3; ++j) {
+                ++offsets[positionOf[triangles[t * 3 + j]] + 1];
+            }
+        }
+        for (uint32_t p = 0; p < positionCount; ++p) {
+            offsets[p + 1] += offsets[p];
+        }
+
+        adjacency.resize(offsets[positionCount]);
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            if (!alive[t]) continue;
+            for (int j = 0; j < 3; ++j) {
+                adjacency[cursor[positionOf[triangles[t * 3 + j]]]++] = static_cast<uint32_t>(t);
+            }
+        }
+    }
+
+    void collectCandidates() {
+        candidates.clear();
+        for (uint32_t p = 0; p < positionCount; ++p) {
+            if (locked[p] || offsets[p] == offsets[p + 1]) continue;
+
+            // 按代价从小到大取第一个满足接缝映射的邻居
+            options.clear();
+            for (uint32_t a = offsets[p]; a < offsets[p + 1]; ++a) {
+                uint32_t t = adjacency[a];
+                for (int j = 0; j < 3; ++j) {
+                    uint32_t q = positionOf[triangles[t * 3 + j]];
+                    if (q == p) continue;
+                    float error = static_cast<float>(collapseError(quadrics[p], quadrics[q], positions[q]));
+                    options.push_back({ error, p, q });
+                }
+            }
+            std::sort(options.begin(), options.end(), [](const Candidate& x, const Candidate& y) {
+                return x.error < y.error || (x.error == y.error && x.to < y.to);
+            });
+
+            uint32_t rejected = INVALID_INDEX;
+            for (const Candidate& option : options) {
+                if (option.to == rejected) continue;
+                if (buildWedgeMapping(p, option.to)) {
+                    candidates.push_back(option);
+                    break;
+                }
+                rejected = option.to;
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Candidate& a, const Candidate& b) { return a.error < b.error; });
+    }
+
+    /**
+     * 为 from 的每个顶点索引确定折叠后使用的 to 顶点索引（由共享边两侧三角形决定）。
+     * 内部顶点只有一个索引；接缝顶点只能沿接缝边折叠，两侧分别映射到对应一侧的索引
+     */
+    bool buildWedgeMapping(uint32_t from, uint32_t to) {
+        wedgeMapping.clear();
+        int sharedTriangles = 0;
+
+        for (uint32_t a = offsets[from]; a < offsets[from + 1]; ++a) {
+            uint32_t t = adjacency[a];
+            if (!alive[t]) continue;
+
+            uint32_t fromVertex = INVALID_INDEX;
+            uint32_t toVertex = INVALID_INDEX;
+            for (int j = 0; j < 3; ++j) {
+                uint32_t v = triangles[t * 3 + j];
+                if (positionOf[v] == from) {
+                    if (fromVertex != INVALID_INDEX) return false;
+                    fromVertex = v;
+                } else if (positionOf[v] == to) {
+                    toVertex = v;
+                }
+            }
+
+            WedgeMapping* mapping = nullptr;
+            for (WedgeMapping& m : wedgeMapping) {
+                if (m.from == fromVertex) mapping = &m;
+            }
+            if (!mapping) {
+                wedgeMapping.push_back({ fromVertex, INVALID_INDEX });
+                mapping = &wedgeMapping.back();
+            }
+
+            if (toVertex != INVALID_INDEX) {
+                ++sharedTriangles;
+                if (mapping->to != INVALID_INDEX && mapping->to != toVertex) return false;
+                mapping->to = toVertex;
+            }
+        }
+        if (sharedTriangles != 2) return false;
+
+        // 每个索引都有映射，且不同索引不能合并到同一个索引（否则会抹掉接缝）
+        for (size_t i = 0; i < wedgeMapping.size(); ++i) {
+            if (wedgeMapping[i].to == INVALID_INDEX) return false;
+            for (size_t j = 0; j < i; ++j) {
+                if (wedgeMapping[j].to == wedgeMapping[i].to) return false;
+            }
+        }
+        return true;
+    }
+
+    void collectNeighbors(uint32_t p, std::vector<uint32_t>& out) const {
+        out.clear();
+        for (uint32_t a = offsets[p]; a < offsets[p + 1]; ++a) {
+            uint32_t t = adjacency[a];
+            if (!alive[t]) continue;
+            for (int j = 0; j < 3; ++j) {
+                uint32_t q = positionOf[triangles[t * 3 + j]];
+                if (q != p) out.push_back(q);
+            }
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+    bool tryCollapse(uint32_t from, uint32_t to) {
+        if (!buildWedgeMapping(from, to)) return false;
+
+        // 流形条件：两端点的公共邻居恰好为共享边两侧的两个顶点
+        collectNeighbors(from, fromNeighbors);
+        collectNeighbors(to, toNeighbors);
+        size_t common = 0;
+        for (size_t i = 0, j = 0; i < fromNeighbors.size() && j < toNeighbors.size();) {
+            if (fromNeighbors[i] < toNeighbors[j]) ++i;
+            else if (fromNeighbors[i] > toNeighbors[j]) ++j;
+            else { ++common; ++i; ++j; }
+        }
+        if (common != 2) return false;
+
+        // 翻转检测：保留下来的三角形法线方向不能反转
+        const glm::vec3& target = positions[to];
+        for (uint32_t a = offsets[from]; a < offsets[from + 1]; ++a) {
+            uint32_t t = adjacency[a];
+            if (!alive[t]) continue;
+            glm::vec3 p[3];
+            glm::vec3 moved[3];
+            bool containsTarget = false;
+            for (int j = 0; j < 3; ++j) {
+                uint32_t q = positionOf[triangles[t * 3 + j]];
+                containsTarget = containsTarget || q == to;
+                p[j] = positions[q];
+                moved[j] = q == from ? target : p[j];
+            }
+            if (containsTarget) continue;
+
+            glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+            glm::vec3 after = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+            if (glm::dot(before, after) <= 0.0f) return false;
+        }
+
+        // 执行折叠
+        for (uint32_t a = offsets[from]; a < offsets[from + 1]; ++a) {
+            uint32_t t = adjacency[a];
+            if (!alive[t]) continue;
+            bool containsTarget = false;
+            for (int j = 0; j < 3; ++j) {
+                containsTarget = containsTarget || positionOf[triangles[t * 3 + j]] == to;
+            }
+            if (containsTarget) {
+                alive[t] = 0;
+                --aliveCount;
+                continue;
+            }
+            for (int j = 0; j < 3; ++j) {
+                for (const WedgeMapping& m : wedgeMapping) {
+                    if (triangles[t * 3 + j] == m.from) {
+                        triangles[t * 3 + j] = m.to;
+                        break;
+                    }
+                }
+            }
+        }
+
+        quadrics[to] += quadrics[from];
+
+        // 邻接表按三角形编号记录，折叠后只有 to 的列表缺少新接管的三角形，本轮内不再使用
+        touched[from] = 1;
+        touched[to] = 1;
+        return true;
+    }
+
+    const std::vector<Vertex>& vertices;
+    std::vector<uint32_t> triangles;
+    std::vector<uint8_t> alive;
+    size_t triangleCount = 0;
+    size_t aliveCount = 0;
+
+    std::vector<uint32_t> positionOf;   // 顶点索引 -> 位置编号
+    std::vector<glm::vec3> positions;
+    std::vector<uint8_t> locked;
+    std::vector<Quadric> quadrics;
+    uint32_t positionCount = 0;
+
+    std::vector<uint32_t> offsets;      // 位置编号 -> 三角形（CSR）
+    std::vector<uint32_t> adjacency;
+    std::vector<Candidate> candidates;
+    std::vector<Candidate> options;
+    std::vector<uint8_t> touched;
+    std::vector<uint32_t> fromNeighbors;
+    std::vector<uint32_t> toNeighbors;
+    std::vector<WedgeMapping> wedgeMapping;
+};
+
+} // namespace
+
+std::vector<uint32_t> MeshSimplifier::simplify(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                               size_t targetIndexCount, float targetError, float* resultError) {
+    if (indices.size() < 3 || targetIndexCount >= indices.size()) {
+        if (resultError) *resultError = 0.0f;
+        return indices;
+    }
+
+    Simplifier simplifier(vertices, indices);
+    float error = simplifier.run(targetIndexCount, targetError);
+    if (resultError) *resultError = error;
+    return simplifier.getIndices();
+}
+
+std::vector<MeshLod> MeshSimplifier::buildLodChain(const std::vector<Vertex>& vertices,
+                                                   const std::vector<uint32_t>& indices,
+                                                   uint32_t maxLevels, uint32_t minTriangles,
+                                                   std::vector<uint32_t>& lodIndices,
+                                                   LodChainStats* stats) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<MeshLod> lods;
+    lodIndices.clear();
+
+    std::vector<uint32_t> current = indices;
+    float accumulatedError = 0.0f;
+
+    for (uint32_t level = 1; level <= maxLevels; ++level) {
+        size_t targetTriangles = current.size() / 3 / 2;
+        if (targetTriangles < minTriangles) break;
+
+        float levelError = 0.0f;
+        std::vector<uint32_t> simplified = simplify(vertices, current, targetTriangles * 3,
+                                                    std::numeric_limits<float>::max(), &levelError);
+        if (simplified.empty() || simplified.size() > current.size() * MIN_LEVEL_REDUCTION) break;
+
+        simplified = MeshOptimizer::optimizeVertexCache(simplified, vertices.size());
+
+        // 每级从上一级简化，误差累加作为相对原始网格的保守估计
+        accumulatedError += levelError;
+
+        MeshLod lod;
+        lod.firstIndex = static_cast<uint32_t>(indices.size() + lodIndices.size());
+        lod.indexCount = static_cast<uint32_t>(simplified.size());
+        lod.error = accumulatedError;
+        lods.push_back(lod);
+
+        lodIndices.insert(lodIndices.end(), simplified.begin(), simplified.end());
+        current.swap(simplified);
+    }
+
+    if (stats) {
+        stats->levels = lods.size();
+        stats->sourceTriangles = indices.size() / 3;
+        stats->lastTriangles = current.size() / 3;
+        stats->milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    return lods;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Vertex.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * LOD 级别：整体索引缓冲区（LOD0 索引之后依次拼接各级索引）中的一段区间
+ * error 为相对原始网格的几何误差估计（网格局部空间距离）
+ */
+struct MeshLod {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    float error = 0.0f;
+    uint32_t reserved = 0;
+};
+
+/**
+ * LOD 链生成统计
+ */
+struct LodChainStats {
+    size_t levels = 0;              // 不含 LOD0
+    size_t sourceTriangles = 0;
+    size_t lastTriangles = 0;
+    double milliseconds = 0.0;
+};
+
+/**
+ * 网格简化（二次误差度量 + 半边折叠）
+ *
+ * 只改写索引，不生成新顶点，因此各级 LOD 与 LOD0 共用同一个顶点缓冲区。
+ * 顶点折叠到相邻顶点的已有位置上，代价为两端二次误差矩阵之和在目标位置的取值
+ * （按面积加权后归一化为平均平方距离）。边界顶点与非流形边上的顶点锁定不移动；
+ * 属性接缝顶点（同一位置对应多个顶点，例如 UV 接缝）只能沿接缝边折叠，
+ * 两侧分别合并到对应一侧的顶点，接缝边附加约束平面以保持接缝形状。
+ * 每一轮按代价排序后贪心折叠，并拒绝会翻转三角形或破坏流形的折叠
+ */
+class MeshSimplifier {
+public:
+    /**
+     * @brief 简化到目标索引数
+     * @param targetError 最大允许误差（网格局部空间距离），超过则提前停止
+     * @param resultError 可选输出：实际最大折叠误差
+     */
+    static std::vector<uint32_t> simplify(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                          size_t targetIndexCount, float targetError,
+                                          float* resultError = nullptr);
+
+    /**
+     * @brief 生成 LOD 链：每级三角形数减半，直到低于 minTriangles 或无法继续简化
+     * @param lodIndices 输出：拼接后的 LOD1..N 索引
+     * @return LOD1..N 的区间（firstIndex 从 indices.size() 开始）
+     */
+    static std::vector<MeshLod> buildLodChain(const std::vector<Vertex>& vertices,
+                                              const std::vector<uint32_t>& indices,
+                                              uint32_t maxLevels, uint32_t minTriangles,
+                                              std::vector<uint32_t>& lodIndices,
+                                              LodChainStats* stats = nullptr);
+};
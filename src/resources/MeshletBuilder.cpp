@@ -0,0 +1,136 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+/**
+ * 计算簇 [firstTriangle, endTriangle) 的包围球与法线锥
+ */
+Meshlet finishMeshlet(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                      size_t firstTriangle, size_t endTriangle) {
+    Meshlet meshlet;
+    meshlet.firstIndex = static_cast<uint32_t>(firstTriangle * 3);
+    meshlet.indexCount = static_cast<uint32_t>((endTriangle - firstTriangle) * 3);
+
+    // 包围球：AABB 中心 + 最远顶点距离
+    glm::vec3 minBounds = vertices[indices[firstTriangle * 3]].pos;
+    glm::vec3 maxBounds = minBounds;
+    for (size_t i = firstTriangle * 3; i < endTriangle * 3; ++i) {
+        minBounds = glm::min(minBounds, vertices[indices[i]].pos);
+        maxBounds = glm::max(maxBounds, vertices[indices[i]].pos);
+    }
+    meshlet.center = (minBounds + maxBounds) * 0.5f;
+
+    float radiusSquared = 0.0f;
+    for (size_t i = firstTriangle * 3; i < endTriangle * 3; ++i) {
+        glm::vec3 d = vertices[indices[i]].pos - meshlet.center;
+        radiusSquared = std::max(radiusSquared, glm::dot(d, d));
+    }
+    meshlet.radius = std::sqrt(radiusSquared);
+
+    // 法线锥：轴为单位面法线之和，半角由最小点积决定
+    std::vector<glm::vec3> normals;
+    normals.reserve(endTriangle - firstTriangle);
+    glm::vec3 axis(0.0f);
+    for (size_t t = firstTriangle; t < endTriangle; ++t) {
+        const glm::vec3& p0 = vertices[indices[t * 3 + 0]].pos;
+        const glm::vec3& p1 = vertices[indices[t * 3 + 1]].pos;
+        const glm::vec3& p2 = vertices[indices[t * 3 + 2]].pos;
+        glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+        float length = glm::length(normal);
+        if (length <= 0.0f) continue;
+        normals.push_back(normal / length);
+        axis += normals.back();
+    }
+
+    float axisLength = glm::length(axis);
+    if (normals.empty() || axisLength <= 0.0f) {
+        return meshlet;
+    }
+    axis = axis / axisLength;
+
+    float minDot = 1.0f;
+    for (const glm::vec3& normal : normals) {
+        minDot = std::min(minDot, glm::dot(normal, axis));
+    }
+
+    meshlet.coneAxis = axis;
+    meshlet.coneCutoff = minDot > 0.0f ? std::sqrt(1.0f - minDot * minDot) : 1.0f;
+    return meshlet;
+}
+
+} // namespace
+
+std::vector<Meshlet> MeshletBuilder::build(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                           MeshletStats* stats) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<Meshlet> meshlets;
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertices.empty()) {
+        if (stats) *stats = MeshletStats();
+        return meshlets;
+    }
+    meshlets.reserve(triangleCount / MAX_TRIANGLES + 1);
+
+    // marker[v] == stamp 表示顶点 v 已在当前簇中
+    std::vector<uint32_t> marker(vertices.size(), 0);
+    uint32_t stamp = 1;
+
+    size_t meshletStart = 0;
+    uint32_t meshletVertices = 0;
+    size_t totalVertices = 0;
+
+    auto countNew = [&](size_t t) {
+        uint32_t a = indices[t * 3 + 0];
+        uint32_t b = indices[t * 3 + 1];
+        uint32_t c = indices[t * 3 + 2];
+        uint32_t count = (marker[a] != stamp) ? 1u : 0u;
+        count += (marker[b] != stamp && b != a) ? 1u : 0u;
+        count += (marker[c] != stamp && c != a && c != b) ? 1u : 0u;
+        return count;
+    };
+
+    for (size_t t = 0; t < triangleCount; ++t) {
+        uint32_t newVertices = countNew(t);
+        size_t meshletTriangles = t - meshletStart;
+
+        if (meshletTriangles > 0 &&
+            (meshletVertices + newVertices > MAX_VERTICES || meshletTriangles + 1 > MAX_TRIANGLES)) {
+            meshlets.push_back(finishMeshlet(vertices, indices, meshletStart, t));
+            totalVertices += meshletVertices;
+
+            ++stamp;
+            meshletStart = t;
+            meshletVertices = 0;
+            newVertices = countNew(t);
+        }
+
+        for (int j = 0; j < 3; ++j) {
+            marker[indices[t * 3 + j]] = stamp;
+        }
+        meshletVertices += newVertices;
+    }
+    meshlets.push_back(finishMeshlet(vertices, indices, meshletStart, triangleCount));
+    totalVertices += meshletVertices;
+
+    if (stats) {
+        stats->meshletCount = meshlets.size();
+        stats->averageVertices = static_cast<double>(totalVertices) / static_cast<double>(meshlets.size());
+        stats->averageTriangles = static_cast<double>(triangleCount) / static_cast<double>(meshlets.size());
+        stats->coneCullable = static_cast<size_t>(std::count_if(meshlets.begin(), meshlets.end(),
+            [](const Meshlet& meshlet) { return meshlet.coneCutoff < 1.0f; }));
+        stats->milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    return meshlets;
+}
+
+void MeshletBuilder::printStats(const char* label, const MeshletStats& stats) {
+    std::cout << "[MeshletBuilder] " << label << ": " << stats.meshletCount << " meshlets"
+              << " (avg " << stats.averageVertices << " vertices, " << stats.averageTriangles << " triangles"
+              << ", " << stats.coneCullable << " cone-cullable) in " << stats.milliseconds << " ms" << std::endl;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Vertex.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 网格簇（meshlet）：索引缓冲区中一段连续的三角形
+ * 包围球与法线锥均位于网格局部空间
+ */
+struct Meshlet {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.0f;
+
+    // 法线锥：当 dot(normalize(center - eye), coneAxis) >= coneCutoff + radius / distance 时整簇背向
+    glm::vec3 coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+    float coneCutoff = 1.0f;   // sin(锥半角)；锥角不小于 90 度时为 1（不可背面剔除）
+};
+
+/**
+ * 网格簇统计
+ */
+struct MeshletStats {
+    size_t meshletCount = 0;
+    double averageVertices = 0.0;
+    double averageTriangles = 0.0;
+    size_t coneCullable = 0;   // 法线锥可用于背面剔除的簇数
+    double milliseconds = 0.0;
+};
+
+/**
+ * 网格簇生成
+ *
+ * 顺序扫描索引流，顶点数或三角形数达到上限时切分。输入应为 MeshOptimizer 处理后的
+ * 索引：Tipsify 的扇形输出本身空间局部性好，顺序切分不会改变索引顺序，
+ * 因此顶点缓存与过度绘制优化的结果保持不变，簇可直接用 firstIndex 绘制
+ */
+class MeshletBuilder {
+public:
+    static constexpr uint32_t MAX_VERTICES = 64;
+    static constexpr uint32_t MAX_TRIANGLES = 124;
+
+    /**
+     * @brief 生成网格簇
+     * @param stats 可选输出：统计信息
+     */
+    static std::vector<Meshlet> build(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                      MeshletStats* stats = nullptr);
+
+    /**
+     * @brief 打印统计
+     */
+    static void printStats(const char* label, const MeshletStats& stats);
+};
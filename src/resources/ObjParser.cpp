@@ -0,0 +1,442 @@
+#include "ObjParser.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+constexpr uint8_t RELATIVE_POSITION = 1 << 0;
+constexpr uint8_t RELATIVE_TEXCOORD = 1 << 1;
+constexpr uint8_t RELATIVE_NORMAL = 1 << 2;
+
+// 每块最小字节数：太小的块调度开销大于解析本身
+constexpr size_t MIN_CHUNK_BYTES = 256 * 1024;
+
+const double POW10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+struct ChunkResult {
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> texCoords;
+    std::vector<ObjCorner> corners;
+    std::vector<uint8_t> relativeFlags;  // 与 corners 一一对应
+    std::vector<uint32_t> quadCorners;   // 四边形拆分出的 6 个角的起始位置（块内）
+    bool hasRelative = false;
+
+    std::string error;
+};
+
+inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline const char* skipBlanks(const char* p, const char* end) {
+    while (p < end && isBlank(*p)) ++p;
+    return p;
+}
+
+inline const char* parseInt(const char* p, const char* end, int64_t& value) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+    const char* digitsBegin = p;
+    int64_t result = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        result = result * 10 + (*p - '0');
+        ++p;
+    }
+    if (p == digitsBegin) return nullptr;
+    value = negative ? -result : result;
+    return p;
+}
+
+// 读取一行中的若干浮点数，返回实际读取数量
+inline int parseFloats(const char* p, const char* lineEnd, float* values, int maxCount) {
+    int count = 0;
+    while (count < maxCount) {
+        p = skipBlanks(p, lineEnd);
+        if (p >= lineEnd) break;
+        const char* next = ObjParser::parseFloat(p, lineEnd, values[count]);
+        if (next == p) break;
+        p = next;
+        ++count;
+    }
+    return count;
+}
+
+// OBJ 索引：正数为 1 基绝对索引，负数为相对已定义元素的偏移
+inline bool resolveIndex(int64_t raw, size_t localCount, int32_t& out, uint8_t bit, uint8_t& flags) {
+    if (raw > 0) {
+        out = static_cast<int32_t>(raw - 1);
+        return true;
+    }
+    if (raw < 0) {
+        out = static_cast<int32_t>(static_cast<int64_t>(localCount) + raw);
+        flags |= bit;
+        return true;
+    }
+    return false;
+}
+
+bool parseFace(const char* p, const char* lineEnd, ChunkResult& chunk,
+               std::vector<ObjCorner>& polygon, std::vector<uint8_t>& polygonFlags) {
+    polygon.clear();
+    polygonFlags.clear();
+
+    const size_t positionCount = chunk.positions.size() / 3;
+    const size_t texCoordCount = chunk.texCoords.size() / 2;
+    const size_t normalCount = chunk.normals.size() / 3;
+
+    for (;;) {
+        p = skipBlanks(p, lineEnd);
+        if (p >= lineEnd) break;
+
+        ObjCorner corner;
+        uint8_t flags = 0;
+        int64_t raw = 0;
+
+        p = parseInt(p, lineEnd, raw);
+        if (!p || !resolveIndex(raw, positionCount, corner.position, RELATIVE_POSITION, flags)) {
+            return false;
+        }
+
+        if (p < lineEnd && *p == '/') {
+            ++p;
+            if (p < lineEnd && *p != '/') {
+                p = parseInt(p, lineEnd, raw);
+                if (!p || !resolveIndex(raw, texCoordCount, corner.texCoord, RELATIVE_TEXCOORD, flags)) {
+                    return false;
+                }
+            }
+            if (p < lineEnd && *p == '/') {
+                ++p;
+                p = parseInt(p, lineEnd, raw);
+                if (!p || !resolveIndex(raw, normalCount, corner.normal, RELATIVE_NORMAL, flags)) {
+                    return false;
+                }
+            }
+        }
+
+        if (p < lineEnd && !isBlank(*p)) {
+            return false;
+        }
+
+        polygon.push_back(corner);
+        polygonFlags.push_back(flags);
+        if (flags) chunk.hasRelative = true;
+    }
+
+    if (polygon.size() < 3) {
+        return false;
+    }
+
+    // 四边形先按 [0,1,2] [0,2,3] 拆分，合并后再根据位置选择较短的对角线
+    if (polygon.size() == 4) {
+        chunk.quadCorners.push_back(static_cast<uint32_t>(chunk.corners.size()));
+    }
+
+    // 扇形三角化（凸多边形）
+    for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+        chunk.corners.push_back(polygon[0]);
+        chunk.corners.push_back(polygon[i]);
+        chunk.corners.push_back(polygon[i + 1]);
+        chunk.relativeFlags.push_back(polygonFlags[0]);
+        chunk.relativeFlags.push_back(polygonFlags[i]);
+        chunk.relativeFlags.push_back(polygonFlags[i + 1]);
+    }
+    return true;
+}
+
+void parseChunk(const char* begin, const char* end, ChunkResult& chunk) {
+    std::vector<ObjCorner> polygon;
+    std::vector<uint8_t> polygonFlags;
+
+    // 预估容量：典型 OBJ 每行 30~40 字节
+    const size_t estimatedLines = static_cast<size_t>(end - begin) / 32;
+    chunk.positions.reserve(estimatedLines);
+    chunk.corners.reserve(estimatedLines);
+    chunk.relativeFlags.reserve(estimatedLines);
+
+    const char* p = begin;
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!lineEnd) lineEnd = end;
+
+        const char* line = skipBlanks(p, lineEnd);
+        const size_t length = static_cast<size_t>(lineEnd - line);
+
+        if (length >= 2 && line[0] == 'v') {
+            float values[3] = {0.0f, 0.0f, 0.0f};
+            if (isBlank(line[1])) {
+                if (parseFloats(line + 2, lineEnd, values, 3) != 3) {
+                    chunk.error = "invalid vertex record";
+                    return;
+                }
+                chunk.positions.insert(chunk.positions.end(), values, values + 3);
+            }
+            else if (line[1] == 'n' && length >= 3 && isBlank(line[2])) {
+                if (parseFloats(line + 3, lineEnd, values, 3) != 3) {
+                    chunk.error = "invalid normal record";
+                    return;
+                }
+                chunk.normals.insert(chunk.normals.end(), values, values + 3);
+            }
+            else if (line[1] == 't' && length >= 3 && isBlank(line[2])) {
+                if (parseFloats(line + 3, lineEnd, values, 2) < 1) {
+                    chunk.error = "invalid texcoord record";
+                    return;
+                }
+                chunk.texCoords.insert(chunk.texCoords.end(), values, values + 2);
+            }
+        }
+        else if (length >= 2 && line[0] == 'f' && isBlank(line[1])) {
+            if (!parseFace(line + 2, lineEnd, chunk, polygon, polygonFlags)) {
+                chunk.error = "invalid face record";
+                return;
+            }
+        }
+
+        p = lineEnd + 1;
+    }
+}
+
+} // namespace
+
+const char* ObjParser::parseFloat(const char* begin, const char* end, float& value) {
+    const char* p = begin;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    uint64_t mantissa = 0;
+    int significantDigits = 0;
+    int exponent = 0;
+    bool anyDigits = false;
+
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (significantDigits < 19) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+            if (mantissa != 0) ++significantDigits;
+        } else {
+            ++exponent;
+        }
+        anyDigits = true;
+        ++p;
+    }
+
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (significantDigits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                if (mantissa != 0) ++significantDigits;
+                --exponent;
+            }
+            anyDigits = true;
+            ++p;
+        }
+    }
+
+    if (!anyDigits) {
+        // inf/nan 等罕见写法交给 strtof
+        char buffer[32];
+        size_t length = std::min(static_cast<size_t>(end - begin), sizeof(buffer) - 1);
+        std::memcpy(buffer, begin, length);
+        buffer[length] = '\0';
+        char* parsedEnd = nullptr;
+        value = std::strtof(buffer, &parsedEnd);
+        return begin + (parsedEnd - buffer);
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char* exponentBegin = p + 1;
+        int64_t exponentValue = 0;
+        const char* exponentEnd = parseInt(exponentBegin, end, exponentValue);
+        if (exponentEnd) {
+            exponent += static_cast<int>(std::max<int64_t>(std::min<int64_t>(exponentValue, 1000), -1000));
+            p = exponentEnd;
+        }
+    }
+
+    // 尾数 < 2^53 且 |指数| <= 22 时，double 乘除一次即可得到正确舍入的结果
+    double result = static_cast<double>(mantissa);
+    if (mantissa == 0) {
+        result = 0.0;
+    } else if (exponent >= 0 && exponent <= 22) {
+        result *= POW10[exponent];
+    } else if (exponent < 0 && exponent >= -22) {
+        result /= POW10[-exponent];
+    } else {
+        result *= std::pow(10.0, exponent);
+    }
+
+    value = static_cast<float>(negative ? -result : result);
+    return p;
+}
+
+bool ObjParser::parseFile(const std::string& filepath, ObjData& out, std::string& error) {
+    MappedFile file(filepath);
+    if (file.isOpen()) {
+        return parse(reinterpret_cast<const char*>(file.getData()), file.getSize(), out, error);
+    }
+
+    // 映射失败（如空文件或特殊文件系统）时回退到普通读取
+    std::ifstream stream(filepath, std::ios::binary | std::ios::ate);
+    if (!stream) {
+        error = "cannot open file";
+        return false;
+    }
+    std::vector<char> buffer(static_cast<size_t>(stream.tellg()));
+    stream.seekg(0);
+    stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return parse(buffer.data(), buffer.size(), out, error);
+}
+
+bool ObjParser::parse(const char* data, size_t size, ObjData& out, std::string& error) {
+    out = ObjData{};
+    if (size == 0) {
+        error = "empty file";
+        return false;
+    }
+
+    ThreadPool& pool = ThreadPool::getShared();
+    const size_t participants = pool.getThreadCount() + 1;
+    const size_t chunkCount = std::max<size_t>(1, std::min(participants * 4, size / MIN_CHUNK_BYTES));
+
+    // 按行边界切分
+    std::vector<const char*> boundaries;
+    boundaries.reserve(chunkCount + 1);
+    boundaries.push_back(data);
+    const char* end = data + size;
+    for (size_t i = 1; i < chunkCount; ++i) {
+        const char* target = data + size * i / chunkCount;
+        target = std::max(target, boundaries.back());
+        const char* newline = static_cast<const char*>(std::memchr(target, '\n', static_cast<size_t>(end - target)));
+        boundaries.push_back(newline ? newline + 1 : end);
+    }
+    boundaries.push_back(end);
+
+    std::vector<ChunkResult> chunks(chunkCount);
+    pool.parallelFor(chunkCount, 1, [&](size_t begin, size_t finish) {
+        for (size_t i = begin; i < finish; ++i) {
+            parseChunk(boundaries[i], boundaries[i + 1], chunks[i]);
+        }
+    });
+
+    for (const auto& chunk : chunks) {
+        if (!chunk.error.empty()) {
+            error = chunk.error;
+            return false;
+        }
+    }
+
+    // 各块元素数量的前缀和，用于合并和相对索引修正
+    std::vector<size_t> positionOffset(chunkCount + 1, 0);
+    std::vector<size_t> normalOffset(chunkCount + 1, 0);
+    std::vector<size_t> texCoordOffset(chunkCount + 1, 0);
+    std::vector<size_t> cornerOffset(chunkCount + 1, 0);
+    for (size_t i = 0; i < chunkCount; ++i) {
+        positionOffset[i + 1] = positionOffset[i] + chunks[i].positions.size() / 3;
+        normalOffset[i + 1] = normalOffset[i] + chunks[i].normals.size() / 3;
+        texCoordOffset[i + 1] = texCoordOffset[i] + chunks[i].texCoords.size() / 2;
+        cornerOffset[i + 1] = cornerOffset[i] + chunks[i].corners.size();
+    }
+
+    const size_t positionCount = positionOffset[chunkCount];
+    const size_t normalCount = normalOffset[chunkCount];
+    const size_t texCoordCount = texCoordOffset[chunkCount];
+
+    if (positionCount > static_cast<size_t>(INT32_MAX) || cornerOffset[chunkCount] == 0) {
+        error = cornerOffset[chunkCount] == 0 ? "no faces" : "too many vertices";
+        return false;
+    }
+
+    out.positions.resize(positionCount * 3);
+    out.normals.resize(normalCount * 3);
+    out.texCoords.resize(texCoordCount * 2);
+    out.corners.resize(cornerOffset[chunkCount]);
+
+    std::vector<uint8_t> rangeErrors(chunkCount, 0);
+    pool.parallelFor(chunkCount, 1, [&](size_t begin, size_t finish) {
+        for (size_t i = begin; i < finish; ++i) {
+            ChunkResult& chunk = chunks[i];
+            std::copy(chunk.positions.begin(), chunk.positions.end(), out.positions.begin() + positionOffset[i] * 3);
+            std::copy(chunk.normals.begin(), chunk.normals.end(), out.normals.begin() + normalOffset[i] * 3);
+            std::copy(chunk.texCoords.begin(), chunk.texCoords.end(), out.texCoords.begin() + texCoordOffset[i] * 2);
+
+            ObjCorner* dst = out.corners.data() + cornerOffset[i];
+            for (size_t c = 0; c < chunk.corners.size(); ++c) {
+                ObjCorner corner = chunk.corners[c];
+                bool relativeUnderflow = false;
+                if (chunk.hasRelative) {
+                    uint8_t flags = chunk.relativeFlags[c];
+                    if (flags & RELATIVE_POSITION) corner.position += static_cast<int32_t>(positionOffset[i]);
+                    if (flags & RELATIVE_TEXCOORD) {
+                        corner.texCoord += static_cast<int32_t>(texCoordOffset[i]);
+                        relativeUnderflow |= corner.texCoord < 0;
+                    }
+                    if (flags & RELATIVE_NORMAL) {
+                        corner.normal += static_cast<int32_t>(normalOffset[i]);
+                        relativeUnderflow |= corner.normal < 0;
+                    }
+                }
+
+                if (relativeUnderflow || corner.position < 0 || static_cast<size_t>(corner.position) >= positionCount ||
+                    corner.texCoord < -1 || (corner.texCoord >= 0 && static_cast<size_t>(corner.texCoord) >= texCoordCount) ||
+                    corner.normal < -1 || (corner.normal >= 0 && static_cast<size_t>(corner.normal) >= normalCount)) {
+                    rangeErrors[i] = 1;
+                    break;
+                }
+                dst[c] = corner;
+            }
+
+            // 尽早释放块内存（四边形列表在下一步还要用）
+            std::vector<uint32_t> quads = std::move(chunk.quadCorners);
+            chunk = ChunkResult{};
+            chunk.quadCorners = std::move(quads);
+        }
+    });
+
+    if (std::find(rangeErrors.begin(), rangeErrors.end(), 1) != rangeErrors.end()) {
+        error = "face index out of range";
+        out = ObjData{};
+        return false;
+    }
+
+    // 四边形沿较短的对角线拆分（与 tinyobj 行为一致），需要全部位置数据就绪
+    pool.parallelFor(chunkCount, 1, [&](size_t begin, size_t finish) {
+        for (size_t i = begin; i < finish; ++i) {
+            for (uint32_t localCorner : chunks[i].quadCorners) {
+                ObjCorner* tri = out.corners.data() + cornerOffset[i] + localCorner;
+                const ObjCorner c0 = tri[0], c1 = tri[1], c2 = tri[2], c3 = tri[5];
+
+                auto squaredDistance = [&](const ObjCorner& a, const ObjCorner& b) {
+                    const float* pa = &out.positions[3 * static_cast<size_t>(a.position)];
+                    const float* pb = &out.positions[3 * static_cast<size_t>(b.position)];
+                    float dx = pb[0] - pa[0], dy = pb[1] - pa[1], dz = pb[2] - pa[2];
+                    return dx * dx + dy * dy + dz * dz;
+                };
+
+                if (!(squaredDistance(c0, c2) < squaredDistance(c1, c3))) {
+                    tri[0] = c0; tri[1] = c1; tri[2] = c3;
+                    tri[3] = c1; tri[4] = c2; tri[5] = c3;
+                }
+            }
+            chunks[i].quadCorners.clear();
+        }
+    });
+
+    return true;
+}
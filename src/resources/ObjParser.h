@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * OBJ 面顶点引用（0 基索引，-1 表示缺失）
+ */
+struct ObjCorner {
+    int32_t position = -1;
+    int32_t texCoord = -1;
+    int32_t normal = -1;
+};
+
+/**
+ * OBJ 解析结果
+ * 面已按扇形三角化，corners 每 3 个构成一个三角形
+ */
+struct ObjData {
+    std::vector<float> positions;   // xyz
+    std::vector<float> normals;     // xyz
+    std::vector<float> texCoords;   // uv
+    std::vector<ObjCorner> corners;
+
+    size_t getPositionCount() const { return positions.size() / 3; }
+    size_t getNormalCount() const { return normals.size() / 3; }
+    size_t getTexCoordCount() const { return texCoords.size() / 2; }
+    size_t getTriangleCount() const { return corners.size() / 3; }
+};
+
+/**
+ * 多线程 OBJ 解析器
+ *
+ * 文件通过内存映射读入后按行边界切分为若干块，各块并行解析 v/vn/vt/f 记录，
+ * 最后按块顺序合并。负索引（相对索引）在块内先记录为局部偏移，合并时再加上
+ * 前面各块的元素数量。其他记录（o/g/s/usemtl/mtllib/l/p 等）被忽略。
+ */
+class ObjParser {
+public:
+    /**
+     * @brief 解析 OBJ 文件
+     * @param filepath 文件路径
+     * @param out 解析结果
+     * @param error 失败时的错误描述
+     */
+    static bool parseFile(const std::string& filepath, ObjData& out, std::string& error);
+
+    /**
+     * @brief 解析内存中的 OBJ 文本
+     */
+    static bool parse(const char* data, size_t size, ObjData& out, std::string& error);
+
+    /**
+     * @brief 快速浮点解析（十进制/科学计数法，常见精度下与 strtof 结果一致）
+     * @return 解析结束位置；无法解析时返回 begin
+     */
+    static const char* parseFloat(const char* begin, const char* end, float& value);
+};
@@ -2,53 +2,107 @@
 
 #include "MeshManager.h"
 #include "TextureManager.h"
+#include "MaterialManager.h"
+#include "DrawSort.h"
+#include "GpuCulling.h"
+#include "FrameAllocator.h"
 #include "../scene/Scene.h"
 #include "../scene/Components.h"
+#include "../scene/Frustum.h"
 #include "../passes/RenderPassBase.h"
 #include "../passes/ForwardPass.h"
 #include "../passes/GBufferPass.h"
 #include <vulkan/vulkan.h>
 #include <glm/glm.hpp>
+#include <filesystem>
 #include <memory>
 #include <unordered_map>
 #include <string>
 #include <vector>
 #include <typeinfo>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace VulkanEngine {
 
+/**
+ * @brief 索引缓冲区中的一段绘制区间
+ */
+struct MeshDrawRange {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+};
+
+/**
+ * @brief 网格簇剔除与 LOD 选择统计（每帧）
+ */
+struct ClusterCullStats {
+    uint32_t totalClusters = 0;
+    uint32_t visibleClusters = 0;
+    uint32_t drawRanges = 0;
+    uint32_t lodEntities = 0;        // 使用 LOD1 及以上绘制的实体数
+    uint32_t submittedTriangles = 0; // 剔除与 LOD 选择后实际提交的三角形数
+};
+
 /**
  * @brief 可渲染实体数据
  * 缓存实体渲染所需的 GPU 资源引用
  */
 struct RenderableEntity {
     entt::entity entityHandle = entt::null;
+    MeshHandle mesh;
     std::shared_ptr<GPUMesh> gpuMesh;
     std::shared_ptr<VulkanTexture> albedoTexture;
     std::shared_ptr<VulkanTexture> normalTexture;
     std::shared_ptr<VulkanTexture> specularTexture;
     glm::mat4 modelMatrix = glm::mat4(1.0f);
+    glm::mat4 normalMatrix = glm::mat4(1.0f);   // transpose(inverse(model))，随变换更新
+    float viewDepth = 0.0f;          // 包围球中心到相机的距离（绘制排序用，每帧更新）
     bool visible = true;
     bool valid = false;
     
-    // ForwardPass 材质描述符引用
-    ForwardPass::MaterialDescriptor* materialDescriptor = nullptr;
+    // 材质句柄：各 Pass 以 index 直接索引材质描述符表（纹理加载期间为默认材质）
+    MaterialHandle material;
+    
+    // 材质纹理句柄（每帧按句柄上报使用情况，无效句柄表示默认纹理）
+    TextureHandle albedoHandle;
+    TextureHandle normalHandle;
+    TextureHandle metallicHandle;
     
-    // GBufferPass 材质描述符引用
-    GBufferPass::MaterialDescriptor* gbufferMaterialDescriptor = nullptr;
+    // Bindless 模式：材质参数缓冲区中的索引（通过 push constant 传递）
+    uint32_t materialIndex = 0;
     
-    std::string materialId;  // 用于查找/创建材质描述符
+    // 网格簇剔除 / LOD 选择结果：useDrawRanges 为 true 时只绘制 drawRanges（可能为空）
+    uint32_t lodLevel = 0;
+    bool useDrawRanges = false;
+    std::vector<MeshDrawRange> drawRanges;
+};
+
+class RenderSystem;
+
+/**
+ * @brief 存放在 registry 上下文中，记录已连接组件信号的 RenderSystem
+ */
+struct RenderSystemObserver {
+    RenderSystem* owner = nullptr;
 };
 
 /**
  * @brief 渲染系统
- * 负责遍历 ECS 场景并渲染所有可渲染实体
+ * 负责遍历 ECS 场景并渲染所有可渲染实体。
+ * 可渲染实体缓存在稠密数组中，通过 EnTT 的 on_construct / on_update / on_destroy 信号按实体记录脏标记，
+ * 每帧只重新解析变化的实体
  */
 class RenderSystem {
 public:
     RenderSystem() = default;
     ~RenderSystem() = default;
     
+    // 组件信号持有 this，禁止拷贝
+    RenderSystem(const RenderSystem&) = delete;
+    RenderSystem& operator=(const RenderSystem&) = delete;
+    
     /**
      * @brief 初始化渲染系统
      * @param device Vulkan 设备
@@ -60,19 +114,91 @@ public:
         MeshManager::getInstance().init(device);
         TextureManager::getInstance().init(device);
         
+        // GPU 驱动路径：设备不支持或剔除着色器未编译时保持 CPU 提交
+        if (!GpuCulling::isSupported(*device)) {
+            std::cout << "[RenderSystem] GPU culling unsupported by device, using CPU submission" << std::endl;
+        } else if (!std::filesystem::exists(GpuCulling::SHADER_PATH)) {
+            std::cout << "[RenderSystem] GPU culling disabled: " << GpuCulling::SHADER_PATH
+                      << " not found, using CPU submission" << std::endl;
+        } else {
+            m_gpuCulling = std::make_unique<GpuCulling>(device);
+        }
+        
         std::cout << "[RenderSystem] Initialized" << std::endl;
     }
     
     /**
-     * @brief 生成材质ID（基于纹理路径）
+     * @brief 设置本帧相机（用于网格簇剔除和 LOD 选择），需在 updateRenderables 之前调用
+     * @param viewportHeight 视口高度（像素），用于把几何误差换算为屏幕像素
+     */
+    void setCamera(const glm::mat4& view, const glm::mat4& proj, const glm::vec3& position, float viewportHeight) {
+        m_frustum = Frustum::fromMatrix(proj * view);
+        m_cameraPosition = position;
+        m_projectionScale = std::abs(proj[1][1]) * viewportHeight * 0.5f;
+        m_hasCamera = true;
+    }
+    
+    /**
+     * @brief 启用/禁用网格簇剔除
+     */
+    void setClusterCullingEnabled(bool enabled) {
+        m_clusterCulling = enabled;
+    }
+    
+    bool isClusterCullingEnabled() const {
+        return m_clusterCulling;
+    }
+    
+    /**
+     * @brief 启用/禁用 LOD 选择
+     */
+    void setLodEnabled(bool enabled) {
+        m_lodEnabled = enabled;
+    }
+    
+    bool isLodEnabled() const {
+        return m_lodEnabled;
+    }
+    
+    /**
+     * @brief 启用/禁用 GPU 驱动渲染（计算着色器视锥剔除 + 间接绘制），设备不支持时无效
+     */
+    void setGpuDrivenEnabled(bool enabled) {
+        m_gpuDriven = enabled;
+    }
+    
+    bool isGpuDrivenEnabled() const {
+        return m_gpuDriven;
+    }
+    
+    bool isGpuDrivenSupported() const {
+        return m_gpuCulling != nullptr;
+    }
+    
+    /**
+     * @brief 设置 LOD 允许的最大屏幕空间误差（像素）
+     */
+    void setLodErrorThreshold(float pixels) {
+        m_lodErrorThreshold = pixels;
+    }
+    
+    float getLodErrorThreshold() const {
+        return m_lodErrorThreshold;
+    }
+    
+    /**
+     * @brief 获取上一次 updateRenderables 的网格簇剔除与 LOD 统计
      */
-    std::string generateMaterialId(const std::string& albedo, const std::string& normal, const std::string& metallic) {
-        return albedo + "|" + normal + "|" + metallic;
+    const ClusterCullStats& getClusterCullStats() const {
+        return m_clusterStats;
     }
     
     /**
      * @brief 更新渲染数据（使用 RTTI 多态版本）
-     * 从场景中收集所有可渲染实体，根据传入的 RenderPass 类型分配相应的材质描述符
+     * 可渲染实体缓存按组件变化增量维护：只重新解析 Transform / MeshRenderer / PBRMaterial 发生变化的实体，
+     * 其余实体每帧只做与相机相关的 LOD 选择、簇剔除和纹理使用上报。
+     * 网格和纹理路径只在组件变化时解析为句柄（存回组件），之后按句柄访问资源，逐帧路径不做字符串查找。
+     * 组件的就地修改需通过 registry.patch / replace（或 Entity::patchComponent）通知，否则缓存不会更新
      * @param scene 要渲染的场景
      * @param renderPasses 渲染通道列表（支持 ForwardPass、GBufferPass 等）
      */
@@ -80,100 +206,66 @@ public:
         if (!scene) return;
         
         auto& registry = scene->getRegistry();
-        auto view = registry.view<VulkanEngine::TransformComponent, VulkanEngine::MeshRendererComponent>();
+        observeRegistry(registry);
         
-        m_renderables.clear();
+        // 上传后台已处理完成的网格和纹理
+        MeshManager::getInstance().processPendingLoads();
+        TextureManager::getInstance().processPendingLoads();
         
-        for (auto entity : view) {
-            auto& transform = view.get<VulkanEngine::TransformComponent>(entity);
-            auto& meshRenderer = view.get<VulkanEngine::MeshRendererComponent>(entity);
-            
-            if (!meshRenderer.visible) continue;
-            
-            RenderableEntity renderable;
-            renderable.entityHandle = entity;
-            renderable.modelMatrix = transform.getTransform();
-            renderable.visible = meshRenderer.visible;
+        // Pass 集合变化或 Pass 重建了材质描述符时，所有实体重新分配描述符
+        syncRenderPasses(renderPasses);
+        
+        resolveDirtyEntities(registry, renderPasses);
+        
+        // 与相机相关的逐帧工作
+        m_clusterStats = ClusterCullStats();
+        m_submitStats = DrawSubmitStats();
+        m_gpuCullRecorded = false;
+        m_instanceDataWritten = false;
+        const bool gpuDriven = isGpuDrivenActive();
+        auto& textureManager = TextureManager::getInstance();
+        
+        for (RenderableEntity& renderable : m_renderables) {
+            renderable.viewDepth = m_hasCamera
+                ? glm::length(glm::vec3(renderable.modelMatrix * glm::vec4(renderable.gpuMesh->boundsCenter, 1.0f)) -
+                              m_cameraPosition)
+                : 0.0f;
             
-            // 获取网格
-            renderable.gpuMesh = MeshManager::getInstance().getMesh(meshRenderer.meshPath);
-            if (!renderable.gpuMesh || !renderable.gpuMesh->isValid()) {
-                continue;  // 跳过无效网格
+
+            // LOD 选择与网格簇剔除（仍保留实体本身，射线拾取等需要完整列表）；
+            // GPU 驱动路径逐实体剔除，不做簇剔除
+            renderable.lodLevel = 0;
+            renderable.useDrawRanges = false;
+            if (m_lodEnabled && m_hasCamera) {
+                renderable.lodLevel = selectLod(renderable);
+            }
+            if (renderable.lodLevel > 0) {
+                applyLod(renderable);
+            } else if (m_clusterCulling && m_hasCamera && !gpuDriven && !renderable.gpuMesh->meshlets.empty()) {
+                cullClusters(renderable);
             }
             
-            // 获取纹理和材质ID
-            std::string albedoPath, normalPath, metallicPath;
-            
-            if (registry.all_of<VulkanEngine::PBRMaterialComponent>(entity)) {
-                auto& material = registry.get<VulkanEngine::PBRMaterialComponent>(entity);
-                
-                albedoPath = material.albedoMap;
-                normalPath = material.normalMap;
-                metallicPath = material.metallicMap;
-                
-                // Albedo 纹理：空路径使用默认白色
-                if (!albedoPath.empty()) {
-                    renderable.albedoTexture = TextureManager::getInstance().getTexture(albedoPath);
-                } else {
-                    renderable.albedoTexture = TextureManager::getInstance().getDefaultWhiteTexture();
-                    albedoPath = "__default_white__";
-                }
-                
-                // Normal 纹理：空路径使用默认法线 (0, 0, 1) 而不是白色 (1, 1, 1)
-                if (!normalPath.empty()) {
-                    renderable.normalTexture = TextureManager::getInstance().getTexture(normalPath);
-                } else {
-                    renderable.normalTexture = TextureManager::getInstance().getDefaultNormalTexture();
-                    normalPath = "__default_normal__";
-                }
-                
-                // Metallic/Specular 纹理：空路径使用默认白色
-                if (!metallicPath.empty()) {
-                    renderable.specularTexture = TextureManager::getInstance().getTexture(metallicPath);
-                } else {
-                    // 使用默认纹理
-                    renderable.albedoTexture = TextureManager::getInstance().getDefaultWhiteTexture();
-                    renderable.normalTexture = TextureManager::getInstance().getDefaultNormalTexture();
-                    renderable.specularTexture = TextureManager::getInstance().getDefaultWhiteTexture();
-                    albedoPath = "__default_white__";
-                    normalPath = "__default_normal__";
-                    metallicPath = "__default_white__";
+            if (renderable.useDrawRanges) {
+                for (const MeshDrawRange& range : renderable.drawRanges) {
+                    m_clusterStats.submittedTriangles += range.indexCount / 3;
                 }
             } else {
-                // 使用默认纹理
-                renderable.albedoTexture = TextureManager::getInstance().getDefaultWhiteTexture();
-                renderable.normalTexture = TextureManager::getInstance().getDefaultNormalTexture();
-                renderable.specularTexture = TextureManager::getInstance().getDefaultWhiteTexture();
-                albedoPath = "__default_white__";
-                normalPath = "__default_normal__";
-                metallicPath = "__default_white__";
+                m_clusterStats.submittedTriangles += renderable.gpuMesh->getIndexCount() / 3;
             }
             
-            // 生成材质ID
-            renderable.materialId = generateMaterialId(albedoPath, normalPath, metallicPath);
-            
-            // 遍历所有 RenderPass，使用 RTTI 判断类型并分配对应的材质描述符
-            for (RenderPassBase* pass : renderPasses) {
-                if (!pass) continue;
-                
-                // 检查纹理是否有效
-                bool texturesValid = renderable.albedoTexture && renderable.normalTexture && renderable.specularTexture;
-                if (!texturesValid) continue;
-                
-                // 使用 dynamic_cast 判断 Pass 类型
-                if (ForwardPass* forwardPass = dynamic_cast<ForwardPass*>(pass)) {
-                    allocateForwardPassDescriptor(renderable, forwardPass);
-                }
-                else if (GBufferPass* gbufferPass = dynamic_cast<GBufferPass*>(pass)) {
-                    allocateGBufferPassDescriptor(renderable, gbufferPass);
-                }
-                // 可扩展其他 Pass 类型...
+            // 可见实体按屏幕尺寸报告纹理需求（流式加载的级别选择与 LRU）
+            if (renderable.albedoHandle.isValid() || renderable.normalHandle.isValid() ||
+                renderable.metallicHandle.isValid()) {
+                const float screenPixels = getScreenDiameter(renderable);
+                textureManager.markTextureUsed(renderable.albedoHandle, screenPixels);
+                textureManager.markTextureUsed(renderable.normalHandle, screenPixels);
+                textureManager.markTextureUsed(renderable.metallicHandle, screenPixels);
             }
-            
-            renderable.valid = true;
-            m_renderables.push_back(renderable);
         }
         
+        // 按本帧的使用情况调整纹理驻留级别
+        textureManager.updateResidency();
+        
         // 避免每帧输出日志
         static size_t lastCount = 0;
         if (m_renderables.size() != lastCount) {
@@ -182,6 +274,16 @@ public:
         }
     }
     
+    /**
+     * @brief 使所有缓存的网格 / 材质引用失效（外部卸载或重载资源后调用），下一帧全部重新解析
+     */
+    void invalidateRenderables() {
+        if (!m_registry) return;
+        for (auto entity : m_registry->view<VulkanEngine::TransformComponent, VulkanEngine::MeshRendererComponent>()) {
+            markDirty(entity, DIRTY_ALL);
+        }
+    }
+    
     /**
      * @brief 更新渲染数据（旧版兼容接口）
      * @param scene 要渲染的场景
@@ -194,56 +296,561 @@ public:
     }
     
 private:
+    // DIRTY_MESH / DIRTY_MATERIAL：组件变化，重新把路径解析为句柄；
+    // DIRTY_MESH_RESOURCE / DIRTY_MATERIAL_RESOURCE：句柄不变，重新按句柄获取资源（等待加载、Pass 重建）
+    static constexpr uint8_t DIRTY_TRANSFORM = 1 << 0;
+    static constexpr uint8_t DIRTY_MESH = 1 << 1;
+    static constexpr uint8_t DIRTY_MATERIAL = 1 << 2;
+    static constexpr uint8_t DIRTY_MESH_RESOURCE = 1 << 3;
+    static constexpr uint8_t DIRTY_MATERIAL_RESOURCE = 1 << 4;
+    static constexpr uint8_t DIRTY_ALL = DIRTY_TRANSFORM | DIRTY_MESH | DIRTY_MATERIAL |
+                                         DIRTY_MESH_RESOURCE | DIRTY_MATERIAL_RESOURCE;
+    static constexpr uint32_t INVALID_SLOT = std::numeric_limits<uint32_t>::max();
+    
     /**
-     * @brief 为 ForwardPass 分配材质描述符
+     * @brief 连接场景 registry 的组件信号；切换到新场景（包括同一地址上重建的场景）时丢弃旧缓存，
+     * 并把已有的可渲染实体全部标记为脏。是否已连接记录在 registry 的上下文中
      */
-    void allocateForwardPassDescriptor(RenderableEntity& renderable, ForwardPass* forwardPass) {
-        // 尝试获取已有的材质描述符
-        renderable.materialDescriptor = forwardPass->getMaterialDescriptor(renderable.materialId);
+    void observeRegistry(entt::registry& registry) {
+        const auto* observer = registry.ctx().find<RenderSystemObserver>();
+        if (m_registry == &registry && observer && observer->owner == this) return;
         
-        // 如果不存在，分配新的
-        if (!renderable.materialDescriptor) {
-            renderable.materialDescriptor = forwardPass->allocateMaterialDescriptor(renderable.materialId);
+        // 旧 registry 可能已随场景销毁，不再访问；其信号由回调中的 registry 比较过滤
+        m_registry = &registry;
+        m_renderables.clear();
+        m_renderableSlots.clear();
+        m_dirtyFlags.clear();
+        m_dirtyOwners.clear();
+        m_dirtyEntities.clear();
+        
+        registry.on_construct<VulkanEngine::TransformComponent>().connect<&RenderSystem::onTransformChanged>(*this);
+        registry.on_update<VulkanEngine::TransformComponent>().connect<&RenderSystem::onTransformChanged>(*this);
+        registry.on_destroy<VulkanEngine::TransformComponent>().connect<&RenderSystem::onRenderableDestroyed>(*this);
+        registry.on_construct<VulkanEngine::MeshRendererComponent>().connect<&RenderSystem::onMeshRendererChanged>(*this);
+        registry.on_update<VulkanEngine::MeshRendererComponent>().connect<&RenderSystem::onMeshRendererChanged>(*this);
+        registry.on_destroy<VulkanEngine::MeshRendererComponent>().connect<&RenderSystem::onRenderableDestroyed>(*this);
+        registry.on_construct<VulkanEngine::PBRMaterialComponent>().connect<&RenderSystem::onMaterialChanged>(*this);
+        registry.on_update<VulkanEngine::PBRMaterialComponent>().connect<&RenderSystem::onMaterialChanged>(*this);
+        registry.on_destroy<VulkanEngine::PBRMaterialComponent>().connect<&RenderSystem::onMaterialChanged>(*this);
+        registry.ctx().insert_or_assign(RenderSystemObserver{ this });
+        
+        invalidateRenderables();
+    }
+    
+    /**
+     * @brief 断开当前 registry 的信号（场景销毁之前调用）
+     */
+    void detachRegistry() {
+        if (!m_registry) return;
+        
+        m_registry->on_construct<VulkanEngine::TransformComponent>().disconnect(*this);
+        m_registry->on_update<VulkanEngine::TransformComponent>().disconnect(*this);
+        m_registry->on_destroy<VulkanEngine::TransformComponent>().disconnect(*this);
+        m_registry->on_construct<VulkanEngine::MeshRendererComponent>().disconnect(*this);
+        m_registry->on_update<VulkanEngine::MeshRendererComponent>().disconnect(*this);
+        m_registry->on_destroy<VulkanEngine::MeshRendererComponent>().disconnect(*this);
+        m_registry->on_construct<VulkanEngine::PBRMaterialComponent>().disconnect(*this);
+        m_registry->on_update<VulkanEngine::PBRMaterialComponent>().disconnect(*this);
+        m_registry->on_destroy<VulkanEngine::PBRMaterialComponent>().disconnect(*this);
+        m_registry->ctx().erase<RenderSystemObserver>();
+        m_registry = nullptr;
+    }
+    
+    void onTransformChanged(entt::registry& registry, entt::entity entity) {
+        if (&registry == m_registry) markDirty(entity, DIRTY_TRANSFORM);
+    }
+    
+    void onMeshRendererChanged(entt::registry& registry, entt::entity entity) {
+        if (&registry == m_registry) markDirty(entity, DIRTY_MESH);
+    }
+    
+    void onMaterialChanged(entt::registry& registry, entt::entity entity) {
+        if (&registry == m_registry) markDirty(entity, DIRTY_MATERIAL);
+    }
+    
+    /**
+     * @brief Transform 或 MeshRenderer 被移除（包括实体销毁）：立即移出缓存，丢弃未处理的脏标记
+     */
+    void onRenderableDestroyed(entt::registry& registry, entt::entity entity) {
+        if (&registry != m_registry) return;
+        
+        removeRenderable(entity);
+        const uint32_t index = static_cast<uint32_t>(entt::to_entity(entity));
+        if (index < m_dirtyOwners.size() && m_dirtyOwners[index] == entity) {
+            m_dirtyFlags[index] = 0;
+        }
+    }
+    
+    /**
+     * @brief 记录实体的变化；脏标记按实体索引存放，索引被新实体复用时旧记录作废
+     */
+    void markDirty(entt::entity entity, uint8_t flags) {
+        const uint32_t index = static_cast<uint32_t>(entt::to_entity(entity));
+        if (index >= m_dirtyFlags.size()) {
+            m_dirtyFlags.resize(index + 1, 0);
+            m_dirtyOwners.resize(index + 1, entt::null);
+        }
+        if (m_dirtyOwners[index] != entity) {
+            m_dirtyOwners[index] = entity;
+            m_dirtyFlags[index] = 0;
+        }
+        if (m_dirtyFlags[index] == 0) {
+            m_dirtyEntities.push_back(entity);
+        }
+        m_dirtyFlags[index] |= flags;
+    }
+    
+    /**
+     * @brief 处理脏实体；网格或纹理仍在加载的实体保留剩余的脏标记，下一帧重试
+     */
+    void resolveDirtyEntities(entt::registry& registry, const std::vector<RenderPassBase*>& renderPasses) {
+        if (m_dirtyEntities.empty()) return;
+        
+        std::vector<entt::entity> pending;
+        for (entt::entity entity : m_dirtyEntities) {
+            const uint32_t index = static_cast<uint32_t>(entt::to_entity(entity));
+            if (m_dirtyOwners[index] != entity || m_dirtyFlags[index] == 0) continue;
+            if (!registry.valid(entity)) {
+                m_dirtyFlags[index] = 0;
+                continue;
+            }
             
-            // 更新纹理绑定
-            if (renderable.materialDescriptor) {
-                forwardPass->updateMaterialTextures(
-                    renderable.materialDescriptor,
-                    renderable.albedoTexture->getImageView(),
-                    renderable.albedoTexture->getSampler(),
-                    renderable.normalTexture->getImageView(),
-                    renderable.normalTexture->getSampler(),
-                    renderable.specularTexture->getImageView(),
-                    renderable.specularTexture->getSampler()
-                );
+            m_dirtyFlags[index] = resolveEntity(registry, entity, m_dirtyFlags[index], renderPasses);
+            if (m_dirtyFlags[index] != 0) {
+                pending.push_back(entity);
             }
         }
+        m_dirtyEntities.swap(pending);
     }
     
     /**
-     * @brief 为 GBufferPass 分配材质描述符
+     * @brief 重新解析实体中发生变化的部分
+     * @return 未完成的脏标记（资源仍在加载），0 表示已解析完毕或实体不可渲染
      */
-    void allocateGBufferPassDescriptor(RenderableEntity& renderable, GBufferPass* gbufferPass) {
-        // 尝试获取已有的材质描述符
-        renderable.gbufferMaterialDescriptor = gbufferPass->getMaterialDescriptor(renderable.materialId);
+    uint8_t resolveEntity(entt::registry& registry, entt::entity entity, uint8_t flags,
+                          const std::vector<RenderPassBase*>& renderPasses) {
+        const auto* transform = registry.try_get<VulkanEngine::TransformComponent>(entity);
+        auto* meshRenderer = registry.try_get<VulkanEngine::MeshRendererComponent>(entity);
+        if (!transform || !meshRenderer || !meshRenderer->visible) {
+            removeRenderable(entity);
+            return 0;
+        }
+        
+        // 新实体在网格驻留后才加入缓存
+        const uint32_t slot = getRenderableSlot(entity);
+        RenderableEntity created;
+        RenderableEntity* renderable = &created;
+        if (slot != INVALID_SLOT) {
+            renderable = &m_renderables[slot];
+        } else {
+            created.entityHandle = entity;
+            flags |= DIRTY_TRANSFORM | DIRTY_MESH_RESOURCE | DIRTY_MATERIAL_RESOURCE;
+        }
+        
+        if (flags & DIRTY_TRANSFORM) {
+            renderable->modelMatrix = transform->getTransform();
+            renderable->normalMatrix = glm::transpose(glm::inverse(renderable->modelMatrix));
+        }
+        
+        if (flags & (DIRTY_MESH | DIRTY_MESH_RESOURCE)) {
+            // 路径变化或句柄已失效（网格被卸载）时重新解析句柄
+            auto& meshManager = MeshManager::getInstance();
+            if ((flags & DIRTY_MESH) || !meshManager.isHandleValid(meshRenderer->meshHandle)) {
+                meshRenderer->meshHandle = meshManager.acquireMeshHandle(meshRenderer->meshPath);
+            }
+            
+            // 获取网格（未驻留时发起后台加载，加载期间不绘制）
+            renderable->mesh = meshRenderer->meshHandle;
+            renderable->gpuMesh = meshManager.getMeshIfResident(renderable->mesh);
+            if (!renderable->gpuMesh || !renderable->gpuMesh->isValid()) {
+                removeRenderable(entity);
+                if (meshManager.isMeshFailed(meshRenderer->meshHandle)) return 0;
+                return static_cast<uint8_t>((flags & ~DIRTY_MESH) | DIRTY_MESH_RESOURCE);
+            }
+        }
+        
+        uint8_t remaining = 0;
+        if (flags & (DIRTY_MATERIAL | DIRTY_MATERIAL_RESOURCE)) {
+            if (!resolveMaterial(registry, entity, *renderable, (flags & DIRTY_MATERIAL) != 0)) {
+                remaining = DIRTY_MATERIAL_RESOURCE;
+            }
+            assignMaterialDescriptors(*renderable, renderPasses);
+        }
+        
+        renderable->valid = true;
+        if (slot == INVALID_SLOT) {
+            const size_t index = static_cast<size_t>(entt::to_entity(entity));
+            if (index >= m_renderableSlots.size()) {
+                m_renderableSlots.resize(index + 1, INVALID_SLOT);
+            }
+            m_renderableSlots[index] = static_cast<uint32_t>(m_renderables.size());
+            m_renderables.push_back(std::move(created));
+        }
+        return remaining;
+    }
+    
+    /**
+     * @brief 解析材质纹理与材质句柄
+     * @param reacquire 材质组件发生变化，需要从纹理路径重新解析句柄
+     * @return 纹理全部加载结束时返回 true；否则使用默认材质，稍后重试
+     */
+    bool resolveMaterial(entt::registry& registry, entt::entity entity, RenderableEntity& renderable, bool reacquire) {
+        auto& textureManager = TextureManager::getInstance();
+        auto& materialManager = MaterialManager::getInstance();
+        bool resident = true;
+        
+        if (auto* material = registry.try_get<VulkanEngine::PBRMaterialComponent>(entity)) {
+            // 句柄存回组件；纹理被卸载或材质表被清空后句柄失效，同样重新解析
+            if (reacquire || !materialManager.isHandleValid(material->materialHandle) ||
+                isTextureHandleStale(material->albedoMap, material->albedoHandle) ||
+                isTextureHandleStale(material->normalMap, material->normalHandle) ||
+                isTextureHandleStale(material->metallicMap, material->metallicHandle)) {
+                material->albedoHandle = textureManager.acquireTextureHandle(material->albedoMap);
+                material->normalHandle = textureManager.acquireTextureHandle(material->normalMap, TextureUsage::Normal);
+                material->metallicHandle = textureManager.acquireTextureHandle(material->metallicMap, getMetallicUsage(*material));
+                material->materialHandle = materialManager.acquireMaterial(
+                    { material->albedoHandle, material->normalHandle, material->metallicHandle });
+            }
+            
+            // 纹理在后台加载，未驻留时使用默认纹理：Albedo/Metallic 为白色，Normal 为 (0, 0, 1)
+            renderable.albedoTexture = textureManager.requestTexture(material->albedoHandle, TextureUsage::Color);
+            renderable.normalTexture = textureManager.requestTexture(material->normalHandle, TextureUsage::Normal);
+            renderable.specularTexture = textureManager.requestTexture(material->metallicHandle, getMetallicUsage(*material));
+            
+            // 加载期间同样上报使用情况
+            renderable.albedoHandle = material->albedoHandle;
+            renderable.normalHandle = material->normalHandle;
+            renderable.metallicHandle = material->metallicHandle;
+            
+            // 三张纹理都加载结束后才切换到材质自己的描述符，加载期间所有材质共用默认材质，
+            // 避免部分驻留的中间组合占用描述符池
+            resident = !textureManager.isTextureLoading(material->albedoHandle) &&
+                       !textureManager.isTextureLoading(material->normalHandle) &&
+                       !textureManager.isTextureLoading(material->metallicHandle);
+            if (resident) {
+                renderable.material = material->materialHandle;
+                return true;
+            }
+        } else {
+            renderable.albedoHandle = TextureHandle();
+            renderable.normalHandle = TextureHandle();
+            renderable.metallicHandle = TextureHandle();
+        }
+        
+        // 使用默认纹理
+        renderable.albedoTexture = textureManager.getDefaultWhiteTexture();
+        renderable.normalTexture = textureManager.getDefaultNormalTexture();
+        renderable.specularTexture = textureManager.getDefaultWhiteTexture();
+        renderable.material = materialManager.getDefaultMaterial();
+        return resident;
+    }
+    
+    /**
+     * @brief 非空纹理路径的句柄已失效（从未解析或纹理被卸载）
+     */
+    static bool isTextureHandleStale(const std::string& texturePath, TextureHandle handle) {
+        return !texturePath.empty() && !TextureManager::getInstance().isHandleValid(handle);
+    }
+    
+    /**
+     * @brief 金属度贴图的用途：与粗糙度贴图为同一文件时是 glTF 打包贴图（B: 金属度, G: 粗糙度），否则为单通道遮罩
+     */
+    static TextureUsage getMetallicUsage(const VulkanEngine::PBRMaterialComponent& material) {
+        return !material.roughnessMap.empty() && material.roughnessMap == material.metallicMap
+            ? TextureUsage::MetallicRoughness : TextureUsage::Mask;
+    }
+    
+    /**
+     * @brief 遍历所有 RenderPass，使用 RTTI 判断类型并分配对应的材质描述符
+     */
+    void assignMaterialDescriptors(RenderableEntity& renderable, const std::vector<RenderPassBase*>& renderPasses) {
+        // 检查纹理是否有效
+        bool texturesValid = renderable.albedoTexture && renderable.normalTexture && renderable.specularTexture;
+        if (!texturesValid) return;
+        
+        for (RenderPassBase* pass : renderPasses) {
+            if (!pass) continue;
+            
+            // 使用 dynamic_cast 判断 Pass 类型
+            if (ForwardPass* forwardPass = dynamic_cast<ForwardPass*>(pass)) {
+                if (forwardPass->isBindless()) {
+                    acquireBindlessMaterial(renderable);
+                } else {
+                    allocateForwardPassDescriptor(renderable, forwardPass);
+                }
+            }
+            else if (GBufferPass* gbufferPass = dynamic_cast<GBufferPass*>(pass)) {
+                if (gbufferPass->isBindless()) {
+                    acquireBindlessMaterial(renderable);
+                } else {
+                    allocateGBufferPassDescriptor(renderable, gbufferPass);
+                }
+            }
+            // 可扩展其他 Pass 类型...
+        }
+    }
+    
+    /**
+     * @brief 记录本帧的 Pass 集合及其资源代数，变化时所有实体重新分配材质描述符
+     */
+    void syncRenderPasses(const std::vector<RenderPassBase*>& renderPasses) {
+        bool changed = renderPasses.size() != m_passGenerations.size();
+        for (size_t i = 0; !changed && i < renderPasses.size(); i++) {
+            changed = m_passGenerations[i].first != renderPasses[i] ||
+                      (renderPasses[i] && m_passGenerations[i].second != renderPasses[i]->getResourceGeneration());
+        }
+        if (!changed) return;
+        
+        m_passGenerations.clear();
+        for (RenderPassBase* pass : renderPasses) {
+            m_passGenerations.emplace_back(pass, pass ? pass->getResourceGeneration() : 0);
+        }
+        for (RenderableEntity& renderable : m_renderables) {
+            markDirty(renderable.entityHandle, DIRTY_MATERIAL_RESOURCE);
+        }
+    }
+    
+    uint32_t getRenderableSlot(entt::entity entity) const {
+        const auto index = static_cast<size_t>(entt::to_entity(entity));
+        if (index >= m_renderableSlots.size()) return INVALID_SLOT;
+        const uint32_t slot = m_renderableSlots[index];
+        if (slot >= m_renderables.size() || m_renderables[slot].entityHandle != entity) return INVALID_SLOT;
+        return slot;
+    }
+    
+    /**
+     * @brief 从稠密数组中移除（与末尾交换）
+     */
+    void removeRenderable(entt::entity entity) {
+        const uint32_t slot = getRenderableSlot(entity);
+        if (slot == INVALID_SLOT) return;
+        
+        const uint32_t last = static_cast<uint32_t>(m_renderables.size() - 1);
+        if (slot != last) {
+            m_renderables[slot] = std::move(m_renderables[last]);
+            m_renderableSlots[entt::to_entity(m_renderables[slot].entityHandle)] = slot;
+        }
+        m_renderables.pop_back();
+        m_renderableSlots[entt::to_entity(entity)] = INVALID_SLOT;
+    }
+    
+    /**
+     * @brief 模型矩阵的最大轴缩放（包围球半径与几何误差按此放大）
+     */
+    static float getMaxScale(const glm::mat4& model) {
+        float maxScaleSquared = std::max(glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+                                std::max(glm::dot(glm::vec3(model[1]), glm::vec3(model[1])),
+                                         glm::dot(glm::vec3(model[2]), glm::vec3(model[2]))));
+        return std::sqrt(maxScaleSquared);
+    }
+    
+    /**
+     * @brief 按屏幕空间误差选择 LOD：
+     * 误差（网格局部空间距离）乘最大缩放后，按包围球最近点的距离投影到屏幕，
+     * 取误差不超过阈值的最粗一级。相机在包围球内时使用 LOD0
+     */
+    uint32_t selectLod(const RenderableEntity& renderable) const {
+        const auto& lods = renderable.gpuMesh->getLods();
+        if (lods.empty()) return 0;
+        
+        const glm::mat4& model = renderable.modelMatrix;
+        float maxScale = getMaxScale(model);
+        glm::vec3 worldCenter = glm::vec3(model * glm::vec4(renderable.gpuMesh->boundsCenter, 1.0f));
+        float distance = glm::length(worldCenter - m_cameraPosition) - renderable.gpuMesh->boundsRadius * maxScale;
+        if (distance <= 0.0f) return 0;
+        
+        float pixelsPerUnit = m_projectionScale * maxScale / distance;
+        uint32_t level = 0;
+        for (const MeshLod& lod : lods) {
+            if (lod.error * pixelsPerUnit > m_lodErrorThreshold) break;
+            ++level;
+        }
+        return level;
+    }
+    
+    /**
+     * @brief 实体包围球在屏幕上的直径（像素）
+     * 无相机或相机位于包围球内时返回 infinity，包围球完全在视锥外时返回 0
+     */
+    float getScreenDiameter(const RenderableEntity& renderable) const {
+        if (!m_hasCamera) return std::numeric_limits<float>::infinity();
+        
+        const glm::mat4& model = renderable.modelMatrix;
+        float radius = renderable.gpuMesh->boundsRadius * getMaxScale(model);
+        glm::vec3 worldCenter = glm::vec3(model * glm::vec4(renderable.gpuMesh->boundsCenter, 1.0f));
+        if (!m_frustum.intersectsSphere(worldCenter, radius)) return 0.0f;
+        
+        float distance = glm::length(worldCenter - m_cameraPosition) - radius;
+        if (distance <= 0.0f) return std::numeric_limits<float>::infinity();
+        return 2.0f * radius * m_projectionScale / distance;
+    }
+    
+    /**
+     * @brief 使用 LOD1 及以上时整体绘制对应区间（网格簇只覆盖 LOD0），
+     * 整个包围球在视锥外时不绘制
+     */
+    void applyLod(RenderableEntity& renderable) {
+        const MeshLod& lod = renderable.gpuMesh->getLods()[renderable.lodLevel - 1];
+        const glm::mat4& model = renderable.modelMatrix;
+        
+        renderable.useDrawRanges = true;
+        renderable.drawRanges.clear();
+        ++m_clusterStats.lodEntities;
+        
+        glm::vec3 worldCenter = glm::vec3(model * glm::vec4(renderable.gpuMesh->boundsCenter, 1.0f));
+        if (m_frustum.intersectsSphere(worldCenter, renderable.gpuMesh->boundsRadius * getMaxScale(model))) {
+            renderable.drawRanges.push_back({ lod.firstIndex, lod.indexCount });
+            ++m_clusterStats.drawRanges;
+        }
+    }
+    
+    /**
+     * @brief 网格簇剔除：视锥剔除使用世界空间包围球，
+     * 背面剔除把相机变换到网格局部空间后与法线锥比较（仿射变换保持平面两侧关系）。
+     * 相邻的可见簇合并为一个绘制区间
+     */
+    void cullClusters(RenderableEntity& renderable) {
+        const auto& meshlets = renderable.gpuMesh->meshlets;
+        const glm::mat4& model = renderable.modelMatrix;
+        
+        // 包围球半径按最大轴缩放放大
+        float maxScale = getMaxScale(model);
+        
+        // 镜像变换会翻转绕序，此时不做背面剔除
+        bool coneCulling = glm::determinant(glm::mat3(model)) > 0.0f;
+        glm::vec3 localEye = glm::vec3(glm::inverse(model) * glm::vec4(m_cameraPosition, 1.0f));
+        
+        renderable.useDrawRanges = true;
+        renderable.drawRanges.clear();
         
-        // 如果不存在，分配新的
-        if (!renderable.gbufferMaterialDescriptor) {
-            renderable.gbufferMaterialDescriptor = gbufferPass->allocateMaterialDescriptor(renderable.materialId);
+        for (const Meshlet& meshlet : meshlets) {
+            glm::vec3 worldCenter = glm::vec3(model * glm::vec4(meshlet.center, 1.0f));
+            if (!m_frustum.intersectsSphere(worldCenter, meshlet.radius * maxScale)) {
+                continue;
+            }
+            
+            if (coneCulling && meshlet.coneCutoff < 1.0f) {
+                glm::vec3 toCenter = meshlet.center - localEye;
+                float distance = glm::length(toCenter);
+                if (glm::dot(toCenter, meshlet.coneAxis) >= meshlet.coneCutoff * distance + meshlet.radius) {
+                    continue;
+                }
+            }
             
-            // 更新纹理绑定
-            if (renderable.gbufferMaterialDescriptor) {
-                gbufferPass->updateMaterialTextures(
-                    renderable.gbufferMaterialDescriptor,
-                    renderable.albedoTexture->getImageView(),
-                    renderable.albedoTexture->getSampler(),
-                    renderable.normalTexture->getImageView(),
-                    renderable.normalTexture->getSampler(),
-                    renderable.specularTexture->getImageView(),
-                    renderable.specularTexture->getSampler()
-                );
+            ++m_clusterStats.visibleClusters;
+            if (!renderable.drawRanges.empty() &&
+                renderable.drawRanges.back().firstIndex + renderable.drawRanges.back().indexCount == meshlet.firstIndex) {
+                renderable.drawRanges.back().indexCount += meshlet.indexCount;
+            } else {
+                renderable.drawRanges.push_back({ meshlet.firstIndex, meshlet.indexCount });
             }
         }
+        
+        m_clusterStats.totalClusters += static_cast<uint32_t>(meshlets.size());
+        m_clusterStats.drawRanges += static_cast<uint32_t>(renderable.drawRanges.size());
+    }
+    
+    /**
+     * @brief 纹理资源被流式替换后重写当前帧的材质描述符集
+     * 在录制该帧、绑定描述符集之前调用（该帧的上一次提交已执行完毕），其他帧在各自录制时更新
+     */
+    template<typename Pass>
+    static void refreshMaterialTextures(Pass* pass, typename Pass::MaterialDescriptor* material,
+                                        const RenderableEntity& renderable, uint32_t frameIndex) {
+        const uint64_t version = renderable.albedoTexture->getResidencyVersion() +
+                                 renderable.normalTexture->getResidencyVersion() +
+                                 renderable.specularTexture->getResidencyVersion();
+        if (material->textureVersions.size() <= frameIndex) {
+            material->textureVersions.resize(frameIndex + 1, 0);
+        }
+        if (material->textureVersions[frameIndex] == version) return;
+        
+        pass->updateMaterialTextures(material, frameIndex,
+                                     renderable.albedoTexture->getImageView(), renderable.albedoTexture->getSampler(),
+                                     renderable.normalTexture->getImageView(), renderable.normalTexture->getSampler(),
+                                     renderable.specularTexture->getImageView(), renderable.specularTexture->getSampler());
+        material->textureVersions[frameIndex] = version;
+    }
+    
+    /**
+     * @brief Bindless 模式：按材质句柄查找或创建材质参数，纹理槽位变化（重新加载）或材质槽位被复用时更新
+     */
+    void acquireBindlessMaterial(RenderableEntity& renderable) {
+        auto& textureManager = TextureManager::getInstance();
+        BindlessDescriptors* bindless = textureManager.getBindlessDescriptors();
+        if (!bindless) return;
+        
+        BindlessMaterialData data;
+        data.albedoTexture = textureManager.getBindlessIndex(renderable.albedoTexture);
+        data.normalTexture = textureManager.getBindlessIndex(renderable.normalTexture, TextureUsage::Normal);
+        data.metallicTexture = textureManager.getBindlessIndex(renderable.specularTexture, TextureUsage::Mask);
+        
+        if (renderable.material.index >= m_bindlessMaterials.size()) {
+            m_bindlessMaterials.resize(renderable.material.index + 1, INVALID_SLOT);
+        }
+        uint32_t& materialIndex = m_bindlessMaterials[renderable.material.index];
+        if (materialIndex == INVALID_SLOT) {
+            materialIndex = bindless->addMaterial(data);
+        } else if (bindless->getMaterial(materialIndex) != data) {
+            bindless->updateMaterial(materialIndex, data);
+        }
+        renderable.materialIndex = materialIndex;
+    }
+    
+    /**
+     * @brief Bindless 模式下每个 Pass 开始时调用：写入本帧待更新的描述符并绑定 Set 1
+     * @return Pass 未使用 bindless 时返回 false，按材质绑定描述符集
+     */
+    template<typename Pass>
+    static bool bindBindlessDescriptors(VkCommandBuffer commandBuffer, Pass* pass, uint32_t frameIndex) {
+        BindlessDescriptors* bindless = TextureManager::getInstance().getBindlessDescriptors();
+        if (!pass->isBindless() || !bindless) return false;
+        
+        bindless->beginFrame(frameIndex);
+        pass->bindBindlessDescriptorSet(commandBuffer, bindless->getDescriptorSet(frameIndex));
+        return true;
+    }
+    
+    /**
+     * @brief 为 ForwardPass 分配材质描述符
+     */
+    void allocateForwardPassDescriptor(RenderableEntity& renderable, ForwardPass* forwardPass) {
+        // 已有的材质描述符（同一句柄的纹理相同）直接复用
+        if (forwardPass->getMaterialDescriptor(renderable.material)) return;
+        
+        // 如果不存在，分配新的并更新纹理绑定
+        if (ForwardPass::MaterialDescriptor* descriptor = forwardPass->allocateMaterialDescriptor(renderable.material)) {
+            forwardPass->updateMaterialTextures(
+                descriptor,
+                renderable.albedoTexture->getImageView(),
+                renderable.albedoTexture->getSampler(),
+                renderable.normalTexture->getImageView(),
+                renderable.normalTexture->getSampler(),
+                renderable.specularTexture->getImageView(),
+                renderable.specularTexture->getSampler()
+            );
+        }
+    }
+    
+    /**
+     * @brief 为 GBufferPass 分配材质描述符
+     */
+    void allocateGBufferPassDescriptor(RenderableEntity& renderable, GBufferPass* gbufferPass) {
+        // 已有的材质描述符（同一句柄的纹理相同）直接复用
+        if (gbufferPass->getMaterialDescriptor(renderable.material)) return;
+        
+        // 如果不存在，分配新的并更新纹理绑定
+        if (GBufferPass::MaterialDescriptor* descriptor = gbufferPass->allocateMaterialDescriptor(renderable.material)) {
+            gbufferPass->updateMaterialTextures(
+                descriptor,
+                renderable.albedoTexture->getImageView(),
+                renderable.albedoTexture->getSampler(),
+                renderable.normalTexture->getImageView(),
+                renderable.normalTexture->getSampler(),
+                renderable.specularTexture->getImageView(),
+                renderable.specularTexture->getSampler()
+            );
+        }
     }
     
 public:
@@ -268,61 +875,339 @@ public:
         // 可扩展其他 Pass 类型...
     }
     
-private:
     /**
-     * @brief ForwardPass 渲染实现
+     * @brief 录制本帧的 GPU 剔除（GPU 驱动路径启用且已设置相机时），在 updateRenderables 之后、
+     * 开始任何渲染通道之前调用（计算调度不能位于渲染通道内）。
+     * 所有可绘制实体按排序后的顺序组成状态组与批次写入 GpuCulling，录制之后本帧各 Pass 的 render
+     * 按状态组绑定一次状态并间接绘制，CPU 不再逐实体提交；未录制时 render 保持 CPU 提交
+     * （FrameAllocator 本帧段空间不足时同样不录制，下一帧扩容后恢复）
      */
-    void renderForwardPass(VkCommandBuffer commandBuffer, ForwardPass* forwardPass, uint32_t frameIndex) {
-        // 绑定全局描述符集（Set 0: UBO）- 只需绑定一次
-        forwardPass->bindGlobalDescriptorSet(commandBuffer, frameIndex);
+    void recordGpuCulling(VkCommandBuffer commandBuffer) {
+        m_gpuCullRecorded = false;
+        if (!isGpuDrivenActive()) return;
         
-        for (const auto& renderable : m_renderables) {
-            if (!renderable.valid || !renderable.gpuMesh) continue;
+        // 各 Pass 共用剔除结果：排序键中只有 Pass 字段不同，绘制包顺序与 Pass 无关
+        buildDrawPackets(DRAW_PASS_FORWARD);
+        m_gpuGroups.clear();
+        
+        GpuCulling& culling = *m_gpuCulling;
+        if (!culling.beginFrame(static_cast<uint32_t>(m_drawPackets.size())) || m_drawPackets.empty()) return;
+        
+        const RenderableEntity* groupState = nullptr;
+        const uint32_t packetCount = static_cast<uint32_t>(m_drawPackets.size());
+        for (uint32_t first = 0, end = 0; first < packetCount; first = end) {
+            end = first + 1;
+            while (end < packetCount && canInstance(m_drawPackets[first], m_drawPackets[end])) {
+                ++end;
+            }
+            
+            const RenderableEntity& renderable = m_renderables[m_drawPackets[first].renderable];
+            const GPUMesh& mesh = *renderable.gpuMesh;
             
-            // 绑定材质描述符集（Set 1: 纹理）- 每个实体独立的描述符
-            if (renderable.materialDescriptor) {
-                forwardPass->bindMaterialDescriptorSet(commandBuffer, frameIndex, renderable.materialDescriptor);
+            // 管线、材质或几何缓冲区变化时开始新的状态组（一次间接绘制调用）
+            if (!groupState || !isSameDrawState(*groupState, renderable)) {
+                culling.addGroup();
+                m_gpuGroups.push_back(m_drawPackets[first].renderable);
+                groupState = &renderable;
             }
             
-            // 推送模型矩阵（Push Constants）
-            forwardPass->pushModelMatrix(commandBuffer, renderable.modelMatrix);
+            // LOD 区间对同一级别的所有实例相同（整个包围球在视锥外的实体已不在绘制包中）
+            if (renderable.lodLevel > 0) {
+                const MeshDrawRange& range = renderable.drawRanges.front();
+                culling.addBatch(range.indexCount, mesh.getFirstIndex() + range.firstIndex, mesh.getVertexOffset());
+            } else {
+                culling.addBatch(mesh.getIndexCount(), mesh.getFirstIndex(), mesh.getVertexOffset());
+            }
             
-            // 绘制网格
-            forwardPass->drawMesh(
-                commandBuffer,
-                renderable.gpuMesh->getVertexBufferHandle(),
-                renderable.gpuMesh->getIndexBufferHandle(),
-                renderable.gpuMesh->getIndexCount()
-            );
+            for (uint32_t i = first; i < end; ++i) {
+                const RenderableEntity& instance = m_renderables[m_drawPackets[i].renderable];
+                const glm::mat4& model = instance.modelMatrix;
+                glm::vec3 worldCenter = glm::vec3(model * glm::vec4(mesh.boundsCenter, 1.0f));
+                culling.addObject(mesh.vertexFormat == VertexFormat::Compact ? model * mesh.dequantizeMatrix : model,
+                                  instance.normalMatrix,
+                                  glm::vec4(worldCenter, mesh.boundsRadius * getMaxScale(model)));
+            }
         }
+        
+        m_gpuCullRecorded = culling.record(commandBuffer, m_frustum);
+    }
+    
+    /**
+     * @brief 本帧从 FrameAllocator 分配的实例 / 剔除数据的上限（按当前可渲染实体数估计，含各 Pass 的 UBO），
+     * 帧开始时交给 FrameAllocator::reserve，避免实体数增长后本帧分配失败
+     */
+    VkDeviceSize getFrameDataEstimate() const {
+        const uint32_t count = static_cast<uint32_t>(m_renderables.size());
+        VkDeviceSize bytes = FRAME_CONSTANTS_BYTES + (static_cast<VkDeviceSize>(count) + 1) * sizeof(ForwardPass::InstanceData);
+        if (m_gpuCulling && m_gpuDriven) {
+            bytes += GpuCulling::getFrameBytes(count);
+        }
+        return bytes;
+    }
+    
+private:
+    // 各 Pass 的 UBO 等每帧常量预留的字节数（getFrameDataEstimate）
+    static constexpr VkDeviceSize FRAME_CONSTANTS_BYTES = 64 * 1024;
+    
+    // 排序键中的 Pass 字段
+    static constexpr uint32_t DRAW_PASS_FORWARD = 0;
+    static constexpr uint32_t DRAW_PASS_GBUFFER = 1;
+    
+    /**
+     * @brief ForwardPass 渲染实现
+     */
+    void renderForwardPass(VkCommandBuffer commandBuffer, ForwardPass* forwardPass, uint32_t frameIndex) {
+        submitDraws(commandBuffer, forwardPass, DRAW_PASS_FORWARD, frameIndex);
     }
     
     /**
      * @brief GBufferPass 渲染实现
      */
     void renderGBufferPass(VkCommandBuffer commandBuffer, GBufferPass* gbufferPass, uint32_t frameIndex) {
-        // 绑定全局描述符集（Set 0: UBO）- 只需绑定一次
-        gbufferPass->bindGlobalDescriptorSet(commandBuffer, frameIndex);
+        submitDraws(commandBuffer, gbufferPass, DRAW_PASS_GBUFFER, frameIndex);
+    }
+    
+    /**
+     * @brief 为本 Pass 生成绘制包并按排序键排序（每个可绘制的实体一个包）
+     */
+    void buildDrawPackets(uint32_t passId) {
+        m_drawPackets.clear();
+        m_drawPackets.reserve(m_renderables.size());
         
-        for (const auto& renderable : m_renderables) {
+        for (uint32_t i = 0; i < m_renderables.size(); ++i) {
+            const RenderableEntity& renderable = m_renderables[i];
             if (!renderable.valid || !renderable.gpuMesh) continue;
+            if (renderable.useDrawRanges && renderable.drawRanges.empty()) continue;
+            
+            const GPUMesh& mesh = *renderable.gpuMesh;
+            DrawPacket packet;
+            packet.key = DrawSort::makeKey(passId, static_cast<uint32_t>(mesh.vertexFormat), renderable.material.index,
+                                           mesh.vertexRange.page, mesh.indexRange.page, renderable.mesh.index,
+                                           renderable.viewDepth);
+            packet.renderable = i;
+            m_drawPackets.push_back(packet);
+        }
+        
+        DrawSort::sort(m_drawPackets, m_sortScratch);
+    }
+    
+    /**
+     * @brief 绘制包 first 与 next 可以合并为一次实例化绘制：同一网格、同一材质、同一 LOD 级别
+     */
+    bool canInstance(const DrawPacket& first, const DrawPacket& next) const {
+        const RenderableEntity& a = m_renderables[first.renderable];
+        const RenderableEntity& b = m_renderables[next.renderable];
+        return a.gpuMesh == b.gpuMesh && a.material == b.material && a.lodLevel == b.lodLevel;
+    }
+    
+    /**
+     * @brief 两个实体的绘制状态相同：顶点格式（管线）、材质、顶点 / 索引缓冲区
+     */
+    static bool isSameDrawState(const RenderableEntity& a, const RenderableEntity& b) {
+        const GPUMesh& meshA = *a.gpuMesh;
+        const GPUMesh& meshB = *b.gpuMesh;
+        return meshA.vertexFormat == meshB.vertexFormat && a.material == b.material &&
+               meshA.getVertexBufferHandle() == meshB.getVertexBufferHandle() &&
+               meshA.getIndexBufferHandle() == meshB.getIndexBufferHandle();
+    }
+    
+    bool isGpuDrivenActive() const {
+        return m_gpuCulling && m_gpuDriven && m_hasCamera;
+    }
+    
+    /**
+     * @brief 本帧实例数据在段内的基准下标：各 Pass 的绘制包顺序相同（排序键中只有 Pass 字段不同），
+     * 第一个 CPU 提交的 Pass 写入一次，之后的 Pass 共用同一段数据
+     */
+    template<typename Pass>
+    uint32_t acquireInstanceData() {
+        static_assert(sizeof(typename Pass::InstanceData) == sizeof(ForwardPass::InstanceData),
+                      "Passes share one per-frame instance array; InstanceData layouts must match");
+        if (!m_instanceDataWritten) {
+            m_instanceBase = writeInstanceData<Pass>();
+            m_instanceDataWritten = true;
+        }
+        return m_instanceBase;
+    }
+    
+    /**
+     * @brief 把所有绘制包的实例数据写入本帧的 FrameAllocator 段（顺序与绘制包一致）
+     * @return 第一个绘制包的实例下标（相对本帧段起点，即着色器中 gl_InstanceIndex 的基准）；
+     *         段空间不足时返回 INVALID_SLOT（FrameAllocator 在下一帧扩容）
+     */
+    template<typename Pass>
+    uint32_t writeInstanceData() {
+        using InstanceData = typename Pass::InstanceData;
+        
+        // 按实例大小对齐，段内偏移可以整除为实例下标
+        FrameAllocator& frameAllocator = m_device->getFrameAllocator();
+        FrameAllocation allocation = frameAllocator.allocate(m_drawPackets.size() * sizeof(InstanceData),
+                                                             sizeof(InstanceData));
+        if (!allocation.isValid()) return INVALID_SLOT;
+        auto* instances = reinterpret_cast<InstanceData*>(allocation.mapped);
+        
+        for (const DrawPacket& packet : m_drawPackets) {
+            const RenderableEntity& renderable = m_renderables[packet.renderable];
+            const GPUMesh& mesh = *renderable.gpuMesh;
             
-            // 绑定材质描述符集（Set 1: 纹理）- 每个实体独立的描述符
-            if (renderable.gbufferMaterialDescriptor) {
-                gbufferPass->bindMaterialDescriptorSet(commandBuffer, frameIndex, renderable.gbufferMaterialDescriptor);
+            // 紧凑顶点格式：位置反量化矩阵并入 model，法线矩阵仍由原始 model 计算
+            instances->model = mesh.vertexFormat == VertexFormat::Compact
+                ? renderable.modelMatrix * mesh.dequantizeMatrix
+                : renderable.modelMatrix;
+            instances->normalMatrix = renderable.normalMatrix;
+            ++instances;
+        }
+        
+        const VkDeviceSize segmentOffset = allocation.offset - frameAllocator.getFrameOffset(frameAllocator.getCurrentFrame());
+        return static_cast<uint32_t>(segmentOffset / sizeof(InstanceData));
+    }
+    
+    /**
+     * @brief 已绑定的绘制状态（一个 Pass 内），调用方已绑定标准顶点格式管线
+     */
+    template<typename Pass>
+    struct BoundDrawState {
+        VertexFormat format = VertexFormat::Standard;
+        typename Pass::MaterialDescriptor* material = nullptr;
+        uint32_t materialIndex = INVALID_SLOT;
+        VkBuffer vertexBuffer = VK_NULL_HANDLE;
+        VkBuffer indexBuffer = VK_NULL_HANDLE;
+    };
+    
+    /**
+     * @brief 绑定实体的管线、材质与几何缓冲区，与上一次绑定相同时跳过
+     */
+    template<typename Pass>
+    void bindDrawState(VkCommandBuffer commandBuffer, Pass* pass, const RenderableEntity& renderable,
+                       bool bindless, uint32_t frameIndex, BoundDrawState<Pass>& bound) {
+        const GPUMesh& mesh = *renderable.gpuMesh;
+        DrawSubmitStats& stats = m_submitStats;
+        
+        if (mesh.vertexFormat != bound.format) {
+            bound.format = mesh.vertexFormat;
+            pass->bindPipeline(commandBuffer, bound.format);
+            ++stats.pipelineBinds;
+        } else {
+            ++stats.pipelineBindsSkipped;
+        }
+        
+        // 绑定材质：按材质句柄直接索引描述符集（Set 1: 纹理），bindless 模式下推送材质索引；
+        // 相邻的同材质绘制只绑定一次
+        if (bindless) {
+            if (renderable.materialIndex != bound.materialIndex) {
+                bound.materialIndex = renderable.materialIndex;
+                pass->pushMaterialIndex(commandBuffer, bound.materialIndex);
+                ++stats.descriptorBinds;
+            } else {
+                ++stats.descriptorBindsSkipped;
+            }
+        } else if (auto* material = pass->getMaterialDescriptor(renderable.material)) {
+            if (material != bound.material) {
+                refreshMaterialTextures(pass, material, renderable, frameIndex);
+                pass->bindMaterialDescriptorSet(commandBuffer, frameIndex, material);
+                bound.material = material;
+                ++stats.descriptorBinds;
+            } else {
+                ++stats.descriptorBindsSkipped;
             }
+        }
+        
+        // 网格位于共享几何缓冲区，只在页切换时重新绑定
+        if (mesh.getVertexBufferHandle() != bound.vertexBuffer) {
+            bound.vertexBuffer = mesh.getVertexBufferHandle();
+            pass->bindVertexBuffer(commandBuffer, bound.vertexBuffer);
+            ++stats.vertexBufferBinds;
+        } else {
+            ++stats.vertexBufferBindsSkipped;
+        }
+        if (mesh.getIndexBufferHandle() != bound.indexBuffer) {
+            bound.indexBuffer = mesh.getIndexBufferHandle();
+            pass->bindIndexBuffer(commandBuffer, bound.indexBuffer);
+            ++stats.indexBufferBinds;
+        } else {
+            ++stats.indexBufferBindsSkipped;
+        }
+    }
+    
+    /**
+     * @brief 按排序后的绘制包提交：
+     * 相邻的同网格、同材质、同 LOD 绘制合并为一次实例化绘制（逐实例矩阵每帧写入一次本帧的存储缓冲区，各 Pass 共用），
+     * 管线、材质描述符集、顶点 / 索引缓冲区与上一次绑定相同时跳过。
+     * 网格簇剔除的结果只用于不能合并的单个实体；合并的实例整网格绘制（完全被剔除的实体仍然跳过）
+     */
+    template<typename Pass>
+    void submitDraws(VkCommandBuffer commandBuffer, Pass* pass, uint32_t passId, uint32_t frameIndex) {
+        // 绑定全局描述符集（Set 0: UBO + 实例数据）- 只需绑定一次
+        pass->bindGlobalDescriptorSet(commandBuffer);
+        
+        // Bindless 模式：Set 1 在整个 Pass 中只绑定一次
+        const bool bindless = bindBindlessDescriptors(commandBuffer, pass, frameIndex);
+        
+        if (m_gpuCullRecorded) {
+            submitIndirectDraws(commandBuffer, pass, bindless, frameIndex);
+            return;
+        }
+        
+        buildDrawPackets(passId);
+        if (m_drawPackets.empty()) return;
+        
+        const uint32_t instanceBase = acquireInstanceData<Pass>();
+        if (instanceBase == INVALID_SLOT) return;
+        
+        // 调用方已绑定标准顶点格式管线，遇到不同格式的网格时切换
+        BoundDrawState<Pass> bound;
+        DrawSubmitStats& stats = m_submitStats;
+        
+        const uint32_t packetCount = static_cast<uint32_t>(m_drawPackets.size());
+        for (uint32_t first = 0, end = 0; first < packetCount; first = end) {
+            end = first + 1;
+            while (end < packetCount && canInstance(m_drawPackets[first], m_drawPackets[end])) {
+                ++end;
+            }
+            const uint32_t instanceCount = end - first;
             
-            // 推送模型矩阵（Push Constants）
-            gbufferPass->pushModelMatrix(commandBuffer, renderable.modelMatrix);
+            const RenderableEntity& renderable = m_renderables[m_drawPackets[first].renderable];
+            const GPUMesh& mesh = *renderable.gpuMesh;
             
-            // 绘制网格
-            gbufferPass->drawMesh(
-                commandBuffer,
-                renderable.gpuMesh->getVertexBufferHandle(),
-                renderable.gpuMesh->getIndexBufferHandle(),
-                renderable.gpuMesh->getIndexCount()
-            );
+            bindDrawState(commandBuffer, pass, renderable, bindless, frameIndex, bound);
+            
+            // 绘制网格：LOD 区间对同一级别的所有实例相同；簇剔除区间只在单个实体时使用
+            const uint32_t firstInstance = instanceBase + first;
+            const bool useDrawRanges = renderable.useDrawRanges && (instanceCount == 1 || renderable.lodLevel > 0);
+            if (useDrawRanges) {
+                for (const MeshDrawRange& range : renderable.drawRanges) {
+                    pass->drawIndexed(commandBuffer, range.indexCount, mesh.getFirstIndex() + range.firstIndex,
+                                      mesh.getVertexOffset(), instanceCount, firstInstance);
+                }
+                stats.draws += static_cast<uint32_t>(renderable.drawRanges.size());
+            } else {
+                pass->drawIndexed(commandBuffer, mesh.getIndexCount(), mesh.getFirstIndex(), mesh.getVertexOffset(),
+                                  instanceCount, firstInstance);
+                ++stats.draws;
+            }
+            stats.instances += instanceCount;
+            if (instanceCount > 1) {
+                ++stats.instancedDraws;
+            }
+        }
+    }
+    
+    /**
+     * @brief GPU 驱动路径：按 recordGpuCulling 生成的状态组提交，每组绑定一次状态后间接绘制，
+     * 实例数（以及支持 draw indirect count 时的绘制数量）由本帧的剔除调度写入
+     */
+    template<typename Pass>
+    void submitIndirectDraws(VkCommandBuffer commandBuffer, Pass* pass, bool bindless, uint32_t frameIndex) {
+        BoundDrawState<Pass> bound;
+        DrawSubmitStats& stats = m_submitStats;
+        
+        for (uint32_t group = 0; group < m_gpuGroups.size(); ++group) {
+            bindDrawState(commandBuffer, pass, m_renderables[m_gpuGroups[group]], bindless, frameIndex, bound);
+            m_gpuCulling->drawGroup(commandBuffer, group);
+            ++stats.draws;
         }
+        stats.instances += m_gpuCulling->getObjectCount();
+        stats.indirectDraws += m_gpuCulling->getBatchCount();
     }
     
 public:
@@ -368,16 +1253,17 @@ public:
     }
     
     /**
-     * @brief 获取 Draw Call 数量
+     * @brief 获取本帧已提交的 Draw Call 数量（实例化合并之后，所有 Pass 累计）
      */
     uint32_t getDrawCallCount() const {
-        uint32_t count = 0;
-        for (const auto& renderable : m_renderables) {
-            if (renderable.valid && renderable.gpuMesh) {
-                count++;
-            }
-        }
-        return count;
+        return m_submitStats.draws;
+    }
+    
+    /**
+     * @brief 本帧绘制提交统计（所有 Pass 累计，包括排序后省去的重复绑定）
+     */
+    const DrawSubmitStats& getDrawSubmitStats() const {
+        return m_submitStats;
     }
     
     /**
@@ -391,19 +1277,25 @@ public:
      * @brief 获取指定实体的 GPUMesh（用于射线检测）
      */
     std::shared_ptr<GPUMesh> getEntityMesh(entt::entity entity) const {
-        for (const auto& renderable : m_renderables) {
-            if (renderable.entityHandle == entity) {
-                return renderable.gpuMesh;
-            }
-        }
-        return nullptr;
+        const uint32_t slot = getRenderableSlot(entity);
+        return slot != INVALID_SLOT ? m_renderables[slot].gpuMesh : nullptr;
     }
     
     /**
      * @brief 清理资源
      */
     void cleanup() {
+        detachRegistry();
         m_renderables.clear();
+        m_renderableSlots.clear();
+        m_dirtyFlags.clear();
+        m_dirtyOwners.clear();
+        m_dirtyEntities.clear();
+        m_passGenerations.clear();
+        m_bindlessMaterials.clear();
+        m_gpuGroups.clear();
+        m_gpuCulling.reset();
+        MaterialManager::getInstance().cleanup();
         MeshManager::getInstance().cleanup();
         TextureManager::getInstance().cleanup();
         std::cout << "[RenderSystem] Cleaned up" << std::endl;
@@ -411,7 +1303,47 @@ public:
     
 private:
     std::shared_ptr<VulkanDevice> m_device;
+    
+    // 可渲染实体缓存：稠密数组 + 按实体索引的槽位表
     std::vector<RenderableEntity> m_renderables;
+    std::vector<uint32_t> m_renderableSlots;          // entt::to_entity(entity) -> m_renderables 下标
+    entt::registry* m_registry = nullptr;             // 已连接信号的 registry
+    
+    // 脏标记（按实体索引），m_dirtyEntities 为待处理列表
+    std::vector<uint8_t> m_dirtyFlags;
+    std::vector<entt::entity> m_dirtyOwners;
+    std::vector<entt::entity> m_dirtyEntities;
+    
+    // 上一帧的 Pass 集合及其资源代数
+    std::vector<std::pair<RenderPassBase*, uint64_t>> m_passGenerations;
+    std::vector<uint32_t> m_bindlessMaterials;  // MaterialHandle::index -> bindless 材质索引
+    
+    // 绘制排序（跨帧复用）与提交统计
+    std::vector<DrawPacket> m_drawPackets;
+    std::vector<DrawPacket> m_sortScratch;
+    DrawSubmitStats m_submitStats;
+    
+    // 网格簇剔除
+    Frustum m_frustum{};
+    glm::vec3 m_cameraPosition = glm::vec3(0.0f);
+    bool m_hasCamera = false;
+    bool m_clusterCulling = true;
+    ClusterCullStats m_clusterStats;
+    
+    // LOD 选择
+    float m_projectionScale = 1.0f;      // 单位距离处 1 个世界单位对应的像素数
+    float m_lodErrorThreshold = 1.0f;    // 像素
+    bool m_lodEnabled = true;
+    
+    // GPU 驱动渲染（设备不支持时为空）
+    std::unique_ptr<GpuCulling> m_gpuCulling;
+    std::vector<uint32_t> m_gpuGroups;   // 每个状态组的代表实体（m_renderables 下标）
+    bool m_gpuDriven = true;
+    bool m_gpuCullRecorded = false;      // 本帧已录制剔除，各 Pass 使用间接绘制
+    
+    // 本帧 CPU 提交的实例数据（各 Pass 共用，updateRenderables 时失效）
+    uint32_t m_instanceBase = INVALID_SLOT;
+    bool m_instanceDataWritten = false;
 };
 
 } // namespace VulkanEngine
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace VulkanEngine {
+
+/**
+ * @brief 代数化资源句柄：index 为资源表中的槽位，generation 在槽位释放时递增，
+ * 槽位被复用后旧句柄不再有效。默认构造的句柄无效（空路径等同于默认资源）
+ */
+template<typename Tag>
+struct ResourceHandle {
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool isValid() const { return index != INVALID_INDEX; }
+
+    bool operator==(const ResourceHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const ResourceHandle& other) const { return !(*this == other); }
+};
+
+struct MeshHandleTag;
+struct TextureHandleTag;
+struct MaterialHandleTag;
+
+using MeshHandle = ResourceHandle<MeshHandleTag>;
+using TextureHandle = ResourceHandle<TextureHandleTag>;
+using MaterialHandle = ResourceHandle<MaterialHandleTag>;
+
+/**
+ * @brief 句柄表：槽位数组 + 空闲链表，按句柄取值为一次数组访问和代数比较。
+ * 释放的槽位递增代数后复用；clear 释放全部槽位但保留代数，清空前发出的句柄不会误命中新资源
+ */
+template<typename Tag, typename T>
+class HandlePool {
+public:
+    using Handle = ResourceHandle<Tag>;
+
+    Handle add(T value) {
+        uint32_t index;
+        if (!m_freeSlots.empty()) {
+            index = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            index = static_cast<uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+        Slot& slot = m_slots[index];
+        slot.value = std::move(value);
+        slot.alive = true;
+        ++m_size;
+        return Handle{ index, slot.generation };
+    }
+
+    void remove(Handle handle) {
+        if (!contains(handle)) return;
+        Slot& slot = m_slots[handle.index];
+        slot.value = T();
+        slot.alive = false;
+        ++slot.generation;
+        m_freeSlots.push_back(handle.index);
+        --m_size;
+    }
+
+    bool contains(Handle handle) const {
+        return handle.index < m_slots.size() && m_slots[handle.index].alive &&
+               m_slots[handle.index].generation == handle.generation;
+    }
+
+    T* get(Handle handle) {
+        return contains(handle) ? &m_slots[handle.index].value : nullptr;
+    }
+
+    const T* get(Handle handle) const {
+        return contains(handle) ? &m_slots[handle.index].value : nullptr;
+    }
+
+    void clear() {
+        for (uint32_t i = 0; i < m_slots.size(); ++i) {
+            if (m_slots[i].alive) {
+                remove(Handle{ i, m_slots[i].generation });
+            }
+        }
+    }
+
+    // 槽位数（含空闲），按句柄 index 建立的旁路数组以此为上限
+    uint32_t getCapacity() const { return static_cast<uint32_t>(m_slots.size()); }
+    uint32_t size() const { return m_size; }
+
+private:
+    struct Slot {
+        T value{};
+        uint32_t generation = 1;
+        bool alive = false;
+    };
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+    uint32_t m_size = 0;
+};
+
+} // namespace VulkanEngine
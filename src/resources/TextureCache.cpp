@@ -0,0 +1,558 @@
+#include "TextureCache.h"
+#include "BlockCompressor.h"
+#include "MappedFile.h"
+#include "MeshCache.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+
+namespace VulkanEngine {
+
+namespace {
+
+const uint8_t KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+const char SOURCE_KEY[] = "VEngine.source";
+constexpr size_t LEVEL_ALIGNMENT = 16;
+
+struct Ktx2Header {
+    uint8_t identifier[12];
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+static_assert(sizeof(Ktx2Header) == 80, "KTX2 header must be 80 bytes");
+
+struct Ktx2LevelIndex {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+static_assert(sizeof(Ktx2LevelIndex) == 24, "KTX2 level index entry must be 24 bytes");
+
+// 键值数据 "VEngine.source" 的值
+struct SourceRecord {
+    uint32_t version;
+    uint32_t usage;
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    uint64_t sourceHash;
+};
+static_assert(sizeof(SourceRecord) == 32, "SourceRecord layout changed, bump FORMAT_VERSION");
+
+struct SourceStamp {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+};
+
+bool statSource(const std::string& path, SourceStamp& stamp) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    auto time = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+
+    stamp.size = static_cast<uint64_t>(size);
+    stamp.mtime = static_cast<int64_t>(time.time_since_epoch().count());
+    return true;
+}
+
+bool hashSource(const std::string& path, uint64_t& hash) {
+    MappedFile source(path);
+    if (!source.isOpen()) return false;
+    hash = MeshCache::hashBytes(source.getData(), source.getSize());
+    return true;
+}
+
+size_t getBlockSize(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+            return BlockCompressor::BC7_BLOCK_SIZE;
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+            return BlockCompressor::BC5_BLOCK_SIZE;
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+            return BlockCompressor::BC4_BLOCK_SIZE;
+        default:
+            return 0;
+    }
+}
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// 块压缩格式的基本数据格式描述符（KHR_DF_MODEL_BC4/BC5/BC7，4x4 块）
+std::vector<uint8_t> buildDataFormatDescriptor(VkFormat format) {
+    struct Sample {
+        uint16_t bitOffset;
+        uint8_t bitLength;
+        uint8_t channel;
+    };
+
+    uint8_t colorModel = 0;
+    std::vector<Sample> samples;
+    switch (format) {
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+            colorModel = 134;
+            samples = { { 0, 127, 0 } };
+            break;
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+            colorModel = 132;
+            samples = { { 0, 63, 0 }, { 64, 63, 1 } };
+            break;
+        default:
+            colorModel = 131;
+            samples = { { 0, 63, 0 } };
+            break;
+    }
+
+    const uint32_t blockSize = 24 + 16 * static_cast<uint32_t>(samples.size());
+    std::vector<uint8_t> dfd(4 + blockSize, 0);
+    auto put32 = [&](size_t offset, uint32_t value) { std::memcpy(dfd.data() + offset, &value, 4); };
+    auto put16 = [&](size_t offset, uint16_t value) { std::memcpy(dfd.data() + offset, &value, 2); };
+
+    put32(0, static_cast<uint32_t>(dfd.size()));
+    put32(4, 0);                                        // vendorId = Khronos, descriptorType = basic
+    put16(8, 2);                                        // versionNumber
+    put16(10, static_cast<uint16_t>(blockSize));
+    dfd[12] = colorModel;
+    dfd[13] = 1;                                        // BT.709 原色
+    dfd[14] = format == VK_FORMAT_BC7_SRGB_BLOCK ? 2 : 1;   // sRGB / 线性传输函数
+    dfd[15] = 0;                                        // 非预乘 alpha
+    dfd[16] = 3;                                        // 块尺寸 4x4（存储为尺寸 - 1）
+    dfd[17] = 3;
+    dfd[20] = static_cast<uint8_t>(getBlockSize(format));
+
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const size_t offset = 28 + i * 16;
+        put16(offset, samples[i].bitOffset);
+        dfd[offset + 2] = samples[i].bitLength;
+        dfd[offset + 3] = samples[i].channel;
+        put32(offset + 8, 0);
+        put32(offset + 12, 0xFFFFFFFFu);
+    }
+    return dfd;
+}
+
+// 在键值数据中查找 SOURCE_KEY，返回值在文件中的偏移（0 表示未找到）
+size_t findSourceRecord(const uint8_t* data, size_t fileSize, const Ktx2Header& header) {
+    if (header.kvdByteLength == 0 ||
+        static_cast<uint64_t>(header.kvdByteOffset) + header.kvdByteLength > fileSize) {
+        return 0;
+    }
+
+    size_t cursor = header.kvdByteOffset;
+    const size_t end = header.kvdByteOffset + header.kvdByteLength;
+    const size_t keyLength = sizeof(SOURCE_KEY);   // 含结尾 '\0'
+    while (cursor + 4 <= end) {
+        uint32_t length;
+        std::memcpy(&length, data + cursor, 4);
+        const size_t entry = cursor + 4;
+        if (length > end - entry) {
+            return 0;
+        }
+        if (length == keyLength + sizeof(SourceRecord) && std::memcmp(data + entry, SOURCE_KEY, keyLength) == 0) {
+            return entry + keyLength;
+        }
+        cursor = alignUp(entry + length, 4);
+    }
+    return 0;
+}
+
+// 法线贴图各 mip 级别重新归一化（盒式滤波后长度会变短，BC5 重建 Z 依赖单位长度）
+void renormalizeNormals(uint8_t* pixels, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; ++i) {
+        uint8_t* p = pixels + i * 4;
+        float x = p[0] / 127.5f - 1.0f;
+        float y = p[1] / 127.5f - 1.0f;
+        float z = p[2] / 127.5f - 1.0f;
+        float length = std::sqrt(x * x + y * y + z * z);
+        if (length < 1e-4f) continue;
+        p[0] = static_cast<uint8_t>(std::lround((x / length + 1.0f) * 127.5f));
+        p[1] = static_cast<uint8_t>(std::lround((y / length + 1.0f) * 127.5f));
+        p[2] = static_cast<uint8_t>(std::lround((z / length + 1.0f) * 127.5f));
+    }
+}
+
+// glTF metallicRoughness 贴图（B: 金属度, G: 粗糙度）重排为 R: 金属度, G: 粗糙度, B: 0, A: 0
+// A = 0 供着色器区分打包贴图与单通道遮罩（遮罩视图和白色占位纹理的 A 均为 1）
+void packMetallicRoughness(uint8_t* pixels, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; ++i) {
+        uint8_t* p = pixels + i * 4;
+        p[0] = p[2];
+        p[2] = 0;
+        p[3] = 0;
+    }
+}
+
+} // namespace
+
+std::string TextureCache::getCachePath(const std::string& sourcePath, TextureUsage usage) {
+    switch (usage) {
+        case TextureUsage::Normal: return sourcePath + ".bc5.ktx2";
+        case TextureUsage::Mask:   return sourcePath + ".bc4.ktx2";
+        case TextureUsage::MetallicRoughness: return sourcePath + ".mr.bc7.ktx2";
+        default:                   return sourcePath + ".bc7.ktx2";
+    }
+}
+
+VkFormat TextureCache::getCompressedFormat(TextureUsage usage) {
+    switch (usage) {
+        case TextureUsage::Normal: return VK_FORMAT_BC5_UNORM_BLOCK;
+        case TextureUsage::Mask:   return VK_FORMAT_BC4_UNORM_BLOCK;
+        case TextureUsage::MetallicRoughness: return VK_FORMAT_BC7_UNORM_BLOCK;
+        default:                   return VK_FORMAT_BC7_SRGB_BLOCK;
+    }
+}
+
+VkFormat TextureCache::getUncompressedFormat(TextureUsage usage) {
+    return usage == TextureUsage::Color ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+}
+
+TextureUsage TextureCache::guessUsage(const std::string& path) {
+    std::string name = std::filesystem::path(path).filename().string();
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+
+    for (const char* hint : { "normal", "nmap", "nrm" }) {
+        if (name.find(hint) != std::string::npos) return TextureUsage::Normal;
+    }
+    for (const char* hint : { "metal", "spec", "rough", "mask", "_ao" }) {
+        if (name.find(hint) != std::string::npos) return TextureUsage::Mask;
+    }
+    return TextureUsage::Color;
+}
+
+const char* TextureCache::getUsageName(TextureUsage usage) {
+    switch (usage) {
+        case TextureUsage::Normal: return "normal";
+        case TextureUsage::Mask:   return "mask";
+        case TextureUsage::MetallicRoughness: return "metallicRoughness";
+        default:                   return "color";
+    }
+}
+
+bool TextureCache::load(const std::string& sourcePath, TextureUsage usage, CookedTexture& texture) {
+    const std::string cachePath = getCachePath(sourcePath, usage);
+
+    MappedFile cache(cachePath);
+    if (!cache.isOpen() || cache.getSize() < sizeof(Ktx2Header)) {
+        return false;
+    }
+    const uint8_t* data = cache.getData();
+    const size_t fileSize = cache.getSize();
+
+    Ktx2Header header;
+    std::memcpy(&header, data, sizeof(header));
+
+    const VkFormat format = getCompressedFormat(usage);
+    if (std::memcmp(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0 ||
+        header.vkFormat != static_cast<uint32_t>(format) ||
+        header.typeSize != 1 || header.pixelWidth == 0 || header.pixelHeight == 0 || header.pixelDepth != 0 ||
+        header.layerCount > 1 || header.faceCount != 1 || header.supercompressionScheme != 0 ||
+        header.levelCount == 0 ||
+        header.levelCount > MipmapGenerator::getMipLevelCount(header.pixelWidth, header.pixelHeight)) {
+        std::cout << "[TextureCache] Unsupported or stale cache, rebuilding: " << cachePath << std::endl;
+        return false;
+    }
+
+    const size_t recordOffset = findSourceRecord(data, fileSize, header);
+    if (recordOffset == 0) {
+        std::cout << "[TextureCache] Cache without source record, rebuilding: " << cachePath << std::endl;
+        return false;
+    }
+    SourceRecord record;
+    std::memcpy(&record, data + recordOffset, sizeof(record));
+    if (record.version != FORMAT_VERSION || record.usage != static_cast<uint32_t>(usage)) {
+        std::cout << "[TextureCache] Stale cache, rebuilding: " << cachePath << std::endl;
+        return false;
+    }
+
+    // 源文件存在时校验；不存在时直接使用烘焙结果
+    bool refreshStamp = false;
+    SourceStamp stamp;
+    if (statSource(sourcePath, stamp)) {
+        if (record.sourceSize != stamp.size) {
+            std::cout << "[TextureCache] Source modified, rebuilding: " << cachePath << std::endl;
+            return false;
+        }
+        if (record.sourceMtime != stamp.mtime) {
+            uint64_t sourceHash = 0;
+            if (!hashSource(sourcePath, sourceHash) || sourceHash != record.sourceHash) {
+                std::cout << "[TextureCache] Source modified, rebuilding: " << cachePath << std::endl;
+                return false;
+            }
+            refreshStamp = true;
+        }
+    }
+
+    const uint64_t levelIndexEnd = sizeof(Ktx2Header) + static_cast<uint64_t>(header.levelCount) * sizeof(Ktx2LevelIndex);
+    if (levelIndexEnd > fileSize) {
+        std::cerr << "[TextureCache] Corrupted cache file: " << cachePath << std::endl;
+        return false;
+    }
+
+    const size_t blockSize = getBlockSize(format);
+    std::vector<MipLevel> levels(header.levelCount);
+    std::vector<Ktx2LevelIndex> levelIndex(header.levelCount);
+    std::memcpy(levelIndex.data(), data + sizeof(Ktx2Header), levelIndex.size() * sizeof(Ktx2LevelIndex));
+
+    size_t total = 0;
+    uint32_t levelWidth = header.pixelWidth;
+    uint32_t levelHeight = header.pixelHeight;
+    for (uint32_t i = 0; i < header.levelCount; ++i) {
+        const size_t expected = BlockCompressor::getCompressedSize(levelWidth, levelHeight, blockSize);
+        if (levelIndex[i].byteLength != expected || levelIndex[i].byteOffset > fileSize ||
+            levelIndex[i].byteLength > fileSize - levelIndex[i].byteOffset) {
+            std::cerr << "[TextureCache] Corrupted level " << i << " in cache file: " << cachePath << std::endl;
+            return false;
+        }
+        levels[i].width = levelWidth;
+        levels[i].height = levelHeight;
+        levels[i].offset = total;
+        levels[i].size = expected;
+        total += expected;
+        levelWidth = std::max(1u, levelWidth / 2);
+        levelHeight = std::max(1u, levelHeight / 2);
+    }
+
+    texture.format = format;
+    texture.width = header.pixelWidth;
+    texture.height = header.pixelHeight;
+    texture.data.resize(total);
+    for (uint32_t i = 0; i < header.levelCount; ++i) {
+        std::memcpy(texture.data.data() + levels[i].offset, data + levelIndex[i].byteOffset, levels[i].size);
+    }
+    texture.levels = std::move(levels);
+
+    cache.close();
+
+    if (refreshStamp) {
+        std::fstream file(cachePath, std::ios::in | std::ios::out | std::ios::binary);
+        if (file) {
+            file.seekp(static_cast<std::streamoff>(recordOffset + offsetof(SourceRecord, sourceMtime)));
+            file.write(reinterpret_cast<const char*>(&stamp.mtime), sizeof(stamp.mtime));
+        }
+    }
+
+    return true;
+}
+
+bool TextureCache::cook(const std::string& sourcePath, TextureUsage usage, CookedTexture& texture) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    int width = 0, height = 0, channels = 0;
+    stbi_uc* pixels = stbi_load(sourcePath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    if (!pixels) {
+        std::cerr << "[TextureCache] Failed to decode: " << sourcePath << std::endl;
+        return false;
+    }
+    if (usage == TextureUsage::MetallicRoughness) {
+        packMetallicRoughness(pixels, static_cast<size_t>(width) * height);
+    }
+
+    std::vector<uint8_t> mips;
+    std::vector<MipLevel> sourceLevels = MipmapGenerator::generate(
+        pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height), usage == TextureUsage::Color, mips);
+    stbi_image_free(pixels);
+
+    const VkFormat format = getCompressedFormat(usage);
+    const size_t blockSize = getBlockSize(format);
+
+    texture.format = format;
+    texture.width = static_cast<uint32_t>(width);
+    texture.height = static_cast<uint32_t>(height);
+    texture.levels.resize(sourceLevels.size());
+
+    size_t total = 0;
+    for (size_t i = 0; i < sourceLevels.size(); ++i) {
+        texture.levels[i].width = sourceLevels[i].width;
+        texture.levels[i].height = sourceLevels[i].height;
+        texture.levels[i].offset = total;
+        texture.levels[i].size = BlockCompressor::getCompressedSize(sourceLevels[i].width, sourceLevels[i].height, blockSize);
+        total += texture.levels[i].size;
+    }
+    texture.data.resize(total);
+
+    for (size_t i = 0; i < sourceLevels.size(); ++i) {
+        uint8_t* level = mips.data() + sourceLevels[i].offset;
+        const uint32_t levelWidth = sourceLevels[i].width;
+        const uint32_t levelHeight = sourceLevels[i].height;
+        uint8_t* out = texture.data.data() + texture.levels[i].offset;
+
+        switch (usage) {
+            case TextureUsage::Normal:
+                if (i > 0) renormalizeNormals(level, static_cast<size_t>(levelWidth) * levelHeight);
+                BlockCompressor::encodeBC5(level, levelWidth, levelHeight, out);
+                break;
+            case TextureUsage::Mask:
+                BlockCompressor::encodeBC4(level, levelWidth, levelHeight, out);
+                break;
+            default:
+                BlockCompressor::encodeBC7(level, levelWidth, levelHeight, out);
+                break;
+        }
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    std::cout << "[TextureCache] Cooked " << sourcePath << " (" << width << "x" << height << ", "
+              << texture.levels.size() << " mips, " << getUsageName(usage) << ") in " << duration.count() << "ms"
+              << std::endl;
+    return true;
+}
+
+bool TextureCache::decode(const std::string& sourcePath, TextureUsage usage, bool generateMips, CookedTexture& texture) {
+    int width = 0, height = 0, channels = 0;
+    stbi_uc* pixels = stbi_load(sourcePath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    if (!pixels) {
+        std::cerr << "[TextureCache] Failed to decode: " << sourcePath << std::endl;
+        return false;
+    }
+    if (usage == TextureUsage::MetallicRoughness) {
+        packMetallicRoughness(pixels, static_cast<size_t>(width) * height);
+    }
+
+    texture.format = getUncompressedFormat(usage);
+    texture.width = static_cast<uint32_t>(width);
+    texture.height = static_cast<uint32_t>(height);
+    texture.data.clear();
+    texture.levels.clear();
+
+    if (generateMips) {
+        texture.levels = MipmapGenerator::generate(pixels, texture.width, texture.height,
+                                                   usage == TextureUsage::Color, texture.data);
+    } else {
+        MipLevel base;
+        base.width = texture.width;
+        base.height = texture.height;
+        base.size = static_cast<size_t>(width) * height * 4;
+        texture.levels.push_back(base);
+        texture.data.assign(pixels, pixels + base.size);
+    }
+    stbi_image_free(pixels);
+    return true;
+}
+
+bool TextureCache::save(const std::string& sourcePath, TextureUsage usage, const CookedTexture& texture) {
+    if (texture.levels.empty() || texture.data.empty()) {
+        return false;
+    }
+
+    SourceStamp stamp;
+    uint64_t sourceHash = 0;
+    if (!statSource(sourcePath, stamp) || !hashSource(sourcePath, sourceHash)) {
+        return false;
+    }
+
+    SourceRecord record{};
+    record.version = FORMAT_VERSION;
+    record.usage = static_cast<uint32_t>(usage);
+    record.sourceSize = stamp.size;
+    record.sourceMtime = stamp.mtime;
+    record.sourceHash = sourceHash;
+
+    const std::vector<uint8_t> dfd = buildDataFormatDescriptor(texture.format);
+
+    std::vector<uint8_t> kvd(4 + sizeof(SOURCE_KEY) + sizeof(SourceRecord));
+    const uint32_t kvLength = static_cast<uint32_t>(kvd.size() - 4);
+    std::memcpy(kvd.data(), &kvLength, 4);
+    std::memcpy(kvd.data() + 4, SOURCE_KEY, sizeof(SOURCE_KEY));
+    std::memcpy(kvd.data() + 4 + sizeof(SOURCE_KEY), &record, sizeof(record));
+    kvd.resize(alignUp(kvd.size(), 4), 0);
+
+    const uint32_t levelCount = static_cast<uint32_t>(texture.levels.size());
+    Ktx2Header header{};
+    std::memcpy(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER));
+    header.vkFormat = static_cast<uint32_t>(texture.format);
+    header.typeSize = 1;
+    header.pixelWidth = texture.width;
+    header.pixelHeight = texture.height;
+    header.faceCount = 1;
+    header.levelCount = levelCount;
+    header.dfdByteOffset = static_cast<uint32_t>(sizeof(Ktx2Header) + levelCount * sizeof(Ktx2LevelIndex));
+    header.dfdByteLength = static_cast<uint32_t>(dfd.size());
+    header.kvdByteOffset = header.dfdByteOffset + header.dfdByteLength;
+    header.kvdByteLength = static_cast<uint32_t>(kvd.size());
+
+    // mip 数据按从最小级别到 LOD0 的顺序存放
+    std::vector<Ktx2LevelIndex> levelIndex(levelCount);
+    size_t offset = header.kvdByteOffset + header.kvdByteLength;
+    for (uint32_t i = levelCount; i-- > 0;) {
+        offset = alignUp(offset, LEVEL_ALIGNMENT);
+        levelIndex[i].byteOffset = offset;
+        levelIndex[i].byteLength = texture.levels[i].size;
+        levelIndex[i].uncompressedByteLength = texture.levels[i].size;
+        offset += texture.levels[i].size;
+    }
+
+    const std::string cachePath = getCachePath(sourcePath, usage);
+    const std::string tempPath = cachePath + ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "[TextureCache] Cannot write cache file: " << tempPath << std::endl;
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(levelIndex.data()), levelIndex.size() * sizeof(Ktx2LevelIndex));
+        file.write(reinterpret_cast<const char*>(dfd.data()), dfd.size());
+        file.write(reinterpret_cast<const char*>(kvd.data()), kvd.size());
+
+        const char padding[LEVEL_ALIGNMENT] = {};
+        size_t written = header.kvdByteOffset + header.kvdByteLength;
+        for (uint32_t i = levelCount; i-- > 0;) {
+            file.write(padding, static_cast<std::streamsize>(levelIndex[i].byteOffset - written));
+            file.write(reinterpret_cast<const char*>(texture.data.data() + texture.levels[i].offset),
+                       static_cast<std::streamsize>(texture.levels[i].size));
+            written = levelIndex[i].byteOffset + texture.levels[i].size;
+        }
+
+        if (!file) {
+            std::cerr << "[TextureCache] Failed writing cache file: " << tempPath << std::endl;
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec) {
+        std::cerr << "[TextureCache] Failed to replace cache file: " << cachePath
+                  << " (" << ec.message() << ")" << std::endl;
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    std::cout << "[TextureCache] Wrote " << cachePath << " (" << offset / 1024 << " KB)" << std::endl;
+    return true;
+}
+
+} // namespace VulkanEngine
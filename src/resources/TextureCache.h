@@ -0,0 +1,91 @@
+#pragma once
+
+#include "MipmapGenerator.h"
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VulkanEngine {
+
+/**
+ * @brief 纹理用途，决定压缩格式和颜色空间
+ */
+enum class TextureUsage {
+    Color,    // 颜色贴图：BC7 sRGB（RGBA）
+    Normal,   // 法线贴图：BC5 UNORM（RG，Z 在着色器中重建）
+    Mask,     // 单通道遮罩（金属度/高光）：BC4 UNORM（R，视图中复制到 RGB）
+    MetallicRoughness  // glTF 金属度/粗糙度（B/G）：烘焙时重排为 R: 金属度, G: 粗糙度, A: 0，BC7 UNORM
+};
+
+/**
+ * @brief 烘焙后的纹理：所有 mip 级别按 LOD0 起依次紧密排列在 data 中
+ */
+struct CookedTexture {
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<MipLevel> levels;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * @brief 块压缩纹理缓存（KTX2）
+ *
+ * 首次加载源图片（.png、.jpg 等）时在 CPU 上解码、生成完整 mip 链并按用途编码为
+ * BC7/BC5/BC4，写入源文件旁边的 "<source>.<bc7|bc5|bc4|mr.bc7>.ktx2"；之后的加载通过内存映射
+ * 读取 KTX2，直接上传压缩数据，不再解码 JPEG/PNG。烘焙过程不依赖 GPU，可在无显示的
+ * 构建机上通过 "V-Engine --cook" 预先完成。
+ *
+ * KTX2 文件：无超压缩，带基本数据格式描述符（DFD），mip 数据按从小到大的顺序存放并按
+ * 16 字节对齐。源文件状态记录在键值数据 "VEngine.source" 中，失效条件与 MeshCache 相同：
+ *   - 格式版本或用途变化
+ *   - 源文件大小变化；修改时间变化且内容哈希也不同
+ * 源文件不存在时直接使用缓存（只发布烘焙结果的情况）。
+ */
+class TextureCache {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    /**
+     * @brief 获取源文件在指定用途下的缓存文件路径
+     */
+    static std::string getCachePath(const std::string& sourcePath, TextureUsage usage);
+
+    /**
+     * @brief 用途对应的块压缩格式 / 未压缩回退格式
+     */
+    static VkFormat getCompressedFormat(TextureUsage usage);
+    static VkFormat getUncompressedFormat(TextureUsage usage);
+
+    /**
+     * @brief 按文件名推断用途（含 normal/nmap/nrm 视为法线，metal/spec/rough/mask/ao 视为遮罩）
+     */
+    static TextureUsage guessUsage(const std::string& path);
+
+    static const char* getUsageName(TextureUsage usage);
+
+    /**
+     * @brief 从缓存加载烘焙后的纹理
+     * @return 缓存有效且加载成功返回 true
+     */
+    static bool load(const std::string& sourcePath, TextureUsage usage, CookedTexture& texture);
+
+    /**
+     * @brief 解码源图片、生成 mip 链并压缩（不写缓存，由调用方决定是否 save）
+     */
+    static bool cook(const std::string& sourcePath, TextureUsage usage, CookedTexture& texture);
+
+    /**
+     * @brief 解码源图片为未压缩 RGBA8（getUncompressedFormat）
+     * @param generateMips true 时在 CPU 上生成完整 mip 链，否则只输出 LOD0（由 GPU blit 生成其余级别）
+     */
+    static bool decode(const std::string& sourcePath, TextureUsage usage, bool generateMips, CookedTexture& texture);
+
+    /**
+     * @brief 将烘焙结果写入 KTX2 缓存（先写临时文件再重命名）
+     */
+    static bool save(const std::string& sourcePath, TextureUsage usage, const CookedTexture& texture);
+};
+
+} // namespace VulkanEngine
@@ -2,9 +2,22 @@
 
 #include "VulkanTexture.h"
 #include "VulkanDevice.h"
+#include "TextureCache.h"
+#include "TextureResidency.h"
+#include "BindlessDescriptors.h"
+#include "ResourceHandle.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <future>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 #include <iostream>
 
 namespace VulkanEngine {
@@ -13,6 +26,21 @@ namespace VulkanEngine {
  * @brief 纹理资源管理器
  * 负责加载、缓存和管理所有纹理资源
  * 单例模式，全局访问
+ *
+ * 设备支持 BC 纹理压缩时优先加载烘焙好的 KTX2（见 TextureCache），缺失或过期时
+ * 在加载时烘焙一次；不支持时解码源图片并上传 RGBA8
+ *
+ * 两种加载方式：
+ * - getTexture：同步加载，返回时纹理已驻留
+ * - requestTexture / preloadTextures：读取、解码和烘焙在共享线程池上执行，主线程每帧调用
+ *   processPendingLoads 把已解码的纹理记录进 UploadManager 的当前批次（与缓冲区上传共用暂存环、
+ *   命令缓冲区和栅栏），批次完成后纹理才进入缓存；在此之前 requestTexture 返回默认纹理
+ *
+ * 纹理流式加载：RenderSystem 每帧通过 markTextureUsed 报告纹理的屏幕尺寸，updateResidency
+ * 由 TextureResidency 按显存预算和 LRU 决定每个纹理驻留的 mip 级别；级别变化时在后台重新读取
+ * 所需级别、上传到新图像，完成后与原纹理交换资源（VulkanTexture 对象不变，描述符按版本重写），
+ * 旧资源在 RETIRE_DELAY_FRAMES 帧后释放
+ * 除 CPU 阶段任务外，所有成员只在主线程访问
  */
 class TextureManager {
 public:
@@ -32,35 +60,338 @@ public:
     void init(std::shared_ptr<VulkanDevice> device) {
         m_device = device;
         createDefaultTextures();
-        std::cout << "[TextureManager] Initialized" << std::endl;
+        
+        // 默认预算：最大设备本地堆的一半（其余留给网格、渲染目标等）
+        if (m_device && m_residency.getBudget() == 0) {
+            VkPhysicalDeviceMemoryProperties memoryProperties;
+            vkGetPhysicalDeviceMemoryProperties(m_device->getPhysicalDevice(), &memoryProperties);
+            VkDeviceSize largestHeap = 0;
+            for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i) {
+                if (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+                    largestHeap = std::max(largestHeap, memoryProperties.memoryHeaps[i].size);
+                }
+            }
+            m_residency.setBudget(largestHeap / 2);
+        }
+        std::cout << "[TextureManager] Initialized (texture budget " << formatMegabytes(m_residency.getBudget())
+                  << ")" << std::endl;
     }
     
     /**
      * @brief 加载或获取纹理
      * 如果纹理已缓存，直接返回；否则加载并缓存
      * @param texturePath 纹理文件路径
+     * @param usage 纹理用途（决定压缩格式与颜色空间），同一文件不同用途分别缓存
      * @return 指向 VulkanTexture 的共享指针，失败返回默认白色纹理
      */
-    std::shared_ptr<VulkanTexture> getTexture(const std::string& texturePath) {
+    std::shared_ptr<VulkanTexture> getTexture(const std::string& texturePath,
+                                              TextureUsage usage = TextureUsage::Color) {
         if (texturePath.empty()) {
             return m_defaultWhiteTexture;
         }
         
         // 检查缓存
-        auto it = m_textureCache.find(texturePath);
+        const std::string key = makeCacheKey(texturePath, usage);
+        auto it = m_textureCache.find(key);
         if (it != m_textureCache.end()) {
             return it->second;
         }
+        if (m_failedTextures.count(key) > 0) {
+            return m_defaultWhiteTexture;
+        }
         
-        // 加载纹理
-        auto texture = loadTexture(texturePath);
-        if (texture) {
-            m_textureCache[texturePath] = texture;
-            return texture;
+        if (!m_device) {
+            std::cerr << "[TextureManager] Error: Device not initialized!" << std::endl;
+            return m_defaultWhiteTexture;
         }
         
+        // 已在上传中：等待所在批次完成；已在后台解码：等待解码完成后立即上传；
+        // 未请求过：在当前线程完成 CPU 阶段
+        if (m_uploadingTextures.count(key) == 0) {
+            std::unique_ptr<PendingTextureLoad> load;
+            auto pending = m_pendingLoads.find(key);
+            if (pending != m_pendingLoads.end()) {
+                load = std::move(pending->second);
+                m_pendingLoads.erase(pending);
+            } else {
+                load = std::make_unique<PendingTextureLoad>();
+                load->texturePath = texturePath;
+                load->usage = usage;
+                load->startTime = std::chrono::steady_clock::now();
+                load->data = loadTextureData(texturePath, usage, m_device->supportsTextureCompressionBC(),
+                                             m_cookOnLoad, needsCpuMips(usage));
+            }
+            std::vector<std::pair<std::string, std::unique_ptr<PendingTextureLoad>>> loads;
+            loads.emplace_back(key, std::move(load));
+            submitUploads(loads);
+        }
+        waitForUpload(key);
+        
         // 加载失败返回默认纹理
-        return m_defaultWhiteTexture;
+        it = m_textureCache.find(key);
+        return it != m_textureCache.end() ? it->second : m_defaultWhiteTexture;
+    }
+    
+    /**
+     * @brief 异步请求纹理
+     * 已驻留时直接返回；否则在后台线程读取/解码（必要时烘焙），返回用途对应的默认纹理
+     * （法线贴图为默认法线，其余为白色），驻留后再次调用返回真实纹理
+     */
+    std::shared_ptr<VulkanTexture> requestTexture(const std::string& texturePath,
+                                                  TextureUsage usage = TextureUsage::Color) {
+        if (texturePath.empty()) {
+            return getPlaceholderTexture(usage);
+        }
+        
+        const std::string key = makeCacheKey(texturePath, usage);
+        auto it = m_textureCache.find(key);
+        if (it != m_textureCache.end()) {
+            return it->second;
+        }
+        
+        if (m_failedTextures.count(key) == 0 && m_uploadingTextures.count(key) == 0 &&
+            m_pendingLoads.find(key) == m_pendingLoads.end() && m_device) {
+            auto load = std::make_unique<PendingTextureLoad>();
+            load->texturePath = texturePath;
+            load->usage = usage;
+            load->startTime = std::chrono::steady_clock::now();
+            
+            // 任务只使用值拷贝的参数，不访问管理器状态和 Vulkan
+            const bool compressed = m_device->supportsTextureCompressionBC();
+            const bool cookOnLoad = m_cookOnLoad;
+            // 已超出预算时新纹理只上传尾部级别，需要 CPU 生成的完整 mip 链
+            const bool cpuMips = needsCpuMips(usage) || m_residency.isOverBudget();
+            load->cpuResult = ThreadPool::getShared().submit([texturePath, usage, compressed, cookOnLoad, cpuMips]() {
+                return loadTextureData(texturePath, usage, compressed, cookOnLoad, cpuMips);
+            });
+            m_pendingLoads.emplace(key, std::move(load));
+        }
+        return getPlaceholderTexture(usage);
+    }
+    
+    /**
+     * @brief 批量预加载纹理并等待全部驻留
+     * 所有文件在线程池上并行解码，上传合并进一个命令缓冲区，只等待一次栅栏
+     */
+    void preloadTextures(const std::vector<std::string>& texturePaths, TextureUsage usage = TextureUsage::Color) {
+        auto startTime = std::chrono::steady_clock::now();
+        for (const auto& texturePath : texturePaths) {
+            requestTexture(texturePath, usage);
+        }
+        waitForPendingLoads();
+        
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+        std::cout << "[TextureManager] Preloaded " << texturePaths.size() << " textures in " << ms << " ms" << std::endl;
+    }
+    
+    /**
+     * @brief 上传 CPU 阶段已完成的纹理，并把上传已完成的纹理放入缓存（主线程每帧调用）
+     * @param maxUploadBytes 本帧最多写入暂存区的字节数（至少上传一个纹理），避免单帧卡顿
+     */
+    void processPendingLoads(VkDeviceSize maxUploadBytes = DEFAULT_UPLOAD_BUDGET) {
+        m_residency.beginFrame();
+        retireUploads(false);
+        
+        // 释放流式替换下来的旧资源（引用它们的帧均已执行完毕）
+        while (!m_retiredTextures.empty() && m_retiredTextures.front().first <= m_residency.getFrame()) {
+            m_retiredTextures.pop_front();
+        }
+        
+        std::vector<std::pair<std::string, std::unique_ptr<PendingTextureLoad>>> loads;
+        VkDeviceSize bytes = 0;
+        collectReadyLoads(m_pendingLoads, loads, bytes, maxUploadBytes);
+        collectReadyLoads(m_streamLoads, loads, bytes, maxUploadBytes);
+        submitUploads(loads);
+    }
+    
+    /**
+     * @brief 记录纹理本帧被使用（RenderSystem 对可见实体调用）
+     * @param screenPixels 物体在屏幕上的直径（像素），未知时传 infinity 要求完整精度
+     */
+    void markTextureUsed(const std::string& texturePath, TextureUsage usage, float screenPixels) {
+        if (!texturePath.empty()) {
+            m_residency.markUsed(makeCacheKey(texturePath, usage), screenPixels);
+        }
+    }
+    
+    /**
+     * @brief 按句柄记录纹理本帧被使用：只在槽位上取屏幕尺寸的最大值，
+     * 每个纹理在 updateResidency 中汇总上报一次
+     */
+    void markTextureUsed(TextureHandle handle, float screenPixels) {
+        if (screenPixels <= 0.0f || !m_textureSlots.contains(handle)) return;
+        
+        float& pixels = m_textureUsage[handle.index];
+        if (pixels == 0.0f) {
+            m_usedTextures.push_back(handle);
+        }
+        pixels = std::max(pixels, screenPixels);
+    }
+    
+    /**
+     * @brief 纹理路径 + 用途对应的句柄（同一组合始终返回同一句柄，直到 unloadTexture 使其失效）
+     * 路径为空时返回无效句柄，表示使用用途对应的默认纹理
+     */
+    TextureHandle acquireTextureHandle(const std::string& texturePath, TextureUsage usage = TextureUsage::Color) {
+        if (texturePath.empty()) {
+            return TextureHandle();
+        }
+        
+        std::string key = makeCacheKey(texturePath, usage);
+        auto it = m_textureHandles.find(key);
+        if (it != m_textureHandles.end()) {
+            return it->second;
+        }
+        
+        TextureSlot slot;
+        slot.key = key;
+        slot.texturePath = texturePath;
+        slot.usage = usage;
+        auto cached = m_textureCache.find(key);
+        if (cached != m_textureCache.end()) {
+            slot.texture = cached->second;
+        }
+        TextureHandle handle = m_textureSlots.add(std::move(slot));
+        m_textureHandles.emplace(std::move(key), handle);
+        m_textureUsage.resize(m_textureSlots.getCapacity(), 0.0f);
+        return handle;
+    }
+    
+    bool isHandleValid(TextureHandle handle) const {
+        return m_textureSlots.contains(handle);
+    }
+    
+    /**
+     * @brief 按句柄异步请求纹理，已驻留时直接返回槽位缓存的纹理；无效句柄返回用途对应的默认纹理
+     */
+    std::shared_ptr<VulkanTexture> requestTexture(TextureHandle handle, TextureUsage usage) {
+        const TextureSlot* slot = m_textureSlots.get(handle);
+        if (!slot) {
+            return getPlaceholderTexture(usage);
+        }
+        if (slot->texture) {
+            return slot->texture;
+        }
+        return requestTexture(slot->texturePath, slot->usage);
+    }
+    
+    bool isTextureLoading(TextureHandle handle) const {
+        const TextureSlot* slot = m_textureSlots.get(handle);
+        return slot && !slot->texture && isTextureLoading(slot->texturePath, slot->usage);
+    }
+    
+    /**
+     * @brief 按使用情况和预算调整驻留级别，发起需要的流式加载（每帧在 markTextureUsed 之后调用）
+     */
+    void updateResidency() {
+        // 汇总本帧按句柄记录的使用情况
+        for (TextureHandle handle : m_usedTextures) {
+            if (const TextureSlot* slot = m_textureSlots.get(handle)) {
+                m_residency.markUsed(slot->key, m_textureUsage[handle.index]);
+            }
+            m_textureUsage[handle.index] = 0.0f;
+        }
+        m_usedTextures.clear();
+        
+        if (!m_streamingEnabled || !m_device) return;
+        
+        for (const auto& request : m_residency.update(MAX_STREAM_REQUESTS)) {
+            auto cached = m_textureCache.find(request.key);
+            if (cached == m_textureCache.end() || m_streamLoads.count(request.key) > 0) continue;
+            
+            std::string texturePath;
+            TextureUsage usage = TextureUsage::Color;
+            parseCacheKey(request.key, texturePath, usage);
+            
+            auto load = std::make_unique<PendingTextureLoad>();
+            load->texturePath = texturePath;
+            load->usage = usage;
+            load->baseLevel = request.baseLevel;
+            load->streaming = true;
+            load->startTime = std::chrono::steady_clock::now();
+            
+            // 需要完整 mip 链才能取出任意级别；缓存缺失时不在流式加载中烘焙
+            const bool compressed = m_device->supportsTextureCompressionBC();
+            load->cpuResult = ThreadPool::getShared().submit([texturePath, usage, compressed]() {
+                return loadTextureData(texturePath, usage, compressed, false, true);
+            });
+            m_residency.setStreaming(request.key, true);
+            m_streamLoads.emplace(request.key, std::move(load));
+        }
+    }
+    
+    /**
+     * @brief 启用 bindless 纹理数组（需在创建使用它的 Pass 之前调用）
+     * 已缓存和之后加载的纹理都会分配槽位，流式替换资源后重写槽位
+     * @return 设备不支持 descriptor indexing 时返回 nullptr，材质继续使用独立描述符集
+     */
+    BindlessDescriptors* enableBindless(uint32_t maxFramesInFlight) {
+        if (m_bindless || !m_device) return m_bindless.get();
+        if (!BindlessDescriptors::isSupported(*m_device)) {
+            std::cout << "[TextureManager] Bindless textures not supported, using per-material descriptor sets" << std::endl;
+            return nullptr;
+        }
+        
+        m_bindless = std::make_unique<BindlessDescriptors>(m_device, maxFramesInFlight);
+        for (auto* texture : { &m_defaultWhiteTexture, &m_defaultNormalTexture, &m_defaultBlackTexture }) {
+            registerBindless(*texture);
+        }
+        for (auto& entry : m_textureCache) {
+            registerBindless(entry.second);
+        }
+        return m_bindless.get();
+    }
+    
+    BindlessDescriptors* getBindlessDescriptors() const { return m_bindless.get(); }
+    
+    /**
+     * @brief 纹理在 bindless 数组中的槽位，未分配（数组已满）时返回对应用途默认纹理的槽位
+     */
+    uint32_t getBindlessIndex(const std::shared_ptr<VulkanTexture>& texture, TextureUsage usage = TextureUsage::Color) const {
+        if (texture && texture->getBindlessIndex() != BindlessDescriptors::INVALID_INDEX) {
+            return texture->getBindlessIndex();
+        }
+        return getPlaceholderTexture(usage)->getBindlessIndex();
+    }
+    
+    /**
+     * @brief 纹理显存预算（字节），0 表示不限制；超出时按 LRU 降低驻留级别
+     */
+    void setMemoryBudget(VkDeviceSize bytes) { m_residency.setBudget(bytes); }
+    VkDeviceSize getMemoryBudget() const { return m_residency.getBudget(); }
+    
+    /**
+     * @brief 启用/禁用流式加载（禁用后保持当前驻留级别）
+     */
+    void setStreamingEnabled(bool enabled) { m_streamingEnabled = enabled; }
+    bool isStreamingEnabled() const { return m_streamingEnabled; }
+    
+    /**
+     * @brief 驻留统计（估算值，供调试面板显示）
+     */
+    TextureResidencyStats getResidencyStats() const {
+        return m_residency.getStats();
+    }
+    
+    /**
+     * @brief 阻塞直到所有已请求的纹理驻留（全部上传合并为一批）
+     */
+    void waitForPendingLoads() {
+        std::vector<std::pair<std::string, std::unique_ptr<PendingTextureLoad>>> loads;
+        for (auto& pending : m_pendingLoads) {
+            pending.second->cpuResult.wait();
+            loads.emplace_back(pending.first, std::move(pending.second));
+        }
+        m_pendingLoads.clear();
+        submitUploads(loads);
+        retireUploads(true);
+    }
+    
+    /**
+     * @brief 正在解码或上传中的纹理数量
+     */
+    size_t getPendingLoadCount() const {
+        return m_pendingLoads.size() + m_uploadingTextures.size();
     }
     
     /**
@@ -85,26 +416,50 @@ public:
     }
     
     /**
-     * @brief 预加载纹理（不返回，仅缓存）
+     * @brief 用途对应的默认纹理（法线贴图为默认法线，其余为白色）
      */
-    void preloadTexture(const std::string& texturePath) {
-        getTexture(texturePath);
+    std::shared_ptr<VulkanTexture> getPlaceholderTexture(TextureUsage usage) const {
+        return usage == TextureUsage::Normal ? m_defaultNormalTexture : m_defaultWhiteTexture;
+    }
+    
+    /**
+     * @brief 预加载纹理（同步，不返回，仅缓存）
+     */
+    void preloadTexture(const std::string& texturePath, TextureUsage usage = TextureUsage::Color) {
+        getTexture(texturePath, usage);
     }
     
     /**
      * @brief 检查纹理是否已缓存
      */
-    bool hasTexture(const std::string& texturePath) const {
-        return m_textureCache.find(texturePath) != m_textureCache.end();
+    bool hasTexture(const std::string& texturePath, TextureUsage usage = TextureUsage::Color) const {
+        return m_textureCache.find(makeCacheKey(texturePath, usage)) != m_textureCache.end();
+    }
+    
+    /**
+     * @brief 检查纹理是否正在解码或上传
+     */
+    bool isTextureLoading(const std::string& texturePath, TextureUsage usage = TextureUsage::Color) const {
+        const std::string key = makeCacheKey(texturePath, usage);
+        return m_pendingLoads.find(key) != m_pendingLoads.end() || m_uploadingTextures.count(key) > 0;
     }
     
     /**
      * @brief 卸载指定纹理
      */
-    void unloadTexture(const std::string& texturePath) {
-        auto it = m_textureCache.find(texturePath);
+    void unloadTexture(const std::string& texturePath, TextureUsage usage = TextureUsage::Color) {
+        // 已发出的句柄失效，再次使用时需重新解析
+        auto handle = m_textureHandles.find(makeCacheKey(texturePath, usage));
+        if (handle != m_textureHandles.end()) {
+            m_textureSlots.remove(handle->second);
+            m_textureHandles.erase(handle);
+        }
+        m_failedTextures.erase(makeCacheKey(texturePath, usage));
+        m_residency.removeTexture(makeCacheKey(texturePath, usage));
+        auto it = m_textureCache.find(makeCacheKey(texturePath, usage));
         if (it != m_textureCache.end()) {
             std::cout << "[TextureManager] Unloading texture: " << texturePath << std::endl;
+            releaseBindless(*it->second);
             m_textureCache.erase(it);
         }
     }
@@ -114,19 +469,81 @@ public:
      */
     void cleanup() {
         std::cout << "[TextureManager] Cleaning up " << m_textureCache.size() << " textures..." << std::endl;
+        
+        // 等待后台任务和进行中的上传结束，未上传的结果直接丢弃
+        for (auto* loads : { &m_pendingLoads, &m_streamLoads }) {
+            for (auto& pending : *loads) {
+                pending.second->cpuResult.wait();
+            }
+            loads->clear();
+        }
+        for (auto& upload : m_inFlightUploads) {
+            upload.batch->wait();
+        }
+        m_inFlightUploads.clear();
+        m_uploadingTextures.clear();
+        m_retiredTextures.clear();
+        m_residency.clear();
+        m_failedTextures.clear();
         m_textureCache.clear();
+        m_textureSlots.clear();
+        m_textureHandles.clear();
+        m_usedTextures.clear();
+        std::fill(m_textureUsage.begin(), m_textureUsage.end(), 0.0f);
         m_defaultWhiteTexture.reset();
         m_defaultNormalTexture.reset();
         m_defaultBlackTexture.reset();
+        m_bindless.reset();
         m_device.reset();
     }
     
+    /**
+     * @brief 缓存缺失或过期时是否在加载时烘焙 KTX2（关闭后直接解码源图片）
+     */
+    void setCookOnLoad(bool enabled) { m_cookOnLoad = enabled; }
+    bool getCookOnLoad() const { return m_cookOnLoad; }
+    
     /**
      * @brief 获取已加载的纹理数量
      */
     size_t getTextureCount() const {
         return m_textureCache.size();
     }
+    
+    /**
+     * @brief 已加载纹理（含默认纹理）占用的设备内存总量，包含所有 mip 级别
+     */
+    VkDeviceSize getTotalMemory() const {
+        VkDeviceSize total = 0;
+        for (const auto& entry : m_textureCache) {
+            total += entry.second->getMemorySize();
+        }
+        for (const auto& texture : { m_defaultWhiteTexture, m_defaultNormalTexture, m_defaultBlackTexture }) {
+            if (texture) total += texture->getMemorySize();
+        }
+        return total;
+    }
+    
+    /**
+     * @brief 输出每个纹理的尺寸、mip 级数和内存占用（按占用从大到小）
+     */
+    void printMemoryReport() const {
+        std::vector<std::pair<std::string, std::shared_ptr<VulkanTexture>>> entries(m_textureCache.begin(), m_textureCache.end());
+        std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+            return a.second->getMemorySize() > b.second->getMemorySize();
+        });
+        
+        std::cout << "[TextureManager] Memory report (" << entries.size() << " textures):" << std::endl;
+        for (const auto& entry : entries) {
+            const VulkanTexture& texture = *entry.second;
+            std::cout << "  " << entry.first << ": " << texture.getWidth() << "x" << texture.getHeight()
+                      << ", " << texture.getMipLevels() << " mips from level " << m_residency.getBaseLevel(entry.first)
+                      << " (" << texture.getMipSource() << "), "
+                      << formatMegabytes(texture.getMemorySize()) << std::endl;
+        }
+        std::cout << "  Total: " << formatMegabytes(getTotalMemory()) << " (budget "
+                  << formatMegabytes(m_residency.getBudget()) << ")" << std::endl;
+    }
 
 private:
     TextureManager() = default;
@@ -153,27 +570,333 @@ private:
         std::cout << "[TextureManager] Default textures created" << std::endl;
     }
     
+    static constexpr VkDeviceSize DEFAULT_UPLOAD_BUDGET = 64ull * 1024 * 1024;
+    static constexpr uint32_t MAX_STREAM_REQUESTS = 4;      // 每帧最多发起的流式加载
+    static constexpr uint64_t RETIRE_DELAY_FRAMES = 3;      // 大于渲染器的 MAX_FRAMES_IN_FLIGHT
+    
     /**
-     * @brief 实际加载纹理的内部方法
+     * @brief 后台加载任务的状态
      */
-    std::shared_ptr<VulkanTexture> loadTexture(const std::string& texturePath) {
-        if (!m_device) {
-            std::cerr << "[TextureManager] Error: Device not initialized!" << std::endl;
+    struct PendingTextureLoad {
+        std::string texturePath;
+        TextureUsage usage = TextureUsage::Color;
+        std::future<std::shared_ptr<CookedTexture>> cpuResult;
+        std::shared_ptr<CookedTexture> data;
+        uint32_t baseLevel = 0;     // 上传的最高精度级别
+        bool streaming = false;     // 替换已驻留纹理的级别，而不是首次加载
+        std::chrono::steady_clock::time_point startTime;
+    };
+    
+    /**
+     * @brief 上传中的纹理（栅栏发出信号后放入缓存或与已驻留纹理交换资源）
+     */
+    struct UploadingTexture {
+        std::string key;
+        std::shared_ptr<VulkanTexture> texture;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t mipLevels = 1;
+        uint32_t baseLevel = 0;
+        bool streaming = false;
+    };
+    
+    /**
+     * @brief 已提交、等待栅栏的一批上传
+     */
+    struct InFlightUpload {
+        std::unique_ptr<TextureUploadBatch> batch;
+        std::vector<UploadingTexture> textures;
+        std::chrono::steady_clock::time_point startTime;
+    };
+    
+    /**
+     * @brief CPU 阶段：读取烘焙缓存 / 烘焙 / 解码（可在工作线程执行，不访问 Vulkan）
+     * @param compressed 设备支持 BC 压缩时优先使用 KTX2
+     * @param cpuMips 未压缩格式不支持线性 blit 时在 CPU 上生成 mip 链
+     */
+    static std::shared_ptr<CookedTexture> loadTextureData(const std::string& texturePath, TextureUsage usage,
+                                                          bool compressed, bool cookOnLoad, bool cpuMips) {
+        auto data = std::make_shared<CookedTexture>();
+        if (compressed) {
+            if (TextureCache::load(texturePath, usage, *data)) {
+                return data;
+            }
+            if (cookOnLoad && TextureCache::cook(texturePath, usage, *data)) {
+                TextureCache::save(texturePath, usage, *data);
+                return data;
+            }
+        }
+        if (TextureCache::decode(texturePath, usage, cpuMips, *data)) {
+            return data;
+        }
+        return nullptr;
+    }
+    
+    /**
+     * @brief 未压缩回退格式是否需要在 CPU 上生成 mip 链
+     */
+    bool needsCpuMips(TextureUsage usage) const {
+        return !m_device || !VulkanTexture::supportsLinearBlit(*m_device, TextureCache::getUncompressedFormat(usage));
+    }
+    
+    std::shared_ptr<CookedTexture> getCpuResult(const std::string& key, PendingTextureLoad& load) {
+        try {
+            return load.cpuResult.get();
+        } catch (const std::exception& e) {
+            std::cerr << "[TextureManager] Background load failed: " << key << " (" << e.what() << ")" << std::endl;
             return nullptr;
         }
+    }
+    
+    /**
+     * @brief 取出 CPU 阶段已完成的任务，直到达到本帧的上传字节数
+     */
+    void collectReadyLoads(std::unordered_map<std::string, std::unique_ptr<PendingTextureLoad>>& pendingLoads,
+                           std::vector<std::pair<std::string, std::unique_ptr<PendingTextureLoad>>>& loads,
+                           VkDeviceSize& bytes, VkDeviceSize maxUploadBytes) {
+        for (auto it = pendingLoads.begin(); it != pendingLoads.end() && (loads.empty() || bytes < maxUploadBytes);) {
+            if (it->second->cpuResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                ++it;
+                continue;
+            }
+            it->second->data = getCpuResult(it->first, *it->second);
+            if (it->second->data && !it->second->data->levels.empty()) {
+                bytes += it->second->data->levels.back().offset + it->second->data->levels.back().size;
+            }
+            loads.emplace_back(it->first, std::move(it->second));
+            it = pendingLoads.erase(it);
+        }
+    }
+    
+    /**
+     * @brief 为 CPU 阶段已完成的纹理创建图像，并把所有上传记录进同一批次提交
+     * 首次加载超出预算时只上传尾部级别；流式加载上传 baseLevel 起的级别到新的纹理对象
+     */
+    void submitUploads(std::vector<std::pair<std::string, std::unique_ptr<PendingTextureLoad>>>& loads) {
+        if (loads.empty()) return;
         
-        auto texture = std::make_shared<VulkanTexture>(m_device);
-        if (texture->loadFromFile(texturePath)) {
-            std::cout << "[TextureManager] Loaded texture: " << texturePath << std::endl;
-            return texture;
+        InFlightUpload upload;
+        upload.batch = std::make_unique<TextureUploadBatch>(m_device);
+        upload.startTime = std::chrono::steady_clock::now();
+        
+        for (auto& entry : loads) {
+            PendingTextureLoad& load = *entry.second;
+            if (!load.data && load.cpuResult.valid()) {
+                load.data = getCpuResult(entry.first, load);
+            }
         }
         
-        std::cerr << "[TextureManager] Failed to load texture: " << texturePath << std::endl;
-        return nullptr;
+        try {
+            for (auto& entry : loads) {
+                const std::string& key = entry.first;
+                PendingTextureLoad& load = *entry.second;
+                
+                if (load.streaming && (!load.data || m_textureCache.find(key) == m_textureCache.end())) {
+                    // 纹理已卸载或读取失败：保持原级别
+                    m_residency.setStreaming(key, false);
+                    continue;
+                }
+                
+                UploadingTexture uploading;
+                uploading.key = key;
+                uploading.streaming = load.streaming;
+                uploading.texture = load.data && m_device ? std::make_shared<VulkanTexture>(m_device) : nullptr;
+                
+                bool loaded = false;
+                if (uploading.texture) {
+                    const CookedTexture& data = *load.data;
+                    uploading.format = data.format;
+                    uploading.width = data.width;
+                    uploading.height = data.height;
+                    uploading.mipLevels = MipmapGenerator::getMipLevelCount(data.width, data.height);
+                    
+                    // 只有 LOD0 时由 GPU blit 生成其余级别（解码时已按格式能力决定），无法只上传部分级别
+                    const bool gpuBlit = data.levels.size() == 1;
+                    uint32_t baseLevel = load.streaming ? load.baseLevel
+                        : m_residency.getInitialBaseLevel(data.format, data.width, data.height, uploading.mipLevels);
+                    baseLevel = gpuBlit ? 0 : std::min(baseLevel, static_cast<uint32_t>(data.levels.size()) - 1);
+                    uploading.baseLevel = baseLevel;
+                    
+                    std::vector<MipLevel> levels(data.levels.begin() + baseLevel, data.levels.end());
+                    const size_t baseOffset = levels.front().offset;
+                    for (MipLevel& level : levels) {
+                        level.offset -= baseOffset;
+                    }
+                    loaded = uploading.texture->loadFromMipChain(*upload.batch, data.data.data() + baseOffset, levels,
+                                                                 data.format, gpuBlit);
+                }
+                
+                if (!loaded) {
+                    if (load.streaming) {
+                        m_residency.setStreaming(key, false);
+                    } else {
+                        std::cerr << "[TextureManager] Failed to load texture: " << load.texturePath << std::endl;
+                        m_failedTextures.insert(key);
+                    }
+                    continue;
+                }
+                
+                if (!load.streaming) {
+                    double ms = std::chrono::duration<double, std::milli>(upload.startTime - load.startTime).count();
+                    std::cout << "[TextureManager] Loaded texture: " << load.texturePath
+                              << " (" << TextureCache::getUsageName(load.usage) << ", " << uploading.texture->getMipLevels()
+                              << " mips via " << uploading.texture->getMipSource() << ", "
+                              << formatMegabytes(uploading.texture->getMemorySize()) << ", ready after " << ms << " ms)" << std::endl;
+                    m_uploadingTextures.insert(key);
+                }
+                upload.textures.push_back(std::move(uploading));
+            }
+            upload.batch->submit();
+        } catch (const std::exception& e) {
+            // 暂存区或提交失败：本批纹理全部视为失败（流式加载保持原级别）
+            std::cerr << "[TextureManager] Texture upload failed: " << e.what() << std::endl;
+            for (const auto& uploading : upload.textures) {
+                if (uploading.streaming) {
+                    m_residency.setStreaming(uploading.key, false);
+                } else {
+                    m_uploadingTextures.erase(uploading.key);
+                    m_failedTextures.insert(uploading.key);
+                }
+            }
+            // 已记录的命令引用本批纹理的图像，先等待执行完毕再释放纹理
+            upload.batch.reset();
+            return;
+        }
+        
+        if (!upload.textures.empty()) {
+            m_inFlightUploads.push_back(std::move(upload));
+        }
+    }
+    
+    /**
+     * @brief 处理栅栏已发出信号的批次：首次加载的纹理放入缓存，流式加载的与已驻留纹理交换资源
+     * @param wait true 时阻塞等待所有批次完成
+     */
+    void retireUploads(bool wait) {
+        for (auto it = m_inFlightUploads.begin(); it != m_inFlightUploads.end();) {
+            if (wait) {
+                it->batch->wait();
+            } else if (!it->batch->isComplete()) {
+                ++it;
+                continue;
+            }
+            
+            uint32_t loadedCount = 0;
+            for (auto& uploading : it->textures) {
+                if (uploading.streaming) {
+                    m_residency.setStreaming(uploading.key, false);
+                    auto cached = m_textureCache.find(uploading.key);
+                    if (cached == m_textureCache.end()) continue;
+                    
+                    // 交换后 uploading.texture 持有旧资源，当前帧及之前提交的帧可能仍在使用
+                    cached->second->swapResources(*uploading.texture);
+                    if (m_bindless && cached->second->getBindlessIndex() != BindlessDescriptors::INVALID_INDEX) {
+                        m_bindless->updateTexture(cached->second->getBindlessIndex(),
+                                                  cached->second->getImageView(), cached->second->getSampler());
+                    }
+                    m_retiredTextures.emplace_back(m_residency.getFrame() + RETIRE_DELAY_FRAMES, uploading.texture);
+                    m_residency.setBaseLevel(uploading.key, uploading.baseLevel);
+                } else if (m_uploadingTextures.erase(uploading.key) > 0) {
+                    m_textureCache[uploading.key] = uploading.texture;
+                    auto handle = m_textureHandles.find(uploading.key);
+                    if (handle != m_textureHandles.end()) {
+                        m_textureSlots.get(handle->second)->texture = uploading.texture;
+                    }
+                    registerBindless(uploading.texture);
+                    m_residency.addTexture(uploading.key, uploading.format, uploading.width, uploading.height,
+                                           uploading.mipLevels, uploading.baseLevel);
+                    ++loadedCount;
+                }
+            }
+            if (loadedCount > 1) {
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - it->startTime).count();
+                std::cout << "[TextureManager] Uploaded " << loadedCount << " textures ("
+                          << formatMegabytes(it->batch->getUploadSize()) << ") in one batch, " << ms << " ms" << std::endl;
+            }
+            it = m_inFlightUploads.erase(it);
+        }
+    }
+    
+    /**
+     * @brief 等待包含指定纹理的上传批次完成并放入缓存
+     */
+    void waitForUpload(const std::string& key) {
+        if (m_uploadingTextures.count(key) == 0) return;
+        for (auto& upload : m_inFlightUploads) {
+            for (const auto& uploading : upload.textures) {
+                if (uploading.key == key && !uploading.streaming) {
+                    upload.batch->wait();
+                    break;
+                }
+            }
+        }
+        retireUploads(false);
+    }
+    
+    static std::string makeCacheKey(const std::string& texturePath, TextureUsage usage) {
+        return usage == TextureUsage::Color ? texturePath
+                                            : texturePath + "|" + TextureCache::getUsageName(usage);
+    }
+    
+    void registerBindless(const std::shared_ptr<VulkanTexture>& texture) {
+        if (m_bindless && texture && texture->getBindlessIndex() == BindlessDescriptors::INVALID_INDEX) {
+            texture->setBindlessIndex(m_bindless->addTexture(texture->getImageView(), texture->getSampler()));
+        }
+    }
+    
+    void releaseBindless(VulkanTexture& texture) {
+        if (m_bindless && texture.getBindlessIndex() != BindlessDescriptors::INVALID_INDEX) {
+            m_bindless->removeTexture(texture.getBindlessIndex());
+            texture.setBindlessIndex(BindlessDescriptors::INVALID_INDEX);
+        }
+    }
+    
+    static void parseCacheKey(const std::string& key, std::string& texturePath, TextureUsage& usage) {
+        texturePath = key;
+        usage = TextureUsage::Color;
+        const size_t separator = key.rfind('|');
+        if (separator == std::string::npos) return;
+        
+        for (TextureUsage candidate : { TextureUsage::Normal, TextureUsage::Mask, TextureUsage::MetallicRoughness }) {
+            if (key.compare(separator + 1, std::string::npos, TextureCache::getUsageName(candidate)) == 0) {
+                texturePath = key.substr(0, separator);
+                usage = candidate;
+                return;
+            }
+        }
+    }
+    
+    static std::string formatMegabytes(VkDeviceSize bytes) {
+        char text[32];
+        snprintf(text, sizeof(text), "%.2f MB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+        return text;
     }
     
     std::shared_ptr<VulkanDevice> m_device;
     std::unordered_map<std::string, std::shared_ptr<VulkanTexture>> m_textureCache;
+    std::unordered_map<std::string, std::unique_ptr<PendingTextureLoad>> m_pendingLoads;
+    std::unordered_map<std::string, std::unique_ptr<PendingTextureLoad>> m_streamLoads;
+    std::unordered_set<std::string> m_uploadingTextures;
+    std::vector<InFlightUpload> m_inFlightUploads;
+    std::deque<std::pair<uint64_t, std::shared_ptr<VulkanTexture>>> m_retiredTextures;
+    std::unordered_set<std::string> m_failedTextures;
+    
+    // 纹理句柄：槽位缓存驻留的纹理；m_textureUsage 按句柄 index 记录本帧的最大屏幕尺寸
+    struct TextureSlot {
+        std::string key;
+        std::string texturePath;
+        TextureUsage usage = TextureUsage::Color;
+        std::shared_ptr<VulkanTexture> texture;
+    };
+    HandlePool<TextureHandleTag, TextureSlot> m_textureSlots;
+    std::unordered_map<std::string, TextureHandle> m_textureHandles;
+    std::vector<float> m_textureUsage;
+    std::vector<TextureHandle> m_usedTextures;
+    TextureResidency m_residency;
+    std::unique_ptr<BindlessDescriptors> m_bindless;
+    bool m_cookOnLoad = true;
+    bool m_streamingEnabled = true;
     
     // 默认纹理
     std::shared_ptr<VulkanTexture> m_defaultWhiteTexture;
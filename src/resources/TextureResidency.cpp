@@ -0,0 +1,224 @@
+#include "TextureResidency.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace VulkanEngine {
+
+void TextureResidency::addTexture(const std::string& key, VkFormat format, uint32_t width, uint32_t height,
+                                  uint32_t mipLevels, uint32_t baseLevel) {
+    Entry& entry = m_entries[key];
+    entry.format = format;
+    entry.width = width;
+    entry.height = height;
+    entry.mipLevels = std::max(mipLevels, 1u);
+    entry.tailLevel = getTailLevel(width, height, entry.mipLevels);
+    entry.baseLevel = std::min(baseLevel, entry.mipLevels - 1);
+    entry.wantedLevel = 0;
+    entry.frameLevel = UINT32_MAX;
+    entry.targetLevel = entry.baseLevel;
+    entry.lastUsedFrame = m_frame;
+    entry.wantedFrame = m_frame;
+    entry.used = false;
+    entry.streaming = false;
+}
+
+void TextureResidency::removeTexture(const std::string& key) {
+    m_entries.erase(key);
+}
+
+void TextureResidency::markUsed(const std::string& key, float screenPixels) {
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) return;
+
+    Entry& entry = it->second;
+    entry.lastUsedFrame = m_frame;
+    entry.frameLevel = std::min(entry.frameLevel, getRequiredLevel(entry, screenPixels));
+}
+
+void TextureResidency::setStreaming(const std::string& key, bool streaming) {
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        it->second.streaming = streaming;
+    }
+}
+
+void TextureResidency::setBaseLevel(const std::string& key, uint32_t baseLevel) {
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        it->second.baseLevel = std::min(baseLevel, it->second.mipLevels - 1);
+    }
+}
+
+uint32_t TextureResidency::getBaseLevel(const std::string& key) const {
+    auto it = m_entries.find(key);
+    return it != m_entries.end() ? it->second.baseLevel : 0;
+}
+
+std::vector<TextureResidency::StreamRequest> TextureResidency::update(uint32_t maxRequests) {
+    // 1. 需要的级别：首次使用和需求提高立即生效，降低需持续 DEMOTE_DELAY_FRAMES 帧；长期未使用只保留尾部
+    for (auto& item : m_entries) {
+        Entry& entry = item.second;
+        if (entry.lastUsedFrame == m_frame && entry.frameLevel != UINT32_MAX) {
+            if (!entry.used || entry.frameLevel <= entry.wantedLevel ||
+                m_frame - entry.wantedFrame > DEMOTE_DELAY_FRAMES) {
+                entry.wantedLevel = entry.frameLevel;
+                entry.wantedFrame = m_frame;
+                entry.used = true;
+            }
+        } else if (m_frame - entry.lastUsedFrame > EVICT_DELAY_FRAMES) {
+            entry.wantedLevel = entry.tailLevel;
+        }
+        entry.frameLevel = UINT32_MAX;
+        entry.targetLevel = std::min(entry.wantedLevel, entry.tailLevel);
+    }
+
+    // 2. 预算：先把最久未使用的纹理降到尾部，仍超出时对本帧可见的纹理逐级降低
+    if (m_budget > 0) {
+        VkDeviceSize total = 0;
+        for (const auto& item : m_entries) {
+            total += item.second.memoryAt(item.second.targetLevel);
+        }
+
+        if (total > m_budget) {
+            std::vector<Entry*> order;
+            order.reserve(m_entries.size());
+            for (auto& item : m_entries) {
+                order.push_back(&item.second);
+            }
+            std::sort(order.begin(), order.end(), [](const Entry* a, const Entry* b) {
+                if (a->lastUsedFrame != b->lastUsedFrame) return a->lastUsedFrame < b->lastUsedFrame;
+                return a->wantedLevel > b->wantedLevel;
+            });
+
+            for (Entry* entry : order) {
+                if (total <= m_budget) break;
+                if (entry->lastUsedFrame == m_frame) continue;
+                total -= entry->memoryAt(entry->targetLevel) - entry->memoryAt(entry->tailLevel);
+                entry->targetLevel = entry->tailLevel;
+            }
+
+            bool progress = true;
+            while (total > m_budget && progress) {
+                progress = false;
+                for (Entry* entry : order) {
+                    if (entry->targetLevel >= entry->tailLevel) continue;
+                    total -= entry->memoryAt(entry->targetLevel) - entry->memoryAt(entry->targetLevel + 1);
+                    ++entry->targetLevel;
+                    progress = true;
+                    if (total <= m_budget) break;
+                }
+            }
+        }
+    }
+
+    // 3. 生成请求：降低精度的先执行以释放内存；提高精度只在当前驻留量加上增量不超出预算时执行
+    std::vector<const std::pair<const std::string, Entry>*> demotions;
+    std::vector<const std::pair<const std::string, Entry>*> promotions;
+    for (const auto& item : m_entries) {
+        const Entry& entry = item.second;
+        if (entry.streaming || entry.targetLevel == entry.baseLevel) continue;
+        (entry.targetLevel > entry.baseLevel ? demotions : promotions).push_back(&item);
+    }
+    std::sort(promotions.begin(), promotions.end(), [](const auto* a, const auto* b) {
+        return a->second.lastUsedFrame > b->second.lastUsedFrame;
+    });
+
+    std::vector<StreamRequest> requests;
+    for (const auto* item : demotions) {
+        if (requests.size() >= maxRequests) return requests;
+        requests.push_back({ item->first, item->second.targetLevel });
+    }
+
+    VkDeviceSize resident = getResidentBytes();
+    for (const auto* item : promotions) {
+        if (requests.size() >= maxRequests) break;
+        const Entry& entry = item->second;
+        const VkDeviceSize growth = entry.memoryAt(entry.targetLevel) - entry.memoryAt(entry.baseLevel);
+        if (m_budget > 0 && resident + growth > m_budget) continue;
+        resident += growth;
+        requests.push_back({ item->first, entry.targetLevel });
+    }
+    return requests;
+}
+
+uint32_t TextureResidency::getInitialBaseLevel(VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels) const {
+    if (m_budget == 0) return 0;
+    if (getResidentBytes() + estimateMemory(format, width, height, mipLevels, 0) <= m_budget) return 0;
+    return getTailLevel(width, height, mipLevels);
+}
+
+bool TextureResidency::isOverBudget() const {
+    return m_budget > 0 && getResidentBytes() > m_budget;
+}
+
+TextureResidencyStats TextureResidency::getStats() const {
+    TextureResidencyStats stats;
+    stats.budgetBytes = m_budget;
+    stats.textureCount = static_cast<uint32_t>(m_entries.size());
+    for (const auto& item : m_entries) {
+        const Entry& entry = item.second;
+        stats.residentBytes += entry.memoryAt(entry.baseLevel);
+        stats.targetBytes += entry.memoryAt(entry.targetLevel);
+        if (entry.streaming) ++stats.streamingCount;
+        if (entry.targetLevel > std::min(entry.wantedLevel, entry.tailLevel)) ++stats.reducedCount;
+    }
+    return stats;
+}
+
+VkDeviceSize TextureResidency::estimateMemory(VkFormat format, uint32_t width, uint32_t height,
+                                              uint32_t mipLevels, uint32_t baseLevel) {
+    VkDeviceSize blockBytes = 0;
+    switch (format) {
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+            blockBytes = 8;
+            break;
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+            blockBytes = 16;
+            break;
+        default:
+            break;
+    }
+
+    VkDeviceSize total = 0;
+    for (uint32_t level = baseLevel; level < mipLevels; ++level) {
+        const VkDeviceSize levelWidth = std::max(width >> level, 1u);
+        const VkDeviceSize levelHeight = std::max(height >> level, 1u);
+        if (blockBytes > 0) {
+            total += ((levelWidth + 3) / 4) * ((levelHeight + 3) / 4) * blockBytes;
+        } else {
+            total += levelWidth * levelHeight * 4;
+        }
+    }
+    return total;
+}
+
+uint32_t TextureResidency::getTailLevel(uint32_t width, uint32_t height, uint32_t mipLevels) {
+    uint32_t level = 0;
+    while (level + 1 < mipLevels && std::max(width >> level, height >> level) > MIN_RESIDENT_SIZE) {
+        ++level;
+    }
+    return level;
+}
+
+uint32_t TextureResidency::getRequiredLevel(const Entry& entry, float screenPixels) const {
+    if (!std::isfinite(screenPixels)) return 0;
+    if (screenPixels <= 1.0f) return entry.tailLevel;
+
+    // 物体在屏幕上的直径通常小于纹理在表面上展开的长度，保守地按两倍计算
+    const float ratio = static_cast<float>(std::max(entry.width, entry.height)) / (screenPixels * 2.0f);
+    if (ratio <= 1.0f) return 0;
+    return std::min(static_cast<uint32_t>(std::floor(std::log2(ratio))), entry.tailLevel);
+}
+
+VkDeviceSize TextureResidency::getResidentBytes() const {
+    VkDeviceSize total = 0;
+    for (const auto& item : m_entries) {
+        total += item.second.memoryAt(item.second.baseLevel);
+    }
+    return total;
+}
+
+} // namespace VulkanEngine
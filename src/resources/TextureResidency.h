@@ -0,0 +1,135 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace VulkanEngine {
+
+/**
+ * @brief 纹理驻留统计（按估算的设备内存）
+ */
+struct TextureResidencyStats {
+    VkDeviceSize residentBytes = 0;   // 当前驻留级别的内存
+    VkDeviceSize targetBytes = 0;     // 目标级别的内存（流式加载完成后）
+    VkDeviceSize budgetBytes = 0;     // 预算（0 表示不限）
+    uint32_t textureCount = 0;
+    uint32_t streamingCount = 0;      // 正在流式加载的纹理
+    uint32_t reducedCount = 0;        // 因预算限制低于所需精度的纹理
+};
+
+/**
+ * @brief 纹理驻留管理：决定每个纹理驻留哪些 mip 级别
+ *
+ * 只做决策，不访问 Vulkan。每个纹理记录完整尺寸、当前驻留的最高精度级别（baseLevel）、
+ * 最后使用帧和按屏幕尺寸需要的级别；update() 按以下规则计算目标级别并返回需要流式加载的纹理：
+ *   - 需要的级别 = log2(纹理尺寸 / (屏幕像素 * 2))，需求提高立即生效，降低需保持
+ *     DEMOTE_DELAY_FRAMES 帧，避免物体在视锥边缘进出时反复加载
+ *   - 连续 EVICT_DELAY_FRAMES 帧未使用的纹理只保留尾部级别（不超过 MIN_RESIDENT_SIZE）
+ *   - 目标总量超出预算时，先把最久未使用的纹理降到尾部级别，仍超出时对本帧可见的纹理
+ *     从屏幕尺寸最小的开始逐级降低
+ * 纹理始终保留尾部级别，材质描述符不会引用到空图像。
+ */
+class TextureResidency {
+public:
+    static constexpr uint32_t MIN_RESIDENT_SIZE = 64;
+    static constexpr uint64_t DEMOTE_DELAY_FRAMES = 120;
+    static constexpr uint64_t EVICT_DELAY_FRAMES = 600;
+
+    struct StreamRequest {
+        std::string key;
+        uint32_t baseLevel = 0;
+    };
+
+    /**
+     * @brief 预算（字节），0 表示不限制
+     */
+    void setBudget(VkDeviceSize bytes) { m_budget = bytes; }
+    VkDeviceSize getBudget() const { return m_budget; }
+
+    /**
+     * @brief 开始新的一帧（每帧调用一次，在 markUsed 之前）
+     */
+    void beginFrame() { ++m_frame; }
+    uint64_t getFrame() const { return m_frame; }
+
+    void addTexture(const std::string& key, VkFormat format, uint32_t width, uint32_t height,
+                    uint32_t mipLevels, uint32_t baseLevel);
+    void removeTexture(const std::string& key);
+    void clear() { m_entries.clear(); }
+    bool hasTexture(const std::string& key) const { return m_entries.count(key) > 0; }
+
+    /**
+     * @brief 记录纹理本帧被使用
+     * @param screenPixels 使用该纹理的物体在屏幕上的直径（像素），未知时传 infinity 要求完整精度
+     */
+    void markUsed(const std::string& key, float screenPixels);
+
+    /**
+     * @brief 流式加载开始 / 完成
+     */
+    void setStreaming(const std::string& key, bool streaming);
+    void setBaseLevel(const std::string& key, uint32_t baseLevel);
+    uint32_t getBaseLevel(const std::string& key) const;
+
+    /**
+     * @brief 计算目标级别，返回需要流式加载的纹理（降低精度的优先，以便先释放内存）
+     * @param maxRequests 本次最多返回的请求数
+     */
+    std::vector<StreamRequest> update(uint32_t maxRequests);
+
+    /**
+     * @brief 新纹理的初始驻留级别：加入后超出预算时只上传尾部级别，之后按需要再提高
+     */
+    uint32_t getInitialBaseLevel(VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels) const;
+
+    /**
+     * @brief 当前驻留级别的估算内存是否已超出预算
+     */
+    bool isOverBudget() const;
+
+    TextureResidencyStats getStats() const;
+
+    /**
+     * @brief 估算 [baseLevel, mipLevels) 级别占用的内存（按格式的块大小，不含驱动对齐）
+     */
+    static VkDeviceSize estimateMemory(VkFormat format, uint32_t width, uint32_t height,
+                                       uint32_t mipLevels, uint32_t baseLevel);
+
+    /**
+     * @brief 尺寸不超过 MIN_RESIDENT_SIZE 的第一个级别
+     */
+    static uint32_t getTailLevel(uint32_t width, uint32_t height, uint32_t mipLevels);
+
+private:
+    struct Entry {
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t mipLevels = 1;
+        uint32_t tailLevel = 0;
+        uint32_t baseLevel = 0;              // 当前驻留的最高精度级别
+        uint32_t wantedLevel = 0;            // 按屏幕尺寸需要的级别
+        uint32_t frameLevel = UINT32_MAX;    // 本帧记录的最小需求级别
+        uint32_t targetLevel = 0;            // 考虑预算后的目标级别
+        uint64_t lastUsedFrame = 0;
+        uint64_t wantedFrame = 0;            // wantedLevel 最近一次被设定的帧
+        bool used = false;                   // 加入后是否已有使用记录
+        bool streaming = false;
+
+        VkDeviceSize memoryAt(uint32_t level) const {
+            return estimateMemory(format, width, height, mipLevels, level);
+        }
+    };
+
+    uint32_t getRequiredLevel(const Entry& entry, float screenPixels) const;
+    VkDeviceSize getResidentBytes() const;
+
+    std::unordered_map<std::string, Entry> m_entries;
+    VkDeviceSize m_budget = 0;
+    uint64_t m_frame = 0;
+};
+
+} // namespace VulkanEngine
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.h>
+
+struct Vertex {
+    glm::vec3 pos;
+    glm::vec3 normal;
+    glm::vec2 texCoord;
+    glm::vec3 tangent;
+
+    static VkVertexInputBindingDescription getBindingDescription() {
+        VkVertexInputBindingDescription bindingDescription{};
+        bindingDescription.binding = 0;
+        bindingDescription.stride = sizeof(Vertex);
+        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        return bindingDescription;
+    }
+
+    static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions() {
+        std::vector<VkVertexInputAttributeDescription> attributeDescriptions(4);
+
+        // Position
+        attributeDescriptions[0].binding = 0;
+        attributeDescriptions[0].location = 0;
+        attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+        attributeDescriptions[0].offset = offsetof(Vertex, pos);
+
+        // Normal
+        attributeDescriptions[1].binding = 0;
+        attributeDescriptions[1].location = 1;
+        attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
+        attributeDescriptions[1].offset = offsetof(Vertex, normal);
+
+        // Texture coordinate
+        attributeDescriptions[2].binding = 0;
+        attributeDescriptions[2].location = 2;
+        attributeDescriptions[2].format = VK_FORMAT_R32G32_SFLOAT;
+        attributeDescriptions[2].offset = offsetof(Vertex, texCoord);
+
+        // Tangent
+        attributeDescriptions[3].binding = 0;
+        attributeDescriptions[3].location = 3;
+        attributeDescriptions[3].format = VK_FORMAT_R32G32B32_SFLOAT;
+        attributeDescriptions[3].offset = offsetof(Vertex, tangent);
+
+        return attributeDescriptions;
+    }
+    
+    // 用于去重的比较运算符
+    bool operator==(const Vertex& other) const {
+        return pos == other.pos && normal == other.normal && 
+               texCoord == other.texCoord && tangent == other.tangent;
+    }
+};
+
+/**
+ * 顶点格式（按网格选择，见 MeshLoadOptions::vertexFormat）
+ */
+enum class VertexFormat : uint32_t {
+    Standard = 0,   // Vertex，44 字节全精度
+    Compact = 1     // CompactVertex，20 字节量化格式
+};
+
+/**
+ * 量化顶点（20 字节）
+ * - position: 16 位 UNORM，相对网格 AABB 归一化，反量化矩阵并入模型矩阵（w 为填充）
+ * - normal / tangent: 八面体编码，16 位 SNORM
+ * - texCoord: 半精度浮点
+ * 副切线由着色器通过 cross(N, T) 重建，与 Vertex 一致，因此不需要额外的手性符号位
+ */
+struct CompactVertex {
+    uint16_t pos[4];
+    int16_t normal[2];
+    int16_t tangent[2];
+    uint16_t texCoord[2];
+
+    static VkVertexInputBindingDescription getBindingDescription() {
+        VkVertexInputBindingDescription bindingDescription{};
+        bindingDescription.binding = 0;
+        bindingDescription.stride = sizeof(CompactVertex);
+        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        return bindingDescription;
+    }
+
+    // location 与 Vertex 保持一致，着色器通过特化常量 COMPACT_VERTEX 选择解码路径
+    static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions() {
+        std::vector<VkVertexInputAttributeDescription> attributeDescriptions(4);
+
+        // Position
+        attributeDescriptions[0].binding = 0;
+        attributeDescriptions[0].location = 0;
+        attributeDescriptions[0].format = VK_FORMAT_R16G16B16A16_UNORM;
+        attributeDescriptions[0].offset = offsetof(CompactVertex, pos);
+
+        // Normal（八面体）
+        attributeDescriptions[1].binding = 0;
+        attributeDescriptions[1].location = 1;
+        attributeDescriptions[1].format = VK_FORMAT_R16G16_SNORM;
+        attributeDescriptions[1].offset = offsetof(CompactVertex, normal);
+
+        // Texture coordinate
+        attributeDescriptions[2].binding = 0;
+        attributeDescriptions[2].location = 2;
+        attributeDescriptions[2].format = VK_FORMAT_R16G16_SFLOAT;
+        attributeDescriptions[2].offset = offsetof(CompactVertex, texCoord);
+
+        // Tangent（八面体）
+        attributeDescriptions[3].binding = 0;
+        attributeDescriptions[3].location = 3;
+        attributeDescriptions[3].format = VK_FORMAT_R16G16_SNORM;
+        attributeDescriptions[3].offset = offsetof(CompactVertex, tangent);
+
+        return attributeDescriptions;
+    }
+};
+
+static_assert(sizeof(CompactVertex) == 20, "CompactVertex layout must stay 20 bytes");
+
+// Vertex 的哈希函数（用于 unordered_map）
+// 对全部 11 个分量的位模式做 64 位混合，避免 XOR 移位在网格状数据上的大量冲突
+namespace std {
+    template<> struct hash<Vertex> {
+        size_t operator()(Vertex const& vertex) const {
+            float components[sizeof(Vertex) / sizeof(float)];
+            std::memcpy(components, &vertex, sizeof(Vertex));
+            
+            uint64_t h = 0x9E3779B97F4A7C15ull;
+            for (float component : components) {
+                // +0.0f 把 -0.0 归一为 0.0，与 operator== 的语义保持一致
+                float normalized = component + 0.0f;
+                uint32_t word;
+                std::memcpy(&word, &normalized, sizeof(word));
+                h ^= word;
+                h *= 0xFF51AFD7ED558CCDull;
+                h ^= h >> 32;
+            }
+            return static_cast<size_t>(h);
+        }
+    };
+}
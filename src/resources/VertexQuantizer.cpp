@@ -0,0 +1,230 @@
+#include "VertexQuantizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+constexpr float UNORM16_MAX = 65535.0f;
+constexpr float SNORM16_MAX = 32767.0f;
+constexpr float HALF_MAX = 65504.0f;
+constexpr float RADIANS_TO_DEGREES = 57.29577951308232f;
+
+inline float signNotZero(float value) {
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+inline int16_t toSnorm16(float value) {
+    return static_cast<int16_t>(std::lround(std::max(-1.0f, std::min(1.0f, value)) * SNORM16_MAX));
+}
+
+inline float fromSnorm16(int16_t value) {
+    return std::max(static_cast<float>(value) / SNORM16_MAX, -1.0f);
+}
+
+inline float angleDegrees(const glm::vec3& a, const glm::vec3& b) {
+    float cosine = std::max(-1.0f, std::min(1.0f, glm::dot(a, b)));
+    return std::acos(cosine) * RADIANS_TO_DEGREES;
+}
+
+} // namespace
+
+float QuantizationReport::getRelativePositionError() const {
+    float longest = std::max(extent.x, std::max(extent.y, extent.z));
+    return longest > 0.0f ? maxPositionError / longest : 0.0f;
+}
+
+glm::vec2 VertexQuantizer::octEncode(const glm::vec3& v) {
+    float l1 = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+    if (l1 <= 0.0f) {
+        return glm::vec2(0.0f);
+    }
+
+    glm::vec2 p(v.x / l1, v.y / l1);
+    if (v.z < 0.0f) {
+        p = glm::vec2((1.0f - std::abs(p.y)) * signNotZero(p.x),
+                      (1.0f - std::abs(p.x)) * signNotZero(p.y));
+    }
+    return p;
+}
+
+glm::vec3 VertexQuantizer::octDecode(const glm::vec2& e) {
+    glm::vec3 v(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+    if (v.z < 0.0f) {
+        float x = (1.0f - std::abs(v.y)) * signNotZero(v.x);
+        float y = (1.0f - std::abs(v.x)) * signNotZero(v.y);
+        v.x = x;
+        v.y = y;
+    }
+    return glm::normalize(v);
+}
+
+uint16_t VertexQuantizer::floatToHalf(float value) {
+    uint32_t x;
+    std::memcpy(&x, &value, sizeof(x));
+
+    const uint16_t sign = static_cast<uint16_t>((x >> 16) & 0x8000u);
+    x &= 0x7FFFFFFFu;
+
+    if (x > 0x7F800000u) {
+        return static_cast<uint16_t>(sign | 0x7E00u);   // NaN
+    }
+    if (x >= 0x477FF000u) {
+        return static_cast<uint16_t>(sign | 0x7BFFu);   // 截断到最大有限值
+    }
+
+    if (x < 0x38800000u) {
+        // 半精度非规格化数
+        if (x < 0x33000000u) {
+            return sign;
+        }
+        uint32_t exponent = x >> 23;
+        uint32_t mantissa = (x & 0x7FFFFFu) | 0x800000u;
+        uint32_t shift = 126 - exponent;
+        uint32_t result = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (result & 1u))) {
+            ++result;
+        }
+        return static_cast<uint16_t>(sign | result);
+    }
+
+    uint32_t result = (x - 0x38000000u) >> 13;
+    uint32_t remainder = x & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (result & 1u))) {
+        ++result;
+    }
+    return static_cast<uint16_t>(sign | result);
+}
+
+float VertexQuantizer::halfToFloat(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1Fu;
+    const uint32_t mantissa = value & 0x3FFu;
+
+    if (exponent == 0) {
+        float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+
+    uint32_t bits = exponent == 0x1Fu ? (sign | 0x7F800000u | (mantissa << 13))
+                                      : (sign | ((exponent + 112) << 23) | (mantissa << 13));
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+std::vector<CompactVertex> VertexQuantizer::quantize(const std::vector<Vertex>& vertices, glm::mat4& dequantize,
+                                                     QuantizationReport* report) {
+    std::vector<CompactVertex> output(vertices.size());
+
+    glm::vec3 minBounds(0.0f);
+    glm::vec3 maxBounds(0.0f);
+    if (!vertices.empty()) {
+        minBounds = maxBounds = vertices[0].pos;
+        for (const Vertex& vertex : vertices) {
+            minBounds = glm::min(minBounds, vertex.pos);
+            maxBounds = glm::max(maxBounds, vertex.pos);
+        }
+    }
+    const glm::vec3 extent = maxBounds - minBounds;
+
+    // 反量化：UNORM 读出 [0,1]，缩放到 extent 后平移到 minBounds
+    dequantize = glm::mat4(1.0f);
+    dequantize[0][0] = extent.x;
+    dequantize[1][1] = extent.y;
+    dequantize[2][2] = extent.z;
+    dequantize[3] = glm::vec4(minBounds, 1.0f);
+
+    const glm::vec3 scale(extent.x > 0.0f ? UNORM16_MAX / extent.x : 0.0f,
+                          extent.y > 0.0f ? UNORM16_MAX / extent.y : 0.0f,
+                          extent.z > 0.0f ? UNORM16_MAX / extent.z : 0.0f);
+
+    QuantizationReport stats;
+    stats.vertexCount = vertices.size();
+    stats.extent = extent;
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex& vertex = vertices[i];
+        CompactVertex& packed = output[i];
+
+        glm::vec3 q = (vertex.pos - minBounds) * scale;
+        for (int c = 0; c < 3; ++c) {
+            packed.pos[c] = static_cast<uint16_t>(std::lround(std::max(0.0f, std::min(UNORM16_MAX, q[c]))));
+        }
+        packed.pos[3] = 0;
+
+        glm::vec2 normal = octEncode(vertex.normal);
+        packed.normal[0] = toSnorm16(normal.x);
+        packed.normal[1] = toSnorm16(normal.y);
+
+        glm::vec2 tangent = octEncode(vertex.tangent);
+        packed.tangent[0] = toSnorm16(tangent.x);
+        packed.tangent[1] = toSnorm16(tangent.y);
+
+        packed.texCoord[0] = floatToHalf(vertex.texCoord.x);
+        packed.texCoord[1] = floatToHalf(vertex.texCoord.y);
+
+        if (!report) continue;
+
+        // 按 GPU 的解码方式还原并统计误差
+        glm::vec3 position = minBounds + glm::vec3(packed.pos[0] / UNORM16_MAX,
+                                                   packed.pos[1] / UNORM16_MAX,
+                                                   packed.pos[2] / UNORM16_MAX) * extent;
+        stats.maxPositionError = std::max(stats.maxPositionError, glm::length(position - vertex.pos));
+
+        float normalLength = glm::length(vertex.normal);
+        if (normalLength > 0.0f) {
+            glm::vec3 decoded = octDecode(glm::vec2(fromSnorm16(packed.normal[0]), fromSnorm16(packed.normal[1])));
+            stats.maxNormalErrorDegrees = std::max(stats.maxNormalErrorDegrees,
+                                                   angleDegrees(decoded, vertex.normal / normalLength));
+        }
+
+        float tangentLength = glm::length(vertex.tangent);
+        if (tangentLength > 0.0f) {
+            glm::vec3 decoded = octDecode(glm::vec2(fromSnorm16(packed.tangent[0]), fromSnorm16(packed.tangent[1])));
+            stats.maxTangentErrorDegrees = std::max(stats.maxTangentErrorDegrees,
+                                                    angleDegrees(decoded, vertex.tangent / tangentLength));
+        }
+
+        for (int c = 0; c < 2; ++c) {
+            float original = vertex.texCoord[c];
+            if (std::abs(original) > HALF_MAX) {
+                ++stats.uvOutOfRange;
+                continue;
+            }
+            stats.maxTexCoordError = std::max(stats.maxTexCoordError,
+                                              std::abs(halfToFloat(packed.texCoord[c]) - original));
+        }
+    }
+
+    if (report) {
+        *report = stats;
+    }
+    return output;
+}
+
+QuantizationReport VertexQuantizer::analyze(const std::vector<Vertex>& vertices) {
+    glm::mat4 dequantize;
+    QuantizationReport report;
+    quantize(vertices, dequantize, &report);
+    return report;
+}
+
+void VertexQuantizer::printReport(const char* label, const QuantizationReport& report) {
+    std::cout << "[VertexQuantizer] " << label << ": " << report.vertexCount << " vertices, "
+              << report.vertexCount * sizeof(Vertex) / 1024 << " KB -> "
+              << report.vertexCount * sizeof(CompactVertex) / 1024 << " KB"
+              << ", position error " << report.maxPositionError
+              << " (" << report.getRelativePositionError() * 100.0f << "% of extent)"
+              << ", normal " << report.maxNormalErrorDegrees << " deg"
+              << ", tangent " << report.maxTangentErrorDegrees << " deg"
+              << ", uv " << report.maxTexCoordError;
+    if (report.uvOutOfRange > 0) {
+        std::cout << " (" << report.uvOutOfRange << " uv components clamped)";
+    }
+    std::cout << std::endl;
+}
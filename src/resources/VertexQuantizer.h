@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Vertex.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 量化精度报告（与原始 Vertex 比较的最大误差）
+ */
+struct QuantizationReport {
+    size_t vertexCount = 0;
+    glm::vec3 extent = glm::vec3(0.0f);   // 网格 AABB 尺寸
+    float maxPositionError = 0.0f;        // 局部空间距离
+    float maxNormalErrorDegrees = 0.0f;
+    float maxTangentErrorDegrees = 0.0f;
+    float maxTexCoordError = 0.0f;
+    size_t uvOutOfRange = 0;              // 超出半精度范围（被截断）的 UV 数
+
+    // 位置误差相对 AABB 最长边的比例
+    float getRelativePositionError() const;
+};
+
+/**
+ * 顶点量化：Vertex (44 字节) -> CompactVertex (20 字节)
+ *
+ * 位置按 AABB 归一化到 [0, 65535]，反量化 (min + q * extent) 以矩阵形式
+ * 并入模型矩阵，着色器中 position 路径无需改动；法线/切线使用八面体编码，
+ * 解码公式与 pbr.vert / gbuffer.vert 中的 octDecode() 一致
+ */
+class VertexQuantizer {
+public:
+    /**
+     * @brief 量化顶点
+     * @param dequantize 输出：反量化矩阵（model * dequantize 得到最终模型矩阵）
+     * @param report 可选输出：精度报告
+     */
+    static std::vector<CompactVertex> quantize(const std::vector<Vertex>& vertices, glm::mat4& dequantize,
+                                               QuantizationReport* report = nullptr);
+
+    /**
+     * @brief 只计算精度报告（用于导入时判断资源是否适合使用紧凑格式）
+     */
+    static QuantizationReport analyze(const std::vector<Vertex>& vertices);
+
+    /**
+     * @brief 打印精度报告
+     */
+    static void printReport(const char* label, const QuantizationReport& report);
+
+    // 八面体编码（单位向量 -> [-1, 1]^2）及其逆变换
+    static glm::vec2 octEncode(const glm::vec3& v);
+    static glm::vec3 octDecode(const glm::vec2& e);
+
+    // IEEE 754 半精度转换（就近舍入，超出范围截断到最大有限值）
+    static uint16_t floatToHalf(float value);
+    static float halfToFloat(uint16_t value);
+};
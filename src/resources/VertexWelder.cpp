@@ -0,0 +1,302 @@
+#include "VertexWelder.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+constexpr uint32_t EMPTY_SLOT = 0;
+
+inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+inline uint64_t hashCorner(const ObjCorner& c) {
+    uint64_t a = static_cast<uint64_t>(static_cast<uint32_t>(c.position)) |
+                 (static_cast<uint64_t>(static_cast<uint32_t>(c.texCoord)) << 32);
+    return mix64(a ^ mix64(static_cast<uint64_t>(static_cast<uint32_t>(c.normal)) + 0x9E3779B97F4A7C15ull));
+}
+
+inline bool sameCorner(const ObjCorner& a, const ObjCorner& b) {
+    return a.position == b.position && a.texCoord == b.texCoord && a.normal == b.normal;
+}
+
+inline uint64_t hashVertexBits(const Vertex& v) {
+    static_assert(sizeof(Vertex) % sizeof(uint32_t) == 0, "Vertex must be made of 32-bit fields");
+    uint32_t words[sizeof(Vertex) / sizeof(uint32_t)];
+    std::memcpy(words, &v, sizeof(Vertex));
+
+    uint64_t hash = 0x9E3779B97F4A7C15ull;
+    for (uint32_t word : words) {
+        hash = mix64(hash ^ word);
+    }
+    return hash;
+}
+
+inline size_t nextPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+inline double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * 开放寻址（线性探测）表，槽位保存 "唯一编号 + 1"，键由调用方通过编号回查比较
+ */
+class IndexTable {
+public:
+    explicit IndexTable(size_t expected) {
+        slots.assign(nextPowerOfTwo(std::max<size_t>(expected * 2, 1024)), EMPTY_SLOT);
+        mask = slots.size() - 1;
+    }
+
+    // 返回已有编号；不存在时插入 newId 并返回 newId
+    template<typename Equal, typename Rehash>
+    uint32_t findOrInsert(uint64_t hash, uint32_t newId, Equal equal, Rehash rehash) {
+        if ((count + 1) * 2 > slots.size()) {
+            grow(rehash);
+        }
+
+        size_t slot = static_cast<size_t>(hash) & mask;
+        for (;;) {
+            uint32_t stored = slots[slot];
+            if (stored == EMPTY_SLOT) {
+                slots[slot] = newId + 1;
+                ++count;
+                return newId;
+            }
+            if (equal(stored - 1)) {
+                return stored - 1;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+private:
+    template<typename Rehash>
+    void grow(Rehash rehash) {
+        std::vector<uint32_t> old = std::move(slots);
+        slots.assign(old.size() * 2, EMPTY_SLOT);
+        mask = slots.size() - 1;
+        for (uint32_t stored : old) {
+            if (stored == EMPTY_SLOT) continue;
+            size_t slot = static_cast<size_t>(rehash(stored - 1)) & mask;
+            while (slots[slot] != EMPTY_SLOT) {
+                slot = (slot + 1) & mask;
+            }
+            slots[slot] = stored;
+        }
+    }
+
+    std::vector<uint32_t> slots;
+    size_t mask = 0;
+    size_t count = 0;
+};
+
+bool withinTolerance(const Vertex& a, const Vertex& b, const VertexWelder::Options& options) {
+    glm::vec3 d = a.pos - b.pos;
+    if (glm::dot(d, d) > options.positionEpsilon * options.positionEpsilon) return false;
+
+    if (std::abs(a.texCoord.x - b.texCoord.x) > options.texCoordEpsilon ||
+        std::abs(a.texCoord.y - b.texCoord.y) > options.texCoordEpsilon) {
+        return false;
+    }
+
+    float lengths = glm::length(a.normal) * glm::length(b.normal);
+    if (lengths < 1e-12f) {
+        return a.normal == b.normal;
+    }
+    return glm::dot(a.normal, b.normal) >= options.normalCosTolerance * lengths;
+}
+
+/**
+ * 容差焊接：单元大小为 epsilon 的空间哈希，每个顶点检查 27 个相邻单元
+ */
+void weldWithTolerance(const std::vector<Vertex>& vertices, const VertexWelder::Options& options,
+                       std::vector<uint32_t>& remap, std::vector<uint32_t>& representatives) {
+    struct Cell {
+        int64_t x, y, z;
+        uint32_t head;
+    };
+    const uint32_t none = std::numeric_limits<uint32_t>::max();
+
+    std::vector<Cell> cells(nextPowerOfTwo(std::max<size_t>(vertices.size() * 2, 1024)), Cell{0, 0, 0, none});
+    const size_t mask = cells.size() - 1;
+    std::vector<uint32_t> next(vertices.size(), none);
+
+    const float inverseCell = 1.0f / options.positionEpsilon;
+    auto cellHash = [](int64_t x, int64_t y, int64_t z) {
+        return mix64(static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ull ^
+                     static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4Full ^
+                     static_cast<uint64_t>(z) * 0x165667B19E3779F9ull);
+    };
+    auto findCell = [&](int64_t x, int64_t y, int64_t z) -> Cell& {
+        size_t slot = static_cast<size_t>(cellHash(x, y, z)) & mask;
+        while (cells[slot].head != none && (cells[slot].x != x || cells[slot].y != y || cells[slot].z != z)) {
+            slot = (slot + 1) & mask;
+        }
+        return cells[slot];
+    };
+
+    remap.resize(vertices.size());
+    representatives.clear();
+
+    for (uint32_t i = 0; i < vertices.size(); ++i) {
+        const Vertex& vertex = vertices[i];
+        int64_t cx = static_cast<int64_t>(std::floor(vertex.pos.x * inverseCell));
+        int64_t cy = static_cast<int64_t>(std::floor(vertex.pos.y * inverseCell));
+        int64_t cz = static_cast<int64_t>(std::floor(vertex.pos.z * inverseCell));
+
+        uint32_t match = none;
+        for (int64_t dz = -1; dz <= 1 && match == none; ++dz) {
+            for (int64_t dy = -1; dy <= 1 && match == none; ++dy) {
+                for (int64_t dx = -1; dx <= 1 && match == none; ++dx) {
+                    const Cell& cell = findCell(cx + dx, cy + dy, cz + dz);
+                    for (uint32_t j = cell.head; j != none; j = next[j]) {
+                        if (withinTolerance(vertices[j], vertex, options)) {
+                            match = j;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (match != none) {
+            remap[i] = remap[match];
+            continue;
+        }
+
+        // 成为新的代表顶点，挂到所在单元的链表头
+        remap[i] = static_cast<uint32_t>(representatives.size());
+        representatives.push_back(i);
+
+        Cell& cell = findCell(cx, cy, cz);
+        if (cell.head == none) {
+            cell.x = cx;
+            cell.y = cy;
+            cell.z = cz;
+        }
+        next[i] = cell.head;
+        cell.head = i;
+    }
+}
+
+} // namespace
+
+VertexWelder::Stats VertexWelder::weldCorners(const ObjCorner* corners, size_t count,
+                                              std::vector<uint32_t>& cornerToVertex,
+                                              std::vector<uint32_t>& uniqueCorners) {
+    auto start = std::chrono::steady_clock::now();
+
+    cornerToVertex.resize(count);
+    uniqueCorners.clear();
+    uniqueCorners.reserve(count / 4);
+
+    IndexTable table(count / 4);
+    for (size_t i = 0; i < count; ++i) {
+        const ObjCorner& corner = corners[i];
+        const uint32_t newId = static_cast<uint32_t>(uniqueCorners.size());
+
+        uint32_t id = table.findOrInsert(
+            hashCorner(corner), newId,
+            [&](uint32_t existing) { return sameCorner(corners[uniqueCorners[existing]], corner); },
+            [&](uint32_t existing) { return hashCorner(corners[uniqueCorners[existing]]); });
+
+        if (id == newId) {
+            uniqueCorners.push_back(static_cast<uint32_t>(i));
+        }
+        cornerToVertex[i] = id;
+    }
+
+    Stats stats;
+    stats.inputVertices = count;
+    stats.outputVertices = uniqueCorners.size();
+    stats.milliseconds = elapsedMs(start);
+    return stats;
+}
+
+VertexWelder::Stats VertexWelder::weldVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+                                               const Options& options) {
+    auto start = std::chrono::steady_clock::now();
+
+    Stats stats;
+    stats.inputVertices = vertices.size();
+
+    if (indices.empty()) {
+        indices.resize(vertices.size() - vertices.size() % 3);
+        for (uint32_t i = 0; i < indices.size(); ++i) {
+            indices[i] = i;
+        }
+    }
+
+    std::vector<uint32_t> remap;
+    std::vector<uint32_t> representatives;
+
+    if (options.positionEpsilon > 0.0f) {
+        weldWithTolerance(vertices, options, remap, representatives);
+    } else {
+        remap.resize(vertices.size());
+        IndexTable table(vertices.size() / 2);
+        for (uint32_t i = 0; i < vertices.size(); ++i) {
+            const uint32_t newId = static_cast<uint32_t>(representatives.size());
+            uint32_t id = table.findOrInsert(
+                hashVertexBits(vertices[i]), newId,
+                [&](uint32_t existing) {
+                    return std::memcmp(&vertices[representatives[existing]], &vertices[i], sizeof(Vertex)) == 0;
+                },
+                [&](uint32_t existing) { return hashVertexBits(vertices[representatives[existing]]); });
+
+            if (id == newId) {
+                representatives.push_back(i);
+            }
+            remap[i] = id;
+        }
+    }
+
+    // 压缩顶点数组（代表顶点按首次出现顺序排列，可原地前移）
+    for (size_t i = 0; i < representatives.size(); ++i) {
+        vertices[i] = vertices[representatives[i]];
+    }
+    vertices.resize(representatives.size());
+
+    // 重映射索引并剔除退化三角形
+    size_t write = 0;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        uint32_t a = remap[indices[i]];
+        uint32_t b = remap[indices[i + 1]];
+        uint32_t c = remap[indices[i + 2]];
+        if (options.removeDegenerate && (a == b || b == c || a == c)) {
+            ++stats.removedTriangles;
+            continue;
+        }
+        indices[write++] = a;
+        indices[write++] = b;
+        indices[write++] = c;
+    }
+    indices.resize(write);
+
+    stats.outputVertices = vertices.size();
+    stats.milliseconds = elapsedMs(start);
+    return stats;
+}
+
+void VertexWelder::printStats(const char* label, const Stats& stats) {
+    std::cout << "[VertexWelder] " << label << ": " << stats.inputVertices << " -> " << stats.outputVertices
+              << " vertices (ratio " << stats.getWeldRatio() << ":1";
+    if (stats.removedTriangles > 0) {
+        std::cout << ", " << stats.removedTriangles << " degenerate triangles removed";
+    }
+    std::cout << ") in " << stats.milliseconds << " ms" << std::endl;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Vertex.h"
+#include "ObjParser.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 焊接参数
+ */
+struct WeldOptions {
+    float positionEpsilon = 0.0f;     // > 0 启用容差焊接
+    float normalCosTolerance = 0.999f; // 容差焊接时法线夹角余弦下限
+    float texCoordEpsilon = 1e-5f;     // 容差焊接时 UV 最大差值
+    bool removeDegenerate = true;      // 删除焊接后退化的三角形
+};
+
+/**
+ * 焊接统计
+ */
+struct WeldStats {
+    size_t inputVertices = 0;
+    size_t outputVertices = 0;
+    size_t removedTriangles = 0;
+    double milliseconds = 0.0;
+
+    // 焊接比：输入顶点数 / 输出顶点数
+    double getWeldRatio() const {
+        return outputVertices ? static_cast<double>(inputVertices) / static_cast<double>(outputVertices) : 0.0;
+    }
+};
+
+/**
+ * 顶点焊接
+ *
+ * - weldCorners(): OBJ 导入路径，按 (位置, 纹理坐标, 法线) 索引三元组精确焊接，
+ *   使用开放寻址哈希表，每个面顶点只做一次探测
+ * - weldVertices(): 对已构建的顶点数组焊接。epsilon 为 0 时按位精确比较全部属性；
+ *   大于 0 时使用空间哈希做容差焊接（适合 CAD 导出的重复顶点）
+ */
+class VertexWelder {
+public:
+    using Options = WeldOptions;
+    using Stats = WeldStats;
+
+    /**
+     * @brief 按 OBJ 索引三元组焊接
+     * @param corners 面顶点数组
+     * @param count 面顶点数量
+     * @param cornerToVertex 输出：每个面顶点对应的唯一顶点编号
+     * @param uniqueCorners 输出：每个唯一顶点的代表面顶点（首次出现位置）
+     */
+    static Stats weldCorners(const ObjCorner* corners, size_t count,
+                             std::vector<uint32_t>& cornerToVertex,
+                             std::vector<uint32_t>& uniqueCorners);
+
+    /**
+     * @brief 焊接顶点并重映射索引
+     * indices 为空时将 vertices 视为三角形列表（每 3 个顶点一个三角形）并生成索引
+     */
+    static Stats weldVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+                              const Options& options = Options());
+
+    /**
+     * @brief 打印焊接统计
+     */
+    static void printStats(const char* label, const Stats& stats);
+};
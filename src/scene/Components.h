@@ -2,6 +2,7 @@
 
 #include <string>
 #include <entt/entt.hpp>
+#include "../resources/ResourceHandle.h"
 
 // GLM 配置
 #define GLM_ENABLE_EXPERIMENTAL
@@ -102,6 +103,9 @@ struct MeshRendererComponent {
     bool castShadows = true;        // 是否投射阴影
     bool receiveShadows = true;     // 是否接收阴影
     bool visible = true;            // 是否可见
+    
+    // 由 RenderSystem 在组件赋值 / patch 时从 meshPath 解析，渲染时按句柄访问（不序列化）
+    MeshHandle meshHandle;
 
     MeshRendererComponent() = default;
     MeshRendererComponent(const std::string& mesh, const std::string& material = "")
@@ -123,9 +127,15 @@ struct PBRMaterialComponent {
     std::string albedoMap;
     std::string normalMap;
     std::string metallicMap;
-    std::string roughnessMap;
+    std::string roughnessMap;     // 与 metallicMap 相同时按 glTF 打包贴图处理（B: 金属度, G: 粗糙度）
     std::string aoMap;
     std::string emissiveMap;
+    
+    // 由 RenderSystem 在组件赋值 / patch 时从纹理路径解析（不序列化）
+    TextureHandle albedoHandle;
+    TextureHandle normalHandle;
+    TextureHandle metallicHandle;
+    MaterialHandle materialHandle;
 };
 
 // ============================================================
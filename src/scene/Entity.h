@@ -47,8 +47,22 @@ public:
         return m_scene->m_registry.emplace_or_replace<T>(m_entityHandle, std::forward<Args>(args)...);
     }
 
+    /**
+     * @brief 就地修改组件并发出 on_update 信号（RenderSystem 等观察者据此更新缓存）
+     * @tparam T 组件类型
+     * @param func 修改函数，参数为组件引用；可省略，仅通知组件已被修改
+     * @return 组件引用
+     */
+    template<typename T, typename... Func>
+    T& patchComponent(Func&&... func) {
+        assert(hasComponent<T>() && "Entity does not have component!");
+        return m_scene->m_registry.patch<T>(m_entityHandle, std::forward<Func>(func)...);
+    }
+
     /**
      * @brief 获取组件
+     * 直接修改返回的引用不会通知观察者，渲染相关组件（Transform / MeshRenderer / PBRMaterial）
+     * 修改后需调用 patchComponent
      * @tparam T 组件类型
      * @return 组件引用
      */
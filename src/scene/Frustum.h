@@ -0,0 +1,53 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace VulkanEngine {
+
+/**
+ * @brief 视锥体（6 个平面，法线指向内侧）
+ */
+struct Frustum {
+    glm::vec4 planes[6];   // (normal, d)，内侧满足 dot(normal, p) + d >= 0
+
+    /**
+     * @brief 从 proj * view（或 proj * view * model）矩阵提取平面（Gribb-Hartmann）
+     * 近平面按 [-1, 1] 深度范围提取，对 [0, 1] 深度的投影而言偏保守
+     */
+    static Frustum fromMatrix(const glm::mat4& m) {
+        glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+        Frustum frustum;
+        frustum.planes[0] = row3 + row0;   // left
+        frustum.planes[1] = row3 - row0;   // right
+        frustum.planes[2] = row3 + row1;   // bottom（Vulkan Y 翻转后为 top，不影响判定）
+        frustum.planes[3] = row3 - row1;   // top
+        frustum.planes[4] = row3 + row2;   // near
+        frustum.planes[5] = row3 - row2;   // far
+
+        for (glm::vec4& plane : frustum.planes) {
+            float length = glm::length(glm::vec3(plane));
+            if (length > 0.0f) {
+                plane = plane / length;
+            }
+        }
+        return frustum;
+    }
+
+    /**
+     * @brief 包围球是否与视锥体相交（保守判定）
+     */
+    bool intersectsSphere(const glm::vec3& center, float radius) const {
+        for (const glm::vec4& plane : planes) {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace VulkanEngine
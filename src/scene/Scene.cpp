@@ -69,7 +69,7 @@ Entity Scene::duplicateEntity(Entity entity) {
     
     // 复制 TransformComponent
     if (entity.hasComponent<TransformComponent>()) {
-        newEntity.getComponent<TransformComponent>() = entity.getComponent<TransformComponent>();
+        m_registry.replace<TransformComponent>(newEntity.getHandle(), entity.getComponent<TransformComponent>());
     }
     
     // 复制 MeshRendererComponent
@@ -2,6 +2,14 @@
 #include "DebugPanel.h"
 #include "imgui.h"
 
+namespace {
+
+float toMB(VkDeviceSize bytes) {
+    return static_cast<float>(bytes) / (1024.0f * 1024.0f);
+}
+
+} // namespace
+
 DebugPanel::DebugPanel() {
     // 初始化 FPS 历史记录
     for (int i = 0; i < FPS_HISTORY_SIZE; ++i) {
@@ -33,14 +41,106 @@ void DebugPanel::render() {
 
         // 渲染统计
         ImGui::Text("Draw Calls: %u", drawCalls);
+        ImGui::Text("Instances: %u (%u instanced batches)", drawStats.instances, drawStats.instancedDraws);
+        if (drawStats.indirectDraws > 0) {
+            ImGui::Text("GPU Culling: %u indirect commands", drawStats.indirectDraws);
+        }
         ImGui::Text("Triangles: %u", triangles);
         ImGui::Text("Vertices: %u", vertices);
+
+        // 绘制排序后的状态绑定（bound / skipped）
+        ImGui::Text("Binds Saved: %u", drawStats.getBindsSaved());
+        ImGui::Text("  Pipeline: %u / %u  Descriptor: %u / %u", drawStats.pipelineBinds, drawStats.pipelineBindsSkipped,
+                    drawStats.descriptorBinds, drawStats.descriptorBindsSkipped);
+        ImGui::Text("  Vertex Buffer: %u / %u  Index Buffer: %u / %u",
+                    drawStats.vertexBufferBinds, drawStats.vertexBufferBindsSkipped,
+                    drawStats.indexBufferBinds, drawStats.indexBufferBindsSkipped);
         
         // GPU 内存使用
         if (gpuMemory > 0) {
             float memoryMB = static_cast<float>(gpuMemory) / (1024.0f * 1024.0f);
             ImGui::Text("GPU Memory: %.2f MB", memoryMB);
         }
+
+        ImGui::Separator();
+
+        // 纹理显存预算
+        float textureMB = static_cast<float>(textureMemory) / (1024.0f * 1024.0f);
+        if (textureBudget > 0) {
+            float budgetMB = static_cast<float>(textureBudget) / (1024.0f * 1024.0f);
+            char budgetOverlay[64];
+            snprintf(budgetOverlay, sizeof(budgetOverlay), "%.1f / %.1f MB", textureMB, budgetMB);
+            ImGui::Text("Texture Memory:");
+            ImGui::ProgressBar(static_cast<float>(textureMemory) / static_cast<float>(textureBudget),
+                               ImVec2(-1.0f, 0.0f), budgetOverlay);
+        } else {
+            ImGui::Text("Texture Memory: %.2f MB (no budget)", textureMB);
+        }
+        ImGui::Text("Textures: %u  Streaming: %u", textureCount, streamingTextures);
+        if (reducedTextures > 0) {
+            ImGui::TextColored(ImVec4(0.9f, 0.6f, 0.3f, 1.0f), "Reduced by budget: %u", reducedTextures);
+        }
+    }
+
+    ImGui::Spacing();
+
+    // === 显存统计 ===
+    if (ImGui::CollapsingHeader("GPU Memory")) {
+        const VulkanAllocatorStats& allocator = memoryReport.allocator;
+        ImGui::Text("Reserved: %.1f MB  Used: %.1f MB", toMB(allocator.reservedBytes), toMB(allocator.usedBytes));
+        ImGui::Text("Device Allocations: %u / %u", allocator.deviceAllocationCount, memoryReport.maxAllocationCount);
+        ImGui::Text("Blocks: %u  Dedicated: %u  Free Ranges: %u",
+                    allocator.blockCount, allocator.dedicatedCount, allocator.freeRangeCount);
+
+        // 按用途
+        if (ImGui::BeginTable("##MemoryCategories", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+            ImGui::TableSetupColumn("Category");
+            ImGui::TableSetupColumn("MB");
+            ImGui::TableSetupColumn("Peak MB");
+            ImGui::TableSetupColumn("Count");
+            ImGui::TableHeadersRow();
+            for (size_t i = 0; i < static_cast<size_t>(VulkanMemoryCategory::Count); ++i) {
+                const VulkanCategoryStats& category = memoryReport.categories[i];
+                if (category.peakBytes == 0) continue;
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%s", getMemoryCategoryName(static_cast<VulkanMemoryCategory>(i)));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", toMB(category.bytes));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", toMB(category.peakBytes));
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", category.allocationCount);
+            }
+            ImGui::EndTable();
+        }
+
+        // 按堆：有预算时显示驱动报告的占用 / 预算，否则显示分配器占用 / 堆大小
+        for (size_t i = 0; i < memoryReport.heaps.size(); ++i) {
+            const VulkanHeapStats& heap = memoryReport.heaps[i];
+            if (heap.reservedBytes == 0 && heap.usageBytes == 0) continue;
+
+            const VkDeviceSize used = memoryReport.hasBudget ? heap.usageBytes : heap.reservedBytes;
+            const VkDeviceSize limit = memoryReport.hasBudget ? heap.budgetBytes : heap.heapSize;
+            const float fraction = limit > 0 ? static_cast<float>(used) / static_cast<float>(limit) : 0.0f;
+
+            ImGui::Text("Heap %zu (%s)  Peak: %.1f MB", i, heap.deviceLocal ? "device" : "host",
+                        toMB(heap.peakReservedBytes));
+            char heapOverlay[64];
+            snprintf(heapOverlay, sizeof(heapOverlay), "%.1f / %.1f MB%s", toMB(used), toMB(limit),
+                     memoryReport.hasBudget ? "" : " (heap)");
+            if (fraction > 0.9f) {
+                ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.9f, 0.3f, 0.3f, 1.0f));
+                ImGui::ProgressBar(fraction, ImVec2(-1.0f, 0.0f), heapOverlay);
+                ImGui::PopStyleColor();
+            } else {
+                ImGui::ProgressBar(fraction, ImVec2(-1.0f, 0.0f), heapOverlay);
+            }
+        }
+        if (!memoryReport.hasBudget) {
+            ImGui::TextDisabled("VK_EXT_memory_budget not supported");
+        }
+        ImGui::TextDisabled("F9 - Dump memory report to JSON");
     }
 
     ImGui::Spacing();
@@ -96,6 +196,7 @@ void DebugPanel::render() {
         ImGui::BulletText("Right Mouse + Drag - Look around");
         ImGui::BulletText("Scroll - Adjust FOV");
         ImGui::BulletText("1-5 - Switch geometry/scene");
+        ImGui::BulletText("F9 - Dump GPU memory report");
         ImGui::BulletText("ESC - Exit");
     }
 
@@ -4,6 +4,8 @@
 #include <glm/glm.hpp>
 #include <string>
 #include <cstdint>
+#include "VulkanAllocator.h"
+#include "DrawSort.h"
 
 /**
  * DebugPanel - 调试信息面板
@@ -28,6 +30,20 @@ public:
     void setVertices(uint32_t count) { vertices = count; }
     void setGPUMemory(size_t bytes) { gpuMemory = bytes; }
 
+    // 设置绘制提交统计（排序后省去的重复绑定）
+    void setDrawSubmitStats(const VulkanEngine::DrawSubmitStats& stats) { drawStats = stats; }
+
+    // 设置显存统计（按用途 / 按堆，含 VK_EXT_memory_budget 预算）
+    void setMemoryReport(const VulkanMemoryReport& report) { memoryReport = report; }
+
+    // 设置纹理流式加载统计
+    void setTextureMemory(size_t resident, size_t budget) { textureMemory = resident; textureBudget = budget; }
+    void setTextureCounts(uint32_t total, uint32_t streaming, uint32_t reduced) {
+        textureCount = total;
+        streamingTextures = streaming;
+        reducedTextures = reduced;
+    }
+
     // 设置相机信息
     void setCameraPosition(const glm::vec3& pos) { cameraPosition = pos; }
     void setCameraRotation(const glm::vec3& rot) { cameraRotation = rot; }
@@ -46,6 +62,15 @@ private:
     uint32_t triangles = 0;
     uint32_t vertices = 0;
     size_t gpuMemory = 0;
+    VulkanEngine::DrawSubmitStats drawStats;
+    VulkanMemoryReport memoryReport;
+
+    // 纹理流式加载
+    size_t textureMemory = 0;
+    size_t textureBudget = 0;
+    uint32_t textureCount = 0;
+    uint32_t streamingTextures = 0;
+    uint32_t reducedTextures = 0;
 
     // FPS 历史记录（用于图表）
     static constexpr int FPS_HISTORY_SIZE = 120;
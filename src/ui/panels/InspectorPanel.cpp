@@ -127,30 +127,37 @@ void InspectorPanel::renderTransformComponent() {
     
     if (ImGui::CollapsingHeader("Transform", ImGuiTreeNodeFlags_DefaultOpen)) {
         auto& transform = registry.get<TransformComponent>(m_selectedEntity);
+        bool changed = false;
         
         // Position
         ImGui::Text("Position");
         ImGui::SameLine(80);
         ImGui::SetNextItemWidth(-1);
-        ImGui::DragFloat3("##Position", &transform.position.x, 0.1f);
+        changed |= ImGui::DragFloat3("##Position", &transform.position.x, 0.1f);
 
         // Rotation (欧拉角)
         ImGui::Text("Rotation");
         ImGui::SameLine(80);
         ImGui::SetNextItemWidth(-1);
-        ImGui::DragFloat3("##Rotation", &transform.rotation.x, 1.0f, -360.0f, 360.0f);
+        changed |= ImGui::DragFloat3("##Rotation", &transform.rotation.x, 1.0f, -360.0f, 360.0f);
 
         // Scale
         ImGui::Text("Scale");
         ImGui::SameLine(80);
         ImGui::SetNextItemWidth(-1);
-        ImGui::DragFloat3("##Scale", &transform.scale.x, 0.01f, 0.001f, 100.0f);
+        changed |= ImGui::DragFloat3("##Scale", &transform.scale.x, 0.01f, 0.001f, 100.0f);
 
         // 重置按钮
         if (ImGui::Button("Reset Transform")) {
             transform.position = glm::vec3(0.0f);
             transform.rotation = glm::vec3(0.0f);
             transform.scale = glm::vec3(1.0f);
+            changed = true;
+        }
+        
+        // 通知观察者（RenderSystem 只重新计算变化实体的模型矩阵）
+        if (changed) {
+            registry.patch<TransformComponent>(m_selectedEntity);
         }
     }
 }
@@ -174,11 +181,12 @@ void InspectorPanel::renderMeshRendererComponent() {
     
     if (componentOpen) {
         auto& meshRenderer = registry.get<MeshRendererComponent>(m_selectedEntity);
+        bool changed = false;
         
         // 可见性
-        ImGui::Checkbox("Visible", &meshRenderer.visible);
-        ImGui::Checkbox("Cast Shadows", &meshRenderer.castShadows);
-        ImGui::Checkbox("Receive Shadows", &meshRenderer.receiveShadows);
+        changed |= ImGui::Checkbox("Visible", &meshRenderer.visible);
+        changed |= ImGui::Checkbox("Cast Shadows", &meshRenderer.castShadows);
+        changed |= ImGui::Checkbox("Receive Shadows", &meshRenderer.receiveShadows);
 
         // 显示网格和材质路径
         char meshBuffer[256] = {0};
@@ -188,6 +196,7 @@ void InspectorPanel::renderMeshRendererComponent() {
         ImGui::SetNextItemWidth(-1);
         if (ImGui::InputText("##MeshPath", meshBuffer, sizeof(meshBuffer))) {
             meshRenderer.meshPath = meshBuffer;
+            changed = true;
         }
 
         char matBuffer[256] = {0};
@@ -197,6 +206,11 @@ void InspectorPanel::renderMeshRendererComponent() {
         ImGui::SetNextItemWidth(-1);
         if (ImGui::InputText("##MaterialPath", matBuffer, sizeof(matBuffer))) {
             meshRenderer.materialPath = matBuffer;
+            changed = true;
+        }
+        
+        if (changed) {
+            registry.patch<MeshRendererComponent>(m_selectedEntity);
         }
     }
 
@@ -204,39 +218,44 @@ void InspectorPanel::renderMeshRendererComponent() {
     if (registry.all_of<PBRMaterialComponent>(m_selectedEntity)) {
         if (ImGui::CollapsingHeader("PBR Material", ImGuiTreeNodeFlags_DefaultOpen)) {
             auto& material = registry.get<PBRMaterialComponent>(m_selectedEntity);
+            bool changed = false;
             
             // Albedo 颜色
             ImGui::Text("Albedo");
             ImGui::SameLine(100);
-            ImGui::ColorEdit3("##Albedo", &material.albedo.x);
+            changed |= ImGui::ColorEdit3("##Albedo", &material.albedo.x);
 
             // Metallic
             ImGui::Text("Metallic");
             ImGui::SameLine(100);
             ImGui::SetNextItemWidth(-1);
-            ImGui::SliderFloat("##Metallic", &material.metallic, 0.0f, 1.0f);
+            changed |= ImGui::SliderFloat("##Metallic", &material.metallic, 0.0f, 1.0f);
 
             // Roughness
             ImGui::Text("Roughness");
             ImGui::SameLine(100);
             ImGui::SetNextItemWidth(-1);
-            ImGui::SliderFloat("##Roughness", &material.roughness, 0.0f, 1.0f);
+            changed |= ImGui::SliderFloat("##Roughness", &material.roughness, 0.0f, 1.0f);
 
             // AO
             ImGui::Text("AO");
             ImGui::SameLine(100);
             ImGui::SetNextItemWidth(-1);
-            ImGui::SliderFloat("##AO", &material.ao, 0.0f, 1.0f);
+            changed |= ImGui::SliderFloat("##AO", &material.ao, 0.0f, 1.0f);
 
             // Emissive
             ImGui::Text("Emissive");
             ImGui::SameLine(100);
-            ImGui::ColorEdit3("##Emissive", &material.emissive.x);
+            changed |= ImGui::ColorEdit3("##Emissive", &material.emissive.x);
 
             ImGui::Text("Emissive Str");
             ImGui::SameLine(100);
             ImGui::SetNextItemWidth(-1);
-            ImGui::SliderFloat("##EmissiveStr", &material.emissiveStrength, 0.0f, 10.0f);
+            changed |= ImGui::SliderFloat("##EmissiveStr", &material.emissiveStrength, 0.0f, 10.0f);
+
+            if (changed) {
+                registry.patch<PBRMaterialComponent>(m_selectedEntity);
+            }
         }
     }
 }